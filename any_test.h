@@ -0,0 +1,189 @@
+#ifndef MYTINYSTL_ANY_TEST_H_
+#define MYTINYSTL_ANY_TEST_H_
+
+// any test : 测试 any 的接口，以及复制、移动、emplace 、 any_cast 相对 std::any 的性能
+
+#include <algorithm>
+#include <any>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "my_any.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace any_test {
+
+// 超出内联缓冲区的负载，总是存放在堆上
+struct large_payload {
+    long long data[8];
+};
+
+// 要求 32 字节对齐的负载，只有缓冲区对齐足够的 basic_any 才内联存放
+struct alignas(32) aligned_payload {
+    float lanes[8];
+};
+
+// 移动构造可能抛异常，即便放得下也存放在堆上
+struct throwing_move {
+    throwing_move() = default;
+    throwing_move(const throwing_move &) {}
+};
+
+static_assert(mystl::any::fits_inline<int>, "int must be stored inline");
+static_assert(mystl::any::fits_inline<std::string>, "std::string must be stored inline");
+static_assert(!mystl::any::fits_inline<large_payload>, "large_payload exceeds the buffer");
+static_assert(!mystl::any::fits_inline<aligned_payload>, "aligned_payload needs a 32-byte aligned buffer");
+static_assert(!mystl::any::fits_inline<throwing_move>, "types with a throwing move go on the heap");
+static_assert(!mystl::basic_any<16>::fits_inline<std::string>, "std::string exceeds a 16-byte buffer");
+static_assert(mystl::basic_any<64>::fits_inline<large_payload>, "large_payload fits a 64-byte buffer");
+static_assert(mystl::basic_any<32, 32>::fits_inline<aligned_payload>, "aligned_payload fits a 32-byte aligned buffer");
+
+template <class T>
+const T *cast(const std::any &a) {
+    return std::any_cast<T>(&a);
+}
+
+template <class T>
+const T *cast(const mystl::any &a) {
+    return mystl::any_cast<T>(&a);
+}
+
+// 把 src 中的 n 个 any 复制进预留好空间的数组，销毁不计入
+template <class Any>
+void copy_bench(bench::State &state, const std::vector<Any> &src) {
+    std::vector<Any> dst;
+    dst.reserve(src.size());
+    for (auto _ : state) {
+        for (auto &a : src) {
+            dst.push_back(a);
+        }
+        bench::ClobberMemory();
+        state.PauseTiming();
+        dst.clear();
+        state.ResumeTiming();
+    }
+}
+
+// 在两个数组之间来回移动赋值，目标总是被移走后的空对象
+template <class Any>
+void move_bench(bench::State &state, const std::vector<Any> &src) {
+    std::vector<Any> from(src);
+    std::vector<Any> to(src.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < from.size(); ++i) {
+            to[i] = std::move(from[i]);
+        }
+        bench::ClobberMemory();
+        from.swap(to);
+    }
+}
+
+// 整体反转数组，每一步都是一次 swap
+template <class Any>
+void swap_bench(bench::State &state, const std::vector<Any> &src) {
+    std::vector<Any> v(src);
+    for (auto _ : state) {
+        std::reverse(v.begin(), v.end());
+        bench::ClobberMemory();
+    }
+}
+
+// 对已存有同类型值的 any 反复 emplace
+template <class Any, class T>
+void emplace_bench(bench::State &state, const std::vector<Any> &src, const T &value) {
+    std::vector<Any> dst(src);
+    for (auto _ : state) {
+        for (auto &a : dst) {
+            a.template emplace<T>(value);
+        }
+        bench::ClobberMemory();
+    }
+}
+
+// 以指针形式的 any_cast 取出每个值
+template <class Any, class T>
+void cast_bench(bench::State &state, const std::vector<Any> &src) {
+    for (auto _ : state) {
+        size_t hits = 0;
+        for (auto &a : src) {
+            hits += cast<T>(a) != nullptr;
+        }
+        bench::DoNotOptimize(hits);
+    }
+}
+
+// 对一种负载分别以 std::any 与 mystl::any 运行四种操作，每行输出两者耗时与比值
+template <class T>
+void any_perf_test(const char *payload, const T &value, size_t n) {
+    std::vector<std::any> std_src(n, std::any(value));
+    std::vector<mystl::any> my_src(n, mystl::any(value));
+    auto row = [&](const char *op, auto std_fn, auto my_fn) {
+        auto name = std::string("any<") + payload + ">::" + op;
+        auto &s = bench::Run(name, "std", n, std_fn);
+        auto &m = bench::Run(name, "mystl", n, my_fn);
+        print_bench_row(std::string(op) + " " + payload, s, m, false);
+    };
+    row("copy", [&](bench::State &state) { copy_bench(state, std_src); }, [&](bench::State &state) { copy_bench(state, my_src); });
+    row("move", [&](bench::State &state) { move_bench(state, std_src); }, [&](bench::State &state) { move_bench(state, my_src); });
+    row("swap", [&](bench::State &state) { swap_bench(state, std_src); }, [&](bench::State &state) { swap_bench(state, my_src); });
+    row("emplace", [&](bench::State &state) { emplace_bench(state, std_src, value); },
+        [&](bench::State &state) { emplace_bench(state, my_src, value); });
+    row("cast", [&](bench::State &state) { cast_bench<std::any, T>(state, std_src); },
+        [&](bench::State &state) { cast_bench<mystl::any, T>(state, my_src); });
+}
+
+void any_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------------ Run container test : any -------------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    mystl::any a1;
+    mystl::any a2(10);
+    mystl::any a3(std::string("a string that does not fit in the buffer"));
+    mystl::any a4(a3);
+    mystl::any a5(std::move(a4));
+    mystl::any a6 = mystl::make_any<std::vector<int>>({1, 2, 3});
+    a1 = 3.14;
+    FUN_VALUE(a1.has_value());
+    FUN_VALUE(mystl::any_cast<double>(a1));
+    FUN_VALUE(mystl::any_cast<int>(a2));
+    FUN_VALUE(mystl::any_cast<const std::string &>(a3));
+    FUN_VALUE(a4.has_value());
+    FUN_VALUE(mystl::any_cast<std::string &>(a5));
+    FUN_VALUE(mystl::any_cast<std::vector<int> &>(a6).size());
+    FUN_VALUE((mystl::any_cast<int>(&a1) == nullptr));
+    a2.swap(a5);
+    FUN_VALUE(mystl::any_cast<std::string &>(a2));
+    FUN_VALUE(mystl::any_cast<int>(a5));
+    FUN_VALUE(a1.emplace<std::string>(3, 'x'));
+    a1.reset();
+    FUN_VALUE(a1.has_value());
+    FUN_VALUE(a1.type().name());
+    mystl::basic_any<16> b1(std::string("stored on the heap"));
+    mystl::basic_any<64> b2(large_payload{{1, 2, 3}});
+    mystl::basic_any<32, 32> b3(aligned_payload{{0.5f}});
+    mystl::basic_any<64> b4(std::move(b2));
+    FUN_VALUE(sizeof(b1));
+    FUN_VALUE(sizeof(b4));
+    FUN_VALUE(sizeof(b3));
+    FUN_VALUE(mystl::any_cast<std::string &>(b1));
+    auto heap_block = mystl::any_cast<std::string>(&b1);
+    FUN_VALUE((&b1.emplace<std::string>("rebuilt in the same heap block") == heap_block));
+    FUN_VALUE(mystl::any_cast<large_payload &>(b4).data[2]);
+    FUN_VALUE((reinterpret_cast<uintptr_t>(mystl::any_cast<aligned_payload>(&b3)) % 32));
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|    any operation    |  std::any   | mystl::any  |  mystl/std  |\n";
+    any_perf_test("int", 42, LEN1);
+    any_perf_test("string", std::string("short"), LEN1);
+    any_perf_test("large", large_payload{}, LEN1);
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[------------------ End container test : any -------------------]\n";
+}
+
+}}}    // namespace mystl::test::any_test
+#endif // !MYTINYSTL_ANY_TEST_H_
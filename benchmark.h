@@ -0,0 +1,881 @@
+#ifndef MYTINYSTL_BENCHMARK_H_
+#define MYTINYSTL_BENCHMARK_H_
+
+// 一个简单的性能测试框架
+// 以 steady_clock（或校准过的 TSC）计时，自动决定每次采样的迭代次数，重复采样后统计中位数、p99 与标准差。
+// 结果可导出为 CSV / JSON ，并可与 std 的同名用例或上一次保存的基线对比。
+//
+// 通过环境变量调整：
+//   MYSTL_BENCH_MIN_TIME_MS   每次采样至少持续的毫秒数，不足时增加迭代次数，默认 20
+//   MYSTL_BENCH_MAX_TIME_MS   每个用例的采样时间预算，超出时减少重复次数，默认 1000
+//   MYSTL_BENCH_REPETITIONS   最多重复采样的次数，默认 10
+//   MYSTL_BENCH_CSV           程序退出时把全部结果写入该 CSV 文件
+//   MYSTL_BENCH_JSON          程序退出时把全部结果写入该 JSON 文件
+//   MYSTL_BENCH_BASELINE      读取之前导出的 CSV 作为基线，在表格中输出相对基线的变化
+//   MYSTL_BENCH_PERF          设为 1 时在 Linux 上用 perf_event_open 统计硬件事件，输出 IPC 与每个元素的缺失次数
+// 定义宏 MYTINYSTL_BENCH_TSC 后在 x86 上改用时间戳计数器计时。
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__GLIBC__) || defined(__linux__)
+#include <malloc.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#define MYTINYSTL_BENCH_HAS_PERF 1
+#else
+#define MYTINYSTL_BENCH_HAS_PERF 0
+#endif
+
+#if defined(MYTINYSTL_BENCH_TSC) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define MYTINYSTL_BENCH_USE_TSC 1
+#else
+#define MYTINYSTL_BENCH_USE_TSC 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MYTINYSTL_BENCH_UNUSED __attribute__((unused))
+#else
+#define MYTINYSTL_BENCH_UNUSED
+#endif
+
+namespace mystl
+{
+namespace test
+{
+namespace bench
+{
+
+/*****************************************************************************************/
+// 防止编译器优化掉被测代码
+
+#if defined(__GNUC__) || defined(__clang__)
+
+// 让编译器认为 value 被读取，计算它的代码不能被删除
+template <class T>
+inline void DoNotOptimize(const T& value)
+{
+  asm volatile("" : : "m"(value) : "memory");
+}
+
+// 让编译器认为 value 被读取并修改，不能把它的值提前算好或缓存在寄存器里
+template <class T>
+inline void DoNotOptimize(T& value)
+{
+  asm volatile("" : "+m"(value) : : "memory");
+}
+
+// 让编译器认为所有内存都可能被读写，之前的写入必须真正落到内存
+inline void ClobberMemory()
+{
+  asm volatile("" : : : "memory");
+}
+
+#else
+
+inline const volatile void* volatile sink = nullptr;
+
+template <class T>
+inline void DoNotOptimize(const T& value)
+{
+  sink = &value;
+  _ReadWriteBarrier();
+}
+
+inline void ClobberMemory()
+{
+  _ReadWriteBarrier();
+}
+
+#endif
+
+/*****************************************************************************************/
+// 计时
+
+// 读取计时器的原始刻度
+inline uint64_t now_ticks()
+{
+#if MYTINYSTL_BENCH_USE_TSC
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// 每个刻度对应的纳秒数。TSC 在第一次调用时以 steady_clock 为准校准 10ms
+inline double ns_per_tick()
+{
+#if MYTINYSTL_BENCH_USE_TSC
+  static const double ratio = []
+  {
+    auto clock_start = std::chrono::steady_clock::now();
+    auto tick_start = __rdtsc();
+    std::chrono::duration<double, std::nano> elapsed;
+    do
+    {
+      elapsed = std::chrono::steady_clock::now() - clock_start;
+    } while (elapsed.count() < 1e7);
+    return elapsed.count() / static_cast<double>(__rdtsc() - tick_start);
+  }();
+  return ratio;
+#else
+  return 1.0;
+#endif
+}
+
+inline const char* clock_name()
+{
+  return MYTINYSTL_BENCH_USE_TSC ? "tsc" : "steady_clock";
+}
+
+/*****************************************************************************************/
+// 硬件性能计数器
+
+enum counter_kind
+{
+  cycles,
+  instructions,
+  l1d_misses,    // L1 数据缓存读缺失
+  llc_misses,    // 末级缓存缺失
+  branch_misses,
+  dtlb_misses,   // 数据 TLB 读缺失
+  counter_count
+};
+
+inline const char* counter_name(int kind)
+{
+  static const char* names[counter_count] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses"};
+  return names[kind];
+}
+
+// Counters 类
+// 为每种事件单独打开一个只统计本线程用户态的计数器。某个事件打不开（内核不支持、权限不足、
+// 虚拟机没有暴露 PMU 等）时只放弃该事件；一个都打不开时 GetInstance 返回 nullptr ，测试照常只计时。
+// 事件数超过硬件计数器时内核会分时复用，读出的值按实际运行时间的比例放大。
+class Counters
+{
+public:
+  static Counters* GetInstance()
+  {
+    static Counters instance;
+    return instance.opened_ ? &instance : nullptr;
+  }
+
+  Counters(const Counters&) = delete;
+  Counters& operator=(const Counters&) = delete;
+
+  ~Counters()
+  {
+#if MYTINYSTL_BENCH_HAS_PERF
+    for (auto fd : fds_)
+    {
+      if (fd >= 0)
+        close(fd);
+    }
+#endif
+  }
+
+  void Reset() { control(reset_request()); }
+  void Enable() { control(enable_request()); }
+  void Disable() { control(disable_request()); }
+
+  // 读出自上次 Reset 以来的计数，打不开或从未被调度到的事件记为 -1
+  void Read(double* values) const
+  {
+    for (int i = 0; i < counter_count; ++i)
+    {
+      values[i] = -1;
+#if MYTINYSTL_BENCH_HAS_PERF
+      uint64_t data[3];  // value, time_enabled, time_running
+      if (fds_[i] < 0 || ::read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0)
+        continue;
+      values[i] = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+#endif
+    }
+  }
+
+private:
+  Counters()
+  {
+    for (auto& fd : fds_)
+      fd = -1;
+#if MYTINYSTL_BENCH_HAS_PERF
+    const uint64_t cache_read_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const uint32_t types[counter_count] = {
+      PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+      PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE};
+    const uint64_t configs[counter_count] = {
+      PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_L1D | cache_read_miss,
+      PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_DTLB | cache_read_miss};
+    int error = 0;
+    for (int i = 0; i < counter_count; ++i)
+    {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = types[i];
+      attr.config = configs[i];
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+      if (fds_[i] >= 0)
+        opened_ = true;
+      else
+        error = errno;
+    }
+    if (!opened_)
+      std::cerr << "benchmark: perf events unavailable (" << std::strerror(error) << "), counters disabled\n";
+#else
+    std::cerr << "benchmark: perf events are only supported on Linux, counters disabled\n";
+#endif
+  }
+
+#if MYTINYSTL_BENCH_HAS_PERF
+  static unsigned long reset_request() { return PERF_EVENT_IOC_RESET; }
+  static unsigned long enable_request() { return PERF_EVENT_IOC_ENABLE; }
+  static unsigned long disable_request() { return PERF_EVENT_IOC_DISABLE; }
+
+  void control(unsigned long request)
+  {
+    for (auto fd : fds_)
+    {
+      if (fd >= 0)
+        ioctl(fd, request, 0);
+    }
+  }
+#else
+  static unsigned long reset_request() { return 0; }
+  static unsigned long enable_request() { return 0; }
+  static unsigned long disable_request() { return 0; }
+
+  void control(unsigned long) {}
+#endif
+
+  int  fds_[counter_count];
+  bool opened_ = false;
+};
+
+// State 类
+// 传给被测函数，以 for (auto _ : state) 的形式驱动 iterations() 次迭代，只统计循环内、未暂停部分的时间。
+// 开启了计数器时，计数器与计时同步开停
+class State
+{
+public:
+  struct MYTINYSTL_BENCH_UNUSED Value {};
+
+  class Iterator
+  {
+  public:
+    Iterator(State* state, size_t left) : state_(state), left_(left) {}
+
+    Value operator*() const { return Value(); }
+    void operator++() { --left_; }
+    bool operator!=(const Iterator&)
+    {
+      if (left_ != 0)
+        return true;
+      state_->finish();
+      return false;
+    }
+
+  private:
+    State* state_;
+    size_t left_;
+  };
+
+  explicit State(size_t iterations, Counters* counters = nullptr) : iterations_(iterations), counters_(counters) {}
+
+  Iterator begin()
+  {
+    ResumeTiming();
+    return Iterator(this, iterations_);
+  }
+  Iterator end() { return Iterator(this, 0); }
+
+  // 暂停计时，用于排除准备数据、销毁容器等不属于被测操作的开销。已暂停时重复调用不会再次累加
+  void PauseTiming()
+  {
+    if (!running_)
+      return;
+    elapsed_ += now_ticks() - start_;
+    running_ = false;
+    if (counters_)
+      counters_->Disable();
+  }
+
+  void ResumeTiming()
+  {
+    if (running_)
+      return;
+    if (counters_)
+      counters_->Enable();
+    running_ = true;
+    start_ = now_ticks();
+  }
+
+  size_t iterations() const { return iterations_; }
+  double elapsed_ns() const { return static_cast<double>(elapsed_) * ns_per_tick(); }
+
+private:
+  void finish()
+  {
+    if (running_)
+      PauseTiming();
+  }
+
+  size_t    iterations_;
+  Counters* counters_;
+  uint64_t  start_   = 0;
+  uint64_t  elapsed_ = 0;
+  bool      running_ = false;
+};
+
+/*****************************************************************************************/
+// 配置与结果
+
+inline double env_number(const char* name, double fallback)
+{
+  auto s = std::getenv(name);
+  if (s == nullptr || *s == '\0')
+    return fallback;
+  auto v = std::strtod(s, nullptr);
+  return v > 0 ? v : fallback;
+}
+
+inline std::string env_string(const char* name)
+{
+  auto s = std::getenv(name);
+  return s ? s : "";
+}
+
+struct Options
+{
+  double      min_sample_ns  = 20e6;       // 每次采样至少持续的时间
+  double      max_case_ns    = 1e9;        // 每个用例的采样时间预算
+  size_t      repetitions    = 10;         // 最多重复采样的次数
+  size_t      max_iterations = 1000000000; // 每次采样最多的迭代次数
+  bool        perf_counters  = false;      // 是否统计硬件事件
+  std::string csv_path;
+  std::string json_path;
+  std::string baseline_path;
+
+  static Options FromEnv()
+  {
+    Options o;
+    o.min_sample_ns = env_number("MYSTL_BENCH_MIN_TIME_MS", o.min_sample_ns / 1e6) * 1e6;
+    o.max_case_ns   = env_number("MYSTL_BENCH_MAX_TIME_MS", o.max_case_ns / 1e6) * 1e6;
+    o.repetitions   = static_cast<size_t>(env_number("MYSTL_BENCH_REPETITIONS", static_cast<double>(o.repetitions)));
+    o.perf_counters = env_number("MYSTL_BENCH_PERF", 0) > 0;
+    o.csv_path      = env_string("MYSTL_BENCH_CSV");
+    o.json_path     = env_string("MYSTL_BENCH_JSON");
+    o.baseline_path = env_string("MYSTL_BENCH_BASELINE");
+    return o;
+  }
+};
+
+// 一个用例的统计结果，时间均为单次迭代的纳秒数
+struct Result
+{
+  std::string name;         // 用例名，如 vector<int>::push_back
+  std::string variant;      // 实现，如 std 、 mystl
+  size_t      items = 0;    // 单次迭代处理的元素数
+  size_t      iterations = 0;
+  size_t      repetitions = 0;
+  double      median_ns = 0;
+  double      p99_ns = 0;
+  double      mean_ns = 0;
+  double      stddev_ns = 0;
+  double      min_ns = 0;
+  double      counters[counter_count] = {-1, -1, -1, -1, -1, -1};  // 单次迭代的事件数，-1 表示未统计
+
+  double ns_per_item() const { return items ? median_ns / items : median_ns; }
+  bool has_counter(int kind) const { return counters[kind] >= 0; }
+
+  // 每条指令周期数的倒数，未统计时为 -1
+  double ipc() const
+  {
+    return has_counter(cycles) && has_counter(instructions) && counters[cycles] > 0
+      ? counters[instructions] / counters[cycles] : -1;
+  }
+
+  // 平均每个元素发生的事件数，未统计时为 -1
+  double per_item(int kind) const
+  {
+    return has_counter(kind) ? counters[kind] / (items ? items : 1) : -1;
+  }
+};
+
+// 由各次采样（单次迭代耗时）计算统计量，p99 取最近秩
+inline void summarize(Result& r, std::vector<double> samples)
+{
+  std::sort(samples.begin(), samples.end());
+  auto n = samples.size();
+  r.repetitions = n;
+  r.min_ns = samples.front();
+  r.median_ns = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+  auto rank = static_cast<size_t>(std::ceil(0.99 * n));
+  r.p99_ns = samples[rank ? rank - 1 : 0];
+  double sum = 0;
+  for (auto s : samples)
+    sum += s;
+  r.mean_ns = sum / n;
+  double sq = 0;
+  for (auto s : samples)
+    sq += (s - r.mean_ns) * (s - r.mean_ns);
+  r.stddev_ns = n > 1 ? std::sqrt(sq / (n - 1)) : 0;
+}
+
+// 拆分 CSV 的一行，支持以双引号包围的字段
+inline std::vector<std::string> split_csv(const std::string& line)
+{
+  std::vector<std::string> fields(1);
+  bool quoted = false;
+  for (auto ch : line)
+  {
+    if (ch == '"')
+      quoted = !quoted;
+    else if (ch == ',' && !quoted)
+      fields.emplace_back();
+    else if (ch != '\r')
+      fields.back() += ch;
+  }
+  return fields;
+}
+
+inline std::string json_escape(const std::string& s)
+{
+  std::string out;
+  for (auto ch : s)
+  {
+    if (ch == '"' || ch == '\\')
+      out += '\\';
+    out += ch;
+  }
+  return out;
+}
+
+// Registry 类
+// 保存本次运行的全部结果与读入的基线，程序退出时按配置导出
+class Registry
+{
+public:
+  static Registry* GetInstance()
+  {
+    static Registry instance;
+    return &instance;
+  }
+
+  Registry(const Registry&) = delete;
+  Registry& operator=(const Registry&) = delete;
+
+  ~Registry()
+  {
+    if (!options_.csv_path.empty())
+    {
+      std::ofstream out(options_.csv_path);
+      WriteCsv(out);
+    }
+    if (!options_.json_path.empty())
+    {
+      std::ofstream out(options_.json_path);
+      WriteJson(out);
+    }
+  }
+
+  const Options& options() const { return options_; }
+  bool has_baseline() const { return !baseline_.empty(); }
+
+  const Result& Add(Result r)
+  {
+    results_.push_back(std::move(r));
+    return results_.back();
+  }
+
+  const Result* Find(const std::string& name, const std::string& variant, size_t items) const
+  {
+    return find_in(results_, name, variant, items);
+  }
+
+  const Result* FindBaseline(const std::string& name, const std::string& variant, size_t items) const
+  {
+    return find_in(baseline_, name, variant, items);
+  }
+
+  void WriteCsv(std::ostream& out) const
+  {
+    out << "name,variant,items,iterations,repetitions,median_ns,p99_ns,mean_ns,stddev_ns,min_ns,ns_per_item,ipc";
+    for (int i = 0; i < counter_count; ++i)
+      out << ',' << counter_name(i);
+    out << '\n';
+    out << std::setprecision(12);
+    for (auto& r : results_)
+    {
+      out << '"' << r.name << "\"," << r.variant << ',' << r.items << ',' << r.iterations << ',' << r.repetitions << ','
+          << r.median_ns << ',' << r.p99_ns << ',' << r.mean_ns << ',' << r.stddev_ns << ',' << r.min_ns << ','
+          << r.ns_per_item() << ',';
+      if (r.ipc() >= 0)
+        out << r.ipc();
+      for (int i = 0; i < counter_count; ++i)
+      {
+        out << ',';
+        if (r.has_counter(i))
+          out << r.counters[i];
+      }
+      out << '\n';
+    }
+  }
+
+  void WriteJson(std::ostream& out) const
+  {
+    out << std::setprecision(12);
+    out << "{\n  \"clock\": \"" << clock_name() << "\",\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results_.size(); ++i)
+    {
+      auto& r = results_[i];
+      out << (i ? ",\n" : "\n") << "    {\"name\": \"" << json_escape(r.name) << "\", \"variant\": \"" << json_escape(r.variant)
+          << "\", \"items\": " << r.items << ", \"iterations\": " << r.iterations << ", \"repetitions\": " << r.repetitions
+          << ", \"median_ns\": " << r.median_ns << ", \"p99_ns\": " << r.p99_ns << ", \"mean_ns\": " << r.mean_ns
+          << ", \"stddev_ns\": " << r.stddev_ns << ", \"min_ns\": " << r.min_ns << ", \"ns_per_item\": " << r.ns_per_item();
+      if (r.ipc() >= 0)
+        out << ", \"ipc\": " << r.ipc();
+      for (int k = 0; k < counter_count; ++k)
+      {
+        if (r.has_counter(k))
+          out << ", \"" << counter_name(k) << "\": " << r.counters[k];
+      }
+      out << "}";
+    }
+    out << "\n  ]\n}\n";
+  }
+
+  // 读入 WriteCsv 导出的文件，失败时不使用基线
+  bool LoadBaseline(const std::string& path)
+  {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line))
+      return false;
+    while (std::getline(in, line))
+    {
+      auto f = split_csv(line);
+      if (f.size() < 10)
+        continue;
+      Result r;
+      r.name = f[0];
+      r.variant = f[1];
+      r.items = std::strtoull(f[2].c_str(), nullptr, 10);
+      r.iterations = std::strtoull(f[3].c_str(), nullptr, 10);
+      r.repetitions = std::strtoull(f[4].c_str(), nullptr, 10);
+      r.median_ns = std::strtod(f[5].c_str(), nullptr);
+      r.p99_ns = std::strtod(f[6].c_str(), nullptr);
+      r.mean_ns = std::strtod(f[7].c_str(), nullptr);
+      r.stddev_ns = std::strtod(f[8].c_str(), nullptr);
+      r.min_ns = std::strtod(f[9].c_str(), nullptr);
+      baseline_.push_back(std::move(r));
+    }
+    return true;
+  }
+
+private:
+  Registry() : options_(Options::FromEnv())
+  {
+    if (!options_.baseline_path.empty() && !LoadBaseline(options_.baseline_path))
+      std::cerr << "benchmark: cannot read baseline " << options_.baseline_path << "\n";
+  }
+
+  static const Result* find_in(const std::deque<Result>& v, const std::string& name, const std::string& variant, size_t items)
+  {
+    // 同一用例可能测了多次，取最近的一次
+    for (auto it = v.rbegin(); it != v.rend(); ++it)
+    {
+      if (it->name == name && it->variant == variant && it->items == items)
+        return &*it;
+    }
+    return nullptr;
+  }
+
+  Options            options_;
+  std::deque<Result> results_;   // 用 deque 保存， Run 返回的引用在之后的 Run 中仍然有效
+  std::deque<Result> baseline_;
+};
+
+/*****************************************************************************************/
+// 运行用例
+
+// 把 malloc 缓存的空闲块合并并还给系统。前一个用例按乱序释放的大量结点会留在空闲链表里，
+// 不整理的话下一个用例申请到的结点散落在整片旧内存中，结果取决于用例的先后顺序
+inline void release_free_memory()
+{
+#if defined(__GLIBC__)
+  malloc_trim(0);
+#endif
+}
+
+// 以 iterations 次迭代运行一次 fn ，返回单次迭代的纳秒数。给出 counters 时把这次采样的事件数写入 values
+template <class Fn>
+double sample(Fn& fn, size_t iterations, Counters* counters = nullptr, double* values = nullptr)
+{
+  State state(iterations, counters);
+  if (counters)
+    counters->Reset();
+  fn(state);
+  if (counters)
+    counters->Read(values);
+  return state.elapsed_ns() / iterations;
+}
+
+// 运行一个用例并记录结果。先从 1 次迭代开始，按耗时放大迭代次数直到一次采样不短于 min_sample_ns ，
+// 这些校准用的采样同时起到预热的作用，不计入结果；再在时间预算内重复采样，至多 repetitions 次。
+// 单次采样已超出预算的大用例（例如排序 1e7 个元素）只采样这一次。
+// 开启计数器时，事件数取所有计入结果的采样的平均值。
+template <class Fn>
+const Result& Run(const std::string& name, const std::string& variant, size_t items, Fn fn)
+{
+  auto& opt = Registry::GetInstance()->options();
+  auto counters = opt.perf_counters ? Counters::GetInstance() : nullptr;
+  release_free_memory();
+  double values[counter_count];
+  size_t iterations = 1;
+  double per_iter = sample(fn, iterations, counters, values);
+  while (per_iter * iterations < opt.min_sample_ns && iterations < opt.max_iterations)
+  {
+    auto scale = per_iter > 0 ? opt.min_sample_ns * 1.2 / (per_iter * iterations) : 10.0;
+    scale = std::min(std::max(scale, 1.5), 10.0);
+    iterations = std::min(static_cast<size_t>(iterations * scale) + 1, opt.max_iterations);
+    per_iter = sample(fn, iterations, counters, values);
+  }
+  Result r;
+  auto sample_ns = per_iter * iterations;
+  std::vector<double> samples;
+  if (sample_ns >= opt.max_case_ns)
+  {
+    samples.push_back(per_iter);
+    if (counters)
+      std::copy(values, values + counter_count, r.counters);
+  }
+  else
+  {
+    auto reps = static_cast<size_t>(opt.max_case_ns / sample_ns);
+    reps = std::max<size_t>(1, std::min(reps, opt.repetitions));
+    double totals[counter_count] = {};
+    for (size_t i = 0; i < reps; ++i)
+    {
+      samples.push_back(sample(fn, iterations, counters, values));
+      for (int k = 0; counters && k < counter_count; ++k)
+        totals[k] = values[k] < 0 || totals[k] < 0 ? -1 : totals[k] + values[k];
+    }
+    for (int k = 0; counters && k < counter_count; ++k)
+      r.counters[k] = totals[k] < 0 ? -1 : totals[k] / reps;
+  }
+  for (int k = 0; counters && k < counter_count; ++k)
+  {
+    if (r.counters[k] >= 0)
+      r.counters[k] /= iterations;
+  }
+  r.name = name;
+  r.variant = variant;
+  r.items = items;
+  r.iterations = iterations;
+  summarize(r, std::move(samples));
+  return Registry::GetInstance()->Add(std::move(r));
+}
+
+// 供表格宏使用：mode 形如 std::vector<int> ，拆成实现名 std 与用例名 vector<int>::fun
+template <class Fn>
+const Result& RunCell(const char* mode, const char* fun, size_t items, Fn fn)
+{
+  std::string m = mode;
+  auto pos = m.find("::");
+  auto variant = pos == std::string::npos ? m : m.substr(0, pos);
+  auto name = (pos == std::string::npos ? std::string() : m.substr(pos + 2) + "::") + fun;
+  return Run(name, variant, items, std::move(fn));
+}
+
+/*****************************************************************************************/
+// 输出
+
+inline void print_text_cell(const std::string& text, int wide)
+{
+  std::cout << std::setw(wide) << text + "    |";
+}
+
+// 按数量级选择单位：不足 10us 以 ns 输出，不足 1ms 以 us 输出，其余以 ms 输出
+inline std::string format_time(double ns)
+{
+  char buf[32];
+  if (ns < 1e4)
+    std::snprintf(buf, sizeof(buf), "%.0fns", ns);
+  else if (ns < 1e6)
+    std::snprintf(buf, sizeof(buf), "%.1fus", ns / 1e3);
+  else
+  {
+    auto ms = ns / 1e6;
+    std::snprintf(buf, sizeof(buf), ms < 10 ? "%.2fms" : ms < 1000 ? "%.1fms" : "%.0fms", ms);
+  }
+  return buf;
+}
+
+// 以表格单元格的形式输出单次迭代耗时的中位数
+inline void PrintCell(const Result& r, int wide)
+{
+  print_text_cell(format_time(r.median_ns), wide);
+}
+
+// 输出 variant 相对 reference 的耗时比，小于 1 表示更快
+inline void print_ratio_cell(const Result* r, const Result* ref, int wide)
+{
+  if (r == nullptr || ref == nullptr || ref->median_ns <= 0)
+  {
+    print_text_cell("-", wide);
+    return;
+  }
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.2fx", r->median_ns / ref->median_ns);
+  print_text_cell(buf, wide);
+}
+
+// 输出相对基线的变化百分比，负数表示更快
+inline void print_change_cell(const Result* r, const Result* base, int wide)
+{
+  if (r == nullptr || base == nullptr || base->median_ns <= 0)
+  {
+    print_text_cell("-", wide);
+    return;
+  }
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%+.1f%%", (r->median_ns / base->median_ns - 1) * 100);
+  print_text_cell(buf, wide);
+}
+
+// 以 std/mystl 的形式输出一对计数器的值，value 返回负数表示未统计
+template <class Value>
+void print_pair_cell(const Result* lhs, const Result* rhs, Value value, int wide)
+{
+  auto a = lhs ? value(*lhs) : -1;
+  auto b = rhs ? value(*rhs) : -1;
+  if (a < 0 && b < 0)
+  {
+    print_text_cell("-", wide);
+    return;
+  }
+  a = a < 0 ? 0.0 : a;
+  b = b < 0 ? 0.0 : b;
+  char buf[64];
+  auto n = std::snprintf(buf, sizeof(buf), "%.2g/%.2g", a, b);
+  if (n >= wide)  // 放不下时改用一位有效数字
+    std::snprintf(buf, sizeof(buf), "%.0e/%.0e", a, b);
+  std::cout << std::setw(wide - 1) << buf << "|";
+}
+
+// 统计了硬件事件时，输出 IPC 与每个元素的各类缺失次数，每格为 std/mystl
+inline void print_counter_rows(const Result* s1, const Result* m1, const Result* s2, const Result* m2,
+                               const Result* s3, const Result* m3, int wide)
+{
+  const Result* row[] = {s1, m1, s2, m2, s3, m3};
+  bool any = false;
+  for (auto r : row)
+    any = any || (r && r->has_counter(cycles)) || (r && r->has_counter(llc_misses));
+  if (!any)
+    return;
+  std::cout << "\n|   IPC (std/mystl)   |";
+  for (int i = 0; i < 6; i += 2)
+    print_pair_cell(row[i], row[i + 1], [](const Result& r) { return r.ipc(); }, wide);
+  const char* titles[] = {"\n|   L1D miss / elem   |", "\n|   LLC miss / elem   |",
+                          "\n|  branch miss/elem   |", "\n|  dTLB miss / elem   |"};
+  const int kinds[] = {l1d_misses, llc_misses, branch_misses, dtlb_misses};
+  for (int t = 0; t < 4; ++t)
+  {
+    std::cout << titles[t];
+    auto kind = kinds[t];
+    for (int i = 0; i < 6; i += 2)
+      print_pair_cell(row[i], row[i + 1], [kind](const Result& r) { return r.per_item(kind); }, wide);
+  }
+}
+
+// 以 wide 宽的单元格输出一个计数器的值，负数表示未统计
+inline void print_value_cell(double value, int wide)
+{
+  if (value < 0)
+  {
+    std::cout << std::setw(wide - 1) << "-" << "|";
+    return;
+  }
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.2g", value);
+  std::cout << std::setw(wide - 1) << buf << "|";
+}
+
+// 一行对比 std 与 mystl 的表格（首列 title_wide 宽，其后三列各 wide 宽）之后的计数器行：
+// 统计了硬件事件时，第二、三列分别输出 std 与 mystl 的 IPC 与每个元素的各类缺失次数
+inline void PrintPairCounters(const Result& s, const Result& m, int title_wide, int wide)
+{
+  if (!s.has_counter(cycles) && !s.has_counter(llc_misses) && !m.has_counter(cycles) && !m.has_counter(llc_misses))
+    return;
+  const char* titles[] = {"IPC", "L1D miss / elem", "LLC miss / elem", "branch miss/elem", "dTLB miss / elem"};
+  const int kinds[] = {-1, l1d_misses, llc_misses, branch_misses, dtlb_misses};
+  for (int t = 0; t < 5; ++t)
+  {
+    std::cout << "|" << std::setw(title_wide) << titles[t] << "|";
+    print_value_cell(kinds[t] < 0 ? s.ipc() : s.per_item(kinds[t]), wide);
+    print_value_cell(kinds[t] < 0 ? m.ipc() : m.per_item(kinds[t]), wide);
+    std::cout << std::setw(wide) << "|" << "\n";
+  }
+}
+
+// 在 std 与 mystl 两行之后输出对比行：mystl / std 的耗时比；统计了硬件事件时输出 IPC 与缺失次数；
+// 读入了基线时再输出两者相对基线的变化
+inline void PrintComparisonRows(const std::string& name, size_t len1, size_t len2, size_t len3, int wide)
+{
+  auto reg = Registry::GetInstance();
+  size_t lens[] = {len1, len2, len3};
+  std::cout << "\n|     mystl / std     |";
+  for (auto len : lens)
+    print_ratio_cell(reg->Find(name, "mystl", len), reg->Find(name, "std", len), wide);
+  print_counter_rows(reg->Find(name, "std", len1), reg->Find(name, "mystl", len1),
+                     reg->Find(name, "std", len2), reg->Find(name, "mystl", len2),
+                     reg->Find(name, "std", len3), reg->Find(name, "mystl", len3), wide);
+  if (!reg->has_baseline())
+    return;
+  const char* variants[] = {"std", "mystl"};
+  const char* titles[] = {"\n|   std vs baseline   |", "\n|  mystl vs baseline  |"};
+  for (int i = 0; i < 2; ++i)
+  {
+    std::cout << titles[i];
+    for (auto len : lens)
+      print_change_cell(reg->Find(name, variants[i], len), reg->FindBaseline(name, variants[i], len), wide);
+  }
+}
+
+} // namespace bench
+} // namespace test
+} // namespace mystl
+#endif // !MYTINYSTL_BENCHMARK_H_
@@ -0,0 +1,228 @@
+#ifndef MYTINYSTL_DEQUE_TEST_H_
+#define MYTINYSTL_DEQUE_TEST_H_
+
+// deque test : 测试 deque 的接口、与 std::deque 随机对比的结果，以及两端插入与先进先出队列的性能
+
+#include <deque>
+#include <list>
+#include <random>
+
+#include "my_deque.hpp"
+#include "my_list.hpp"
+#include "my_vector.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace deque_test {
+
+static_assert(std::is_same<std::iterator_traits<mystl::deque<int>::iterator>::iterator_category, std::random_access_iterator_tag>::value,
+              "deque iterator must be random access");
+static_assert(std::is_trivially_copyable<mystl::deque<int>::iterator>::value, "deque iterator must be trivially copyable");
+static_assert(std::is_nothrow_move_assignable<mystl::deque<int>>::value, "move assignment with an always-equal allocator cannot throw");
+static_assert(!std::is_nothrow_move_assignable<mystl::pmr::deque<int>>::value, "move assignment between unequal pmr allocators allocates");
+
+// 两端插入、弹出、中间插入与删除随机交错，每步与 std::deque 对比
+bool check_random(unsigned seed) {
+    std::mt19937 gen(seed);
+    mystl::deque<int> d;
+    std::deque<int> r;
+    bool ok = true;
+    for (int i = 0; i < 20000 && ok; ++i) {
+        int v = static_cast<int>(gen());
+        auto pos = r.empty() ? 0 : gen() % (r.size() + 1);
+        switch (gen() % 8) {
+        case 0:
+        case 1:
+            d.push_back(v);
+            r.push_back(v);
+            break;
+        case 2:
+        case 3:
+            d.push_front(v);
+            r.push_front(v);
+            break;
+        case 4:
+            if (r.size() >= 2) {
+                d.pop_back();
+                r.pop_back();
+                d.pop_front();
+                r.pop_front();
+            }
+            break;
+        case 5:
+            ok = *d.insert(d.begin() + pos, v) == v;
+            r.insert(r.begin() + pos, v);
+            break;
+        case 6: {
+            auto count = gen() % 300 + 1;
+            d.insert(d.begin() + pos, count, v);
+            r.insert(r.begin() + pos, count, v);
+            break;
+        }
+        default:
+            if (pos < r.size()) {
+                auto count = gen() % std::min<size_t>(r.size() - pos, 300);
+                d.erase(d.begin() + pos, d.begin() + pos + count);
+                r.erase(r.begin() + pos, r.begin() + pos + count);
+            }
+            break;
+        }
+        ok = ok && d.size() == r.size() && (r.empty() || (d.front() == r.front() && d.back() == r.back() && d[pos % r.size()] == r[pos % r.size()]));
+    }
+    mystl::deque<int> c(d);
+    return ok && std::equal(d.begin(), d.end(), r.begin(), r.end()) && c == d;
+}
+
+// 两端插入不搬动已有元素，指向元素的引用保持有效
+bool check_stable_refs() {
+    mystl::deque<int> d{42};
+    auto &ref = d.front();
+    for (int i = 0; i < 100000; ++i) {
+        d.push_back(i);
+        d.push_front(-i);
+    }
+    return &ref == &d[100000] && ref == 42;
+}
+
+// 首块弹空后挂入空闲链表，尾部再次需要新块时取回同一块内存
+bool check_block_reuse() {
+    const auto count = mystl::deque<int>::block_capacity;
+    mystl::deque<int> d;
+    for (size_t i = 0; i < 3 * count; ++i) {
+        d.push_back(static_cast<int>(i));
+    }
+    auto first_block = &d.front();
+    for (size_t i = 0; i < count; ++i) {
+        d.pop_front();
+    }
+    for (size_t i = 0; i <= count; ++i) {
+        d.push_back(0);
+    }
+    return &d.back() == first_block;
+}
+
+// 先进先出队列：不断在尾部加入、从头部取出，队列长度保持在 1000 左右。 vector 只能从头部 erase
+template <typename Queue>
+void fifo_pop(Queue &q) {
+    q.pop_front();
+}
+
+template <typename T>
+void fifo_pop(mystl::vector<T> &q) {
+    q.erase(q.begin());
+}
+
+template <typename Queue>
+void fifo_queue_test(const char *variant, size_t count) {
+    auto &r = bench::Run("deque<int>::fifo", variant, count, [count](bench::State &state) {
+        for (auto _ : state) {
+            Queue q;
+            for (size_t i = 0; i < count; ++i) {
+                q.push_back(static_cast<int>(i));
+                if (q.size() > 1000) {
+                    fifo_pop(q);
+                }
+            }
+            bench::DoNotOptimize(q);
+        }
+    });
+    bench::PrintCell(r, WIDE);
+}
+
+void deque_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[----------------- Run container test : deque ------------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = {1, 2, 3, 4, 5};
+    mystl::deque<int> d1;
+    mystl::deque<int> d2(5);
+    mystl::deque<int> d3(5, 1);
+    mystl::deque<int> d4(a, a + 5);
+    mystl::deque<int> d5(d4);
+    mystl::deque<int> d6(std::move(d5));
+    mystl::deque<int> d7{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    mystl::deque<int> d8, d9;
+    d8 = d3;
+    d9 = std::move(d3);
+
+    FUN_AFTER(d1, d1.assign(5, 8));
+    FUN_AFTER(d1, d1.assign(a, a + 5));
+    FUN_AFTER(d1, d1.push_front(0));
+    FUN_AFTER(d1, d1.push_back(6));
+    FUN_AFTER(d1, d1.emplace_front(-1));
+    FUN_AFTER(d1, d1.emplace_back(7));
+    FUN_AFTER(d1, d1.emplace(d1.begin() + 3, 10));
+    FUN_AFTER(d1, d1.insert(d1.end() - 2, 2, 20));
+    FUN_AFTER(d1, d1.insert(d1.begin() + 1, a, a + 3));
+    FUN_AFTER(d1, d1.pop_front());
+    FUN_AFTER(d1, d1.pop_back());
+    FUN_AFTER(d1, d1.erase(d1.begin() + 2));
+    FUN_AFTER(d1, d1.erase(d1.begin(), d1.begin() + 3));
+    FUN_AFTER(d1, d1.swap(d7));
+    FUN_VALUE(*d1.begin());
+    FUN_VALUE(*(d1.end() - 1));
+    FUN_VALUE(*d1.rbegin());
+    FUN_VALUE(d1.front());
+    FUN_VALUE(d1.back());
+    FUN_VALUE(d1[3]);
+    FUN_VALUE(d1.at(4));
+    FUN_VALUE(d1.size());
+    FUN_AFTER(d1, d1.resize(12, 9));
+    FUN_AFTER(d1, d1.resize(4));
+    FUN_AFTER(d1, d1.clear());
+    FUN_AFTER(d1, d1.shrink_to_fit());
+    std::cout << std::boolalpha;
+    FUN_VALUE(d1.empty());
+    FUN_VALUE((d4 == d6));
+    FUN_VALUE((d2 < d8));
+    FUN_VALUE(check_random(1));
+    FUN_VALUE(check_stable_refs());
+    FUN_VALUE(check_block_reuse());
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|      push_back      |";
+#if LARGER_TEST_DATA_ON
+    CON_TEST_P1(deque<int>, push_back, rand(), LEN1 _LL, LEN2 _LL, LEN3 _LL);
+#else
+    CON_TEST_P1(deque<int>, push_back, rand(), LEN1 _L, LEN2 _L, LEN3 _L);
+#endif
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|     push_front      |";
+#if LARGER_TEST_DATA_ON
+    CON_TEST_P1(deque<int>, push_front, rand(), LEN1 _LL, LEN2 _LL, LEN3 _LL);
+#else
+    CON_TEST_P1(deque<int>, push_front, rand(), LEN1 _L, LEN2 _L, LEN3 _L);
+#endif
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|     fifo queue      |";
+    TEST_LEN(LEN1 _L, LEN2 _L, LEN3 _L, WIDE);
+    std::cout << "|         std         |";
+    fifo_queue_test<std::deque<int>>("std", LEN1 _L);
+    fifo_queue_test<std::deque<int>>("std", LEN2 _L);
+    fifo_queue_test<std::deque<int>>("std", LEN3 _L);
+    std::cout << "\n|        mystl        |";
+    fifo_queue_test<mystl::deque<int>>("mystl", LEN1 _L);
+    fifo_queue_test<mystl::deque<int>>("mystl", LEN2 _L);
+    fifo_queue_test<mystl::deque<int>>("mystl", LEN3 _L);
+    std::cout << "\n|     mystl list      |";
+    fifo_queue_test<mystl::list<int>>("mystl list", LEN1 _L);
+    fifo_queue_test<mystl::list<int>>("mystl list", LEN2 _L);
+    fifo_queue_test<mystl::list<int>>("mystl list", LEN3 _L);
+    std::cout << "\n|    mystl vector     |";
+    fifo_queue_test<mystl::vector<int>>("mystl vector", LEN1 _L);
+    fifo_queue_test<mystl::vector<int>>("mystl vector", LEN2 _L);
+    fifo_queue_test<mystl::vector<int>>("mystl vector", LEN3 _L);
+    bench::PrintComparisonRows("deque<int>::fifo", LEN1 _L, LEN2 _L, LEN3 _L, WIDE);
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[----------------- End container test : deque ------------------]\n";
+}
+
+}}}    // namespace mystl::test::deque_test
+#endif // !MYTINYSTL_DEQUE_TEST_H_
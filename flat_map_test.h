@@ -0,0 +1,174 @@
+#ifndef MYTINYSTL_FLAT_MAP_TEST_H_
+#define MYTINYSTL_FLAT_MAP_TEST_H_
+
+// flat_map test : 测试 flat_map 的接口、与 std::map 随机对比的结果，以及成批插入与查找的性能
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "my_flat_map.hpp"
+#include "my_vector.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace flat_map_test {
+
+// 逐个插入、成批插入（含批内与批外重复）、删除、边界查找随机交错，每一步与 std::map 对比
+bool check_random(unsigned seed) {
+    std::mt19937 gen(seed);
+    bool ok = true;
+    for (int range : {20, 500, 100000}) {
+        mystl::flat_map<int, int> m;
+        std::map<int, int> r;
+        for (int i = 0; i < 3000; ++i) {
+            int k = static_cast<int>(gen() % range);
+            auto op = gen() % 6;
+            if (op < 2) {
+                auto a = m.try_emplace(k, i);
+                auto b = r.try_emplace(k, i);
+                ok = ok && a.second == b.second && a.first->second == b.first->second;
+            } else if (op == 2) {
+                mystl::vector<std::pair<int, int>> batch;
+                for (auto j = gen() % 50; j > 0; --j) {
+                    batch.push_back(std::make_pair(static_cast<int>(gen() % range), i));
+                }
+                m.insert_range(batch);
+                r.insert(batch.begin(), batch.end());
+            } else if (op == 3) {
+                std::map<int, int> batch;
+                for (auto j = gen() % 30; j > 0; --j) {
+                    batch.emplace(static_cast<int>(gen() % range), -i);
+                }
+                m.insert_sorted_unique(batch);
+                r.insert(batch.begin(), batch.end());
+            } else if (op == 4) {
+                ok = ok && m.erase(k) == r.erase(k);
+            } else {
+                auto it = m.lower_bound(k);
+                auto jt = r.lower_bound(k);
+                ok = ok && (it == m.end()) == (jt == r.end()) && (it == m.end() || (it->first == jt->first && it->second == jt->second));
+                ok = ok && m.count(k) == r.count(k);
+            }
+            ok = ok && m.size() == r.size();
+        }
+        ok = ok && std::equal(m.begin(), m.end(), r.begin(), r.end(), [](std::pair<const int &, int &> a, const std::pair<const int, int> &b) {
+                 return a.first == b.first && a.second == b.second;
+             });
+        auto c = m;
+        auto parts = std::move(c).extract();
+        mystl::flat_map<int, int> d(mystl::sorted_unique, std::move(parts.keys), std::move(parts.values));
+        ok = ok && c.empty() && d == m;
+    }
+    return ok;
+}
+
+// std::less<> 下 at、find、contains 接受字面量和 string_view；初始化列表中重复的键只保留第一个
+bool check_transparent() {
+    mystl::flat_map<std::string, int, std::less<>> m{{"b", 2}, {"a", 1}, {"b", 3}};
+    return m.size() == 2 && m.at("b") == 2 && m.find(std::string_view("a"))->second == 1 && !m.contains("c");
+}
+
+// n 个随机键的容器中成批插入 n / 100 个随机键，以及全部命中的查找。 std 一栏为 std::map
+void batch_rows(size_t n) {
+    std::mt19937 gen(42);
+    mystl::vector<std::pair<int, int>> base(n);
+    mystl::vector<std::pair<int, int>> batch(n / 100);
+    for (auto &p : base) {
+        p = std::make_pair(static_cast<int>(gen()), 1);
+    }
+    for (auto &p : batch) {
+        p = std::make_pair(static_cast<int>(gen()), 2);
+    }
+    std::map<int, int> s(base.begin(), base.end());
+    mystl::flat_map<int, int> m(base.begin(), base.end());
+    bench_row(
+        "flat_map<int, int>::", "batch insert", n,
+        [&](bench::State &state) {
+            for (auto _ : state) {
+                {
+                    state.PauseTiming();
+                    auto c = s;
+                    state.ResumeTiming();
+                    c.insert(batch.begin(), batch.end());
+                    state.PauseTiming();
+                }
+                state.ResumeTiming();
+            }
+        },
+        [&](bench::State &state) {
+            for (auto _ : state) {
+                {
+                    state.PauseTiming();
+                    auto c = m;
+                    state.ResumeTiming();
+                    c.insert_range(batch);
+                    state.PauseTiming();
+                }
+                state.ResumeTiming();
+            }
+        });
+    bench_row(
+        "flat_map<int, int>::", "find", n,
+        [&](bench::State &state) {
+            for (auto _ : state)
+                for (auto &p : base) bench::DoNotOptimize(s.find(p.first));
+        },
+        [&](bench::State &state) {
+            for (auto _ : state)
+                for (auto &p : base) bench::DoNotOptimize(m.find(p.first));
+        });
+}
+
+void flat_map_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[---------------- Run container test : flat_map ----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    mystl::flat_map<int, int> m1;
+    mystl::flat_map<int, int> m2{{3, 9}, {1, 1}, {2, 4}, {2, 5}};
+    mystl::flat_map<int, int> m3(m2);
+    mystl::vector<std::pair<int, int>> v{{7, 49}, {5, 25}, {6, 36}, {5, 0}};
+    std::cout << std::boolalpha;
+    FUN_VALUE(m2.size());
+    FUN_VALUE(m2.at(2));
+    FUN_VALUE(m2.begin()->first);
+    COUT(m2.keys());
+    COUT(m2.values());
+    FUN_VALUE(m1.emplace(1, 10).second);
+    FUN_VALUE(m1.emplace(1, 11).second);
+    FUN_VALUE(m1.try_emplace(3, 30).second);
+    FUN_VALUE(m1.insert_or_assign(3, 31).second);
+    FUN_VALUE(m1[3]);
+    FUN_VALUE(m1[4]);
+    m1.insert_range(v);
+    COUT(m1.keys());
+    COUT(m1.values());
+    FUN_VALUE(m1.lower_bound(2)->first);
+    FUN_VALUE(m1.upper_bound(5)->first);
+    FUN_VALUE(m1.erase(1));
+    FUN_VALUE(m1.erase(1));
+    FUN_VALUE((m1.find(2) == m1.end()));
+    FUN_VALUE((m2 == m3));
+    FUN_VALUE((m1 != m2));
+    m1.clear();
+    FUN_VALUE(m1.empty());
+    FUN_VALUE(check_random(1));
+    FUN_VALUE(check_transparent());
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  op  element count  |     std     |    mystl    |   speedup   |\n";
+    for (size_t n : {size_t(LEN1 _M), size_t(LEN3 _M)}) {
+        batch_rows(n);
+    }
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[---------------- End container test : flat_map ----------------]\n";
+}
+
+}}}    // namespace mystl::test::flat_map_test
+#endif // !MYTINYSTL_FLAT_MAP_TEST_H_
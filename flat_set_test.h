@@ -0,0 +1,123 @@
+#ifndef MYTINYSTL_FLAT_SET_TEST_H_
+#define MYTINYSTL_FLAT_SET_TEST_H_
+
+// flat_set test : 测试 flat_set 的接口、与 std::set 随机对比的结果，以及成批插入的性能
+
+#include <random>
+#include <set>
+
+#include "my_flat_set.hpp"
+#include "my_vector.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace flat_set_test {
+
+static_assert(std::is_same<mystl::flat_set<int>::iterator, mystl::flat_set<int>::const_iterator>::value,
+              "flat_set elements must not be modified through iterators");
+
+// 逐个插入（含位置提示）、成批插入与删除随机交错，与 std::set 对比
+bool check_random(unsigned seed) {
+    std::mt19937 gen(seed);
+    mystl::flat_set<int> s;
+    std::set<int> r;
+    bool ok = true;
+    for (int i = 0; i < 20000; ++i) {
+        int k = static_cast<int>(gen() % 3000);
+        auto op = gen() % 4;
+        if (op == 0) {
+            ok = ok && s.insert(k).second == r.insert(k).second;
+        } else if (op == 1) {
+            s.insert(s.lower_bound(k), k);
+            r.insert(k);
+        } else if (op == 2) {
+            mystl::vector<int> batch;
+            for (auto j = gen() % 40; j > 0; --j) {
+                batch.push_back(static_cast<int>(gen() % 3000));
+            }
+            s.insert_range(batch);
+            r.insert(batch.begin(), batch.end());
+        } else {
+            ok = ok && s.erase(k) == r.erase(k);
+        }
+    }
+    return ok && s.size() == r.size() && std::equal(s.begin(), s.end(), r.begin(), r.end());
+}
+
+void flat_set_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[---------------- Run container test : flat_set ----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = {5, 3, 5, 1, 3, 9};
+    mystl::flat_set<int> s1;
+    mystl::flat_set<int> s2(a, a + 6);
+    mystl::flat_set<int> s3{1, 2, 3};
+    mystl::flat_set<int> s4(mystl::sorted_unique, {2, 4, 6});
+    mystl::vector<int> v{8, 2, 10, 8};
+    std::cout << std::boolalpha;
+    COUT(s2);
+    COUT(s4);
+    FUN_AFTER(s1, s1.insert({4, 2, 4, 8}));
+    FUN_AFTER(s1, s1.emplace(6));
+    FUN_AFTER(s1, s1.erase(s1.begin()));
+    FUN_AFTER(s1, s1.insert_range(v));
+    FUN_AFTER(s1, s1.insert_sorted_unique(s3));
+    FUN_AFTER(s1, s1.erase(8));
+    FUN_AFTER(s1, s1.swap(s3));
+    FUN_VALUE(s1.contains(2));
+    FUN_VALUE(*s3.lower_bound(5));
+    FUN_VALUE((s2 == s3));
+    FUN_AFTER(s1, s1.clear());
+    FUN_VALUE(check_random(1));
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  op  element count  |     std     |    mystl    |   speedup   |\n";
+    for (size_t n : {size_t(LEN1 _M), size_t(LEN3 _M)}) {
+        std::mt19937 gen(7);
+        mystl::vector<int> base(n);
+        mystl::vector<int> batch(n / 100);
+        for (auto &k : base) {
+            k = static_cast<int>(gen());
+        }
+        for (auto &k : batch) {
+            k = static_cast<int>(gen());
+        }
+        std::set<int> ss(base.begin(), base.end());
+        mystl::flat_set<int> ms(base.begin(), base.end());
+        bench_row(
+            "flat_set<int>::", "batch insert", n,
+            [&](bench::State &state) {
+                for (auto _ : state) {
+                    {
+                        state.PauseTiming();
+                        auto c = ss;
+                        state.ResumeTiming();
+                        c.insert(batch.begin(), batch.end());
+                        state.PauseTiming();
+                    }
+                    state.ResumeTiming();
+                }
+            },
+            [&](bench::State &state) {
+                for (auto _ : state) {
+                    {
+                        state.PauseTiming();
+                        auto c = ms;
+                        state.ResumeTiming();
+                        c.insert_range(batch);
+                        state.PauseTiming();
+                    }
+                    state.ResumeTiming();
+                }
+            });
+    }
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[---------------- End container test : flat_set ----------------]\n";
+}
+
+}}}    // namespace mystl::test::flat_set_test
+#endif // !MYTINYSTL_FLAT_SET_TEST_H_
@@ -0,0 +1,204 @@
+#ifndef MYTINYSTL_INTRUSIVE_LIST_TEST_H_
+#define MYTINYSTL_INTRUSIVE_LIST_TEST_H_
+
+// intrusive_list test : 测试 intrusive_list 的接口，以及链入、遍历、按对象摘除相对 list<T*> 的性能
+
+#include <cstddef>
+#include <vector>
+
+#include "my_intrusive_list.hpp"
+#include "my_list.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace intrusive_list_test {
+
+// 同时挂在活动链表与定时器链表上的连接对象
+struct connection {
+    int id = 0;
+    mystl::list_hook active;
+    mystl::list_hook timer;
+
+    bool operator<(const connection &other) const { return id < other.id; }
+    bool operator==(const connection &other) const { return id == other.id; }
+};
+
+using active_list = mystl::intrusive_list<connection, &connection::active>;
+using timer_list = mystl::intrusive_list<connection, &connection::timer>;
+
+static_assert(offsetof(mystl::list_node<int>, next) == offsetof(mystl::list_hook, next), "list_hook must match list_node's layout");
+static_assert(offsetof(mystl::list_node<int>, prev) == offsetof(mystl::list_hook, prev), "list_hook must match list_node's layout");
+static_assert(sizeof(active_list::iterator) == sizeof(void *), "intrusive_list iterator must be pointer-sized");
+static_assert(std::is_standard_layout<connection>::value, "connection must be standard layout for offsetof");
+
+std::ostream &operator<<(std::ostream &os, const connection &c) { return os << c.id; }
+
+// 以 op 分别测试 list<connection *> 与 intrusive_list ，每行输出两者耗时与比值
+template <class ListFn, class IntrusiveFn>
+void intrusive_row(const char *op, size_t n, ListFn list_fn, IntrusiveFn intrusive_fn) {
+    bench_row("intrusive_list::", op, n, {"list<T*>", "intrusive_list", false}, list_fn, intrusive_fn);
+}
+
+void intrusive_perf_test(size_t n) {
+    std::vector<connection> objects(n);
+    for (size_t i = 0; i < n; ++i) {
+        objects[i].id = static_cast<int>(i);
+    }
+    intrusive_row(
+        "link", n,
+        [&](bench::State &state) {
+            for (auto _ : state) {
+                mystl::list<connection *> l;
+                for (auto &c : objects) {
+                    l.push_back(&c);
+                }
+                bench::DoNotOptimize(l.size());
+                state.PauseTiming();
+                l.clear();
+                state.ResumeTiming();
+            }
+        },
+        [&](bench::State &state) {
+            for (auto _ : state) {
+                active_list l;
+                for (auto &c : objects) {
+                    l.push_back(c);
+                }
+                bench::DoNotOptimize(l.empty());
+                state.PauseTiming();
+                l.clear();
+                state.ResumeTiming();
+            }
+        });
+    {
+        mystl::list<connection *> l;
+        active_list il;
+        for (auto &c : objects) {
+            l.push_back(&c);
+            il.push_back(c);
+        }
+        intrusive_row(
+            "iterate", n,
+            [&](bench::State &state) {
+                for (auto _ : state) {
+                    long long sum = 0;
+                    for (auto p : l) {
+                        sum += p->id;
+                    }
+                    bench::DoNotOptimize(sum);
+                }
+            },
+            [&](bench::State &state) {
+                for (auto _ : state) {
+                    long long sum = 0;
+                    for (auto &c : il) {
+                        sum += c.id;
+                    }
+                    bench::DoNotOptimize(sum);
+                }
+            });
+    }
+    // 每隔一个对象摘除一个： list 需要事先保存每个对象的迭代器，侵入式链表直接从对象上摘下
+    intrusive_row(
+        "unlink", n,
+        [&](bench::State &state) {
+            std::vector<mystl::list<connection *>::iterator> handles(n);
+            for (auto _ : state) {
+                state.PauseTiming();
+                mystl::list<connection *> l;
+                for (size_t i = 0; i < n; ++i) {
+                    handles[i] = l.insert(l.end(), &objects[i]);
+                }
+                state.ResumeTiming();
+                for (size_t i = 0; i < n; i += 2) {
+                    l.erase(handles[i]);
+                }
+                bench::DoNotOptimize(l.size());
+                state.PauseTiming();
+                l.clear();
+                state.ResumeTiming();
+            }
+        },
+        [&](bench::State &state) {
+            for (auto _ : state) {
+                state.PauseTiming();
+                active_list l;
+                for (auto &c : objects) {
+                    l.push_back(c);
+                }
+                state.ResumeTiming();
+                for (size_t i = 0; i < n; i += 2) {
+                    objects[i].active.unlink();
+                }
+                bench::DoNotOptimize(l.empty());
+                state.PauseTiming();
+                l.clear();
+                state.ResumeTiming();
+            }
+        });
+}
+
+void intrusive_list_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : intrusive_list -------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    std::vector<connection> c(10);
+    for (int i = 0; i < 10; ++i) {
+        c[i].id = (i * 7) % 10;
+    }
+    active_list l1, l2;
+    timer_list t1;
+    for (int i = 0; i < 6; ++i) {
+        l1.push_back(c[i]);
+    }
+    for (int i = 6; i < 10; ++i) {
+        l2.push_front(c[i]);
+    }
+    for (int i = 0; i < 10; i += 2) {
+        t1.push_back(c[i]);
+    }
+    std::cout << std::boolalpha;
+    FUN_VALUE((mystl::intrusive_node_traits<connection, &connection::timer>::hook_offset() == static_cast<std::ptrdiff_t>(offsetof(connection, timer))));
+    FUN_VALUE((&t1.front() == &c[0]));
+    FUN_VALUE(l1.size());
+    FUN_VALUE(t1.size());
+    FUN_AFTER(l1, l1.sort());
+    FUN_AFTER(l2, l2.sort());
+    FUN_AFTER(l1, l1.merge(l2));
+    FUN_VALUE(l2.empty());
+    FUN_AFTER(l1, c[3].active.unlink());
+    FUN_VALUE(c[3].active.is_linked());
+    FUN_VALUE(c[3].timer.is_linked());
+    FUN_AFTER(t1, c[4].timer.unlink());
+    FUN_AFTER(l1, l1.erase(active_list::iterator_to(c[0])));
+    FUN_AFTER(l1, l1.sort(std::less<connection>()));
+    FUN_AFTER(l1, l1.reverse());
+    FUN_AFTER(l2, l2.splice(l2.end(), l1, l1.begin()));
+    FUN_AFTER(l2, l2.splice(l2.begin(), l1, l1.begin(), ++++l1.begin()));
+    FUN_AFTER(l1, l1.remove_if([](const connection &x) { return x.id & 1; }));
+    FUN_AFTER(l1, l1.swap(l2));
+    FUN_AFTER(l1, l1.splice(l1.begin(), l2));
+    {
+        connection temp;
+        temp.id = 42;
+        l1.push_back(temp);
+        FUN_VALUE(l1.back());
+    }
+    FUN_VALUE(l1.back());
+    FUN_AFTER(t1, t1.clear());
+    FUN_VALUE(c[0].timer.is_linked());
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  op  element count  |   list<T*>  |  intrusive  |  intru/list |\n";
+    intrusive_perf_test(LEN1);
+    intrusive_perf_test(LEN2);
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[------------- End container test : intrusive_list -------------]\n";
+}
+
+}}}    // namespace mystl::test::intrusive_list_test
+#endif // !MYTINYSTL_INTRUSIVE_LIST_TEST_H_
@@ -1,11 +1,12 @@
 ﻿#ifndef MYTINYSTL_LIST_TEST_H_
 #define MYTINYSTL_LIST_TEST_H_
 
-// list test : 测试 list 的接口与 insert, sort 的性能
+// list test : 测试 list 的接口与 insert, copy, sort 以及结点反复申请释放的性能
 
 #include <list>
 
 #include "my_list.hpp"
+#include "my_node_pool.hpp"
 #include "test.h"
 
 namespace mystl
@@ -15,9 +16,80 @@ namespace test
 namespace list_test
 {
 
+static_assert(std::is_trivially_copyable<mystl::list<int>::iterator>::value, "list iterator must be trivially copyable");
+static_assert(sizeof(mystl::list<int>::iterator) == sizeof(void *), "list iterator must be pointer-sized");
+static_assert(std::is_nothrow_move_assignable<mystl::list<int>>::value, "move assignment with an always-equal allocator cannot throw");
+static_assert(!std::is_nothrow_move_assignable<mystl::pmr::list<int>>::value, "move assignment between unequal pmr allocators creates nodes");
+
 // 一个辅助测试函数
 bool is_odd(int x) { return x & 1; }
 
+// 模拟 LRU 链表：不断在尾部插入、从头部淘汰，链表长度保持在 1000 左右，输出耗时
+template <typename List>
+void node_churn_list(size_t count)
+{
+  List l;
+  for (size_t i = 0; i < count; ++i)
+  {
+    l.push_back(static_cast<int>(i));
+    if (l.size() > 1000)
+      l.pop_front();
+  }
+}
+
+template <typename List>
+void node_churn_test(const char* variant, size_t count)
+{
+  auto& r = bench::Run("list<int>::churn", variant, count, [count](bench::State& state) {
+    for (auto _ : state)
+      node_churn_list<List>(count);
+  });
+  bench::PrintCell(r, WIDE);
+}
+
+// 复制一个含 count 个元素的链表，新链表的析构不计入
+template <typename List>
+void list_copy_test(const char* variant, size_t count)
+{
+  List src;
+  for (size_t i = 0; i < count; ++i)
+    src.push_back(static_cast<int>(i));
+  auto& r = bench::Run("list<int>::copy", variant, count, [&src](bench::State& state) {
+    for (auto _ : state)
+    {
+      {
+        List l(src);
+        bench::DoNotOptimize(l);
+        state.PauseTiming();
+      }
+      state.ResumeTiming();
+    }
+  });
+  bench::PrintCell(r, WIDE);
+}
+
+// 与 LIST_SORT_DO_TEST 相同，但调用 sort_indexed
+void list_sort_indexed_test(size_t count)
+{
+  auto& r = bench::Run("list<int>::sort_indexed", "mystl", count, [count](bench::State& state) {
+    for (auto _ : state)
+    {
+      state.PauseTiming();
+      {
+        mystl::list<int> l;
+        for (size_t i = 0; i < count; ++i)
+          l.insert(l.end(), rand());
+        state.ResumeTiming();
+        l.sort_indexed();
+        bench::DoNotOptimize(l);
+        state.PauseTiming();
+      }
+      state.ResumeTiming();
+    }
+  });
+  bench::PrintCell(r, WIDE);
+}
+
 void list_test()
 {
   std::cout << "[===============================================================]" << std::endl;
@@ -73,6 +145,7 @@ void list_test()
   FUN_AFTER(l1, l1.unique([&](int a, int b) {return b == a + 1; }));
   FUN_AFTER(l1, l1.merge(l7));
   FUN_AFTER(l1, l1.sort(std::greater<int>()));
+  FUN_AFTER(l1, l1.sort_indexed());
   FUN_AFTER(l1, l1.merge(l8, std::greater<int>()));
   FUN_AFTER(l1, l1.reverse());
   FUN_AFTER(l1, l1.clear());
@@ -96,17 +169,60 @@ void list_test()
 #else
   CON_TEST_P2(list<int>, insert, end, rand(), LEN1 _M, LEN2 _M, LEN3 _M);
 #endif
-//   std::cout << std::endl;
-//   std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
-//   std::cout << "|         sort        |";
-// #if LARGER_TEST_DATA_ON
-//   //LIST_SORT_TEST(LEN1 _M, LEN2 _M, LEN3 _M);
-// #else
-//   LIST_SORT_TEST(LEN1 _S, LEN2 _S, LEN3 _S);
-// #endif
-//   std::cout << std::endl;
-//   std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
-//   PASSED;
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|     node churn      |";
+  TEST_LEN(LEN1 _L, LEN2 _L, LEN3 _L, WIDE);
+  std::cout << "|         std         |";
+  node_churn_test<std::list<int>>("std", LEN1 _L);
+  node_churn_test<std::list<int>>("std", LEN2 _L);
+  node_churn_test<std::list<int>>("std", LEN3 _L);
+  std::cout << std::endl << "|        mystl        |";
+  node_churn_test<mystl::list<int>>("mystl", LEN1 _L);
+  node_churn_test<mystl::list<int>>("mystl", LEN2 _L);
+  node_churn_test<mystl::list<int>>("mystl", LEN3 _L);
+  std::cout << std::endl << "|     mystl pool      |";
+  node_churn_test<mystl::list<int, mystl::pool_allocator<int>>>("mystl pool", LEN1 _L);
+  node_churn_test<mystl::list<int, mystl::pool_allocator<int>>>("mystl pool", LEN2 _L);
+  node_churn_test<mystl::list<int, mystl::pool_allocator<int>>>("mystl pool", LEN3 _L);
+  bench::PrintComparisonRows("list<int>::churn", LEN1 _L, LEN2 _L, LEN3 _L, WIDE);
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|         copy        |";
+  TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+  std::cout << "|         std         |";
+  list_copy_test<std::list<int>>("std", LEN1 _M);
+  list_copy_test<std::list<int>>("std", LEN2 _M);
+  list_copy_test<std::list<int>>("std", LEN3 _M);
+  std::cout << std::endl << "|        mystl        |";
+  list_copy_test<mystl::list<int>>("mystl", LEN1 _M);
+  list_copy_test<mystl::list<int>>("mystl", LEN2 _M);
+  list_copy_test<mystl::list<int>>("mystl", LEN3 _M);
+  std::cout << std::endl << "|     mystl pool      |";
+  list_copy_test<mystl::list<int, mystl::pool_allocator<int>>>("mystl pool", LEN1 _M);
+  list_copy_test<mystl::list<int, mystl::pool_allocator<int>>>("mystl pool", LEN2 _M);
+  list_copy_test<mystl::list<int, mystl::pool_allocator<int>>>("mystl pool", LEN3 _M);
+  bench::PrintComparisonRows("list<int>::copy", LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|         sort        |";
+  TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+  std::cout << "|         std         |";
+  LIST_SORT_DO_TEST(std, LEN1 _M);
+  LIST_SORT_DO_TEST(std, LEN2 _M);
+  LIST_SORT_DO_TEST(std, LEN3 _M);
+  std::cout << std::endl << "|        mystl        |";
+  LIST_SORT_DO_TEST(mystl, LEN1 _M);
+  LIST_SORT_DO_TEST(mystl, LEN2 _M);
+  LIST_SORT_DO_TEST(mystl, LEN3 _M);
+  std::cout << std::endl << "|    mystl indexed    |";
+  list_sort_indexed_test(LEN1 _M);
+  list_sort_indexed_test(LEN2 _M);
+  list_sort_indexed_test(LEN3 _M);
+  bench::PrintComparisonRows("list<int>::sort", LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+  std::cout << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
 #endif
   std::cout << "[------------------ End container test : list ------------------]" << std::endl;
 }
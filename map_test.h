@@ -0,0 +1,218 @@
+#ifndef MYTINYSTL_MAP_TEST_H_
+#define MYTINYSTL_MAP_TEST_H_
+
+// map test : 测试 map, multimap 的接口、与 std::map, std::multimap 随机对比的结果，以及 emplace, find, 区间扫描, 有序批量构造的性能
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "my_map.hpp"
+#include "my_vector.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace map_test {
+
+static_assert(mystl::map<int, int>::node_capacity * sizeof(std::pair<const int, int>) <= mystl::btree_node_bytes,
+              "values of a node fit in btree_node_bytes");
+
+// 插入（含位置提示）、按键与按迭代器删除、边界查找随机交错，每一步与 std::map / std::multimap 对比
+template <class Map, class Ref>
+bool check_random(unsigned seed) {
+    std::mt19937 gen(seed);
+    bool ok = true;
+    for (int round = 0; round < 6; ++round) {
+        Map m;
+        Ref r;
+        int range = 30 + round * 2000;
+        for (int i = 0; i < 20000; ++i) {
+            int k = static_cast<int>(gen() % range);
+            auto op = gen() % 6;
+            if (op < 2) {
+                m.insert(mystl::make_pair(k, i));
+                r.insert(std::make_pair(k, i));
+            } else if (op == 2) {
+                auto hint = m.upper_bound(k);
+                auto rhint = r.upper_bound(k);
+                ok = ok && m.insert(hint, mystl::make_pair(k, i))->second == r.insert(rhint, std::make_pair(k, i))->second;
+            } else if (op == 3) {
+                ok = ok && m.erase(k) == r.erase(k);
+            } else if (op == 4 && !r.empty()) {
+                auto n = gen() % r.size();
+                auto it = m.erase(std::next(m.begin(), n));
+                auto jt = r.erase(std::next(r.begin(), n));
+                ok = ok && (it == m.end()) == (jt == r.end()) && (it == m.end() || *it == *jt);
+            } else {
+                auto it = m.lower_bound(k);
+                auto jt = r.lower_bound(k);
+                ok = ok && (it == m.end()) == (jt == r.end()) && (it == m.end() || *it == *jt);
+                ok = ok && m.count(k) == r.count(k);
+            }
+            ok = ok && m.size() == r.size();
+        }
+        ok = ok && std::equal(m.begin(), m.end(), r.begin(), r.end()) && std::equal(m.rbegin(), m.rend(), r.rbegin(), r.rend());
+        // 边遍历边删除，每个剩余元素恰好访问一次
+        for (auto it = m.begin(); it != m.end();) {
+            it = it->first % 3 == 0 ? m.erase(it) : std::next(it);
+        }
+        for (auto it = r.begin(); it != r.end();) {
+            it = it->first % 3 == 0 ? r.erase(it) : std::next(it);
+        }
+        ok = ok && std::equal(m.begin(), m.end(), r.begin(), r.end());
+        auto c = m;
+        auto d = std::move(c);
+        ok = ok && c.empty() && d == m;
+        mystl::vector<std::pair<int, int>> sorted(r.begin(), r.end());
+        Map b(typename Map::sorted_t(), sorted.begin(), sorted.end());
+        ok = ok && b == m;
+        while (!d.empty()) {
+            d.erase(d.size() % 2 ? d.begin() : std::prev(d.end()));
+        }
+        ok = ok && d.begin() == d.end();
+    }
+    return ok;
+}
+
+// std::less<> 下 count、find、lower_bound、upper_bound 直接与字面量和 string_view 比较
+bool check_transparent() {
+    mystl::map<std::string, int, std::less<>> m;
+    for (int i = 0; i < 1000; ++i) {
+        m[std::to_string(i)] = i;
+    }
+    bool ok = m.count("7") == 1 && m.find(std::string_view("999"))->second == 999 && !m.contains("1000");
+    return ok && m.lower_bound("99")->first == "99" && m.upper_bound("99")->first == "990";
+}
+
+// 随机键的查找（全部命中）、每 100 个键一次的 100 个元素区间扫描、由有序 vector 构造
+void lookup_rows(size_t n) {
+    std::mt19937 gen(42);
+    mystl::vector<int> keys(n);
+    for (auto &k : keys) {
+        k = static_cast<int>(gen());
+    }
+    std::map<int, int> s;
+    mystl::map<int, int> m;
+    for (auto k : keys) {
+        s.emplace(k, k);
+        m.emplace(k, k);
+    }
+    mystl::vector<std::pair<int, int>> sorted(s.begin(), s.end());
+    bench_row(
+        "map<int, int>::", "find", n,
+        [&](bench::State &state) {
+            for (auto _ : state)
+                for (auto k : keys) bench::DoNotOptimize(s.find(k));
+        },
+        [&](bench::State &state) {
+            for (auto _ : state)
+                for (auto k : keys) bench::DoNotOptimize(m.find(k));
+        });
+    bench_row(
+        "map<int, int>::", "range scan", n,
+        [&](bench::State &state) {
+            for (auto _ : state) {
+                long long sum = 0;
+                for (size_t i = 0; i < n; i += 100) {
+                    auto it = s.lower_bound(keys[i]);
+                    for (int j = 0; j < 100 && it != s.end(); ++j, ++it) sum += it->second;
+                }
+                bench::DoNotOptimize(sum);
+            }
+        },
+        [&](bench::State &state) {
+            for (auto _ : state) {
+                long long sum = 0;
+                for (size_t i = 0; i < n; i += 100) {
+                    auto it = m.lower_bound(keys[i]);
+                    for (int j = 0; j < 100 && it != m.end(); ++j, ++it) sum += it->second;
+                }
+                bench::DoNotOptimize(sum);
+            }
+        });
+    bench_row(
+        "map<int, int>::", "sorted build", n,
+        [&](bench::State &state) {
+            for (auto _ : state) {
+                std::map<int, int> c(sorted.begin(), sorted.end());
+                bench::DoNotOptimize(c);
+            }
+        },
+        [&](bench::State &state) {
+            for (auto _ : state) {
+                mystl::map<int, int> c(mystl::sorted_unique, sorted.begin(), sorted.end());
+                bench::DoNotOptimize(c);
+            }
+        });
+}
+
+void map_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------------- Run container test : map ------------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    mystl::map<int, int> m1;
+    mystl::map<int, int> m2{{3, 9}, {1, 1}, {2, 4}, {2, 5}};
+    mystl::map<int, int> m3(m2);
+    mystl::map<int, int> m4(std::move(m3));
+    mystl::multimap<int, int> mm{{2, 1}, {1, 1}, {2, 2}, {2, 3}};
+    std::cout << std::boolalpha;
+    FUN_VALUE(m1.node_capacity);
+    FUN_VALUE(m1.size());
+    FUN_VALUE(m2.size());
+    FUN_VALUE(m2.at(2));
+    FUN_VALUE(m2.begin()->first);
+    FUN_VALUE(m2.rbegin()->first);
+    FUN_VALUE(m4.count(3));
+    FUN_VALUE(m1.emplace(1, 10).second);
+    FUN_VALUE(m1.emplace(1, 11).second);
+    FUN_VALUE(m1.insert(mystl::make_pair(5, 50)).second);
+    FUN_VALUE(m1.try_emplace(3, 30).second);
+    FUN_VALUE(m1.insert_or_assign(3, 31).second);
+    FUN_VALUE(m1[3]);
+    FUN_VALUE(m1[4]);
+    FUN_VALUE(m1.lower_bound(2)->first);
+    FUN_VALUE(m1.upper_bound(3)->first);
+    FUN_VALUE(m1.erase(1));
+    FUN_VALUE(m1.erase(1));
+    FUN_VALUE(m1.begin()->first);
+    FUN_VALUE((m1.find(6) == m1.end()));
+    FUN_VALUE(m1.size());
+    FUN_VALUE((m2 == m4));
+    FUN_VALUE((m1 < m2));
+    FUN_VALUE(mm.size());
+    FUN_VALUE(mm.count(2));
+    FUN_VALUE(mm.lower_bound(2)->second);
+    FUN_VALUE(mm.insert(mystl::make_pair(2, 4))->second);
+    FUN_VALUE(mm.erase(2));
+    FUN_VALUE(mm.size());
+    m1.clear();
+    FUN_VALUE(m1.empty());
+    FUN_VALUE((check_random<mystl::map<int, int>, std::map<int, int>>(1)));
+    FUN_VALUE((check_random<mystl::multimap<int, int>, std::multimap<int, int>>(2)));
+    FUN_VALUE(check_transparent());
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|       emplace       |";
+#if LARGER_TEST_DATA_ON
+    MAP_EMPLACE_TEST(map, LEN1 _L, LEN2 _L, LEN3 _L);
+#else
+    MAP_EMPLACE_TEST(map, LEN1 _M, LEN2 _M, LEN3 _M);
+#endif
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  op  element count  |     std     |    mystl    |   speedup   |\n";
+    for (size_t n : {size_t(LEN1 _M), size_t(LEN3 _M)}) {
+        lookup_rows(n);
+    }
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[------------------- End container test : map ------------------]\n";
+}
+
+}}}    // namespace mystl::test::map_test
+#endif // !MYTINYSTL_MAP_TEST_H_
@@ -1,55 +1,61 @@
 #pragma once
 #include <cstdlib>
+#include <initializer_list>
+#include <new>
 #include <stdexcept>
 #include <type_traits>
 #include <typeinfo>
 #include <utility>
 #include <iostream>
 
-#define BufferSize 3
+#include "my_memory.hpp"
 
 namespace mystl {
-class any;
-
-class any {
-    class var_base;
-    template <class T>
-    class var;
+///类型擦除的值容器。 InlineBytes 为内联缓冲区的字节数， Align 为缓冲区的对齐。
+///每种被存放的类型对应一张静态的操作表（复制、移动、销毁、类型信息）， basic_any 只保存指向它的指针和一块内联缓冲区。
+///操作表的地址同时充当类型标识： any_cast 与 has_value 只做一次指针比较。
+///满足 fits_inline<T> 的类型直接存放在缓冲区中，其余类型存放在堆上、缓冲区只保存指针。
+///堆上的对象与可平凡重定位的内联对象移动时只按字节复制缓冲区。
+template <size_t InlineBytes, size_t Align = alignof(void *)>
+class basic_any {
+    static_assert(InlineBytes >= sizeof(void *), "the inline buffer must be able to hold a pointer");
+    static_assert(Align != 0 && (Align & (Align - 1)) == 0, "alignment must be a power of two");
 
 public:
-    template <class T>
-    friend T any_cast(const any &operand);
-
-    template <class T>
-    friend T any_cast(any &operand);
+    template <class T, size_t N, size_t A>
+    friend const T *any_cast(const basic_any<N, A> *operand) noexcept;
 
-    template <class T>
-    friend T any_cast(any &&operand);
+    template <class T, size_t N, size_t A>
+    friend T *any_cast(basic_any<N, A> *operand) noexcept;
 
-    template <class T>
-    friend const T *any_cast(const any *operand) noexcept;
+    static constexpr size_t inline_bytes = InlineBytes;
+    static constexpr size_t inline_align = Align > alignof(void *) ? Align : alignof(void *);
 
+    ///T 是否存放在内联缓冲区中、不经过堆分配：放得下、对齐要求不超过缓冲区，并且移动构造不抛异常。
+    ///移动构造可能抛异常的类型若存放在缓冲区中， basic_any 的移动便无法保证 noexcept ，所以一律放到堆上。
     template <class T>
-    friend T *any_cast(any *operand) noexcept;
+    static constexpr bool fits_inline = sizeof(T) <= InlineBytes && alignof(T) <= inline_align && std::is_nothrow_move_constructible<T>::value;
 
-    constexpr any() noexcept;  // 构造空对象。
-    any(const any &other);     // 复制 other 的内容进新实例，从而任何内容的类型和值都等于构造函数调用前的 other 所拥有者，或者若 other 为空则内容为空。
-    any(any &&other) noexcept; // 移动 other 的内容进新实例，从而任何内容的类型和值都等于构造函数调用前的 other 所拥有者，或者若 other 为空则内容为空。
-    template <typename ValueType, typename = std::enable_if_t<!std::is_same<any, std::decay_t<ValueType>>::value>>
-    any(ValueType &&value); //构造对象，其初始内容为 std::decay_t<ValueType> 类型对象，从 std::forward<ValueType>(value) 直接初始化它。
+    constexpr basic_any() noexcept = default; // 构造空对象。
+    basic_any(const basic_any &other);        // 复制 other 的内容进新实例，从而任何内容的类型和值都等于构造函数调用前的 other 所拥有者，或者若 other 为空则内容为空。
+    basic_any(basic_any &&other) noexcept;    // 移动 other 的内容进新实例，从而任何内容的类型和值都等于构造函数调用前的 other 所拥有者，或者若 other 为空则内容为空。
+    template <typename ValueType, typename = std::enable_if_t<!std::is_same<basic_any, std::decay_t<ValueType>>::value>>
+    basic_any(ValueType &&value); //构造对象，其初始内容为 std::decay_t<ValueType> 类型对象，从 std::forward<ValueType>(value) 直接初始化它。
     template <typename ValueType, typename... Args>
-    explicit any(std::in_place_type_t<ValueType>, Args &&...args); //构造对象，其初始内容为 std::decay_t<ValueType> 类型对象，从 std::forward<Args>(args)... 直接非列表初始化它。
+    explicit basic_any(std::in_place_type_t<ValueType>, Args &&...args); //构造对象，其初始内容为 std::decay_t<ValueType> 类型对象，从 std::forward<Args>(args)... 直接非列表初始化它。
     template <typename ValueType, typename U, typename... Args>
-    explicit any(std::in_place_type_t<ValueType>, std::initializer_list<U> il,
-                 Args &&...args); //构造对象，其初始内容为 std::decay_t<ValueType> 类型对象，从 il, std::forward<Args>(args)... 直接非列表初始化它。
+    explicit basic_any(std::in_place_type_t<ValueType>, std::initializer_list<U> il,
+                       Args &&...args); //构造对象，其初始内容为 std::decay_t<ValueType> 类型对象，从 il, std::forward<Args>(args)... 直接非列表初始化它。
 
-    any &operator=(const any &rhs);     // 以复制 rhs 的状态赋值，如同用 any(rhs).swap(*this) 。
-    any &operator=(any &&rhs) noexcept; // 以移动 rhs 的状态赋值，如同用 any(std::move(rhs)).swap(*this) 。赋值后 rhs 留在合法但未指定的状态。
-    template <typename ValueType, typename = std::enable_if_t<!std::is_same<any, std::decay_t<ValueType>>::value>> // 以 rhs 的类型和值赋值，如同用 any(std::forward<ValueType>(rhs)).swap(*this) 。
-    any &operator=(ValueType &&rhs); // 此重载仅若 std::decay_t<ValueType> 与 any 不是同一类型且 std::is_copy_constructible_v<std::decay_t<ValueType>> 为 true才参与重载决议。
+    basic_any &operator=(const basic_any &rhs);     // 以复制 rhs 的状态赋值，如同用 basic_any(rhs).swap(*this) 。
+    basic_any &operator=(basic_any &&rhs) noexcept; // 以移动 rhs 的状态赋值，如同用 basic_any(std::move(rhs)).swap(*this) 。赋值后 rhs 为空。
+    template <typename ValueType, typename = std::enable_if_t<!std::is_same<basic_any, std::decay_t<ValueType>>::value>> // 以 rhs 的类型和值赋值，如同用 basic_any(std::forward<ValueType>(rhs)).swap(*this) 。
+    basic_any &operator=(ValueType &&rhs); // 此重载仅若 std::decay_t<ValueType> 与 basic_any 不是同一类型且 std::is_copy_constructible_v<std::decay_t<ValueType>> 为 true才参与重载决议。
 
-    ~any();
+    ~basic_any();
 
+    ///销毁当前所存对象，再以 args 构造 std::decay_t<ValueType> 对象。所存类型不变时复用原有存储，堆上的对象不重新申请内存。
+    ///构造抛出异常时 *this 为空。
     template <class ValueType, class... Args>
     std::decay_t<ValueType> &emplace(Args &&...args);
     template <class ValueType, class U, class... Args>
@@ -57,255 +63,309 @@ public:
 
     void reset() noexcept;
 
-    void swap(any &other) noexcept;
+    void swap(basic_any &other) noexcept; // 直接互换两边的对象，不构造临时的 basic_any ，可平凡重定位的对象与堆上的对象只按字节交换。
 
-    [[nodiscard]] bool has_value() const noexcept;
+    [[nodiscard]] bool has_value() const noexcept; // 只检查操作表指针，不调用任何函数。
 
     [[nodiscard]] const std::type_info &type() const noexcept;
 
-protected:
-    static var_base static_var_base;
-
-    var_base *ptr = nullptr;
-    //std::type_info *info = const_cast<std::type_info *>(&typeid(void));
-    void *stack_mem[BufferSize] = {nullptr};
-
 private:
-    class var_base {
-    public:
-        var_base() = default;
-        virtual ~var_base() = default;
-
-        virtual var_base *copy_constructor() const { return nullptr; }
-        virtual var_base *copy_constructor(var_base *stack_ptr) const { return nullptr; }
-        virtual var_base *move_constructor(var_base *stack_ptr) const { return nullptr; }
-        virtual const std::type_info &typeInfo() const { return typeid(void); }
+    union storage {
+        void *heap = nullptr;
+        alignas(inline_align) unsigned char buffer[InlineBytes];
     };
 
-    template <class T>
-    class var : public var_base {
-    public:
-        T data;
-
-        var(T &_data) : data(_data) {}
-        var(T &&_data) : data(std::move(_data)) {}
-        template <class... Args>
-        var(Args &&...args) : data(std::forward<Args>(args)...) {}
-        template <typename U, typename... Args>
-        var(std::initializer_list<U> il, Args &&...args) : data(il, std::forward<Args>(args)...) {}
-
-        ~var() = default;
-
-        var *copy_constructor() const override { return new var<T>(this->data); }
-        var *copy_constructor(var_base *stack_ptr) const override { return new (stack_ptr) var<T>(this->data); }
-        var *move_constructor(var_base *stack_ptr) const override { return new (stack_ptr) var<T>(std::move(this->data)); }
-        [[nodiscard]] const std::type_info &typeInfo() const override { return typeid(T); }
+    struct ops_table {
+        void (*copy)(const storage &src, storage &dst);     // 在空的 dst 中构造 src 所存对象的副本。
+        void (*move)(storage &src, storage &dst) noexcept;  // 把 src 的对象移进空的 dst 并销毁 src 中的对象。为空表示按字节复制 storage 即可。
+        void (*destroy)(storage &self) noexcept;            // 销毁所存对象，堆上的对象连同内存一起释放。
+        const std::type_info &(*type)() noexcept;
     };
+
+    template <class T, bool Local = fits_inline<T>>
+    struct manager;
+
+    template <class T, class... Args>
+    T &M_create(Args &&...args); // 在空的 basic_any 中构造 T 。
+    template <class T, class... Args>
+    T &M_emplace(Args &&...args); // 所存类型已是 T 时原地重建，堆上的对象沿用原来的内存；否则先 reset 再构造。
+    void M_steal(basic_any &other) noexcept; // 把 other 的内容移进空的 *this ，other 变为空。
+    static void M_relocate(const ops_table *ops, storage &src, storage &dst) noexcept; // 把 src 中由 ops 管理的对象搬进 dst 。
+
+    const ops_table *ops = nullptr; // 为空表示没有值。
+    storage data;
 };
-any::var_base any::static_var_base;
-constexpr any::any() noexcept {
-    this->ptr = &any::static_var_base;
-}
-any::any(const any &other) {
-    //this->info = other.info;
-    if (other.type() != typeid(void)) {
-        if (reinterpret_cast<size_t>(other.ptr) == reinterpret_cast<size_t>(other.stack_mem)) {
-            this->ptr = other.ptr->copy_constructor(reinterpret_cast<var_base *>(this->stack_mem));
+
+///默认的 any ：四个指针大小的内联缓冲区，容得下 libstdc++ 的 std::string ， sizeof(any) 为 40 字节。
+using any = basic_any<4 * sizeof(void *)>;
+
+///内联存放的对象。
+template <size_t InlineBytes, size_t Align>
+template <class T>
+struct basic_any<InlineBytes, Align>::manager<T, true> {
+    static T *get(const storage &self) noexcept { return std::launder(reinterpret_cast<T *>(const_cast<unsigned char *>(self.buffer))); }
+
+    template <class... Args>
+    static T &create(storage &self, Args &&...args) {
+        return *::new (static_cast<void *>(self.buffer)) T(std::forward<Args>(args)...);
+    }
+
+    //调用者须先把 ops 置空：构造抛出异常时对象已经销毁。
+    template <class... Args>
+    static T &rebuild(storage &self, Args &&...args) {
+        destroy(self);
+        return create(self, std::forward<Args>(args)...);
+    }
+
+    static void copy(const storage &src, storage &dst) { create(dst, *get(src)); }
+
+    static void move(storage &src, storage &dst) noexcept {
+        auto p = get(src);
+        create(dst, std::move(*p));
+        p->~T();
+    }
+
+    static void destroy(storage &self) noexcept { get(self)->~T(); }
+
+    static const std::type_info &type() noexcept { return typeid(T); }
+
+    static constexpr ops_table table = {&copy, is_trivially_relocatable<T>::value ? nullptr : &move, &destroy, &type};
+};
+
+///堆上存放的对象，缓冲区只保存指针，移动时交接指针即可。
+///内存与对象分开管理，同类型 emplace 时只重建对象、沿用原来的内存。
+template <size_t InlineBytes, size_t Align>
+template <class T>
+struct basic_any<InlineBytes, Align>::manager<T, false> {
+    static constexpr bool over_aligned = alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    static T *get(const storage &self) noexcept { return static_cast<T *>(self.heap); }
+
+    static void *allocate() {
+        return over_aligned ? ::operator new(sizeof(T), std::align_val_t(alignof(T))) : ::operator new(sizeof(T));
+    }
+
+    static void deallocate(void *p) noexcept {
+        if (over_aligned) {
+            ::operator delete(p, std::align_val_t(alignof(T)));
         } else {
-            this->ptr = other.ptr->copy_constructor();
+            ::operator delete(p);
         }
-    } else {
-        //this->ptr = new (reinterpret_cast<var_base *>(this->stack_mem + 1)) var_base;
-        this->ptr = &any::static_var_base;
     }
-}
-any::any(any &&other) noexcept {
-    if (reinterpret_cast<size_t>(other.ptr) == reinterpret_cast<size_t>(other.stack_mem)) {
-        this->ptr = other.ptr->move_constructor(reinterpret_cast<var_base *>(this->stack_mem));
-    } else {
-        if (other.type() == typeid(void)) {
-            this->ptr = &any::static_var_base;
-        } else {
-            std::swap(this->ptr, other.ptr);
+
+    template <class... Args>
+    static T &create(storage &self, Args &&...args) {
+        auto p = allocate();
+        try {
+            ::new (p) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(p);
+            throw;
+        }
+        self.heap = p;
+        return *get(self);
+    }
+
+    //调用者须先把 ops 置空：构造抛出异常时内存已经释放。
+    template <class... Args>
+    static T &rebuild(storage &self, Args &&...args) {
+        get(self)->~T();
+        try {
+            ::new (self.heap) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(self.heap);
+            throw;
         }
+        return *get(self);
+    }
+
+    static void copy(const storage &src, storage &dst) { create(dst, *get(src)); }
+
+    static void destroy(storage &self) noexcept {
+        get(self)->~T();
+        deallocate(self.heap);
+    }
+
+    static const std::type_info &type() noexcept { return typeid(T); }
+
+    static constexpr ops_table table = {&copy, nullptr, &destroy, &type};
+};
+
+template <size_t InlineBytes, size_t Align>
+basic_any<InlineBytes, Align>::basic_any(const basic_any &other) {
+    if (other.ops) {
+        other.ops->copy(other.data, this->data);
+        this->ops = other.ops;
     }
 }
+template <size_t InlineBytes, size_t Align>
+basic_any<InlineBytes, Align>::basic_any(basic_any &&other) noexcept {
+    M_steal(other);
+}
+template <size_t InlineBytes, size_t Align>
 template <typename ValueType, typename>
-any::any(ValueType &&value) {
-    //this->info = const_cast<std::type_info *>(&typeid(ValueType));
-    if (sizeof(var<ValueType>) <= BufferSize * sizeof(void *)) {
-        this->ptr = new (reinterpret_cast<var_base *>(stack_mem)) var<ValueType>(std::forward<ValueType>(value));
-        // std::cout << "value type : " << this->info->name() << " on stack, size : " << sizeof(var<ValueType>) << std::endl;
-    } else {
-        this->ptr = new var<ValueType>(std::forward<ValueType>(value));
-        // std::cout << "value type : " << this->info->name() << " on heap, size : " << sizeof(var<ValueType>) << std::endl;
-    }
+basic_any<InlineBytes, Align>::basic_any(ValueType &&value) {
+    M_create<std::decay_t<ValueType>>(std::forward<ValueType>(value));
 }
+template <size_t InlineBytes, size_t Align>
 template <typename ValueType, typename... Args>
-any::any(std::in_place_type_t<ValueType>, Args &&...args) {
-    //this->info = const_cast<std::type_info *>(&typeid(ValueType));
-    if (sizeof(var<ValueType>) <= BufferSize * sizeof(void *)) {
-        this->ptr = new (reinterpret_cast<ValueType *>(stack_mem)) var<ValueType>(std::forward<Args>(args)...);
-    } else {
-        this->ptr = new var<ValueType>(std::forward<Args>(args)...);
-    }
+basic_any<InlineBytes, Align>::basic_any(std::in_place_type_t<ValueType>, Args &&...args) {
+    M_create<std::decay_t<ValueType>>(std::forward<Args>(args)...);
 }
+template <size_t InlineBytes, size_t Align>
 template <typename ValueType, typename U, typename... Args>
-any::any(std::in_place_type_t<ValueType>, std::initializer_list<U> il, Args &&...args) {
-    //this->info = const_cast<std::type_info *>(&typeid(ValueType));
-    if (sizeof(var<ValueType>) <= BufferSize * sizeof(void *)) {
-        this->ptr = new (reinterpret_cast<ValueType *>(stack_mem)) var<ValueType>(il, std::forward<Args>(args)...);
-    } else {
-        this->ptr = new var<ValueType>(il, std::forward<Args>(args)...);
-    }
+basic_any<InlineBytes, Align>::basic_any(std::in_place_type_t<ValueType>, std::initializer_list<U> il, Args &&...args) {
+    M_create<std::decay_t<ValueType>>(il, std::forward<Args>(args)...);
 }
-any &any::operator=(const any &rhs) {
-    if (this->ptr == rhs.ptr) {
+template <size_t InlineBytes, size_t Align>
+basic_any<InlineBytes, Align> &basic_any<InlineBytes, Align>::operator=(const basic_any &rhs) {
+    if (this == &rhs) {
         return *this;
     }
     this->reset();
-    //this->info = rhs.info;
-    if (rhs.type() != typeid(void)) {
-        if (reinterpret_cast<size_t>(rhs.ptr) == reinterpret_cast<size_t>(rhs.stack_mem)) {
-            this->ptr = rhs.ptr->copy_constructor(reinterpret_cast<var_base *>(this->stack_mem));
-        } else {
-            this->ptr = rhs.ptr->copy_constructor();
-        }
+    if (rhs.ops) {
+        rhs.ops->copy(rhs.data, this->data);
+        this->ops = rhs.ops;
     }
     return *this;
 }
-any &any::operator=(any &&rhs) noexcept {
-    if (this->ptr == rhs.ptr) {
+template <size_t InlineBytes, size_t Align>
+basic_any<InlineBytes, Align> &basic_any<InlineBytes, Align>::operator=(basic_any &&rhs) noexcept {
+    if (this == &rhs) {
         return *this;
     }
-    if (reinterpret_cast<size_t>(rhs.ptr) == reinterpret_cast<size_t>(rhs.stack_mem)) {
-        //this->info = rhs.info;
-        this->ptr = rhs.ptr->move_constructor(reinterpret_cast<var_base *>(this->stack_mem));
-    } else {
-        //std::swap(this->info, rhs.info);
-        std::swap(this->ptr, rhs.ptr);
-    }
+    this->reset();
+    M_steal(rhs);
     return *this;
 }
+template <size_t InlineBytes, size_t Align>
 template <typename ValueType, typename>
-any &any::operator=(ValueType &&rhs) {
-    this->reset();
-    //this->info = const_cast<std::type_info *>(&typeid(ValueType));
-    if (sizeof(var<ValueType>) <= BufferSize * sizeof(void *)) {
-        this->ptr = new (reinterpret_cast<var_base *>(stack_mem)) var<ValueType>(std::forward<ValueType>(rhs));
-    } else {
-        this->ptr = new var<ValueType>(std::forward<ValueType>(rhs));
-    }
+basic_any<InlineBytes, Align> &basic_any<InlineBytes, Align>::operator=(ValueType &&rhs) {
+    // 先构造再替换，rhs 可能引用着当前所存的对象
+    *this = basic_any(std::forward<ValueType>(rhs));
     return *this;
 }
-any::~any() {
+template <size_t InlineBytes, size_t Align>
+basic_any<InlineBytes, Align>::~basic_any() {
     this->reset();
 }
+template <size_t InlineBytes, size_t Align>
 template <class ValueType, class... Args>
-std::decay_t<ValueType> &any::emplace(Args &&...args) {
-    this->reset();
-    //this->info = const_cast<std::type_info *>(&typeid(ValueType));
-    if (sizeof(var<ValueType>) <= BufferSize * sizeof(void *)) {
-        this->ptr = new (reinterpret_cast<ValueType *>(stack_mem)) var<ValueType>(std::forward<Args>(args)...);
-    } else {
-        this->ptr = new var<ValueType>(std::forward<Args>(args)...);
-    }
-    auto casted_ptr = static_cast<var<ValueType> *>(this->ptr);
-    return *casted_ptr->data;
+std::decay_t<ValueType> &basic_any<InlineBytes, Align>::emplace(Args &&...args) {
+    return M_emplace<std::decay_t<ValueType>>(std::forward<Args>(args)...);
 }
+template <size_t InlineBytes, size_t Align>
 template <class ValueType, class U, class... Args>
-std::decay_t<ValueType> &any::emplace(std::initializer_list<U> il, Args &&...args) {
-    this->reset();
-    //this->info = const_cast<std::type_info *>(&typeid(ValueType));
-    if (sizeof(var<ValueType>) <= BufferSize * sizeof(void *)) {
-        this->ptr = new (reinterpret_cast<ValueType *>(stack_mem)) var<ValueType>(il, std::forward<Args>(args)...);
-    } else {
-        this->ptr = new var<ValueType>(il, std::forward<Args>(args)...);
+std::decay_t<ValueType> &basic_any<InlineBytes, Align>::emplace(std::initializer_list<U> il, Args &&...args) {
+    return M_emplace<std::decay_t<ValueType>>(il, std::forward<Args>(args)...);
+}
+template <size_t InlineBytes, size_t Align>
+void basic_any<InlineBytes, Align>::reset() noexcept {
+    if (this->ops) {
+        this->ops->destroy(this->data);
+        this->ops = nullptr;
     }
-    auto casted_ptr = static_cast<var<ValueType> *>(this->ptr);
-    return *casted_ptr->data;
 }
-void any::reset() noexcept {
-    if (this->type() != typeid(void)) {
-        if (reinterpret_cast<size_t>(this->ptr) == reinterpret_cast<size_t>(this->stack_mem)) {
-            this->ptr->~var_base();
-        } else {
-            delete this->ptr;
-        }
-        this->ptr = &any::static_var_base;
-        //this->info = const_cast<std::type_info *>(&typeid(void));
+template <size_t InlineBytes, size_t Align>
+void basic_any<InlineBytes, Align>::swap(basic_any &other) noexcept {
+    if (this == &other) {
+        return;
     }
+    // 直接搬移两边的对象，不构造临时的 basic_any ：两边都可按字节搬移时只是三次 storage 复制。
+    storage temp;
+    M_relocate(other.ops, other.data, temp);
+    M_relocate(this->ops, this->data, other.data);
+    M_relocate(other.ops, temp, this->data);
+    std::swap(this->ops, other.ops);
+}
+template <size_t InlineBytes, size_t Align>
+bool basic_any<InlineBytes, Align>::has_value() const noexcept {
+    return this->ops != nullptr;
+}
+template <size_t InlineBytes, size_t Align>
+const std::type_info &basic_any<InlineBytes, Align>::type() const noexcept {
+    return this->ops ? this->ops->type() : typeid(void);
+}
+template <size_t InlineBytes, size_t Align>
+template <class T, class... Args>
+T &basic_any<InlineBytes, Align>::M_create(Args &&...args) {
+    auto &value = manager<T>::create(this->data, std::forward<Args>(args)...);
+    this->ops = &manager<T>::table;
+    return value;
 }
-void any::swap(any &other) noexcept {
-    // std::swap(this->info, other.info);
-    if (reinterpret_cast<size_t>(other.ptr) == reinterpret_cast<size_t>(other.stack_mem)) {
-        if (reinterpret_cast<size_t>(this->ptr) == reinterpret_cast<size_t>(this->stack_mem)) {
-            any temp(std::move(*this));
-            this->reset();
-            //this->info = other.info;
-            this->ptr = other.ptr->move_constructor(reinterpret_cast<var_base *>(this->stack_mem));
-            other = std::move(temp);
-        } else {
-            any temp(std::move(*this));
-            //this->info = other.info;
-            this->ptr = other.ptr->move_constructor(reinterpret_cast<var_base *>(this->stack_mem));
-            other = std::move(temp);
-        }
+template <size_t InlineBytes, size_t Align>
+template <class T, class... Args>
+T &basic_any<InlineBytes, Align>::M_emplace(Args &&...args) {
+    if (this->ops != &manager<T>::table) {
+        this->reset();
+        return M_create<T>(std::forward<Args>(args)...);
+    }
+    this->ops = nullptr;
+    auto &value = manager<T>::rebuild(this->data, std::forward<Args>(args)...);
+    this->ops = &manager<T>::table;
+    return value;
+}
+template <size_t InlineBytes, size_t Align>
+void basic_any<InlineBytes, Align>::M_steal(basic_any &other) noexcept {
+    M_relocate(other.ops, other.data, this->data);
+    this->ops = other.ops;
+    other.ops = nullptr;
+}
+template <size_t InlineBytes, size_t Align>
+void basic_any<InlineBytes, Align>::M_relocate(const ops_table *ops, storage &src, storage &dst) noexcept {
+    if (!ops) {
+        return;
+    }
+    if (ops->move) {
+        ops->move(src, dst);
     } else {
-        if (reinterpret_cast<size_t>(this->ptr) == reinterpret_cast<size_t>(this->stack_mem)) {
-            any temp(std::move(other));
-            //other.info = this->info;
-            other.ptr = this->ptr->move_constructor(reinterpret_cast<var_base *>(other.stack_mem));
-            this->operator=(std::move(temp));
-        } else {
-            //std::swap(this->info, other.info);
-            std::swap(this->ptr, other.ptr);
-        }
+        dst = src;
     }
 }
-bool any::has_value() const noexcept {
-    return this->type() != typeid(void);
-}
-const std::type_info &any::type() const noexcept {
-    return this->ptr->typeInfo();
-}
-void swap(any &lhs, any &rhs) noexcept {
+template <size_t InlineBytes, size_t Align>
+void swap(basic_any<InlineBytes, Align> &lhs, basic_any<InlineBytes, Align> &rhs) noexcept {
     lhs.swap(rhs);
 }
-template <class T>
-T any_cast(const any &operand) {
-    if (typeid(T) != operand.type()) {
+template <class T, size_t InlineBytes, size_t Align>
+T any_cast(const basic_any<InlineBytes, Align> &operand) {
+    auto p = any_cast<std::remove_cv_t<std::remove_reference_t<T>>>(&operand);
+    if (!p) {
         throw std::bad_cast();
     }
-    return static_cast<T>(*any_cast<std::remove_cv_t<std::remove_reference_t<T>>>(&operand));
+    return static_cast<T>(*p);
 }
-template <class T>
-T any_cast(any &operand) {
-    if (typeid(T) != operand.type()) {
+template <class T, size_t InlineBytes, size_t Align>
+T any_cast(basic_any<InlineBytes, Align> &operand) {
+    auto p = any_cast<std::remove_cv_t<std::remove_reference_t<T>>>(&operand);
+    if (!p) {
         throw std::bad_cast();
     }
-    return static_cast<T>(*any_cast<std::remove_cv_t<std::remove_reference_t<T>>>(&operand));
+    return static_cast<T>(*p);
 }
-template <class T>
-T any_cast(any &&operand) {
-    if (typeid(T) != operand.type()) {
+template <class T, size_t InlineBytes, size_t Align>
+T any_cast(basic_any<InlineBytes, Align> &&operand) {
+    auto p = any_cast<std::remove_cv_t<std::remove_reference_t<T>>>(&operand);
+    if (!p) {
         throw std::bad_cast();
     }
-    return static_cast<T>(std::move(*any_cast<std::remove_cv_t<std::remove_reference_t<T>>>(&operand)));
+    return static_cast<T>(std::move(*p));
 }
-template <class T>
-const T *any_cast(const any *operand) noexcept {
-    if (typeid(T) != operand->type() || !operand) {
+//类型检查只是一次指针比较。
+template <class T, size_t InlineBytes, size_t Align>
+const T *any_cast(const basic_any<InlineBytes, Align> *operand) noexcept {
+    using manager = typename basic_any<InlineBytes, Align>::template manager<std::remove_cv_t<T>>;
+    if (!operand || operand->ops != &manager::table) {
         return nullptr;
     }
-    return &static_cast<const any::var<T> *>(operand->ptr)->data;
+    return manager::get(operand->data);
 }
-template <class T>
-T *any_cast(any *operand) noexcept {
-    if (typeid(T) != operand->type() || !operand) {
+template <class T, size_t InlineBytes, size_t Align>
+T *any_cast(basic_any<InlineBytes, Align> *operand) noexcept {
+    using manager = typename basic_any<InlineBytes, Align>::template manager<std::remove_cv_t<T>>;
+    if (!operand || operand->ops != &manager::table) {
         return nullptr;
     }
-    return &static_cast<any::var<T> *>(operand->ptr)->data;
+    return manager::get(operand->data);
 }
 template <class T, class... Args>
 any make_any(Args &&...args) {
@@ -0,0 +1,1313 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "my_list.hpp"
+#include "my_memory.hpp"
+#include "my_node_pool.hpp"
+#include "my_simd.hpp"
+#include "my_utility.hpp"
+
+namespace mystl {
+///B 树结点的目标大小：四个缓存行。结点内查找只触及其中少数几行，顺序扫描时硬件预取也跟得上。
+constexpr size_t btree_node_bytes = 4 * cache_line_size;
+
+///元素类型的可修改版本。 map 的元素 pair<const Key, T> 不能移动其中的键，结点内外挪动元素时改用同一位置上的 pair<Key, T> 移动构造。
+template <typename Value>
+struct btree_mutable {
+    using type = Value;
+};
+
+template <typename K, typename T>
+struct btree_mutable<std::pair<const K, T>> {
+    using type = std::pair<K, T>;
+};
+
+///结点中的一个元素位置。构造与析构都由 btree 负责，只有 [0, count) 中的位置是存活的。
+template <typename Value>
+union btree_slot {
+    Value value;
+    typename btree_mutable<Value>::type mutable_value;
+
+    btree_slot() noexcept {}
+    ~btree_slot() {}
+};
+
+///键是有 SIMD 核函数的类型且按 std::less 比较时，结点内查找对整个结点计数，代替分支难以预测的二分查找。
+template <typename Key, typename Compare>
+struct btree_simd_search : std::integral_constant<bool, simd::has_kernel<Key>::value && (std::is_same<Compare, std::less<Key>>::value ||
+                                                                                          std::is_same<Compare, std::less<>>::value)> {};
+
+///结点中键的连续副本，供 SIMD 查找使用。 set 的元素本身就是连续的键，不需要副本。
+template <typename Key, size_t N, bool Cached>
+struct btree_key_cache {
+    Key keys[N];
+};
+
+template <typename Key, size_t N>
+struct btree_key_cache<Key, N, false> {};
+
+///每个结点的元素数：结点头与元素合计不超过 btree_node_bytes ，至少为 3 。键的副本不计在内，
+///否则 map 的结点元素数减少三分之一，树更高，抵消了 SIMD 查找的收益。
+template <typename Value>
+struct btree_node_capacity {
+    static constexpr size_t header = (sizeof(void *) + 2 * sizeof(uint16_t) + 1 + alignof(Value) - 1) / alignof(Value) * alignof(Value);
+    static constexpr size_t fit = btree_node_bytes > header ? (btree_node_bytes - header) / sizeof(Value) : 0;
+    static constexpr size_t value = fit < 3 ? 3 : fit;
+};
+
+template <typename Value, typename Key, bool Cached>
+struct btree_internal_node;
+
+///叶结点，也是内部结点的公共部分。
+template <typename Value, typename Key, bool Cached>
+struct btree_node {
+    using value_type = Value;
+    using internal = btree_internal_node<Value, Key, Cached>;
+    static constexpr size_t capacity = btree_node_capacity<Value>::value;
+
+    btree_node *parent = nullptr; //根结点为 nullptr
+    uint16_t position = 0;        //在父结点的子结点数组中的下标
+    uint16_t count = 0;           //存活的元素数
+    bool leaf;
+    btree_key_cache<Key, capacity, Cached> cache; //紧跟结点头，查找时与元素数一同读入
+    btree_slot<Value> slots[capacity];
+
+    explicit btree_node(bool is_leaf) noexcept : leaf(is_leaf) {}
+
+    btree_node *&child(size_t i) noexcept { return static_cast<internal *>(this)->children[i]; }
+    btree_node *child(size_t i) const noexcept { return static_cast<const internal *>(this)->children[i]; }
+};
+
+///内部结点： count 个元素把 count + 1 棵子树分隔开，子树 i 中的元素都位于元素 i - 1 与元素 i 之间。
+template <typename Value, typename Key, bool Cached>
+struct btree_internal_node : btree_node<Value, Key, Cached> {
+    static_assert(btree_node<Value, Key, Cached>::capacity < std::numeric_limits<uint16_t>::max(), "too many values per node");
+
+    btree_node<Value, Key, Cached> *children[btree_node<Value, Key, Cached>::capacity + 1];
+
+    btree_internal_node() noexcept : btree_node<Value, Key, Cached>(false) {}
+};
+
+//迭代器保存结点指针与结点内下标。 end() 为 (最右叶结点, 其元素数) ，空树为 (nullptr, 0) 。
+template <typename Node, typename Ref, typename Ptr>
+class btree_iterator {
+public:
+    using self = btree_iterator<Node, Ref, Ptr>;
+    using value_type = typename Node::value_type;
+    using iterator = btree_iterator<Node, value_type &, value_type *>;
+    using const_iterator = btree_iterator<Node, const value_type &, const value_type *>;
+    using pointer = Ptr;
+    using reference = Ref;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    template <typename, typename, typename, typename, typename, bool>
+    friend class btree;
+    template <typename, typename, typename>
+    friend class btree_iterator;
+
+protected:
+    Node *node = nullptr;
+    size_t position = 0;
+
+public:
+    btree_iterator() = default;
+    btree_iterator(Node *_node, size_t _position) noexcept : node(_node), position(_position) {}
+    ///iterator 可隐式转换为 const_iterator 。
+    template <typename Iter, typename = typename std::enable_if<std::is_same<Iter, iterator>::value && !std::is_same<Iter, self>::value>::type>
+    btree_iterator(const Iter &other) noexcept : node(other.node), position(other.position) {}
+
+    friend bool operator==(const self &lhs, const self &rhs) noexcept { return lhs.node == rhs.node && lhs.position == rhs.position; }
+    friend bool operator!=(const self &lhs, const self &rhs) noexcept { return !(lhs == rhs); }
+
+    reference operator*() const noexcept { return node->slots[position].value; }
+    pointer operator->() const noexcept { return &node->slots[position].value; }
+
+    //叶结点内的前进与后退是最常见的情况，内联处理；跨结点时另行处理。
+    self &operator++() noexcept {
+        if (node->leaf && ++position < node->count) {
+            return *this;
+        }
+        M_increment_slow();
+        return *this;
+    }
+
+    self operator++(int) noexcept {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    self &operator--() noexcept {
+        if (node->leaf && position > 0) {
+            --position;
+            return *this;
+        }
+        M_decrement_slow();
+        return *this;
+    }
+
+    self operator--(int) noexcept {
+        auto temp = *this;
+        --*this;
+        return temp;
+    }
+
+private:
+    ///叶结点走完后沿父结点上行，直到找到位于右侧的分隔元素；内部结点的元素之后是右子树的最左叶结点。
+    void M_increment_slow() noexcept {
+        if (node->leaf) {
+            auto saved = *this;
+            while (position == node->count && node->parent) {
+                position = node->position;
+                node = node->parent;
+            }
+            if (position == node->count) { //已越过最后一个元素，回到 end()
+                *this = saved;
+            }
+        } else {
+            node = node->child(position + 1);
+            while (!node->leaf) {
+                node = node->child(0);
+            }
+            position = 0;
+        }
+    }
+
+    void M_decrement_slow() noexcept {
+        if (node->leaf) {
+            auto saved = *this;
+            while (position == 0 && node->parent) {
+                position = node->position;
+                node = node->parent;
+            }
+            if (position == 0) {
+                *this = saved;
+                return;
+            }
+            --position;
+        } else {
+            node = node->child(position);
+            while (!node->leaf) {
+                node = node->child(node->count);
+            }
+            position = node->count - 1;
+        }
+    }
+};
+
+///B 树， map 、 set 、 multimap 与 multiset 的公共实现。 Multi 为 true 时允许等价的键，等价元素按插入顺序排列。
+///每个结点约 btree_node_bytes 字节，存放多个元素，叶结点不含子结点指针。与红黑树相比，每个元素几乎没有指针开销，
+///查找时每层只访问一个结点，千万级的元素也只有五六层。
+///结点内查找：键是 int32_t 、 uint8_t 、 float 或 double 且比较器为 std::less 时，用 SIMD 核函数数出小于键的元素个数；
+///这时 map 的结点另存一份连续的键。其他情况二分查找。
+///插入时结点满则一分为二，中间元素上移到父结点；在结点末尾插入时左半保留尽量多的元素，顺序插入因此得到几乎全满的结点。
+///删除后结点不足半满时与兄弟结点合并或从兄弟结点借入元素。
+///插入与删除会在结点之间搬动元素，使所有迭代器失效（与 std::map 不同），只有返回的迭代器有效。元素需要能够无异常地搬迁。
+template <typename Value, typename Key, typename KeyOfValue, typename Compare, typename Alloc, bool Multi>
+class btree {
+    using simd_search = btree_simd_search<Key, Compare>;
+    using key_cached = std::integral_constant<bool, simd_search::value && !std::is_same<Value, Key>::value>;
+    using node = btree_node<Value, Key, key_cached::value>;
+    using internal_node = btree_internal_node<Value, Key, key_cached::value>;
+    using slot = btree_slot<Value>;
+    using mutable_type = typename btree_mutable<Value>::type;
+    using leaf_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<node>;
+    using leaf_alloc_traits = std::allocator_traits<leaf_alloc_type>;
+    using internal_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<internal_node>;
+    using internal_alloc_traits = std::allocator_traits<internal_alloc_type>;
+    using value_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Value>;
+    using value_alloc_traits = std::allocator_traits<value_alloc_type>;
+
+    static_assert(is_trivially_relocatable<mutable_type>::value || std::is_nothrow_move_constructible<mutable_type>::value,
+                  "btree requires elements that can be relocated without throwing");
+
+public:
+    using key_type = Key;
+    using value_type = Value;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = Compare;
+    using allocator_type = Alloc;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using const_iterator = btree_iterator<node, const Value &, const Value *>;
+    //set 的元素就是键，不能通过迭代器修改。
+    using iterator = typename std::conditional<std::is_same<Value, Key>::value, const_iterator, btree_iterator<node, Value &, Value *>>::type;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using insert_return = typename std::conditional<Multi, iterator, std::pair<iterator, bool>>::type; //multi 容器的插入总是成功，只返回迭代器
+    using sorted_t = typename std::conditional<Multi, sorted_equivalent_t, sorted_unique_t>::type;
+
+    static constexpr size_type node_capacity = node::capacity; //每个结点的元素数上限
+
+    //构造函数
+    btree() : btree(Compare()) {}
+    explicit btree(const Compare &comp, const Alloc &alloc = Alloc()) : M_impl(leaf_alloc_type(alloc)), comp_(comp) {}
+    explicit btree(const Alloc &alloc) : btree(Compare(), alloc) {}
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    btree(InputIt first, InputIt last, const Compare &comp = Compare(), const Alloc &alloc = Alloc()) : btree(comp, alloc) {
+        insert(first, last);
+    }
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    btree(InputIt first, InputIt last, const Alloc &alloc) : btree(first, last, Compare(), alloc) {}
+    ///由已排好序的区间批量构造：元素逐个追加到最右叶结点，不做比较，结点几乎全满。
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    btree(sorted_t, InputIt first, InputIt last, const Compare &comp = Compare(), const Alloc &alloc = Alloc()) : btree(comp, alloc) {
+        insert(sorted_t(), first, last);
+    }
+    btree(std::initializer_list<value_type> init, const Compare &comp = Compare(), const Alloc &alloc = Alloc()) : btree(init.begin(), init.end(), comp, alloc) {}
+    btree(std::initializer_list<value_type> init, const Alloc &alloc) : btree(init.begin(), init.end(), Compare(), alloc) {}
+    btree(const btree &other) : btree(other, value_alloc_traits::select_on_container_copy_construction(other.get_allocator())) {}
+    btree(const btree &other, const Alloc &alloc); //按结点结构逐个复制，不做比较，也不分裂结点。
+    btree(btree &&other) noexcept;
+    btree(btree &&other, const Alloc &alloc);
+    ~btree() { clear(); }
+
+    btree &operator=(const btree &other);
+    btree &operator=(btree &&other) noexcept(leaf_alloc_traits::propagate_on_container_move_assignment::value || leaf_alloc_traits::is_always_equal::value);
+    btree &operator=(std::initializer_list<value_type> init);
+
+    allocator_type get_allocator() const noexcept { return allocator_type(static_cast<const leaf_alloc_type &>(M_impl)); }
+
+    //迭代器，按键升序遍历
+    iterator begin() noexcept { return iterator(M_impl.leftmost, 0); }
+    const_iterator begin() const noexcept { return const_iterator(M_impl.leftmost, 0); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(M_impl.rightmost, M_impl.rightmost ? M_impl.rightmost->count : 0); }
+    const_iterator end() const noexcept { return const_iterator(M_impl.rightmost, M_impl.rightmost ? M_impl.rightmost->count : 0); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    //容量
+    bool empty() const noexcept { return M_impl.size == 0; }
+    size_type size() const noexcept { return M_impl.size; }
+    size_type max_size() const noexcept { return static_cast<size_type>(std::numeric_limits<difference_type>::max()) / sizeof(Value); }
+    size_type height() const noexcept; //树的层数，空树为 0 。
+
+    //修改器
+    void clear() noexcept;
+    insert_return insert(const value_type &value) { return emplace(value); }
+    insert_return insert(value_type &&value) { return emplace(std::move(value)); }
+    template <typename P, typename = typename std::enable_if<std::is_constructible<value_type, P &&>::value>::type>
+    insert_return insert(P &&value) {
+        return emplace(std::forward<P>(value));
+    }
+    iterator insert(const_iterator hint, const value_type &value) { return emplace_hint(hint, value); }
+    iterator insert(const_iterator hint, value_type &&value) { return emplace_hint(hint, std::move(value)); }
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    void insert(InputIt first, InputIt last); //以 end() 为位置提示逐个插入，升序的输入不必从根结点查找。
+    void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    void insert(sorted_t, InputIt first, InputIt last); //区间已排好序且不小于已有的全部元素时逐个追加到末尾，不做比较。
+    template <typename... Args>
+    insert_return emplace(Args &&...args); //先构造元素再查找位置，键已存在时销毁新元素。
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args &&...args); //新元素恰好应位于 hint 之前时不从根结点查找。
+    iterator erase(const_iterator pos);                        //删除 pos 处的元素，返回其后继。
+    iterator erase(const_iterator first, const_iterator last); //删除 [first, last) 中的元素。
+    size_type erase(const key_type &key);
+    void swap(btree &other) noexcept;
+
+    //查找
+    size_type count(const key_type &key) const { return M_count(key); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    size_type count(const K &key) const {
+        return M_count(key);
+    }
+    iterator find(const key_type &key) { return M_mutable(M_find(key)); }
+    const_iterator find(const key_type &key) const { return M_find(key); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    iterator find(const K &key) {
+        return M_mutable(M_find(key));
+    }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    const_iterator find(const K &key) const {
+        return M_find(key);
+    }
+    bool contains(const key_type &key) const { return M_find(key) != end(); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    bool contains(const K &key) const {
+        return M_find(key) != end();
+    }
+    iterator lower_bound(const key_type &key) { return M_mutable(M_lower_bound(key)); }
+    const_iterator lower_bound(const key_type &key) const { return M_lower_bound(key); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    iterator lower_bound(const K &key) {
+        return M_mutable(M_lower_bound(key));
+    }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    const_iterator lower_bound(const K &key) const {
+        return M_lower_bound(key);
+    }
+    iterator upper_bound(const key_type &key) { return M_mutable(M_upper_bound(key)); }
+    const_iterator upper_bound(const key_type &key) const { return M_upper_bound(key); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    iterator upper_bound(const K &key) {
+        return M_mutable(M_upper_bound(key));
+    }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    const_iterator upper_bound(const K &key) const {
+        return M_upper_bound(key);
+    }
+    std::pair<iterator, iterator> equal_range(const key_type &key) { return {lower_bound(key), upper_bound(key)}; }
+    std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const { return {lower_bound(key), upper_bound(key)}; }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    std::pair<iterator, iterator> equal_range(const K &key) {
+        return {lower_bound(key), upper_bound(key)};
+    }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    std::pair<const_iterator, const_iterator> equal_range(const K &key) const {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    //观察器
+    key_compare key_comp() const { return comp_; }
+
+protected:
+    ///内嵌类，保存根结点与最左、最右叶结点。继承结点分配器以便空分配器不占用空间。
+    class impl : public leaf_alloc_type {
+    public:
+        node *root = nullptr;
+        node *leftmost = nullptr;
+        node *rightmost = nullptr;
+        size_type size = 0;
+
+        explicit impl(const leaf_alloc_type &alloc) noexcept : leaf_alloc_type(alloc) {}
+    };
+
+    impl M_impl;
+    Compare comp_;
+
+    static constexpr size_type min_values = node::capacity / 2; //非根结点删除后的最少元素数，低于它时合并或借入
+
+    static const Key &M_key(const Value &value) noexcept { return KeyOfValue()(value); }
+    static const Key &M_key(const node *n, size_type i) noexcept { return KeyOfValue()(n->slots[i].value); }
+    ///查找时读取结点中第 i 个键：有键的副本时读副本，不必访问元素所在的缓存行。
+    static const Key &M_node_key(const node *n, size_type i) noexcept { return M_node_key(n, i, key_cached()); }
+    static const Key &M_node_key(const node *n, size_type i, std::true_type) noexcept { return n->cache.keys[i]; }
+    static const Key &M_node_key(const node *n, size_type i, std::false_type) noexcept { return M_key(n, i); }
+    static iterator M_mutable(const_iterator it) noexcept { return iterator(it.node, it.position); }
+
+    node *M_new_leaf() { return ::new (static_cast<void *>(leaf_alloc_traits::allocate(M_impl, 1))) node(true); }
+    node *M_new_internal() {
+        internal_alloc_type alloc(M_impl);
+        return ::new (static_cast<void *>(internal_alloc_traits::allocate(alloc, 1))) internal_node();
+    }
+    void M_free_node(node *n) noexcept;
+    void M_destroy_tree(node *n) noexcept; //析构并归还以 n 为根的子树
+    node *M_copy_tree(const node *src, node *parent);
+    void M_reset_ends() noexcept; //按根结点重新确定最左、最右叶结点
+
+    template <typename... Args>
+    void M_construct(Value *p, Args &&...args) {
+        value_alloc_type alloc(M_impl);
+        value_alloc_traits::construct(alloc, p, std::forward<Args>(args)...);
+    }
+    void M_destroy(Value *p) noexcept {
+        value_alloc_type alloc(M_impl);
+        value_alloc_traits::destroy(alloc, p);
+    }
+
+    ///把 src 中从 first 起的 n 个元素搬到 dest 中 d_first 起的位置，两者可以是同一结点且区间重叠。键的副本一并搬动。
+    static void M_move_slots(node *dest, size_type d_first, node *src, size_type first, size_type n) noexcept {
+        M_relocate(src->slots + first, src->slots + first + n, dest->slots + d_first, is_trivially_relocatable<mutable_type>());
+        M_move_keys(dest, d_first, src, first, n, key_cached());
+    }
+    static void M_relocate(slot *first, slot *last, slot *dest, std::true_type) noexcept;
+    static void M_relocate(slot *first, slot *last, slot *dest, std::false_type) noexcept;
+    static void M_move_keys(node *dest, size_type d_first, node *src, size_type first, size_type n, std::true_type) noexcept {
+        std::memmove(dest->cache.keys + d_first, src->cache.keys + first, n * sizeof(Key));
+    }
+    static void M_move_keys(node *, size_type, node *, size_type, size_type, std::false_type) noexcept {}
+    static void M_set_key(node *n, size_type i, std::true_type) noexcept { n->cache.keys[i] = M_key(n, i); }
+    static void M_set_key(node *, size_type, std::false_type) noexcept {}
+    ///把 src 中从 first 起的 n 个子结点搬到 dest 中 d_first 起的位置，并更新它们的父结点与下标。
+    static void M_move_children(node *dest, size_type d_first, node *src, size_type first, size_type n) noexcept;
+
+    static const Key *M_keys(const node *n, std::true_type) noexcept { return n->cache.keys; }
+    static const Key *M_keys(const node *n, std::false_type) noexcept { return reinterpret_cast<const Key *>(n->slots); }
+    ///结点内第一个不小于 key 的元素的下标。
+    template <typename K>
+    size_type M_lower(const node *n, const K &key) const {
+        return M_lower(n, key, std::integral_constant<bool, simd_search::value && std::is_same<K, Key>::value>());
+    }
+    size_type M_lower(const node *n, const Key &key, std::true_type) const { return simd::count_less(M_keys(n, key_cached()), n->count, key); }
+    template <typename K>
+    size_type M_lower(const node *n, const K &key, std::false_type) const;
+    ///结点内第一个大于 key 的元素的下标。
+    template <typename K>
+    size_type M_upper(const node *n, const K &key) const {
+        return M_upper(n, key, std::integral_constant<bool, simd_search::value && std::is_same<K, Key>::value>());
+    }
+    size_type M_upper(const node *n, const Key &key, std::true_type) const {
+        return n->count - simd::count_greater(M_keys(n, key_cached()), n->count, key);
+    }
+    template <typename K>
+    size_type M_upper(const node *n, const K &key, std::false_type) const;
+
+    template <typename K>
+    const_iterator M_lower_bound(const K &key) const;
+    template <typename K>
+    const_iterator M_upper_bound(const K &key) const;
+    template <typename K>
+    const_iterator M_find(const K &key) const;
+    template <typename K>
+    size_type M_count(const K &key) const;
+
+    ///唯一键插入的位置：键已存在时返回 (该元素, false) ，否则返回 (叶结点中应插入的位置, true) 。空树返回 (nullptr, 0) 。
+    template <typename K>
+    std::pair<iterator, bool> M_locate_unique(const K &key);
+    ///可重复键插入的位置：叶结点中最后一个等价元素之后， upper 为 false 时为第一个等价元素之前。
+    template <typename K>
+    iterator M_locate_multi(const K &key, bool upper = true);
+    ///在 hint 之前插入时对应的叶结点位置。
+    iterator M_leaf_position(const_iterator hint) noexcept;
+    ///hint 是否恰好是新元素 value 的插入位置。
+    bool M_hint_fits(const_iterator hint, const Key &key) const;
+
+    ///在叶结点位置 pos 腾出一个空位，结点已满时先分裂。返回空位的位置，空位中没有元素。
+    iterator M_make_room(iterator pos);
+    ///分裂已满的结点 n ，为在 (n, i) 处插入做准备，(n, i) 随之更新为插入位置。父结点也满时先分裂父结点。
+    void M_split(node *&n, size_type &i);
+    ///把临时位置 tmp 中已构造的元素搬进叶结点位置 pos 。分配结点失败时 tmp 中的元素原样保留。
+    iterator M_insert_slot(iterator pos, slot &tmp);
+    ///在临时位置构造元素后插入。 Hinted 为 true 时先检查 hint 。
+    template <bool Hinted, typename... Args>
+    std::pair<iterator, bool> M_emplace(const_iterator hint, Args &&...args);
+    std::pair<iterator, bool> M_insert_tmp(const_iterator hint, bool hinted, slot &tmp, std::false_type);
+    std::pair<iterator, bool> M_insert_tmp(const_iterator hint, bool hinted, slot &tmp, std::true_type);
+    static iterator M_result(std::pair<iterator, bool> r, std::true_type) noexcept { return r.first; }
+    static std::pair<iterator, bool> M_result(std::pair<iterator, bool> r, std::false_type) noexcept { return r; }
+
+    ///按键查找，键不存在时才以 args 构造元素，唯一键容器的 try_emplace 使用。
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> M_emplace_key(const K &key, Args &&...args);
+    ///把元素追加到最右叶结点末尾。
+    template <typename... Args>
+    void M_append(Args &&...args);
+
+    ///删除后从叶结点 it 处向上合并或借入元素，返回调整后原位置的后继。
+    iterator M_rebalance_after_erase(iterator it) noexcept;
+    ///it 所在结点不足半满时与兄弟结点合并或借入元素，it 随之更新；发生合并时返回 true ，父结点需要继续检查。
+    bool M_merge_or_rebalance(iterator &it) noexcept;
+    void M_merge(node *left, node *right) noexcept;                        //把 right 与分隔元素并入左兄弟 left
+    void M_shift_left(node *n, node *right, size_type to_move) noexcept;  //从右兄弟 right 借入 to_move 个元素
+    void M_shift_right(node *left, node *n, size_type to_move) noexcept;  //从左兄弟 left 借入 to_move 个元素
+    void M_try_shrink() noexcept;                                          //根结点为空时降低一层
+
+    void M_take(btree &other) noexcept; //接管 other 的全部结点，调用者保证 *this 为空
+    void M_move_assign(btree &other, std::true_type) noexcept;
+    void M_move_assign(btree &other, std::false_type);
+};
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+btree<V, K, KoV, C, A, M>::btree(const btree &other, const A &alloc) : M_impl(leaf_alloc_type(alloc)), comp_(other.comp_) {
+    if (other.M_impl.root) {
+        M_impl.root = M_copy_tree(other.M_impl.root, nullptr);
+        M_reset_ends();
+        M_impl.size = other.M_impl.size;
+    }
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+btree<V, K, KoV, C, A, M>::btree(btree &&other) noexcept : M_impl(static_cast<leaf_alloc_type &>(other.M_impl)), comp_(other.comp_) {
+    M_take(other);
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+btree<V, K, KoV, C, A, M>::btree(btree &&other, const A &alloc) : M_impl(leaf_alloc_type(alloc)), comp_(other.comp_) {
+    if (static_cast<leaf_alloc_type &>(M_impl) == static_cast<leaf_alloc_type &>(other.M_impl)) {
+        M_take(other);
+    } else {
+        for (auto &i : other) {
+            M_append(std::move(const_cast<mutable_type &>(reinterpret_cast<const mutable_type &>(i))));
+        }
+        other.clear();
+    }
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+btree<V, K, KoV, C, A, M> &btree<V, K, KoV, C, A, M>::operator=(const btree &other) {
+    if (this == &other) {
+        return *this;
+    }
+    clear();
+    alloc_on_copy(static_cast<leaf_alloc_type &>(M_impl), static_cast<const leaf_alloc_type &>(other.M_impl),
+                  typename leaf_alloc_traits::propagate_on_container_copy_assignment());
+    comp_ = other.comp_;
+    if (other.M_impl.root) {
+        M_impl.root = M_copy_tree(other.M_impl.root, nullptr);
+        M_reset_ends();
+        M_impl.size = other.M_impl.size;
+    }
+    return *this;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+btree<V, K, KoV, C, A, M> &btree<V, K, KoV, C, A, M>::operator=(btree &&other) noexcept(leaf_alloc_traits::propagate_on_container_move_assignment::value ||
+                                                                                        leaf_alloc_traits::is_always_equal::value) {
+    if (this != &other) {
+        M_move_assign(other, std::integral_constant<bool, leaf_alloc_traits::propagate_on_container_move_assignment::value ||
+                                                              leaf_alloc_traits::is_always_equal::value>());
+    }
+    return *this;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+btree<V, K, KoV, C, A, M> &btree<V, K, KoV, C, A, M>::operator=(std::initializer_list<value_type> init) {
+    clear();
+    insert(init.begin(), init.end());
+    return *this;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_take(btree &other) noexcept {
+    M_impl.root = other.M_impl.root;
+    M_impl.leftmost = other.M_impl.leftmost;
+    M_impl.rightmost = other.M_impl.rightmost;
+    M_impl.size = other.M_impl.size;
+    other.M_impl.root = other.M_impl.leftmost = other.M_impl.rightmost = nullptr;
+    other.M_impl.size = 0;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_move_assign(btree &other, std::true_type) noexcept {
+    clear();
+    alloc_on_move(static_cast<leaf_alloc_type &>(M_impl), static_cast<leaf_alloc_type &>(other.M_impl),
+                  typename leaf_alloc_traits::propagate_on_container_move_assignment());
+    comp_ = other.comp_;
+    M_take(other);
+}
+
+//分配器不传播且不相等时，元素逐个移动到本容器的结点中，按序追加，不做比较。
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_move_assign(btree &other, std::false_type) {
+    if (static_cast<leaf_alloc_type &>(M_impl) == static_cast<leaf_alloc_type &>(other.M_impl)) {
+        M_move_assign(other, std::true_type());
+        return;
+    }
+    clear();
+    comp_ = other.comp_;
+    for (auto &i : other) {
+        M_append(std::move(const_cast<mutable_type &>(reinterpret_cast<const mutable_type &>(i))));
+    }
+    other.clear();
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::swap(btree &other) noexcept {
+    std::swap(M_impl.root, other.M_impl.root);
+    std::swap(M_impl.leftmost, other.M_impl.leftmost);
+    std::swap(M_impl.rightmost, other.M_impl.rightmost);
+    std::swap(M_impl.size, other.M_impl.size);
+    std::swap(comp_, other.comp_);
+    alloc_on_swap(static_cast<leaf_alloc_type &>(M_impl), static_cast<leaf_alloc_type &>(other.M_impl), typename leaf_alloc_traits::propagate_on_container_swap());
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+typename btree<V, K, KoV, C, A, M>::size_type btree<V, K, KoV, C, A, M>::height() const noexcept {
+    size_type h = 0;
+    for (auto n = M_impl.root; n; n = n->leaf ? nullptr : n->child(0)) {
+        ++h;
+    }
+    return h;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_free_node(node *n) noexcept {
+    if (n->leaf) {
+        n->~node();
+        leaf_alloc_traits::deallocate(M_impl, n, 1);
+    } else {
+        auto p = static_cast<internal_node *>(n);
+        p->~internal_node();
+        internal_alloc_type alloc(M_impl);
+        internal_alloc_traits::deallocate(alloc, p, 1);
+    }
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_destroy_tree(node *n) noexcept {
+    if (!n->leaf) {
+        for (size_type i = 0; i <= n->count; ++i) {
+            M_destroy_tree(n->child(i));
+        }
+    }
+    for (size_type i = 0; i < n->count; ++i) {
+        M_destroy(&n->slots[i].value);
+    }
+    M_free_node(n);
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::clear() noexcept {
+    if (M_impl.root) {
+        M_destroy_tree(M_impl.root);
+    }
+    M_impl.root = M_impl.leftmost = M_impl.rightmost = nullptr;
+    M_impl.size = 0;
+}
+
+//先复制子树 0 ，再交替复制元素 i 与子树 i + 1 。中途抛出异常时析构本结点已复制的部分再重新抛出。
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+typename btree<V, K, KoV, C, A, M>::node *btree<V, K, KoV, C, A, M>::M_copy_tree(const node *src, node *parent) {
+    auto n = src->leaf ? M_new_leaf() : M_new_internal();
+    n->parent = parent;
+    n->position = src->position;
+    size_type children = 0;
+    try {
+        if (!src->leaf) {
+            n->child(0) = M_copy_tree(src->child(0), n);
+            children = 1;
+        }
+        for (size_type i = 0; i < src->count; ++i) {
+            M_construct(&n->slots[i].value, src->slots[i].value);
+            M_set_key(n, i, key_cached());
+            ++n->count;
+            if (!src->leaf) {
+                n->child(i + 1) = M_copy_tree(src->child(i + 1), n);
+                ++children;
+            }
+        }
+    } catch (...) {
+        for (size_type i = 0; i < children; ++i) {
+            M_destroy_tree(n->child(i));
+        }
+        for (size_type i = 0; i < n->count; ++i) {
+            M_destroy(&n->slots[i].value);
+        }
+        M_free_node(n);
+        throw;
+    }
+    return n;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_reset_ends() noexcept {
+    auto n = M_impl.root;
+    while (!n->leaf) {
+        n = n->child(0);
+    }
+    M_impl.leftmost = n;
+    n = M_impl.root;
+    while (!n->leaf) {
+        n = n->child(n->count);
+    }
+    M_impl.rightmost = n;
+}
+
+//可平凡重定位类型整段 memmove 。
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_relocate(slot *first, slot *last, slot *dest, std::true_type) noexcept {
+    if (first != last) {
+        std::memmove(static_cast<void *>(dest), static_cast<const void *>(first), (last - first) * sizeof(slot));
+    }
+}
+
+//其他类型通过可修改版本逐个移动构造并析构原对象。后移时从后往前，前移时从前往后。
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_relocate(slot *first, slot *last, slot *dest, std::false_type) noexcept {
+    if (dest == first) {
+        return;
+    }
+    if (dest > first) {
+        auto dest_last = dest + (last - first);
+        while (last != first) {
+            --last;
+            --dest_last;
+            ::new (static_cast<void *>(&dest_last->mutable_value)) mutable_type(std::move(last->mutable_value));
+            last->mutable_value.~mutable_type();
+        }
+    } else {
+        for (; first != last; ++first, ++dest) {
+            ::new (static_cast<void *>(&dest->mutable_value)) mutable_type(std::move(first->mutable_value));
+            first->mutable_value.~mutable_type();
+        }
+    }
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_move_children(node *dest, size_type d_first, node *src, size_type first, size_type n) noexcept {
+    if (n == 0) {
+        return;
+    }
+    std::memmove(&dest->child(d_first), &src->child(first), n * sizeof(node *));
+    for (auto i = d_first; i < d_first + n; ++i) {
+        dest->child(i)->parent = dest;
+        dest->child(i)->position = static_cast<uint16_t>(i);
+    }
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename Key2>
+typename btree<V, K, KoV, C, A, M>::size_type btree<V, K, KoV, C, A, M>::M_lower(const node *n, const Key2 &key, std::false_type) const {
+    size_type lo = 0;
+    size_type hi = n->count;
+    while (lo < hi) {
+        auto mid = (lo + hi) / 2;
+        if (comp_(M_key(n, mid), key)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename Key2>
+typename btree<V, K, KoV, C, A, M>::size_type btree<V, K, KoV, C, A, M>::M_upper(const node *n, const Key2 &key, std::false_type) const {
+    size_type lo = 0;
+    size_type hi = n->count;
+    while (lo < hi) {
+        auto mid = (lo + hi) / 2;
+        if (comp_(key, M_key(n, mid))) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+//每层记下结点内第一个不小于 key 的元素作为候选，再进入它左侧的子树；越往下候选越小。
+//唯一键容器在内部结点遇到等价的键即可返回。
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename Key2>
+typename btree<V, K, KoV, C, A, M>::const_iterator btree<V, K, KoV, C, A, M>::M_lower_bound(const Key2 &key) const {
+    auto result = end();
+    auto n = M_impl.root;
+    while (n) {
+        auto i = M_lower(n, key);
+        if (i < n->count) {
+            result = const_iterator(n, i);
+            if (!M && !comp_(key, M_node_key(n, i))) {
+                return result;
+            }
+        }
+        if (n->leaf) {
+            break;
+        }
+        n = n->child(i);
+    }
+    return result;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename Key2>
+typename btree<V, K, KoV, C, A, M>::const_iterator btree<V, K, KoV, C, A, M>::M_upper_bound(const Key2 &key) const {
+    auto result = end();
+    auto n = M_impl.root;
+    while (n) {
+        auto i = M_upper(n, key);
+        if (i < n->count) {
+            result = const_iterator(n, i);
+        }
+        if (n->leaf) {
+            break;
+        }
+        n = n->child(i);
+    }
+    return result;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename Key2>
+typename btree<V, K, KoV, C, A, M>::const_iterator btree<V, K, KoV, C, A, M>::M_find(const Key2 &key) const {
+    auto it = M_lower_bound(key);
+    return it != end() && !comp_(key, M_node_key(it.node, it.position)) ? it : end();
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename Key2>
+typename btree<V, K, KoV, C, A, M>::size_type btree<V, K, KoV, C, A, M>::M_count(const Key2 &key) const {
+    if (!M) {
+        return M_find(key) != end();
+    }
+    size_type n = 0;
+    for (auto first = M_lower_bound(key), last = M_upper_bound(key); first != last; ++first) {
+        ++n;
+    }
+    return n;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename Key2>
+std::pair<typename btree<V, K, KoV, C, A, M>::iterator, bool> btree<V, K, KoV, C, A, M>::M_locate_unique(const Key2 &key) {
+    auto n = M_impl.root;
+    if (!n) {
+        return {iterator(), true};
+    }
+    for (;;) {
+        auto i = M_lower(n, key);
+        if (i < n->count && !comp_(key, M_node_key(n, i))) {
+            return {iterator(n, i), false};
+        }
+        if (n->leaf) {
+            return {iterator(n, i), true};
+        }
+        n = n->child(i);
+    }
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename Key2>
+typename btree<V, K, KoV, C, A, M>::iterator btree<V, K, KoV, C, A, M>::M_locate_multi(const Key2 &key, bool upper) {
+    auto n = M_impl.root;
+    if (!n) {
+        return iterator();
+    }
+    for (;;) {
+        auto i = upper ? M_upper(n, key) : M_lower(n, key);
+        if (n->leaf) {
+            return iterator(n, i);
+        }
+        n = n->child(i);
+    }
+}
+
+//在内部结点元素 i 之前插入，即在子树 i 的最后一个元素之后插入。
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+typename btree<V, K, KoV, C, A, M>::iterator btree<V, K, KoV, C, A, M>::M_leaf_position(const_iterator hint) noexcept {
+    auto n = hint.node;
+    if (!n || n->leaf) {
+        return iterator(n, hint.position);
+    }
+    n = n->child(hint.position);
+    while (!n->leaf) {
+        n = n->child(n->count);
+    }
+    return iterator(n, n->count);
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+bool btree<V, K, KoV, C, A, M>::M_hint_fits(const_iterator hint, const K &key) const {
+    if (!M_impl.root) {
+        return true;
+    }
+    if (M) {
+        return (hint == begin() || !comp_(key, M_key(*std::prev(hint)))) && (hint == end() || !comp_(M_key(*hint), key));
+    }
+    return (hint == begin() || comp_(M_key(*std::prev(hint)), key)) && (hint == end() || comp_(key, M_key(*hint)));
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+typename btree<V, K, KoV, C, A, M>::iterator btree<V, K, KoV, C, A, M>::M_make_room(iterator pos) {
+    auto n = pos.node;
+    auto i = pos.position;
+    if (n->count == node::capacity) {
+        M_split(n, i);
+    }
+    M_move_slots(n, i + 1, n, i, n->count - i);
+    ++n->count;
+    return iterator(n, i);
+}
+
+//右结点分得 r 个元素：在结点开头插入时留一个给左结点，在末尾插入时右结点为空，新元素随后放入；
+//其余情况对半分。中间元素上移到父结点，位于两个结点之间。
+//所有分配都在改动树之前完成，分配失败时树保持原样。
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_split(node *&n, size_type &i) {
+    const size_type cap = node::capacity;
+    const size_type r = i == 0 ? cap - 1 : i == cap ? 0 : cap / 2;
+    auto right = n->leaf ? M_new_leaf() : M_new_internal();
+    auto parent = n->parent;
+    size_type p = n->position;
+    try {
+        if (!parent) {
+            parent = M_new_internal();
+            parent->child(0) = n;
+            n->parent = parent;
+            n->position = 0;
+            M_impl.root = parent;
+        } else if (parent->count == cap) {
+            M_split(parent, p);
+        }
+    } catch (...) {
+        M_free_node(right);
+        throw;
+    }
+    const size_type left = cap - r - 1; //分裂后左结点的元素数，下标 left 处的元素上移
+    M_move_slots(right, 0, n, cap - r, r);
+    if (!n->leaf) {
+        M_move_children(right, 0, n, cap - r, r + 1);
+    }
+    right->count = static_cast<uint16_t>(r);
+    n->count = static_cast<uint16_t>(left);
+    M_move_slots(parent, p + 1, parent, p, parent->count - p);
+    M_move_children(parent, p + 2, parent, p + 1, parent->count - p);
+    M_move_slots(parent, p, n, left, 1);
+    parent->child(p + 1) = right;
+    right->parent = parent;
+    right->position = static_cast<uint16_t>(p + 1);
+    ++parent->count;
+    if (n == M_impl.rightmost) {
+        M_impl.rightmost = right;
+    }
+    if (i > left) {
+        n = right;
+        i -= left + 1;
+    }
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+typename btree<V, K, KoV, C, A, M>::iterator btree<V, K, KoV, C, A, M>::M_insert_slot(iterator pos, slot &tmp) {
+    if (!M_impl.root) {
+        M_impl.root = M_impl.leftmost = M_impl.rightmost = M_new_leaf();
+        pos = iterator(M_impl.root, 0);
+    }
+    pos = M_make_room(pos);
+    M_relocate(&tmp, &tmp + 1, pos.node->slots + pos.position, is_trivially_relocatable<mutable_type>());
+    M_set_key(pos.node, pos.position, key_cached());
+    ++M_impl.size;
+    return pos;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <bool Hinted, typename... Args>
+std::pair<typename btree<V, K, KoV, C, A, M>::iterator, bool> btree<V, K, KoV, C, A, M>::M_emplace(const_iterator hint, Args &&...args) {
+    slot tmp;
+    M_construct(&tmp.value, std::forward<Args>(args)...);
+    try {
+        return M_insert_tmp(hint, Hinted, tmp, std::integral_constant<bool, M>());
+    } catch (...) {
+        M_destroy(&tmp.value);
+        throw;
+    }
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+std::pair<typename btree<V, K, KoV, C, A, M>::iterator, bool> btree<V, K, KoV, C, A, M>::M_insert_tmp(const_iterator hint, bool hinted, slot &tmp,
+                                                                                                          std::false_type) {
+    const auto &key = M_key(tmp.value);
+    if (hinted && M_hint_fits(hint, key)) {
+        return {M_insert_slot(M_leaf_position(hint), tmp), true};
+    }
+    auto pos = M_locate_unique(key);
+    if (!pos.second) {
+        M_destroy(&tmp.value);
+        return pos;
+    }
+    return {M_insert_slot(pos.first, tmp), true};
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+std::pair<typename btree<V, K, KoV, C, A, M>::iterator, bool> btree<V, K, KoV, C, A, M>::M_insert_tmp(const_iterator hint, bool hinted, slot &tmp,
+                                                                                                          std::true_type) {
+    const auto &key = M_key(tmp.value);
+    if (hinted && M_hint_fits(hint, key)) {
+        return {M_insert_slot(M_leaf_position(hint), tmp), true};
+    }
+    //hint 不合适时插入到离 hint 最近的位置：hint 在等价区间之前时插在区间开头，否则插在末尾。
+    auto upper = !hinted || hint == end() || !comp_(M_key(*hint), key);
+    return {M_insert_slot(M_locate_multi(key, upper), tmp), true};
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename... Args>
+typename btree<V, K, KoV, C, A, M>::insert_return btree<V, K, KoV, C, A, M>::emplace(Args &&...args) {
+    return M_result(M_emplace<false>(const_iterator(), std::forward<Args>(args)...), std::integral_constant<bool, M>());
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename... Args>
+typename btree<V, K, KoV, C, A, M>::iterator btree<V, K, KoV, C, A, M>::emplace_hint(const_iterator hint, Args &&...args) {
+    return M_emplace<true>(hint, std::forward<Args>(args)...).first;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename Key2, typename... Args>
+std::pair<typename btree<V, K, KoV, C, A, M>::iterator, bool> btree<V, K, KoV, C, A, M>::M_emplace_key(const Key2 &key, Args &&...args) {
+    auto pos = M_locate_unique(key);
+    if (!pos.second) {
+        return pos;
+    }
+    slot tmp;
+    M_construct(&tmp.value, std::forward<Args>(args)...);
+    try {
+        return {M_insert_slot(pos.first, tmp), true};
+    } catch (...) {
+        M_destroy(&tmp.value);
+        throw;
+    }
+}
+
+//最右叶结点未满时直接在末尾构造，否则经临时位置插入并分裂。
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename... Args>
+void btree<V, K, KoV, C, A, M>::M_append(Args &&...args) {
+    auto n = M_impl.rightmost;
+    if (n && n->count < node::capacity) {
+        M_construct(&n->slots[n->count].value, std::forward<Args>(args)...);
+        M_set_key(n, n->count, key_cached());
+        ++n->count;
+        ++M_impl.size;
+        return;
+    }
+    slot tmp;
+    M_construct(&tmp.value, std::forward<Args>(args)...);
+    try {
+        M_insert_slot(end(), tmp);
+    } catch (...) {
+        M_destroy(&tmp.value);
+        throw;
+    }
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename InputIt, typename>
+void btree<V, K, KoV, C, A, M>::insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+        emplace_hint(end(), *first);
+    }
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+template <typename InputIt, typename>
+void btree<V, K, KoV, C, A, M>::insert(sorted_t, InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+        M_append(*first);
+    }
+}
+
+//内部结点中的元素由其前驱（某个叶结点的最后一个元素）顶替，删除总是发生在叶结点。
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+typename btree<V, K, KoV, C, A, M>::iterator btree<V, K, KoV, C, A, M>::erase(const_iterator pos) {
+    auto it = M_mutable(pos);
+    const bool internal = !it.node->leaf;
+    if (internal) {
+        auto inner = it;
+        --it;
+        M_destroy(&inner.node->slots[inner.position].value);
+        M_move_slots(inner.node, inner.position, it.node, it.position, 1);
+    } else {
+        M_destroy(&it.node->slots[it.position].value);
+        M_move_slots(it.node, it.position, it.node, it.position + 1, it.node->count - it.position - 1);
+    }
+    --it.node->count;
+    --M_impl.size;
+    it = M_rebalance_after_erase(it);
+    if (internal) {
+        ++it;
+    }
+    return it;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+typename btree<V, K, KoV, C, A, M>::iterator btree<V, K, KoV, C, A, M>::erase(const_iterator first, const_iterator last) {
+    if (first == begin() && last == end()) {
+        clear();
+        return end();
+    }
+    auto n = std::distance(first, last);
+    auto it = M_mutable(first);
+    while (n--) {
+        it = erase(it);
+    }
+    return it;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+typename btree<V, K, KoV, C, A, M>::size_type btree<V, K, KoV, C, A, M>::erase(const key_type &key) {
+    if (!M) {
+        auto it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+    auto range = equal_range(key);
+    auto n = static_cast<size_type>(std::distance(range.first, range.second));
+    erase(range.first, range.second);
+    return n;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+typename btree<V, K, KoV, C, A, M>::iterator btree<V, K, KoV, C, A, M>::M_rebalance_after_erase(iterator it) noexcept {
+    auto result = it;
+    bool first = true;
+    for (;;) {
+        if (it.node == M_impl.root) {
+            M_try_shrink();
+            if (empty()) {
+                return end();
+            }
+            break;
+        }
+        if (it.node->count >= min_values) {
+            break;
+        }
+        bool merged = M_merge_or_rebalance(it);
+        if (first) {
+            result = it;
+            first = false;
+        }
+        if (!merged) {
+            break;
+        }
+        it.position = it.node->position;
+        it.node = it.node->parent;
+    }
+    //删除的是结点的最后一个元素时，后继在别的结点中。
+    if (result.position == result.node->count) {
+        result.position = result.node->count - 1;
+        ++result;
+    }
+    return result;
+}
+
+//依次尝试与左兄弟合并、与右兄弟合并、从右兄弟借入、从左兄弟借入。
+//在结点开头删除时不从右兄弟借、在末尾删除时不从左兄弟借，连续从一端删除时不必反复搬动元素。
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+bool btree<V, K, KoV, C, A, M>::M_merge_or_rebalance(iterator &it) noexcept {
+    auto parent = it.node->parent;
+    if (it.node->position > 0) {
+        auto left = parent->child(it.node->position - 1);
+        if (1u + left->count + it.node->count <= node::capacity) {
+            it.position += 1 + left->count;
+            M_merge(left, it.node);
+            it.node = left;
+            return true;
+        }
+    }
+    if (it.node->position < parent->count) {
+        auto right = parent->child(it.node->position + 1);
+        if (1u + it.node->count + right->count <= node::capacity) {
+            M_merge(it.node, right);
+            return true;
+        }
+        if (right->count > min_values && (it.node->count == 0 || it.position > 0)) {
+            size_type to_move = (right->count - it.node->count) / 2;
+            M_shift_left(it.node, right, std::min<size_type>(to_move, right->count - 1));
+            return false;
+        }
+    }
+    if (it.node->position > 0) {
+        auto left = parent->child(it.node->position - 1);
+        if (left->count > min_values && (it.node->count == 0 || it.position < it.node->count)) {
+            size_type to_move = std::min<size_type>((left->count - it.node->count) / 2, left->count - 1);
+            M_shift_right(left, it.node, to_move);
+            it.position += to_move;
+        }
+    }
+    return false;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_merge(node *left, node *right) noexcept {
+    auto parent = left->parent;
+    size_type p = left->position;
+    M_move_slots(left, left->count, parent, p, 1);
+    M_move_slots(left, left->count + 1, right, 0, right->count);
+    if (!left->leaf) {
+        M_move_children(left, left->count + 1, right, 0, right->count + 1);
+    }
+    left->count = static_cast<uint16_t>(left->count + 1 + right->count);
+    M_move_slots(parent, p, parent, p + 1, parent->count - p - 1);
+    M_move_children(parent, p + 1, parent, p + 2, parent->count - p - 1);
+    --parent->count;
+    if (M_impl.rightmost == right) {
+        M_impl.rightmost = left;
+    }
+    M_free_node(right);
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_shift_left(node *n, node *right, size_type to_move) noexcept {
+    auto parent = n->parent;
+    size_type p = n->position;
+    M_move_slots(n, n->count, parent, p, 1);
+    M_move_slots(n, n->count + 1, right, 0, to_move - 1);
+    M_move_slots(parent, p, right, to_move - 1, 1);
+    M_move_slots(right, 0, right, to_move, right->count - to_move);
+    if (!n->leaf) {
+        M_move_children(n, n->count + 1, right, 0, to_move);
+        M_move_children(right, 0, right, to_move, right->count - to_move + 1);
+    }
+    n->count = static_cast<uint16_t>(n->count + to_move);
+    right->count = static_cast<uint16_t>(right->count - to_move);
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_shift_right(node *left, node *n, size_type to_move) noexcept {
+    auto parent = n->parent;
+    size_type p = left->position;
+    M_move_slots(n, to_move, n, 0, n->count);
+    M_move_slots(n, to_move - 1, parent, p, 1);
+    M_move_slots(n, 0, left, left->count - to_move + 1, to_move - 1);
+    M_move_slots(parent, p, left, left->count - to_move, 1);
+    if (!n->leaf) {
+        M_move_children(n, to_move, n, 0, n->count + 1);
+        M_move_children(n, 0, left, left->count - to_move + 1, to_move);
+    }
+    left->count = static_cast<uint16_t>(left->count - to_move);
+    n->count = static_cast<uint16_t>(n->count + to_move);
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+void btree<V, K, KoV, C, A, M>::M_try_shrink() noexcept {
+    auto old = M_impl.root;
+    if (old->count > 0) {
+        return;
+    }
+    if (old->leaf) {
+        M_impl.root = M_impl.leftmost = M_impl.rightmost = nullptr;
+    } else {
+        auto child = old->child(0);
+        child->parent = nullptr;
+        child->position = 0;
+        M_impl.root = child;
+    }
+    M_free_node(old);
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+bool operator==(const btree<V, K, KoV, C, A, M> &lhs, const btree<V, K, KoV, C, A, M> &rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+bool operator!=(const btree<V, K, KoV, C, A, M> &lhs, const btree<V, K, KoV, C, A, M> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+bool operator<(const btree<V, K, KoV, C, A, M> &lhs, const btree<V, K, KoV, C, A, M> &rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+bool operator>(const btree<V, K, KoV, C, A, M> &lhs, const btree<V, K, KoV, C, A, M> &rhs) {
+    return rhs < lhs;
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+bool operator<=(const btree<V, K, KoV, C, A, M> &lhs, const btree<V, K, KoV, C, A, M> &rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename V, typename K, typename KoV, typename C, typename A, bool M>
+bool operator>=(const btree<V, K, KoV, C, A, M> &lhs, const btree<V, K, KoV, C, A, M> &rhs) {
+    return !(lhs < rhs);
+}
+} // namespace mystl
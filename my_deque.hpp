@@ -0,0 +1,842 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_memory.hpp"
+#include "my_memory_resource.hpp"
+#include "my_vector.hpp"
+
+namespace mystl {
+template <typename T, typename Ref, typename Ptr>
+class deque_iterator;
+
+template <typename T, typename Alloc = allocator<T>>
+class deque;
+
+///每块可容纳的元素数：一块约 4096 字节，元素较大时至少 16 个。
+template <typename T>
+struct deque_block_capacity {
+    static constexpr size_t value = sizeof(T) <= 4096 / 16 ? 4096 / sizeof(T) : 16;
+};
+
+//迭代器保存元素指针、所在块的起始地址与该块在块表中的位置。块内移动只比较本地的块起点，不读块表；越过块边界时经块表换到相邻块。
+//容器保证尾后位置所在的块总是已分配，因此从最后一个元素前进到 end() 不会读到无效的块指针。
+template <typename T, typename Ref, typename Ptr>
+class deque_iterator {
+public:
+    using self = deque_iterator<T, Ref, Ptr>;
+    using iterator = deque_iterator<T, T &, T *>;
+    using const_iterator = deque_iterator<T, const T &, const T *>;
+    using value_type = T;
+    using pointer = Ptr;
+    using reference = Ref;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::random_access_iterator_tag;
+
+    static constexpr difference_type block_capacity = deque_block_capacity<T>::value;
+
+    template <typename, typename>
+    friend class deque;
+    template <typename, typename, typename>
+    friend class deque_iterator;
+
+protected:
+    T *cur = nullptr;   //指向的元素
+    T *first = nullptr; //所在块的起始地址
+    T **node = nullptr; //所在块在块表中的位置
+
+    void M_set_node(T **_node) noexcept {
+        node = _node;
+        first = *_node;
+    }
+
+public:
+    deque_iterator() = default;
+    deque_iterator(T *_cur, T **_node) noexcept : cur(_cur), first(*_node), node(_node) {}
+    ///iterator 可隐式转换为 const_iterator 。
+    template <typename Iter, typename = typename std::enable_if<std::is_same<Iter, iterator>::value && !std::is_same<Iter, self>::value>::type>
+    deque_iterator(const Iter &other) noexcept : cur(other.cur), first(other.first), node(other.node) {}
+
+    friend bool operator==(const self &lhs, const self &rhs) noexcept { return lhs.cur == rhs.cur; }
+    friend bool operator!=(const self &lhs, const self &rhs) noexcept { return lhs.cur != rhs.cur; }
+    friend bool operator<(const self &lhs, const self &rhs) noexcept { return lhs.node == rhs.node ? lhs.cur < rhs.cur : lhs.node < rhs.node; }
+    friend bool operator>(const self &lhs, const self &rhs) noexcept { return rhs < lhs; }
+    friend bool operator<=(const self &lhs, const self &rhs) noexcept { return !(rhs < lhs); }
+    friend bool operator>=(const self &lhs, const self &rhs) noexcept { return !(lhs < rhs); }
+
+    ///两迭代器之间的距离。
+    friend difference_type operator-(const self &lhs, const self &rhs) noexcept {
+        return (lhs.node - rhs.node) * block_capacity + (lhs.cur - lhs.first) - (rhs.cur - rhs.first);
+    }
+
+    reference operator*() const noexcept { return *cur; }
+    pointer operator->() const noexcept { return cur; }
+
+    self &operator++() noexcept {
+        if (++cur == first + block_capacity) {
+            M_set_node(node + 1);
+            cur = first;
+        }
+        return *this;
+    }
+
+    self operator++(int) noexcept {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    self &operator--() noexcept {
+        if (cur == first) {
+            M_set_node(node - 1);
+            cur = first + block_capacity;
+        }
+        --cur;
+        return *this;
+    }
+
+    self operator--(int) noexcept {
+        auto temp = *this;
+        --*this;
+        return temp;
+    }
+
+    self &operator+=(difference_type n) noexcept {
+        auto offset = n + (cur - first);
+        if (offset >= 0 && offset < block_capacity) {
+            cur += n;
+        } else {
+            auto node_offset = offset > 0 ? offset / block_capacity : -((-offset - 1) / block_capacity) - 1;
+            M_set_node(node + node_offset);
+            cur = first + (offset - node_offset * block_capacity);
+        }
+        return *this;
+    }
+
+    self &operator-=(difference_type n) noexcept { return *this += -n; }
+
+    self operator+(difference_type n) const noexcept {
+        auto temp = *this;
+        return temp += n;
+    }
+    friend self operator+(difference_type n, const self &it) noexcept { return it + n; }
+
+    self operator-(difference_type n) const noexcept {
+        auto temp = *this;
+        return temp -= n;
+    }
+
+    reference operator[](difference_type n) const noexcept { return *(*this + n); }
+};
+
+///双端队列：元素存放在固定大小的块中，块指针集中在一张块表里，块表本身是一个 mystl::vector 。
+///两端的 push/pop 均摊 O(1) ：块内有空位时只构造一个元素，块用完时申请或复用一块并在块表中登记，块表两端用尽时居中或加倍。
+///元素从不搬动，因此两端插入不使任何引用失效（块表变化时迭代器失效）；中间插入与删除移动较近一端的元素。
+///两端弹出后空出的块挂在容器内的空闲链表上，之后的插入优先复用，直到 shrink_to_fit 或析构时才归还分配器。
+template <typename T, typename Alloc>
+class deque {
+    using T_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    using T_alloc_traits = std::allocator_traits<T_alloc_type>;
+    using map_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<T *>;
+    using map_type = vector<T *, map_alloc_type>;
+
+    static_assert(std::is_same<typename T_alloc_traits::pointer, T *>::value, "deque requires an allocator whose pointer type is T *");
+
+public:
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = deque_iterator<T, T &, T *>;
+    using const_iterator = deque_iterator<T, const T &, const T *>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using allocator_type = Alloc;
+
+    static constexpr size_type block_capacity = deque_block_capacity<T>::value; //每块可容纳的元素数。
+
+    //构造函数
+    deque() : deque(Alloc()) {}                                              //构造空容器。不申请任何内存。
+    explicit deque(const Alloc &alloc) : M_impl(T_alloc_type(alloc)) {}      //构造拥有给定分配器 alloc 的空容器。
+    deque(size_type count, const T &value, const Alloc &alloc = Alloc());    //构造拥有 count 个有值 value 的元素的容器。
+    explicit deque(size_type count, const Alloc &alloc = Alloc());           //构造拥有 count 个默认插入的 T 实例的容器。
+    template <typename InputIt, typename = RequireInputIter<InputIt>>        //
+    deque(InputIt first, InputIt last, const Alloc &alloc = Alloc());        //构造拥有范围 [first, last) 内容的容器。
+    deque(const deque &other);                                               //复制构造函数。块内偏移与 other 相同，逐块复制。
+    deque(deque &&other) noexcept;                                           //移动构造函数。接管 other 的块表与全部块。
+    deque(std::initializer_list<T> init, const Alloc &alloc = Alloc());      //构造拥有 initializer_list init 内容的容器。
+    ~deque() { M_destroy_all(); }
+
+    deque &operator=(const deque &other);         //复制赋值运算符。
+    deque &operator=(deque &&other) noexcept(T_alloc_traits::propagate_on_container_move_assignment::value || T_alloc_traits::is_always_equal::value); //移动赋值运算符。分配器不随之转移且不相等时逐个移动元素，可能抛出异常。
+    deque &operator=(std::initializer_list<T> ilist); //以 initializer_list ilist 所标识者替换内容。
+
+    allocator_type get_allocator() const noexcept { return allocator_type(M_get_allocator()); } //返回与容器关联的分配器。
+
+    void assign(size_type count, const T &value);                     //以 count 份 value 的副本替换内容。
+    template <typename InputIt, typename = RequireInputIter<InputIt>> //
+    void assign(InputIt first, InputIt last);                         //以范围 [first, last) 中元素的副本替换内容。
+    void assign(std::initializer_list<T> ilist) { assign(ilist.begin(), ilist.end()); }
+
+    //元素访问
+    reference at(size_type pos);             //有边界检查。 pos 不在容器范围内时抛出 std::out_of_range 。
+    const_reference at(size_type pos) const; //有边界检查。 pos 不在容器范围内时抛出 std::out_of_range 。
+    reference operator[](size_type pos) noexcept { return *M_at(pos); }
+    const_reference operator[](size_type pos) const noexcept { return *M_at(pos); }
+    reference front() noexcept { return *M_impl.start.cur; }
+    const_reference front() const noexcept { return *M_impl.start.cur; }
+    reference back() noexcept { return *std::prev(end()); }
+    const_reference back() const noexcept { return *std::prev(end()); }
+
+    //迭代器
+    iterator begin() noexcept { return M_impl.start; }
+    const_iterator begin() const noexcept { return M_impl.start; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return M_impl.finish; }
+    const_iterator end() const noexcept { return M_impl.finish; }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    //容量
+    bool empty() const noexcept { return M_impl.start == M_impl.finish; }
+    size_type size() const noexcept { return static_cast<size_type>(M_impl.finish - M_impl.start); }
+    size_type max_size() const noexcept { return T_alloc_traits::max_size(M_get_allocator()); }
+    void shrink_to_fit() noexcept { M_release_spare(); } //归还空闲链表上的块。
+
+    //修改器
+    void clear() noexcept { M_erase_at_end(begin()); } //移除全部元素，只保留一块，其余块挂入空闲链表。
+
+    iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }            //在 pos 前插入 value 。
+    iterator insert(const_iterator pos, T &&value) { return emplace(pos, std::move(value)); }      //在 pos 前插入 value 。
+    iterator insert(const_iterator pos, size_type count, const T &value);                         //在 pos 前插入 count 个 value 的副本。
+    template <typename InputIt, typename = RequireInputIter<InputIt>>                              //
+    iterator insert(const_iterator pos, InputIt first, InputIt last);                              //在 pos 前插入来自范围 [first, last) 的元素。
+    iterator insert(const_iterator pos, std::initializer_list<T> ilist) { return insert(pos, ilist.begin(), ilist.end()); }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args); //直接于 pos 前构造元素，移动较近一端的元素腾出位置。
+
+    iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); } //移除位于 pos 的元素。
+    iterator erase(const_iterator first, const_iterator last);              //移除范围 [first, last) 中的元素，移动较近一端的元素填补空位。
+
+    //两端的插入与弹出定义在类内，块内有空位时只有一次比较与一次构造；需要换块时才进入 M_push_back_aux 等函数。
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+    template <typename... Args>
+    reference emplace_back(Args &&...args) { //添加新元素到容器尾。
+        auto &finish = M_impl.finish;
+        if (finish.cur && finish.cur != finish.first + block_capacity - 1) {
+            M_construct(finish.cur, std::forward<Args>(args)...);
+            return *finish.cur++;
+        }
+        return M_push_back_aux(std::forward<Args>(args)...);
+    }
+    void pop_back() noexcept { //移除末元素。末块变空时挂入空闲链表。
+        auto &finish = M_impl.finish;
+        if (finish.cur == finish.first) {
+            M_put_block(finish.first);
+            finish.M_set_node(finish.node - 1);
+            finish.cur = finish.first + block_capacity;
+        }
+        --finish.cur;
+        M_destroy(finish.cur, finish.cur + 1);
+    }
+
+    void push_front(const T &value) { emplace_front(value); }
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+    template <typename... Args>
+    reference emplace_front(Args &&...args) { //插入新元素到容器起始。
+        auto &start = M_impl.start;
+        if (start.cur && start.cur != start.first) {
+            M_construct(start.cur - 1, std::forward<Args>(args)...);
+            return *--start.cur;
+        }
+        return M_push_front_aux(std::forward<Args>(args)...);
+    }
+    void pop_front() noexcept { //移除首元素。首块变空时挂入空闲链表。
+        auto &start = M_impl.start;
+        M_destroy(start.cur, start.cur + 1);
+        if (++start.cur == start.first + block_capacity) {
+            M_put_block(start.first);
+            start.M_set_node(start.node + 1);
+            start.cur = start.first;
+        }
+    }
+
+    void resize(size_type count);                          //重设容器大小以容纳 count 个元素。
+    void resize(size_type count, const value_type &value); //重设容器大小以容纳 count 个元素。
+
+    void swap(deque &other) noexcept; //交换内容，不搬动任何元素。
+
+private:
+    ///内嵌类，保存块表、首尾迭代器与空闲链表。继承分配器以便空分配器不占用空间。
+    ///块表中只有 [start.node, finish.node] 位置上的块指针有效，容器从未插入过元素时块表为空。
+    class impl : public T_alloc_type {
+    public:
+        map_type map;
+        iterator start;
+        iterator finish;
+        T *spare = nullptr; //空闲块链表，下一块的地址存放在块内存的开头
+
+        explicit impl(const T_alloc_type &alloc) : T_alloc_type(alloc), map(map_alloc_type(alloc)) {}
+
+        void M_swap_data(impl &other) noexcept {
+            map.swap(other.map);
+            std::swap(start, other.start);
+            std::swap(finish, other.finish);
+            std::swap(spare, other.spare);
+        }
+    };
+
+    impl M_impl;
+
+    T_alloc_type &M_get_allocator() noexcept { return M_impl; }
+    const T_alloc_type &M_get_allocator() const noexcept { return M_impl; }
+
+    T *M_at(size_type pos) const noexcept {
+        auto offset = pos + static_cast<size_type>(M_impl.start.cur - M_impl.start.first);
+        return M_impl.start.node[offset / block_capacity] + offset % block_capacity;
+    }
+
+    template <typename... Args>
+    void M_construct(T *p, Args &&...args) {
+        T_alloc_traits::construct(M_get_allocator(), p, std::forward<Args>(args)...);
+    }
+    void M_destroy(T *first, T *last) noexcept { destroy_a(first, last, M_get_allocator()); }
+    ///析构 [first, last) 中的元素，逐块进行。
+    void M_destroy(iterator first, iterator last) noexcept;
+
+    ///取一块未初始化的内存，优先取自空闲链表。
+    T *M_get_block();
+    ///把块挂入空闲链表。
+    void M_put_block(T *block) noexcept;
+    ///把空闲链表上的块全部归还分配器。
+    void M_release_spare() noexcept;
+
+    ///为 count 个元素建立块表与块，首元素位于首块的 offset 处。调用者保证块表为空。
+    void M_initialize_map(size_type count, size_type offset);
+    ///块表尾部（头部）至少留出 count 个空位，不足时把已用部分移到中间，仍不足时换一张更大的块表。
+    void M_reserve_map_at_back(size_type count);
+    void M_reserve_map_at_front(size_type count);
+    void M_reallocate_map(size_type count, bool at_front);
+
+    ///端块用尽或块表为空时的插入。
+    template <typename... Args>
+    reference M_push_back_aux(Args &&...args);
+    template <typename... Args>
+    reference M_push_front_aux(Args &&...args);
+
+    ///析构 [pos, end()) 中的元素，其后的块挂入空闲链表。
+    void M_erase_at_end(iterator pos) noexcept;
+    ///析构 [begin(), pos) 中的元素，其前的块挂入空闲链表。
+    void M_erase_at_begin(iterator pos) noexcept;
+    ///析构全部元素，归还全部块与块表，容器回到未申请内存的状态。
+    void M_destroy_all() noexcept;
+
+    ///在 pos 前插入若干元素： emplace(at_front) 把新元素逐个加到离 pos 较近的一端，之后旋转到位。
+    ///加到前端时新元素是逆序的，先翻转。中途抛出异常时移除已加入的元素，原有元素不变。
+    template <typename Emplace>
+    iterator M_insert_aux(const_iterator pos, Emplace emplace);
+
+    void M_move_assign(deque &other, std::true_type) noexcept;
+    void M_move_assign(deque &other, std::false_type);
+};
+
+template <typename T, typename Alloc>
+deque<T, Alloc>::deque(size_type count, const T &value, const Alloc &alloc) : deque(alloc) {
+    try {
+        for (; count > 0; --count) {
+            emplace_back(value);
+        }
+    } catch (...) {
+        M_destroy_all();
+        throw;
+    }
+}
+
+template <typename T, typename Alloc>
+deque<T, Alloc>::deque(size_type count, const Alloc &alloc) : deque(alloc) {
+    try {
+        resize(count);
+    } catch (...) {
+        M_destroy_all();
+        throw;
+    }
+}
+
+template <typename T, typename Alloc>
+template <typename InputIt, typename>
+deque<T, Alloc>::deque(InputIt first, InputIt last, const Alloc &alloc) : deque(alloc) {
+    try {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    } catch (...) {
+        M_destroy_all();
+        throw;
+    }
+}
+
+//新容器的首元素与 other 处于相同的块内偏移，两边的块一一对应，每块只需一次区间复制。
+template <typename T, typename Alloc>
+deque<T, Alloc>::deque(const deque &other) : M_impl(T_alloc_traits::select_on_container_copy_construction(other.M_get_allocator())) {
+    if (other.empty()) {
+        return;
+    }
+    auto offset = static_cast<size_type>(other.M_impl.start.cur - other.M_impl.start.first);
+    M_initialize_map(other.size(), offset);
+    auto node = M_impl.start.node;
+    auto last_node = M_impl.finish.node;
+    auto done = M_impl.start; //已复制部分的尾后位置
+    try {
+        for (auto src = other.M_impl.start.node;; ++src, ++node) {
+            auto first = src == other.M_impl.start.node ? other.M_impl.start.cur : *src;
+            auto last = src == other.M_impl.finish.node ? other.M_impl.finish.cur : *src + block_capacity;
+            done = iterator(*node + (first - *src), node);
+            uninitialized_copy_a(first, last, done.cur, M_get_allocator());
+            if (src == other.M_impl.finish.node) {
+                break;
+            }
+        }
+    } catch (...) {
+        //出错的那一块已由 uninitialized_copy_a 清理，只析构之前各块；之后尚未用到的块先挂入空闲链表再一并归还
+        for (auto rest = done.node + 1; rest <= last_node; ++rest) {
+            M_put_block(*rest);
+        }
+        M_impl.finish = done;
+        M_destroy_all();
+        throw;
+    }
+}
+
+template <typename T, typename Alloc>
+deque<T, Alloc>::deque(deque &&other) noexcept : M_impl(other.M_get_allocator()) {
+    M_impl.M_swap_data(other.M_impl);
+}
+
+template <typename T, typename Alloc>
+deque<T, Alloc>::deque(std::initializer_list<T> init, const Alloc &alloc) : deque(init.begin(), init.end(), alloc) {}
+
+template <typename T, typename Alloc>
+deque<T, Alloc> &deque<T, Alloc>::operator=(const deque &other) {
+    if (this == &other) {
+        return *this;
+    }
+    if (T_alloc_traits::propagate_on_container_copy_assignment::value && M_get_allocator() != other.M_get_allocator()) {
+        //旧块只能由旧分配器释放，必须在替换分配器之前归还。
+        M_destroy_all();
+    }
+    alloc_on_copy(M_get_allocator(), other.M_get_allocator(), typename T_alloc_traits::propagate_on_container_copy_assignment());
+    assign(other.begin(), other.end());
+    return *this;
+}
+
+template <typename T, typename Alloc>
+deque<T, Alloc> &deque<T, Alloc>::operator=(deque &&other) noexcept(T_alloc_traits::propagate_on_container_move_assignment::value || T_alloc_traits::is_always_equal::value) {
+    if (this == &other) {
+        return *this;
+    }
+    M_move_assign(other, std::integral_constant<bool, T_alloc_traits::propagate_on_container_move_assignment::value || T_alloc_traits::is_always_equal::value>());
+    return *this;
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::M_move_assign(deque &other, std::true_type) noexcept {
+    M_destroy_all();
+    M_impl.M_swap_data(other.M_impl);
+    alloc_on_move(M_get_allocator(), other.M_get_allocator(), typename T_alloc_traits::propagate_on_container_move_assignment());
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::M_move_assign(deque &other, std::false_type) {
+    if (M_get_allocator() == other.M_get_allocator()) {
+        M_move_assign(other, std::true_type());
+        return;
+    }
+    assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    other.clear();
+}
+
+template <typename T, typename Alloc>
+deque<T, Alloc> &deque<T, Alloc>::operator=(std::initializer_list<T> ilist) {
+    assign(ilist.begin(), ilist.end());
+    return *this;
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::assign(size_type count, const T &value) {
+    clear();
+    for (; count > 0; --count) {
+        emplace_back(value);
+    }
+}
+
+template <typename T, typename Alloc>
+template <typename InputIt, typename>
+void deque<T, Alloc>::assign(InputIt first, InputIt last) {
+    clear();
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+}
+
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::reference deque<T, Alloc>::at(size_type pos) {
+    if (pos >= size()) {
+        throw std::out_of_range("deque::at");
+    }
+    return (*this)[pos];
+}
+
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::const_reference deque<T, Alloc>::at(size_type pos) const {
+    if (pos >= size()) {
+        throw std::out_of_range("deque::at");
+    }
+    return (*this)[pos];
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::M_destroy(iterator first, iterator last) noexcept {
+    if (first.node == last.node) {
+        M_destroy(first.cur, last.cur);
+        return;
+    }
+    M_destroy(first.cur, *first.node + block_capacity);
+    for (auto node = first.node + 1; node != last.node; ++node) {
+        M_destroy(*node, *node + block_capacity);
+    }
+    M_destroy(*last.node, last.cur);
+}
+
+template <typename T, typename Alloc>
+T *deque<T, Alloc>::M_get_block() {
+    if (M_impl.spare) {
+        auto block = M_impl.spare;
+        std::memcpy(static_cast<void *>(&M_impl.spare), static_cast<const void *>(block), sizeof(T *));
+        return block;
+    }
+    return T_alloc_traits::allocate(M_get_allocator(), block_capacity);
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::M_put_block(T *block) noexcept {
+    std::memcpy(static_cast<void *>(block), static_cast<const void *>(&M_impl.spare), sizeof(T *));
+    M_impl.spare = block;
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::M_release_spare() noexcept {
+    while (M_impl.spare) {
+        auto block = M_impl.spare;
+        std::memcpy(static_cast<void *>(&M_impl.spare), static_cast<const void *>(block), sizeof(T *));
+        T_alloc_traits::deallocate(M_get_allocator(), block, block_capacity);
+    }
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::M_initialize_map(size_type count, size_type offset) {
+    auto nodes = (offset + count) / block_capacity + 1;
+    map_type map(std::max<size_type>(8, nodes + 2), nullptr, map_alloc_type(M_get_allocator()));
+    auto first = map.data() + (map.size() - nodes) / 2;
+    auto current = first;
+    try {
+        for (; current != first + nodes; ++current) {
+            *current = M_get_block();
+        }
+    } catch (...) {
+        while (current != first) {
+            M_put_block(*--current);
+        }
+        throw;
+    }
+    M_impl.map.swap(map);
+    M_impl.start = iterator(*first + offset, first);
+    M_impl.finish = iterator(first[nodes - 1] + (offset + count) % block_capacity, first + nodes - 1);
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::M_reserve_map_at_back(size_type count) {
+    if (count + 1 > M_impl.map.size() - static_cast<size_type>(M_impl.finish.node - M_impl.map.data())) {
+        M_reallocate_map(count, false);
+    }
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::M_reserve_map_at_front(size_type count) {
+    if (count > static_cast<size_type>(M_impl.start.node - M_impl.map.data())) {
+        M_reallocate_map(count, true);
+    }
+}
+
+//已用部分不足块表的一半时原地居中，否则换一张至少两倍大的块表。两端交替用尽时居中的代价由此前 count 次插入分摊。
+template <typename T, typename Alloc>
+void deque<T, Alloc>::M_reallocate_map(size_type count, bool at_front) {
+    auto old_nodes = static_cast<size_type>(M_impl.finish.node - M_impl.start.node) + 1;
+    auto new_nodes = old_nodes + count;
+    T **new_start;
+    if (M_impl.map.size() > 2 * new_nodes) {
+        new_start = M_impl.map.data() + (M_impl.map.size() - new_nodes) / 2 + (at_front ? count : 0);
+        std::memmove(static_cast<void *>(new_start), static_cast<const void *>(M_impl.start.node), old_nodes * sizeof(T *));
+    } else {
+        map_type map(M_impl.map.size() + std::max(M_impl.map.size(), count) + 2, nullptr, map_alloc_type(M_get_allocator()));
+        new_start = map.data() + (map.size() - new_nodes) / 2 + (at_front ? count : 0);
+        std::copy(M_impl.start.node, M_impl.finish.node + 1, new_start);
+        M_impl.map.swap(map);
+    }
+    M_impl.start.node = new_start; //块本身不动，块起点不变
+    M_impl.finish.node = new_start + old_nodes - 1;
+}
+
+//末块只剩最后一个空位：先备好下一块再构造，使尾后位置始终落在已分配的块中。
+template <typename T, typename Alloc>
+template <typename... Args>
+typename deque<T, Alloc>::reference deque<T, Alloc>::M_push_back_aux(Args &&...args) {
+    if (M_impl.map.empty()) {
+        M_initialize_map(0, 0);
+        M_construct(M_impl.finish.cur, std::forward<Args>(args)...);
+        return *M_impl.finish.cur++;
+    }
+    M_reserve_map_at_back(1);
+    auto &finish = M_impl.finish;
+    finish.node[1] = M_get_block();
+    try {
+        M_construct(finish.cur, std::forward<Args>(args)...);
+    } catch (...) {
+        M_put_block(finish.node[1]);
+        throw;
+    }
+    auto &result = *finish.cur;
+    finish.M_set_node(finish.node + 1);
+    finish.cur = finish.first;
+    return result;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+typename deque<T, Alloc>::reference deque<T, Alloc>::M_push_front_aux(Args &&...args) {
+    if (M_impl.map.empty()) {
+        M_initialize_map(0, 0);
+    }
+    M_reserve_map_at_front(1);
+    auto &start = M_impl.start;
+    start.node[-1] = M_get_block();
+    try {
+        M_construct(start.node[-1] + block_capacity - 1, std::forward<Args>(args)...);
+    } catch (...) {
+        M_put_block(start.node[-1]);
+        throw;
+    }
+    start.M_set_node(start.node - 1);
+    start.cur = start.first + block_capacity - 1;
+    return *start.cur;
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::M_erase_at_end(iterator pos) noexcept {
+    if (pos == M_impl.finish) {
+        return;
+    }
+    M_destroy(pos, M_impl.finish);
+    for (auto node = pos.node + 1; node <= M_impl.finish.node; ++node) {
+        M_put_block(*node);
+    }
+    M_impl.finish = pos;
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::M_erase_at_begin(iterator pos) noexcept {
+    if (pos == M_impl.start) {
+        return;
+    }
+    M_destroy(M_impl.start, pos);
+    for (auto node = M_impl.start.node; node < pos.node; ++node) {
+        M_put_block(*node);
+    }
+    M_impl.start = pos;
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::M_destroy_all() noexcept {
+    if (M_impl.map.empty()) {
+        M_release_spare();
+        return;
+    }
+    M_destroy(M_impl.start, M_impl.finish);
+    for (auto node = M_impl.start.node; node <= M_impl.finish.node; ++node) {
+        T_alloc_traits::deallocate(M_get_allocator(), *node, block_capacity);
+    }
+    M_release_spare();
+    map_type(map_alloc_type(M_get_allocator())).swap(M_impl.map);
+    M_impl.start = M_impl.finish = iterator();
+}
+
+template <typename T, typename Alloc>
+template <typename Emplace>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::M_insert_aux(const_iterator pos, Emplace emplace) {
+    auto index = static_cast<size_type>(pos - cbegin());
+    auto old_size = size();
+    bool at_front = index < old_size / 2;
+    try {
+        emplace(at_front);
+    } catch (...) {
+        if (at_front) {
+            M_erase_at_begin(begin() + static_cast<difference_type>(size() - old_size));
+        } else {
+            M_erase_at_end(begin() + static_cast<difference_type>(old_size));
+        }
+        throw;
+    }
+    auto count = static_cast<difference_type>(size() - old_size);
+    if (at_front) {
+        std::reverse(begin(), begin() + count);
+        std::rotate(begin(), begin() + count, begin() + count + static_cast<difference_type>(index));
+    } else {
+        std::rotate(begin() + static_cast<difference_type>(index), begin() + static_cast<difference_type>(old_size), end());
+    }
+    return begin() + static_cast<difference_type>(index);
+}
+
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::insert(const_iterator pos, size_type count, const T &value) {
+    return M_insert_aux(pos, [&](bool at_front) {
+        for (auto n = count; n > 0; --n) {
+            at_front ? (void)emplace_front(value) : (void)emplace_back(value);
+        }
+    });
+}
+
+template <typename T, typename Alloc>
+template <typename InputIt, typename>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::insert(const_iterator pos, InputIt first, InputIt last) {
+    return M_insert_aux(pos, [&](bool at_front) {
+        for (; first != last; ++first) {
+            at_front ? (void)emplace_front(*first) : (void)emplace_back(*first);
+        }
+    });
+}
+
+//先在较近一端复制出一个端点元素，再把 pos 与该端之间的元素挪一格，最后把新值移入空出的位置。
+template <typename T, typename Alloc>
+template <typename... Args>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::emplace(const_iterator pos, Args &&...args) {
+    if (pos == cbegin()) {
+        emplace_front(std::forward<Args>(args)...);
+        return begin();
+    }
+    if (pos == cend()) {
+        emplace_back(std::forward<Args>(args)...);
+        return std::prev(end());
+    }
+    auto index = pos - cbegin();
+    value_type value(std::forward<Args>(args)...);
+    if (static_cast<size_type>(index) < size() / 2) {
+        emplace_front(std::move(front()));
+        std::move(begin() + 2, begin() + index + 1, begin() + 1);
+    } else {
+        emplace_back(std::move(back()));
+        std::move_backward(begin() + index, end() - 2, end() - 1);
+    }
+    auto it = begin() + index;
+    *it = std::move(value);
+    return it;
+}
+
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::erase(const_iterator first, const_iterator last) {
+    auto index = first - cbegin();
+    auto count = last - first;
+    if (count == 0) {
+        return begin() + index;
+    }
+    if (static_cast<size_type>(index) < (size() - static_cast<size_type>(count)) / 2) {
+        std::move_backward(begin(), begin() + index, begin() + index + count);
+        M_erase_at_begin(begin() + count);
+    } else {
+        std::move(begin() + index + count, end(), begin() + index);
+        M_erase_at_end(end() - count);
+    }
+    return begin() + index;
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::resize(size_type count) {
+    if (count < size()) {
+        M_erase_at_end(begin() + static_cast<difference_type>(count));
+        return;
+    }
+    for (auto n = count - size(); n > 0; --n) {
+        emplace_back();
+    }
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::resize(size_type count, const value_type &value) {
+    if (count < size()) {
+        M_erase_at_end(begin() + static_cast<difference_type>(count));
+        return;
+    }
+    insert(cend(), count - size(), value);
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::swap(deque &other) noexcept {
+    M_impl.M_swap_data(other.M_impl);
+    alloc_on_swap(M_get_allocator(), other.M_get_allocator(), typename T_alloc_traits::propagate_on_container_swap());
+}
+
+template <typename T, typename Alloc>
+bool operator==(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename Alloc>
+bool operator!=(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Alloc>
+bool operator<(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, typename Alloc>
+bool operator>(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, typename Alloc>
+bool operator<=(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, typename Alloc>
+bool operator>=(const deque<T, Alloc> &lhs, const deque<T, Alloc> &rhs) {
+    return !(lhs < rhs);
+}
+
+template <typename T, typename Alloc>
+void swap(deque<T, Alloc> &lhs, deque<T, Alloc> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+///使用多态分配器的 deque 。
+template <typename T>
+using deque = mystl::deque<T, polymorphic_allocator<T>>;
+} // namespace pmr
+} // namespace mystl
@@ -0,0 +1,553 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "my_flat_tree.hpp"
+#include "my_list.hpp"
+#include "my_utility.hpp"
+#include "my_vector.hpp"
+
+namespace mystl {
+///flat_map 的迭代器，同时指向键数组与值数组的同一下标。解引用得到 pair<const Key &, T &> ，不是元素的引用。
+template <typename KeyIter, typename MappedIter>
+class flat_map_iterator {
+public:
+    using self = flat_map_iterator<KeyIter, MappedIter>;
+    using key_type = typename std::iterator_traits<KeyIter>::value_type;
+    using mapped_type = typename std::iterator_traits<MappedIter>::value_type;
+    using value_type = std::pair<key_type, mapped_type>;
+    using reference = std::pair<const key_type &, typename std::iterator_traits<MappedIter>::reference>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::random_access_iterator_tag;
+
+    ///operator-> 返回的代理，保存一个 reference 。
+    class pointer {
+        reference ref;
+
+    public:
+        explicit pointer(reference r) : ref(r) {}
+        const reference *operator->() const noexcept { return &ref; }
+    };
+
+    template <typename, typename>
+    friend class flat_map_iterator;
+    template <typename, typename, typename, typename, typename>
+    friend class flat_map;
+
+protected:
+    KeyIter key_it;
+    MappedIter mapped_it;
+
+public:
+    flat_map_iterator() = default;
+    flat_map_iterator(KeyIter k, MappedIter m) : key_it(k), mapped_it(m) {}
+    ///iterator 可隐式转换为 const_iterator 。
+    template <typename K, typename M,
+              typename = typename std::enable_if<std::is_convertible<M, MappedIter>::value && !std::is_same<M, MappedIter>::value &&
+                                                 std::is_const<typename std::remove_reference<typename std::iterator_traits<MappedIter>::reference>::type>::value>::type>
+    flat_map_iterator(const flat_map_iterator<K, M> &other) : key_it(other.key_it), mapped_it(other.mapped_it) {}
+
+    reference operator*() const { return reference(*key_it, *mapped_it); }
+    pointer operator->() const { return pointer(**this); }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    self &operator++() {
+        ++key_it;
+        ++mapped_it;
+        return *this;
+    }
+    self operator++(int) {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+    self &operator--() {
+        --key_it;
+        --mapped_it;
+        return *this;
+    }
+    self operator--(int) {
+        auto temp = *this;
+        --*this;
+        return temp;
+    }
+    self &operator+=(difference_type n) {
+        key_it += n;
+        mapped_it += n;
+        return *this;
+    }
+    self &operator-=(difference_type n) { return *this += -n; }
+    friend self operator+(self it, difference_type n) { return it += n; }
+    friend self operator+(difference_type n, self it) { return it += n; }
+    friend self operator-(self it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const self &lhs, const self &rhs) { return lhs.key_it - rhs.key_it; }
+
+    friend bool operator==(const self &lhs, const self &rhs) { return lhs.key_it == rhs.key_it; }
+    friend bool operator!=(const self &lhs, const self &rhs) { return !(lhs == rhs); }
+    friend bool operator<(const self &lhs, const self &rhs) { return lhs.key_it < rhs.key_it; }
+    friend bool operator>(const self &lhs, const self &rhs) { return rhs < lhs; }
+    friend bool operator<=(const self &lhs, const self &rhs) { return !(rhs < lhs); }
+    friend bool operator>=(const self &lhs, const self &rhs) { return !(lhs < rhs); }
+};
+
+///有序数组上的映射，键与值分别存放在两个数组中：查找只访问键数组，缓存中能容纳更多的键。
+///查找为无分支的二分查找；逐个插入与删除需要移动其后的元素，
+///成批插入时先把新元素追加到末尾、排序，再与原有元素一次合并，代价与容器大小成线性而非与批量大小成正比。
+///插入与删除使插入点之后的迭代器失效，容量变化时使全部迭代器失效。成批插入中途抛出异常时容器被清空。
+template <typename Key, typename T, typename Compare = std::less<Key>, typename KeyContainer = vector<Key>, typename MappedContainer = vector<T>>
+class flat_map {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using key_compare = Compare;
+    using reference = std::pair<const Key &, T &>;
+    using const_reference = std::pair<const Key &, const T &>;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_container_type = KeyContainer;
+    using mapped_container_type = MappedContainer;
+    using iterator = flat_map_iterator<typename KeyContainer::const_iterator, typename MappedContainer::iterator>;
+    using const_iterator = flat_map_iterator<typename KeyContainer::const_iterator, typename MappedContainer::const_iterator>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    ///按键比较两个元素。
+    class value_compare {
+        friend class flat_map;
+        Compare comp;
+        explicit value_compare(const Compare &c) : comp(c) {}
+
+    public:
+        bool operator()(const_reference lhs, const_reference rhs) const { return comp(lhs.first, rhs.first); }
+    };
+
+    ///由 extract 返回的两个数组。
+    struct containers {
+        key_container_type keys;
+        mapped_container_type values;
+    };
+
+    //构造函数
+    flat_map() = default;
+    explicit flat_map(const Compare &comp) : comp_(comp) {}
+    flat_map(key_container_type keys, mapped_container_type values, const Compare &comp = Compare()); //两数组等长。按键排序，重复的键保留最先出现的一个。
+    flat_map(sorted_unique_t, key_container_type keys, mapped_container_type values, const Compare &comp = Compare())
+        : keys_(std::move(keys)), values_(std::move(values)), comp_(comp) {}
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    flat_map(InputIt first, InputIt last, const Compare &comp = Compare()) : comp_(comp) {
+        insert(first, last);
+    }
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    flat_map(sorted_unique_t, InputIt first, InputIt last, const Compare &comp = Compare()) : comp_(comp) {
+        M_append(first, last);
+    }
+    flat_map(std::initializer_list<value_type> init, const Compare &comp = Compare()) : flat_map(init.begin(), init.end(), comp) {}
+    flat_map(sorted_unique_t, std::initializer_list<value_type> init, const Compare &comp = Compare()) : flat_map(sorted_unique, init.begin(), init.end(), comp) {}
+
+    flat_map &operator=(std::initializer_list<value_type> init);
+
+    //迭代器
+    iterator begin() noexcept { return iterator(keys_.cbegin(), values_.begin()); }
+    const_iterator begin() const noexcept { return const_iterator(keys_.cbegin(), values_.cbegin()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(keys_.cend(), values_.end()); }
+    const_iterator end() const noexcept { return const_iterator(keys_.cend(), values_.cend()); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    //容量
+    bool empty() const noexcept { return keys_.empty(); }
+    size_type size() const noexcept { return keys_.size(); }
+    size_type max_size() const noexcept { return std::min(keys_.max_size(), values_.max_size()); }
+
+    //元素访问
+    T &at(const key_type &key);             //返回键为 key 的元素的值，不存在时抛出 std::out_of_range 。
+    const T &at(const key_type &key) const; //返回键为 key 的元素的值，不存在时抛出 std::out_of_range 。
+    T &operator[](const key_type &key) { return try_emplace(key).first->second; }
+    T &operator[](key_type &&key) { return try_emplace(std::move(key)).first->second; }
+
+    //修改器
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args &&...args) {
+        value_type value(std::forward<Args>(args)...);
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+    template <typename... Args>
+    iterator emplace_hint(const_iterator, Args &&...args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+    std::pair<iterator, bool> insert(const value_type &value) { return try_emplace(value.first, value.second); }
+    std::pair<iterator, bool> insert(value_type &&value) { return try_emplace(std::move(value.first), std::move(value.second)); }
+    template <typename P, typename = typename std::enable_if<std::is_constructible<value_type, P &&>::value>::type>
+    std::pair<iterator, bool> insert(P &&value) {
+        return emplace(std::forward<P>(value));
+    }
+    iterator insert(const_iterator hint, const value_type &value) { return emplace_hint(hint, value); }
+    iterator insert(const_iterator hint, value_type &&value) { return emplace_hint(hint, std::move(value)); }
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    void insert(InputIt first, InputIt last) { //成批插入：追加、排序、一次合并。
+        M_insert_batch<false>(first, last);
+    }
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    void insert(sorted_unique_t, InputIt first, InputIt last) { //区间已按键升序且无重复时省去排序。
+        M_insert_batch<true>(first, last);
+    }
+    void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+    void insert(sorted_unique_t, std::initializer_list<value_type> ilist) { insert(sorted_unique, ilist.begin(), ilist.end()); }
+    template <typename Range>
+    void insert_range(Range &&range) { //同 insert(first, last) ，接受任何有 begin/end 的区间。
+        insert(std::begin(range), std::end(range));
+    }
+    template <typename Range>
+    void insert_sorted_unique(Range &&range) { //同 insert(sorted_unique, first, last) 。
+        insert(sorted_unique, std::begin(range), std::end(range));
+    }
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) { //键不存在时才以 args 构造值，存在时不移动实参。
+        return M_try_emplace(key, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+        return M_try_emplace(std::move(key), std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    iterator try_emplace(const_iterator, const key_type &key, Args &&...args) {
+        return try_emplace(key, std::forward<Args>(args)...).first;
+    }
+    template <typename... Args>
+    iterator try_emplace(const_iterator, key_type &&key, Args &&...args) {
+        return try_emplace(std::move(key), std::forward<Args>(args)...).first;
+    }
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj); //键存在时赋值，否则插入。
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(key_type &&key, M &&obj);
+    containers extract() &&; //移出两个数组，容器变为空。
+    void replace(key_container_type &&keys, mapped_container_type &&values); //以已按键升序且无重复的两个等长数组替换内容。
+    iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+    size_type erase(const key_type &key);
+    void swap(flat_map &other) noexcept;
+    void clear() noexcept;
+
+    //查找
+    iterator find(const key_type &key) { return M_mutable(M_find(key)); }
+    const_iterator find(const key_type &key) const { return M_find(key); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    iterator find(const K &key) {
+        return M_mutable(M_find(key));
+    }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    const_iterator find(const K &key) const {
+        return M_find(key);
+    }
+    size_type count(const key_type &key) const { return M_find(key) != end(); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    size_type count(const K &key) const {
+        return M_find(key) != end();
+    }
+    bool contains(const key_type &key) const { return M_find(key) != end(); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    bool contains(const K &key) const {
+        return M_find(key) != end();
+    }
+    iterator lower_bound(const key_type &key) { return M_at(M_lower(key)); }
+    const_iterator lower_bound(const key_type &key) const { return M_at(M_lower(key)); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    iterator lower_bound(const K &key) {
+        return M_at(M_lower(key));
+    }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    const_iterator lower_bound(const K &key) const {
+        return M_at(M_lower(key));
+    }
+    iterator upper_bound(const key_type &key) { return M_at(M_upper(key)); }
+    const_iterator upper_bound(const key_type &key) const { return M_at(M_upper(key)); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    iterator upper_bound(const K &key) {
+        return M_at(M_upper(key));
+    }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    const_iterator upper_bound(const K &key) const {
+        return M_at(M_upper(key));
+    }
+    std::pair<iterator, iterator> equal_range(const key_type &key) { return M_equal_range(key); }
+    std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const { return M_equal_range(key); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    std::pair<iterator, iterator> equal_range(const K &key) {
+        return M_equal_range(key);
+    }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    std::pair<const_iterator, const_iterator> equal_range(const K &key) const {
+        return M_equal_range(key);
+    }
+
+    //观察器
+    key_compare key_comp() const { return comp_; }
+    value_compare value_comp() const { return value_compare(comp_); }
+    const key_container_type &keys() const noexcept { return keys_; }         //升序的键数组
+    const mapped_container_type &values() const noexcept { return values_; } //与键数组一一对应的值数组
+
+protected:
+    key_container_type keys_;
+    mapped_container_type values_;
+    Compare comp_;
+
+    iterator M_at(size_type i) noexcept { return begin() + static_cast<difference_type>(i); }
+    const_iterator M_at(size_type i) const noexcept { return begin() + static_cast<difference_type>(i); }
+    iterator M_mutable(const_iterator it) noexcept { return M_at(static_cast<size_type>(it - cbegin())); }
+
+    template <typename K>
+    size_type M_lower(const K &key) const {
+        return static_cast<size_type>(flat_lower_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+    }
+    template <typename K>
+    size_type M_upper(const K &key) const {
+        return static_cast<size_type>(flat_upper_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+    }
+    template <typename K>
+    const_iterator M_find(const K &key) const {
+        auto i = M_lower(key);
+        return i < size() && !comp_(key, keys_[i]) ? M_at(i) : end();
+    }
+    template <typename K>
+    std::pair<iterator, iterator> M_equal_range(const K &key) {
+        auto i = M_lower(key);
+        return {M_at(i), M_at(i < size() && !comp_(key, keys_[i]) ? i + 1 : i)};
+    }
+    template <typename K>
+    std::pair<const_iterator, const_iterator> M_equal_range(const K &key) const {
+        auto i = M_lower(key);
+        return {M_at(i), M_at(i < size() && !comp_(key, keys_[i]) ? i + 1 : i)};
+    }
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> M_try_emplace(K &&key, Args &&...args);
+    template <typename InputIt>
+    void M_append(InputIt first, InputIt last);
+    template <bool Sorted, typename InputIt>
+    void M_insert_batch(InputIt first, InputIt last);
+};
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+flat_map<Key, T, C, KC, MC>::flat_map(key_container_type keys, mapped_container_type values, const C &comp) : comp_(comp) {
+    keys_.swap(keys);
+    values_.swap(values);
+    try {
+        auto order = flat_batch_order<false>(keys_, 0, comp_);
+        key_container_type sorted_keys;
+        mapped_container_type sorted_values;
+        sorted_keys.reserve(order.size());
+        sorted_values.reserve(order.size());
+        for (auto i : order) {
+            sorted_keys.push_back(std::move(keys_[i]));
+            sorted_values.push_back(std::move(values_[i]));
+        }
+        keys_.swap(sorted_keys);
+        values_.swap(sorted_values);
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+flat_map<Key, T, C, KC, MC> &flat_map<Key, T, C, KC, MC>::operator=(std::initializer_list<value_type> init) {
+    clear();
+    insert(init.begin(), init.end());
+    return *this;
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+T &flat_map<Key, T, C, KC, MC>::at(const key_type &key) {
+    auto it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("flat_map::at");
+    }
+    return it->second;
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+const T &flat_map<Key, T, C, KC, MC>::at(const key_type &key) const {
+    auto it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("flat_map::at");
+    }
+    return it->second;
+}
+
+//先插入值再插入键：插入键失败时删去刚插入的值，两数组保持等长。
+template <typename Key, typename T, typename C, typename KC, typename MC>
+template <typename K, typename... Args>
+std::pair<typename flat_map<Key, T, C, KC, MC>::iterator, bool> flat_map<Key, T, C, KC, MC>::M_try_emplace(K &&key, Args &&...args) {
+    auto i = M_lower(key);
+    if (i < size() && !comp_(key, keys_[i])) {
+        return {M_at(i), false};
+    }
+    auto pos = static_cast<difference_type>(i);
+    values_.emplace(values_.begin() + pos, std::forward<Args>(args)...);
+    try {
+        keys_.emplace(keys_.begin() + pos, std::forward<K>(key));
+    } catch (...) {
+        values_.erase(values_.begin() + pos);
+        throw;
+    }
+    return {M_at(i), true};
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+template <typename M>
+std::pair<typename flat_map<Key, T, C, KC, MC>::iterator, bool> flat_map<Key, T, C, KC, MC>::insert_or_assign(const key_type &key, M &&obj) {
+    auto result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) {
+        result.first->second = std::forward<M>(obj);
+    }
+    return result;
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+template <typename M>
+std::pair<typename flat_map<Key, T, C, KC, MC>::iterator, bool> flat_map<Key, T, C, KC, MC>::insert_or_assign(key_type &&key, M &&obj) {
+    auto result = try_emplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+        result.first->second = std::forward<M>(obj);
+    }
+    return result;
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+template <typename InputIt>
+void flat_map<Key, T, C, KC, MC>::M_append(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+        const auto &value = *first;
+        keys_.push_back(value.first);
+        values_.push_back(value.second);
+    }
+}
+
+//新元素先追加到两个数组末尾，按键挑出要插入的新元素移到临时数组，截去末尾多余的部分，再从后往前合并两个数组。
+//合并前原有元素未被改动，失败时截回原长度即可（强保证）；合并中失败时两数组已被部分覆盖，只能清空。
+template <typename Key, typename T, typename C, typename KC, typename MC>
+template <bool Sorted, typename InputIt>
+void flat_map<Key, T, C, KC, MC>::M_insert_batch(InputIt first, InputIt last) {
+    auto n = size();
+    vector<Key> fresh_keys;
+    vector<T> fresh_values;
+    try {
+        M_append(first, last);
+        auto order = flat_batch_order<Sorted>(keys_, n, comp_);
+        fresh_keys.reserve(order.size());
+        fresh_values.reserve(order.size());
+        for (auto i : order) {
+            fresh_keys.push_back(std::move(keys_[n + i]));
+            fresh_values.push_back(std::move(values_[n + i]));
+        }
+    } catch (...) {
+        keys_.erase(keys_.begin() + static_cast<difference_type>(n), keys_.end());
+        values_.erase(values_.begin() + static_cast<difference_type>(n), values_.end());
+        throw;
+    }
+    auto k = fresh_keys.size();
+    keys_.erase(keys_.begin() + static_cast<difference_type>(n + k), keys_.end());
+    values_.erase(values_.begin() + static_cast<difference_type>(n + k), values_.end());
+    try {
+        flat_merge_back(
+            n, k, [&](size_t j, size_t i) { return comp_(fresh_keys[j], keys_[i]); },
+            [&](size_t w, size_t i) {
+                keys_[w] = std::move(keys_[i]);
+                values_[w] = std::move(values_[i]);
+            },
+            [&](size_t w, size_t j) {
+                keys_[w] = std::move(fresh_keys[j]);
+                values_[w] = std::move(fresh_values[j]);
+            });
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+typename flat_map<Key, T, C, KC, MC>::containers flat_map<Key, T, C, KC, MC>::extract() && {
+    containers result{std::move(keys_), std::move(values_)};
+    clear();
+    return result;
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+void flat_map<Key, T, C, KC, MC>::replace(key_container_type &&keys, mapped_container_type &&values) {
+    keys_ = std::move(keys);
+    values_ = std::move(values);
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+typename flat_map<Key, T, C, KC, MC>::iterator flat_map<Key, T, C, KC, MC>::erase(const_iterator pos) {
+    auto i = pos - cbegin();
+    keys_.erase(keys_.begin() + i);
+    values_.erase(values_.begin() + i);
+    return M_at(static_cast<size_type>(i));
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+typename flat_map<Key, T, C, KC, MC>::iterator flat_map<Key, T, C, KC, MC>::erase(const_iterator first, const_iterator last) {
+    auto i = first - cbegin();
+    auto j = last - cbegin();
+    keys_.erase(keys_.begin() + i, keys_.begin() + j);
+    values_.erase(values_.begin() + i, values_.begin() + j);
+    return M_at(static_cast<size_type>(i));
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+typename flat_map<Key, T, C, KC, MC>::size_type flat_map<Key, T, C, KC, MC>::erase(const key_type &key) {
+    auto it = M_find(key);
+    if (it == end()) {
+        return 0;
+    }
+    erase(it);
+    return 1;
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+void flat_map<Key, T, C, KC, MC>::swap(flat_map &other) noexcept {
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+    std::swap(comp_, other.comp_);
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+void flat_map<Key, T, C, KC, MC>::clear() noexcept {
+    keys_.clear();
+    values_.clear();
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+bool operator==(const flat_map<Key, T, C, KC, MC> &lhs, const flat_map<Key, T, C, KC, MC> &rhs) {
+    return lhs.keys() == rhs.keys() && lhs.values() == rhs.values();
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+bool operator!=(const flat_map<Key, T, C, KC, MC> &lhs, const flat_map<Key, T, C, KC, MC> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+bool operator<(const flat_map<Key, T, C, KC, MC> &lhs, const flat_map<Key, T, C, KC, MC> &rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Key, typename T, typename C, typename KC, typename MC>
+void swap(flat_map<Key, T, C, KC, MC> &lhs, flat_map<Key, T, C, KC, MC> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+} // namespace mystl
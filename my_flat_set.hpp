@@ -0,0 +1,262 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "my_flat_tree.hpp"
+#include "my_list.hpp"
+#include "my_utility.hpp"
+#include "my_vector.hpp"
+
+namespace mystl {
+///有序数组上的集合。查找为无分支的二分查找；逐个插入与删除需要移动其后的元素，
+///成批插入时先把新元素追加到末尾、排序，再与原有元素一次合并，代价与容器大小成线性而非与批量大小成正比。
+///插入与删除使插入点之后的迭代器失效，容量变化时使全部迭代器失效。成批插入中途抛出异常时容器被清空。
+template <typename Key, typename Compare = std::less<Key>, typename KeyContainer = vector<Key>>
+class flat_set {
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using value_compare = Compare;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using container_type = KeyContainer;
+    using const_iterator = typename KeyContainer::const_iterator;
+    using iterator = const_iterator; //元素就是键，不能通过迭代器修改
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    //构造函数
+    flat_set() = default;
+    explicit flat_set(const Compare &comp) : comp_(comp) {}
+    explicit flat_set(container_type cont, const Compare &comp = Compare()); //排序并去除重复的键。
+    flat_set(sorted_unique_t, container_type cont, const Compare &comp = Compare()) : c_(std::move(cont)), comp_(comp) {}
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    flat_set(InputIt first, InputIt last, const Compare &comp = Compare()) : comp_(comp) {
+        insert(first, last);
+    }
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    flat_set(sorted_unique_t, InputIt first, InputIt last, const Compare &comp = Compare()) : c_(first, last), comp_(comp) {}
+    flat_set(std::initializer_list<value_type> init, const Compare &comp = Compare()) : flat_set(init.begin(), init.end(), comp) {}
+    flat_set(sorted_unique_t, std::initializer_list<value_type> init, const Compare &comp = Compare()) : flat_set(sorted_unique, init.begin(), init.end(), comp) {}
+
+    flat_set &operator=(std::initializer_list<value_type> init);
+
+    //迭代器
+    iterator begin() const noexcept { return c_.begin(); }
+    const_iterator cbegin() const noexcept { return c_.begin(); }
+    iterator end() const noexcept { return c_.end(); }
+    const_iterator cend() const noexcept { return c_.end(); }
+    reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    //容量
+    bool empty() const noexcept { return c_.empty(); }
+    size_type size() const noexcept { return c_.size(); }
+    size_type max_size() const noexcept { return c_.max_size(); }
+
+    //修改器
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args &&...args) {
+        return M_insert_unique(value_type(std::forward<Args>(args)...));
+    }
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args &&...args); //新键恰好应位于 hint 之前时不查找。
+    std::pair<iterator, bool> insert(const value_type &value) { return M_insert_unique(value); }
+    std::pair<iterator, bool> insert(value_type &&value) { return M_insert_unique(std::move(value)); }
+    iterator insert(const_iterator hint, const value_type &value) { return emplace_hint(hint, value); }
+    iterator insert(const_iterator hint, value_type &&value) { return emplace_hint(hint, std::move(value)); }
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    void insert(InputIt first, InputIt last) { //成批插入：追加、排序、一次合并。
+        M_insert_batch<false>(first, last);
+    }
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    void insert(sorted_unique_t, InputIt first, InputIt last) { //区间已升序且无重复时省去排序。
+        M_insert_batch<true>(first, last);
+    }
+    void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+    void insert(sorted_unique_t, std::initializer_list<value_type> ilist) { insert(sorted_unique, ilist.begin(), ilist.end()); }
+    template <typename Range>
+    void insert_range(Range &&range) { //同 insert(first, last) ，接受任何有 begin/end 的区间。
+        insert(std::begin(range), std::end(range));
+    }
+    template <typename Range>
+    void insert_sorted_unique(Range &&range) { //同 insert(sorted_unique, first, last) 。
+        insert(sorted_unique, std::begin(range), std::end(range));
+    }
+    container_type extract() &&; //移出底层数组，容器变为空。
+    void replace(container_type &&cont) { c_ = std::move(cont); } //以已升序且无重复的数组替换内容。
+    iterator erase(const_iterator pos) { return c_.erase(pos); }
+    iterator erase(const_iterator first, const_iterator last) { return c_.erase(first, last); }
+    size_type erase(const key_type &key);
+    void swap(flat_set &other) noexcept;
+    void clear() noexcept { c_.clear(); }
+
+    //查找
+    iterator find(const key_type &key) const { return M_find(key); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    iterator find(const K &key) const {
+        return M_find(key);
+    }
+    size_type count(const key_type &key) const { return M_find(key) != end(); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    size_type count(const K &key) const {
+        return M_find(key) != end();
+    }
+    bool contains(const key_type &key) const { return M_find(key) != end(); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    bool contains(const K &key) const {
+        return M_find(key) != end();
+    }
+    iterator lower_bound(const key_type &key) const { return flat_lower_bound(begin(), end(), key, comp_); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    iterator lower_bound(const K &key) const {
+        return flat_lower_bound(begin(), end(), key, comp_);
+    }
+    iterator upper_bound(const key_type &key) const { return flat_upper_bound(begin(), end(), key, comp_); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    iterator upper_bound(const K &key) const {
+        return flat_upper_bound(begin(), end(), key, comp_);
+    }
+    std::pair<iterator, iterator> equal_range(const key_type &key) const { return M_equal_range(key); }
+    template <typename K, typename = typename std::enable_if<is_transparent_compare<Compare>::value, K>::type>
+    std::pair<iterator, iterator> equal_range(const K &key) const {
+        return M_equal_range(key);
+    }
+
+    //观察器
+    key_compare key_comp() const { return comp_; }
+    value_compare value_comp() const { return comp_; }
+
+protected:
+    container_type c_;
+    Compare comp_;
+
+    template <typename K>
+    iterator M_find(const K &key) const {
+        auto it = lower_bound(key);
+        return it != end() && !comp_(key, *it) ? it : end();
+    }
+    template <typename K>
+    std::pair<iterator, iterator> M_equal_range(const K &key) const {
+        auto it = lower_bound(key);
+        return {it, it != end() && !comp_(key, *it) ? std::next(it) : it};
+    }
+    template <typename V>
+    std::pair<iterator, bool> M_insert_unique(V &&value);
+    template <bool Sorted, typename InputIt>
+    void M_insert_batch(InputIt first, InputIt last);
+};
+
+template <typename Key, typename Compare, typename KeyContainer>
+flat_set<Key, Compare, KeyContainer>::flat_set(container_type cont, const Compare &comp) : comp_(comp) {
+    insert(std::make_move_iterator(cont.begin()), std::make_move_iterator(cont.end()));
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+flat_set<Key, Compare, KeyContainer> &flat_set<Key, Compare, KeyContainer>::operator=(std::initializer_list<value_type> init) {
+    clear();
+    insert(init.begin(), init.end());
+    return *this;
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+template <typename V>
+std::pair<typename flat_set<Key, Compare, KeyContainer>::iterator, bool> flat_set<Key, Compare, KeyContainer>::M_insert_unique(V &&value) {
+    auto it = lower_bound(value);
+    if (it != end() && !comp_(value, *it)) {
+        return {it, false};
+    }
+    return {c_.insert(it, std::forward<V>(value)), true};
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+template <typename... Args>
+typename flat_set<Key, Compare, KeyContainer>::iterator flat_set<Key, Compare, KeyContainer>::emplace_hint(const_iterator hint, Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    if ((hint == begin() || comp_(*std::prev(hint), value)) && (hint == end() || comp_(value, *hint))) {
+        return c_.insert(hint, std::move(value));
+    }
+    return M_insert_unique(std::move(value)).first;
+}
+
+//新元素先追加到末尾，按序挑出要插入的新元素移到临时数组，截去末尾多余的部分，再从后往前合并。
+//合并前原有元素未被改动，失败时截回原长度即可（强保证）；合并中失败时数组已被部分覆盖，只能清空。
+template <typename Key, typename Compare, typename KeyContainer>
+template <bool Sorted, typename InputIt>
+void flat_set<Key, Compare, KeyContainer>::M_insert_batch(InputIt first, InputIt last) {
+    auto n = c_.size();
+    vector<value_type> fresh;
+    try {
+        c_.insert(c_.end(), first, last);
+        auto order = flat_batch_order<Sorted>(c_, n, comp_);
+        fresh.reserve(order.size());
+        for (auto i : order) {
+            fresh.push_back(std::move(c_[n + i]));
+        }
+    } catch (...) {
+        c_.erase(c_.begin() + static_cast<difference_type>(n), c_.end());
+        throw;
+    }
+    auto k = fresh.size();
+    c_.erase(c_.begin() + static_cast<difference_type>(n + k), c_.end());
+    try {
+        flat_merge_back(
+            n, k, [&](size_t j, size_t i) { return comp_(fresh[j], c_[i]); }, [&](size_t w, size_t i) { c_[w] = std::move(c_[i]); },
+            [&](size_t w, size_t j) { c_[w] = std::move(fresh[j]); });
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+typename flat_set<Key, Compare, KeyContainer>::container_type flat_set<Key, Compare, KeyContainer>::extract() && {
+    auto result = std::move(c_);
+    c_.clear();
+    return result;
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+typename flat_set<Key, Compare, KeyContainer>::size_type flat_set<Key, Compare, KeyContainer>::erase(const key_type &key) {
+    auto it = M_find(key);
+    if (it == end()) {
+        return 0;
+    }
+    c_.erase(it);
+    return 1;
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+void flat_set<Key, Compare, KeyContainer>::swap(flat_set &other) noexcept {
+    c_.swap(other.c_);
+    std::swap(comp_, other.comp_);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+bool operator==(const flat_set<Key, Compare, KeyContainer> &lhs, const flat_set<Key, Compare, KeyContainer> &rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+bool operator!=(const flat_set<Key, Compare, KeyContainer> &lhs, const flat_set<Key, Compare, KeyContainer> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+bool operator<(const flat_set<Key, Compare, KeyContainer> &lhs, const flat_set<Key, Compare, KeyContainer> &rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+void swap(flat_set<Key, Compare, KeyContainer> &lhs, flat_set<Key, Compare, KeyContainer> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+} // namespace mystl
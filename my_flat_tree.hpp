@@ -0,0 +1,97 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "my_vector.hpp"
+
+namespace mystl {
+///flat_map 与 flat_set 的公共部分：有序数组上的查找与批量合并。
+
+///第一个不小于 key 的位置。每步只根据一次比较选择下一段的起点，编译为条件传送而非分支；
+///区间较长时预取下一步可能访问的两个位置，两次内存访问得以重叠。
+template <typename RandomIt, typename K, typename Compare>
+RandomIt flat_lower_bound(RandomIt first, RandomIt last, const K &key, const Compare &comp) {
+    auto len = static_cast<size_t>(last - first);
+    if (len == 0) {
+        return first;
+    }
+    while (len > 1) {
+        auto half = len / 2;
+        if (len > 64) {
+            __builtin_prefetch(std::addressof(first[half / 2]));
+            __builtin_prefetch(std::addressof(first[half + half / 2]));
+        }
+        first = comp(first[half], key) ? first + half : first;
+        len -= half;
+    }
+    return first + static_cast<std::ptrdiff_t>(comp(*first, key));
+}
+
+///第一个大于 key 的位置。
+template <typename RandomIt, typename K, typename Compare>
+RandomIt flat_upper_bound(RandomIt first, RandomIt last, const K &key, const Compare &comp) {
+    auto len = static_cast<size_t>(last - first);
+    if (len == 0) {
+        return first;
+    }
+    while (len > 1) {
+        auto half = len / 2;
+        if (len > 64) {
+            __builtin_prefetch(std::addressof(first[half / 2]));
+            __builtin_prefetch(std::addressof(first[half + half / 2]));
+        }
+        first = comp(key, first[half]) ? first : first + half;
+        len -= half;
+    }
+    return first + static_cast<std::ptrdiff_t>(!comp(key, *first));
+}
+
+///批量插入的第一步：新键已追加在 keys 的 [n, size) 中，返回其中应插入的新键的下标（相对 n ），按键升序，
+///批内重复的键只保留最先出现的一个，已在 [0, n) 中的键不再插入。 Sorted 为 true 时调用者保证批内已升序且无重复，不再排序。
+///批内的键升序，在 [0, n) 中的查找从上一个键的位置开始，总代价为 O(m log n) 。
+template <bool Sorted, typename Keys, typename Compare>
+vector<size_t> flat_batch_order(const Keys &keys, size_t n, const Compare &comp) {
+    auto base = keys.begin() + static_cast<std::ptrdiff_t>(n);
+    vector<size_t> order(keys.size() - n);
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    if (!Sorted) {
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return comp(base[a], base[b]); });
+    }
+    size_t kept = 0;
+    auto hint = keys.begin();
+    for (size_t i = 0; i < order.size(); ++i) {
+        const auto &key = base[order[i]];
+        if (kept > 0 && !comp(base[order[kept - 1]], key)) {
+            continue; //与批内前一个保留的键等价
+        }
+        hint = flat_lower_bound(hint, base, key, comp);
+        if (hint != base && !comp(key, *hint)) {
+            continue; //已在容器中
+        }
+        order[kept++] = order[i];
+    }
+    order.erase(order.begin() + static_cast<std::ptrdiff_t>(kept), order.end());
+    return order;
+}
+
+///批量插入的第二步：从后往前把 [0, n) 中的 n 个旧元素与 k 个已排序的新元素合并到 [0, n + k) 。
+///less(j, i) 判断第 j 个新元素是否小于第 i 个旧元素， move_old(w, i) 把旧元素 i 移到 w ， take_new(w, j) 把新元素 j 移到 w 。
+///只移动不小于最小新元素的旧元素，每个元素至多移动一次。
+template <typename Less, typename MoveOld, typename TakeNew>
+void flat_merge_back(size_t n, size_t k, Less less, MoveOld move_old, TakeNew take_new) {
+    auto i = n;
+    auto j = k;
+    auto w = n + k;
+    while (j > 0) {
+        if (i > 0 && less(j - 1, i - 1)) {
+            move_old(--w, --i);
+        } else {
+            take_new(--w, --j);
+        }
+    }
+}
+} // namespace mystl
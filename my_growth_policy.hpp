@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+
+namespace mystl {
+//增长策略：容器需要扩容时，由 next_capacity(当前容量, 至少需要的元素数, 元素大小) 决定新的容量（以元素计）。
+//返回值小于所需元素数时，容器会改用所需元素数。
+
+///精确增长，只申请恰好够用的空间。适合只构造一次、不再增长的容器。
+struct exact_growth {
+    static size_t next_capacity(size_t, size_t required, size_t) noexcept { return required; }
+};
+
+///二倍增长，均摊插入开销最低，但最坏情况下浪费接近一半的内存。
+struct double_growth {
+    static size_t next_capacity(size_t capacity, size_t required, size_t) noexcept {
+        auto grown = capacity * 2;
+        return grown > required ? grown : required;
+    }
+};
+
+///1.5 倍增长，释放的旧内存块之和最终可以容纳新的申请，便于分配器复用。
+struct one_and_half_growth {
+    static size_t next_capacity(size_t capacity, size_t required, size_t) noexcept {
+        auto grown = capacity + capacity / 2;
+        return grown > required ? grown : required;
+    }
+};
+
+///黄金分割增长，以 1 + 1/2 + 1/8 = 1.625 近似 1.618 。
+struct golden_growth {
+    static size_t next_capacity(size_t capacity, size_t required, size_t) noexcept {
+        auto grown = capacity + capacity / 2 + capacity / 8;
+        return grown > required ? grown : required;
+    }
+};
+
+///页粒度增长。先按 Base 策略计算容量，再把字节数向上取整到 PageSize 的倍数，让大块内存不留下半页的空洞。
+template <typename Base = double_growth, size_t PageSize = 4096>
+struct page_growth {
+    static_assert((PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two");
+
+    static size_t next_capacity(size_t capacity, size_t required, size_t elem_size) noexcept {
+        auto bytes = Base::next_capacity(capacity, required, elem_size) * elem_size;
+        bytes = (bytes + PageSize - 1) & ~(PageSize - 1);
+        return bytes / elem_size;
+    }
+};
+
+///按 jemalloc 的尺寸分级取整：16 字节以内按 8 对齐，128 字节以内按 16 对齐，
+///更大的尺寸在每个 [2^k, 2^(k+1)] 区间内划分为 4 级。分配器本来就会给出这么多字节，容器把它们全部用作容量。
+template <typename Base = double_growth>
+struct size_class_growth {
+    static size_t round_to_size_class(size_t bytes) noexcept {
+        if (bytes <= 16) {
+            return (bytes + 7) & ~size_t(7);
+        }
+        if (bytes <= 128) {
+            return (bytes + 15) & ~size_t(15);
+        }
+        size_t lg = 0;
+        for (auto n = bytes - 1; n > 1; n >>= 1) {
+            ++lg;
+        }
+        auto delta = size_t(1) << (lg - 2);
+        return (bytes + delta - 1) & ~(delta - 1);
+    }
+
+    static size_t next_capacity(size_t capacity, size_t required, size_t elem_size) noexcept {
+        auto bytes = Base::next_capacity(capacity, required, elem_size) * elem_size;
+        return round_to_size_class(bytes) / elem_size;
+    }
+};
+
+///一次增长模拟的统计结果。
+struct growth_report {
+    size_t capacity = 0;        //最终容量（元素数）
+    size_t wasted_bytes = 0;    //最终未使用的字节数
+    size_t reallocations = 0;   //重新分配的次数
+    size_t allocated_bytes = 0; //累计申请的字节数
+    size_t copied_bytes = 0;    //累计搬迁的字节数
+};
+
+///模拟从空容器逐个追加 count 个大小为 elem_size 的元素，统计 Policy 留下的浪费与搬迁代价。
+template <typename Policy>
+growth_report simulate_growth(size_t count, size_t elem_size) noexcept {
+    growth_report report;
+    for (size_t size = 0; size < count; ++size) {
+        if (size == report.capacity) {
+            auto new_capacity = Policy::next_capacity(report.capacity, size + 1, elem_size);
+            if (new_capacity < size + 1) {
+                new_capacity = size + 1;
+            }
+            report.copied_bytes += size * elem_size;
+            report.allocated_bytes += new_capacity * elem_size;
+            report.capacity = new_capacity;
+            ++report.reallocations;
+        }
+    }
+    report.wasted_bytes = (report.capacity - count) * elem_size;
+    return report;
+}
+
+///返回容器已申请但尚未使用的字节数。
+template <typename Container>
+size_t wasted_bytes(const Container &c) noexcept {
+    return (c.capacity() - c.size()) * sizeof(typename Container::value_type);
+}
+} // namespace mystl
@@ -0,0 +1,751 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MYTINYSTL_HASH_GROUP_SSE2 1
+#include <emmintrin.h>
+#else
+#define MYTINYSTL_HASH_GROUP_SSE2 0
+#endif
+
+#include "my_memory.hpp"
+#include "my_simd.hpp"
+#include "my_utility.hpp"
+#include "my_vector.hpp"
+
+namespace mystl {
+///连续 16 个桶的控制字节。空桶为 0x80 ，有元素的桶为其哈希值的低 7 位，一次比较即可筛出整组中可能命中的桶。
+///SSE2 是 x86-64 的基线指令集，编译期即可确定，不需要运行期分派；其他平台逐字节比较。
+struct hash_group {
+    static constexpr size_t width = 16;
+    static constexpr uint8_t empty = 0x80;
+
+#if MYTINYSTL_HASH_GROUP_SSE2
+    __m128i ctrl;
+
+    explicit hash_group(const uint8_t *p) noexcept : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))) {}
+
+    uint32_t match(uint8_t h2) const noexcept { return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(h2))))); }
+    uint32_t match_empty() const noexcept { return static_cast<uint32_t>(_mm_movemask_epi8(ctrl)); } //只有空桶的最高位为 1 。
+#else
+    uint8_t ctrl[width];
+
+    explicit hash_group(const uint8_t *p) noexcept { std::memcpy(ctrl, p, width); }
+
+    uint32_t match(uint8_t h2) const noexcept {
+        uint32_t m = 0;
+        for (size_t i = 0; i < width; ++i) {
+            m |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+        }
+        return m;
+    }
+    uint32_t match_empty() const noexcept {
+        uint32_t m = 0;
+        for (size_t i = 0; i < width; ++i) {
+            m |= static_cast<uint32_t>(ctrl[i] >> 7) << i;
+        }
+        return m;
+    }
+#endif
+};
+
+///一个桶：元素在元素数组中的下标，以及元素哈希值中决定起始桶的部分（低 32 位）。
+///删除时判断探测链上的元素能否前移、扩容时重新放置，都只读桶本身，不访问元素也不重新计算哈希值。
+struct hash_bucket {
+    uint32_t index;
+    uint32_t hash;
+};
+
+///Hash 与 KeyEqual 都声明了 is_transparent 时，查找接受任何可与键比较的类型，不必先构造键。
+template <typename Hash, typename KeyEqual, typename = void>
+struct is_transparent_lookup : std::false_type {};
+
+template <typename Hash, typename KeyEqual>
+struct is_transparent_lookup<Hash, KeyEqual, std::void_t<typename Hash::is_transparent, typename KeyEqual::is_transparent>> : std::true_type {};
+
+///开放寻址哈希表， unordered_map 与 unordered_set 的公共实现。
+///元素按插入顺序连续存放在 vector 中，迭代器就是 vector 的迭代器；桶数组只保存元素下标与部分哈希值，另有一个控制字节数组。
+///桶数为 2 的幂，从哈希值决定的起始桶开始线性探测，每次取 16 个控制字节成组比较，遇到含空桶的组即停止。
+///控制字节数组末尾额外复制前 15 个字节，探测到表尾时无需回绕即可整组读取。
+///删除不留墓碑：同一探测链上后面的桶依次前移填补空桶（backward shift），元素数组中的空位由末尾元素填补。
+///因此插入可能使所有迭代器失效（元素数组扩容），删除使被删元素与原末尾元素的迭代器失效；
+///erase 返回的迭代器指向填补进来的原末尾元素，边遍历边删除时每个剩余元素恰好访问一次。
+template <typename Value, typename Key, typename KeyOfValue, typename Hash, typename KeyEqual, typename Alloc>
+class hash_table {
+    using value_storage = vector<Value, Alloc>;
+    using bucket_storage = vector_base<hash_bucket, Alloc>;
+    using value_alloc_traits = std::allocator_traits<Alloc>;
+
+public:
+    using key_type = Key;
+    using value_type = Value;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Alloc;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using const_iterator = vector_const_iterator<value_type>;
+    //set 的元素就是键，不能通过迭代器修改。
+    using iterator = typename std::conditional<std::is_same<Value, Key>::value, const_iterator, vector_iterator<value_type>>::type;
+
+    //构造函数
+    hash_table() : hash_table(0) {}
+    explicit hash_table(size_type bucket_count, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual(), const Alloc &alloc = Alloc());
+    hash_table(size_type bucket_count, const Alloc &alloc) : hash_table(bucket_count, Hash(), KeyEqual(), alloc) {}
+    hash_table(size_type bucket_count, const Hash &hash, const Alloc &alloc) : hash_table(bucket_count, hash, KeyEqual(), alloc) {}
+    explicit hash_table(const Alloc &alloc) : hash_table(0, Hash(), KeyEqual(), alloc) {}
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    hash_table(InputIt first, InputIt last, size_type bucket_count = 0, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual(),
+               const Alloc &alloc = Alloc());
+    hash_table(std::initializer_list<value_type> init, size_type bucket_count = 0, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual(),
+               const Alloc &alloc = Alloc());
+    hash_table(const hash_table &other);
+    hash_table(const hash_table &other, const Alloc &alloc);
+    hash_table(hash_table &&other) noexcept;
+    hash_table(hash_table &&other, const Alloc &alloc);
+
+    hash_table &operator=(const hash_table &other);
+    hash_table &operator=(hash_table &&other)
+        noexcept(value_alloc_traits::propagate_on_container_move_assignment::value || value_alloc_traits::is_always_equal::value);
+    hash_table &operator=(std::initializer_list<value_type> init);
+
+    allocator_type get_allocator() const noexcept { return values_.get_allocator(); }
+
+    //迭代器，按插入顺序遍历
+    iterator begin() noexcept { return iterator(values_.data()); }
+    const_iterator begin() const noexcept { return values_.begin(); }
+    const_iterator cbegin() const noexcept { return values_.begin(); }
+    iterator end() noexcept { return iterator(values_.data() + values_.size()); }
+    const_iterator end() const noexcept { return values_.end(); }
+    const_iterator cend() const noexcept { return values_.end(); }
+
+    //容量
+    bool empty() const noexcept { return values_.empty(); }
+    size_type size() const noexcept { return values_.size(); }
+    size_type max_size() const noexcept; //桶中以 32 位保存元素下标，元素数不超过 2^32 - 1 。
+
+    //修改器
+    void clear() noexcept; //删除所有元素，保留桶数组与元素数组的容量。
+    std::pair<iterator, bool> insert(const value_type &value) { return M_emplace_key(KeyOfValue()(value), value); }
+    std::pair<iterator, bool> insert(value_type &&value) { return M_emplace_key(KeyOfValue()(value), std::move(value)); }
+    template <typename P, typename = typename std::enable_if<std::is_constructible<value_type, P &&>::value>::type>
+    std::pair<iterator, bool> insert(P &&value) {
+        return emplace(std::forward<P>(value));
+    }
+    iterator insert(const_iterator, const value_type &value) { return insert(value).first; } //开放寻址没有可利用的位置提示，忽略 hint 。
+    iterator insert(const_iterator, value_type &&value) { return insert(std::move(value)).first; }
+    template <typename InputIt, typename = RequireInputIter<InputIt>>
+    void insert(InputIt first, InputIt last);
+    void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args &&...args); //先在元素数组末尾构造元素再查找，键已存在时销毁新元素。
+    template <typename... Args>
+    iterator emplace_hint(const_iterator, Args &&...args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+    iterator erase(const_iterator pos);                        //删除 pos 处的元素，返回指向填补该位置的元素的迭代器。
+    iterator erase(const_iterator first, const_iterator last); //删除 [first, last) 中的元素，从后往前删，区间外的元素填补进来。
+    size_type erase(const key_type &key);
+    void swap(hash_table &other) noexcept;
+
+    //查找
+    iterator find(const key_type &key) { return M_iter_or_end(M_find(key)); }
+    const_iterator find(const key_type &key) const { return M_iter_or_end(M_find(key)); }
+    template <typename K, typename = typename std::enable_if<is_transparent_lookup<Hash, KeyEqual>::value, K>::type>
+    iterator find(const K &key) {
+        return M_iter_or_end(M_find(key));
+    }
+    template <typename K, typename = typename std::enable_if<is_transparent_lookup<Hash, KeyEqual>::value, K>::type>
+    const_iterator find(const K &key) const {
+        return M_iter_or_end(M_find(key));
+    }
+    size_type count(const key_type &key) const { return M_find(key) != npos; }
+    template <typename K, typename = typename std::enable_if<is_transparent_lookup<Hash, KeyEqual>::value, K>::type>
+    size_type count(const K &key) const {
+        return M_find(key) != npos;
+    }
+    bool contains(const key_type &key) const { return M_find(key) != npos; }
+    template <typename K, typename = typename std::enable_if<is_transparent_lookup<Hash, KeyEqual>::value, K>::type>
+    bool contains(const K &key) const {
+        return M_find(key) != npos;
+    }
+    std::pair<iterator, iterator> equal_range(const key_type &key) { return M_equal_range(find(key)); }
+    std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const { return M_equal_range(find(key)); }
+    template <typename K, typename = typename std::enable_if<is_transparent_lookup<Hash, KeyEqual>::value, K>::type>
+    std::pair<iterator, iterator> equal_range(const K &key) {
+        return M_equal_range(find(key));
+    }
+    template <typename K, typename = typename std::enable_if<is_transparent_lookup<Hash, KeyEqual>::value, K>::type>
+    std::pair<const_iterator, const_iterator> equal_range(const K &key) const {
+        return M_equal_range(find(key));
+    }
+
+    //桶与哈希策略
+    size_type bucket_count() const noexcept { return buckets_.M_impl.M_start ? mask_ + 1 : 0; }
+    size_type max_bucket_count() const noexcept { return size_type(1) << (std::numeric_limits<uint32_t>::digits - 1); }
+    float load_factor() const noexcept { return bucket_count() ? static_cast<float>(size()) / static_cast<float>(bucket_count()) : 0.0f; }
+    float max_load_factor() const noexcept { return max_load_; }
+    void max_load_factor(float ml); //线性探测在高负载下探测链急剧变长，取值限制在 [0.125, 0.875] 。
+    void rehash(size_type count);   //桶数调整为不小于 count 且能容纳当前元素的 2 的幂， count 为 0 时收缩到最小。
+    void reserve(size_type count);  //预留 count 个元素的桶与元素数组，此后插入 count 个元素前不会重新哈希或扩容。
+
+    //观察器
+    hasher hash_function() const { return hash_; }
+    key_equal key_eq() const { return equal_; }
+
+protected:
+    static constexpr size_type npos = static_cast<size_type>(-1);
+    static constexpr size_type min_buckets = hash_group::width;
+
+    value_storage values_;   //元素数组
+    bucket_storage buckets_; //前 mask_ + 1 项为各个桶，其后为控制字节
+    uint8_t *ctrl_;          //控制字节，共 mask_ + 1 + 15 个；没有桶时指向一组只读的空控制字节
+    size_type mask_ = 0;     //桶数减一
+    size_type growth_limit_ = 0; //元素数达到此值时扩容
+    float max_load_ = 0.875f;
+    Hash hash_;
+    KeyEqual equal_;
+
+    ///所有空表共享的一组空控制字节，查找无需判断表是否为空。插入前总会先扩容，不会写入这组字节。
+    static uint8_t *M_empty_group() noexcept {
+        alignas(hash_group::width) static const uint8_t group[hash_group::width] = {
+            hash_group::empty, hash_group::empty, hash_group::empty, hash_group::empty, hash_group::empty, hash_group::empty,
+            hash_group::empty, hash_group::empty, hash_group::empty, hash_group::empty, hash_group::empty, hash_group::empty,
+            hash_group::empty, hash_group::empty, hash_group::empty, hash_group::empty};
+        return const_cast<uint8_t *>(group);
+    }
+
+    ///混合用户哈希值的高低位。 std::hash 对整数是恒等映射，直接取低位会让步长规律的键挤在同一段桶中。
+    static size_type M_mix(size_type h) noexcept {
+        constexpr size_type multiplier = sizeof(size_type) == 8 ? static_cast<size_type>(0x9E3779B97F4A7C15ull) : static_cast<size_type>(0x9E3779B9u);
+        h *= multiplier;
+        return h ^ (h >> (sizeof(size_type) * 4));
+    }
+    template <typename K>
+    size_type M_hash(const K &key) const {
+        return M_mix(static_cast<size_type>(hash_(key)));
+    }
+    size_type M_hash_at(size_type index) const { return M_hash(KeyOfValue()(values_[index])); }
+    hash_bucket *M_slots() const noexcept { return buckets_.M_impl.M_start; }
+    static size_type M_storage_for(size_type buckets) noexcept { //桶与控制字节共占的 hash_bucket 数
+        return buckets + (buckets + hash_group::width - 1 + sizeof(hash_bucket) - 1) / sizeof(hash_bucket);
+    }
+    static size_type M_h1(size_type hash) noexcept { return hash >> 7; }                              //决定起始桶
+    static uint8_t M_h2(size_type hash) noexcept { return static_cast<uint8_t>(hash & 0x7F); }        //存入控制字节
+    size_type M_limit_for(size_type buckets) const noexcept;                                           //buckets 个桶最多容纳的元素数
+    size_type M_buckets_for(size_type count) const;                                                    //容纳 count 个元素所需的最少桶数
+
+    iterator M_iter(size_type index) noexcept { return iterator(values_.data() + index); }
+    iterator M_iter_or_end(size_type index) noexcept { return index == npos ? end() : M_iter(index); }
+    const_iterator M_iter_or_end(size_type index) const noexcept { return index == npos ? end() : begin() + static_cast<difference_type>(index); }
+    std::pair<iterator, iterator> M_equal_range(iterator it) {
+        return {it, it == end() ? it : std::next(it)};
+    }
+    std::pair<const_iterator, const_iterator> M_equal_range(const_iterator it) const {
+        return {it, it == end() ? it : std::next(it)};
+    }
+
+    ///设置桶 b 的控制字节，前 15 个桶同时写入表尾的副本。
+    void M_set_ctrl(size_type b, uint8_t c) noexcept {
+        ctrl_[b] = c;
+        ctrl_[((b - (hash_group::width - 1)) & mask_) + (hash_group::width - 1)] = c;
+    }
+
+    ///查找键为 key 的元素，返回其下标，没有时返回 npos 。
+    template <typename K>
+    size_type M_find(const K &key) const;
+    ///查找键为 key 的元素。找到时返回 true ， bucket 为其所在的桶；否则 bucket 为探测链上第一个空桶，即插入位置。
+    template <typename K>
+    bool M_find_or_empty(const K &key, size_type hash, size_type &bucket) const;
+    size_type M_find_empty(size_type hash) const noexcept; //探测链上第一个空桶
+    size_type M_bucket_of(size_type index) const;          //元素 index 所在的桶
+
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> M_emplace_key(const K &key, Args &&...args); //键已知的插入：先查找，键不存在时才构造元素。
+    void M_rehash(size_type buckets);                                      //以 buckets 个桶重建桶数组，只搬动桶，元素数组不动。
+    void M_set_bucket(size_type b, size_type index, size_type hash) noexcept {
+        M_slots()[b] = hash_bucket{static_cast<uint32_t>(index), static_cast<uint32_t>(M_h1(hash))};
+        M_set_ctrl(b, M_h2(hash));
+    }
+    void M_erase_bucket(size_type hole);                                   //清空桶 hole ，探测链上后面的桶依次前移。
+    ///删除下标为 index 的元素，末尾元素搬入空位。 pair<const Key, T> 的搬迁要复制键，复制或哈希函数抛出异常时调用 std::terminate 。
+    void M_erase_index(size_type index) noexcept;
+    template <typename InputIt>
+    void M_reserve_range(InputIt, InputIt, std::input_iterator_tag) {}
+    ///区间长度已知时预先扩容，区间内有重复键时多预留的空间留给之后的插入。
+    template <typename ForwardIt>
+    void M_reserve_range(ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+        reserve(size() + static_cast<size_type>(std::distance(first, last)));
+    }
+    void M_release_buckets() noexcept;
+    void M_copy_buckets(const hash_table &other);
+    void M_move_assign(hash_table &other, std::true_type) noexcept;
+    void M_move_assign(hash_table &other, std::false_type);
+};
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+hash_table<V, K, KoV, H, E, A>::hash_table(size_type bucket_count, const H &hash, const E &equal, const A &alloc)
+    : values_(alloc), buckets_(typename bucket_storage::T_alloc_type(alloc)), ctrl_(M_empty_group()), hash_(hash), equal_(equal) {
+    if (bucket_count) {
+        rehash(bucket_count);
+    }
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+template <typename InputIt, typename>
+hash_table<V, K, KoV, H, E, A>::hash_table(InputIt first, InputIt last, size_type bucket_count, const H &hash, const E &equal, const A &alloc)
+    : hash_table(bucket_count, hash, equal, alloc) {
+    insert(first, last);
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+hash_table<V, K, KoV, H, E, A>::hash_table(std::initializer_list<value_type> init, size_type bucket_count, const H &hash, const E &equal, const A &alloc)
+    : hash_table(bucket_count, hash, equal, alloc) {
+    insert(init.begin(), init.end());
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+hash_table<V, K, KoV, H, E, A>::hash_table(const hash_table &other)
+    : hash_table(other, value_alloc_traits::select_on_container_copy_construction(other.get_allocator())) {}
+
+//元素按原顺序复制，下标不变，桶数组整块复制即可，无需重新哈希。
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+hash_table<V, K, KoV, H, E, A>::hash_table(const hash_table &other, const A &alloc)
+    : values_(other.values_.begin(), other.values_.end(), alloc), buckets_(typename bucket_storage::T_alloc_type(alloc)), ctrl_(M_empty_group()),
+      max_load_(other.max_load_), hash_(other.hash_), equal_(other.equal_) {
+    M_copy_buckets(other);
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+hash_table<V, K, KoV, H, E, A>::hash_table(hash_table &&other) noexcept
+    : values_(std::move(other.values_)), buckets_(std::move(other.buckets_)), ctrl_(other.ctrl_), mask_(other.mask_), growth_limit_(other.growth_limit_),
+      max_load_(other.max_load_), hash_(other.hash_), equal_(other.equal_) {
+    other.ctrl_ = M_empty_group();
+    other.mask_ = 0;
+    other.growth_limit_ = 0;
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+hash_table<V, K, KoV, H, E, A>::hash_table(hash_table &&other, const A &alloc)
+    : values_(std::move(other.values_), alloc), buckets_(typename bucket_storage::T_alloc_type(alloc)), ctrl_(M_empty_group()),
+      max_load_(other.max_load_), hash_(other.hash_), equal_(other.equal_) {
+    //元素数组无论是接管还是逐个移动，下标都不变。
+    M_copy_buckets(other);
+    other.clear();
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+hash_table<V, K, KoV, H, E, A> &hash_table<V, K, KoV, H, E, A>::operator=(const hash_table &other) {
+    if (this == &other) {
+        return *this;
+    }
+    using propagate = typename value_alloc_traits::propagate_on_container_copy_assignment;
+    if (propagate::value && get_allocator() != other.get_allocator()) {
+        //桶数组只能由旧分配器释放，必须在替换分配器之前归还。
+        M_release_buckets();
+    }
+    clear();
+    alloc_on_copy(buckets_.M_get_allocator(), other.buckets_.M_get_allocator(), propagate());
+    max_load_ = other.max_load_;
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+    //先复制桶数组再复制元素：桶数组分配失败时本表仍是空表；元素复制失败时清空，不留下没有桶的元素。
+    M_copy_buckets(other);
+    try {
+        values_ = other.values_;
+    } catch (...) {
+        clear();
+        throw;
+    }
+    return *this;
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+hash_table<V, K, KoV, H, E, A> &hash_table<V, K, KoV, H, E, A>::operator=(hash_table &&other) noexcept(
+    value_alloc_traits::propagate_on_container_move_assignment::value || value_alloc_traits::is_always_equal::value) {
+    if (this == &other) {
+        return *this;
+    }
+    M_move_assign(other, std::integral_constant<bool, value_alloc_traits::propagate_on_container_move_assignment::value ||
+                                                          value_alloc_traits::is_always_equal::value>());
+    return *this;
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+hash_table<V, K, KoV, H, E, A> &hash_table<V, K, KoV, H, E, A>::operator=(std::initializer_list<value_type> init) {
+    clear();
+    insert(init.begin(), init.end());
+    return *this;
+}
+
+//接管 other 的元素数组与桶数组。
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+void hash_table<V, K, KoV, H, E, A>::M_move_assign(hash_table &other, std::true_type) noexcept {
+    M_release_buckets();
+    values_ = std::move(other.values_);
+    buckets_.M_impl.M_swap_data(other.buckets_.M_impl);
+    alloc_on_move(buckets_.M_get_allocator(), other.buckets_.M_get_allocator(), typename value_alloc_traits::propagate_on_container_move_assignment());
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(mask_, other.mask_);
+    std::swap(growth_limit_, other.growth_limit_);
+    max_load_ = other.max_load_;
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+}
+
+//分配器不传播且不相等时，元素逐个移动到本容器的内存中，下标不变，桶数组照样复制。
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+void hash_table<V, K, KoV, H, E, A>::M_move_assign(hash_table &other, std::false_type) {
+    if (get_allocator() == other.get_allocator()) {
+        M_move_assign(other, std::true_type());
+        return;
+    }
+    clear();
+    max_load_ = other.max_load_;
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+    M_copy_buckets(other);
+    try {
+        values_ = std::move(other.values_);
+    } catch (...) {
+        clear();
+        throw;
+    }
+    other.clear();
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+void hash_table<V, K, KoV, H, E, A>::M_release_buckets() noexcept {
+    buckets_.M_deallocate(buckets_.M_impl.M_start, buckets_.M_impl.M_end_of_storage - buckets_.M_impl.M_start);
+    buckets_.M_impl.M_start = buckets_.M_impl.M_finish = buckets_.M_impl.M_end_of_storage = nullptr;
+    ctrl_ = M_empty_group();
+    mask_ = 0;
+    growth_limit_ = 0;
+}
+
+//values_ 已与 other 的元素逐一对应，桶数组按字节复制。
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+void hash_table<V, K, KoV, H, E, A>::M_copy_buckets(const hash_table &other) {
+    if (!other.bucket_count()) {
+        M_release_buckets();
+        return;
+    }
+    auto words = M_storage_for(other.bucket_count());
+    if (bucket_count() != other.bucket_count()) {
+        auto storage = buckets_.M_allocate(words);
+        M_release_buckets();
+        buckets_.M_impl.M_start = buckets_.M_impl.M_finish = storage;
+        buckets_.M_impl.M_end_of_storage = storage + words;
+    }
+    std::memcpy(buckets_.M_impl.M_start, other.buckets_.M_impl.M_start, words * sizeof(hash_bucket));
+    ctrl_ = reinterpret_cast<uint8_t *>(buckets_.M_impl.M_start + other.bucket_count());
+    mask_ = other.mask_;
+    growth_limit_ = other.growth_limit_;
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+typename hash_table<V, K, KoV, H, E, A>::size_type hash_table<V, K, KoV, H, E, A>::max_size() const noexcept {
+    size_type limit = std::numeric_limits<uint32_t>::max() - 1;
+    return values_.max_size() < limit ? values_.max_size() : limit;
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+void hash_table<V, K, KoV, H, E, A>::clear() noexcept {
+    values_.clear();
+    if (bucket_count()) {
+        std::memset(ctrl_, hash_group::empty, bucket_count() + hash_group::width - 1);
+    }
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+template <typename InputIt, typename>
+void hash_table<V, K, KoV, H, E, A>::insert(InputIt first, InputIt last) {
+    M_reserve_range(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+    for (; first != last; ++first) {
+        emplace(*first);
+    }
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+template <typename... Args>
+std::pair<typename hash_table<V, K, KoV, H, E, A>::iterator, bool> hash_table<V, K, KoV, H, E, A>::emplace(Args &&...args) {
+    auto index = size();
+    values_.emplace_back(std::forward<Args>(args)...);
+    size_type hash, bucket;
+    bool found;
+    try {
+        const auto &key = KoV()(values_.back());
+        hash = M_hash(key);
+        found = M_find_or_empty(key, hash, bucket);
+    } catch (...) {
+        values_.pop_back();
+        throw;
+    }
+    if (found) {
+        values_.pop_back();
+        return {M_iter(M_slots()[bucket].index), false};
+    }
+    if (index >= growth_limit_) {
+        try {
+            M_rehash(M_buckets_for(index + 1));
+        } catch (...) {
+            values_.pop_back();
+            throw;
+        }
+        bucket = M_find_empty(hash);
+    }
+    M_set_bucket(bucket, index, hash);
+    return {M_iter(index), true};
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+template <typename Key2, typename... Args>
+std::pair<typename hash_table<V, K, KoV, H, E, A>::iterator, bool> hash_table<V, K, KoV, H, E, A>::M_emplace_key(const Key2 &key, Args &&...args) {
+    auto hash = M_hash(key);
+    size_type bucket;
+    if (M_find_or_empty(key, hash, bucket)) {
+        return {M_iter(M_slots()[bucket].index), false};
+    }
+    auto index = size();
+    if (index >= growth_limit_) {
+        M_rehash(M_buckets_for(index + 1));
+        bucket = M_find_empty(hash);
+    }
+    //参数可能引用本表中的元素， emplace_back 扩容时先构造新元素再搬迁旧元素。
+    values_.emplace_back(std::forward<Args>(args)...);
+    M_set_bucket(bucket, index, hash);
+    return {M_iter(index), true};
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+typename hash_table<V, K, KoV, H, E, A>::iterator hash_table<V, K, KoV, H, E, A>::erase(const_iterator pos) {
+    auto index = static_cast<size_type>(pos - cbegin());
+    M_erase_index(index);
+    return M_iter(index);
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+typename hash_table<V, K, KoV, H, E, A>::iterator hash_table<V, K, KoV, H, E, A>::erase(const_iterator first, const_iterator last) {
+    auto from = static_cast<size_type>(first - cbegin());
+    //从后往前删，每次填补进来的原末尾元素都在区间之外。
+    for (auto index = static_cast<size_type>(last - cbegin()); index > from;) {
+        M_erase_index(--index);
+    }
+    return M_iter(from);
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+typename hash_table<V, K, KoV, H, E, A>::size_type hash_table<V, K, KoV, H, E, A>::erase(const key_type &key) {
+    auto index = M_find(key);
+    if (index == npos) {
+        return 0;
+    }
+    M_erase_index(index);
+    return 1;
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+void hash_table<V, K, KoV, H, E, A>::swap(hash_table &other) noexcept {
+    values_.swap(other.values_);
+    buckets_.M_impl.M_swap_data(other.buckets_.M_impl);
+    alloc_on_swap(buckets_.M_get_allocator(), other.buckets_.M_get_allocator(), typename value_alloc_traits::propagate_on_container_swap());
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(mask_, other.mask_);
+    std::swap(growth_limit_, other.growth_limit_);
+    std::swap(max_load_, other.max_load_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+void hash_table<V, K, KoV, H, E, A>::max_load_factor(float ml) {
+    max_load_ = ml < 0.125f ? 0.125f : ml > 0.875f ? 0.875f : ml;
+    if (bucket_count()) {
+        growth_limit_ = M_limit_for(bucket_count());
+        if (size() > growth_limit_) {
+            M_rehash(M_buckets_for(size()));
+        }
+    }
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+void hash_table<V, K, KoV, H, E, A>::rehash(size_type count) {
+    if (!count && empty()) {
+        M_release_buckets();
+        return;
+    }
+    auto buckets = M_buckets_for(size());
+    while (buckets < count) {
+        buckets *= 2;
+    }
+    if (buckets != bucket_count()) {
+        M_rehash(buckets);
+    }
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+void hash_table<V, K, KoV, H, E, A>::reserve(size_type count) {
+    if (count > growth_limit_) {
+        M_rehash(M_buckets_for(count));
+    }
+    values_.reserve(count);
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+typename hash_table<V, K, KoV, H, E, A>::size_type hash_table<V, K, KoV, H, E, A>::M_limit_for(size_type buckets) const noexcept {
+    auto limit = static_cast<size_type>(static_cast<double>(buckets) * max_load_);
+    return limit < buckets ? limit : buckets - 1; //至少留一个空桶，探测总能终止
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+typename hash_table<V, K, KoV, H, E, A>::size_type hash_table<V, K, KoV, H, E, A>::M_buckets_for(size_type count) const {
+    if (count > max_size()) {
+        throw std::length_error("hash_table too long");
+    }
+    size_type buckets = min_buckets;
+    while (M_limit_for(buckets) < count) {
+        buckets *= 2;
+    }
+    if (buckets > max_bucket_count()) { //桶中只保存哈希值的低 32 位，桶数更多时无法由它得出起始桶
+        throw std::length_error("hash_table too long");
+    }
+    return buckets;
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+template <typename Key2>
+typename hash_table<V, K, KoV, H, E, A>::size_type hash_table<V, K, KoV, H, E, A>::M_find(const Key2 &key) const {
+    size_type bucket;
+    return M_find_or_empty(key, M_hash(key), bucket) ? M_slots()[bucket].index : npos;
+}
+
+//起始桶到元素所在桶之间没有空桶，因此遇到含空桶的组时，若本组没有命中，元素一定不存在。
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+template <typename Key2>
+bool hash_table<V, K, KoV, H, E, A>::M_find_or_empty(const Key2 &key, size_type hash, size_type &bucket) const {
+    auto h2 = M_h2(hash);
+    __builtin_prefetch(M_slots() + (M_h1(hash) & mask_)); //桶与控制字节不在同一缓存行，与控制字节的读取并行
+    for (auto pos = M_h1(hash) & mask_;; pos = (pos + hash_group::width) & mask_) {
+        hash_group g(ctrl_ + pos);
+        for (auto m = g.match(h2); m; m &= m - 1) {
+            auto b = (pos + simd::lowest_bit(m)) & mask_;
+            if (equal_(KoV()(values_[M_slots()[b].index]), key)) {
+                bucket = b;
+                return true;
+            }
+        }
+        if (auto m = g.match_empty()) {
+            bucket = (pos + simd::lowest_bit(m)) & mask_;
+            return false;
+        }
+    }
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+typename hash_table<V, K, KoV, H, E, A>::size_type hash_table<V, K, KoV, H, E, A>::M_find_empty(size_type hash) const noexcept {
+    for (auto pos = M_h1(hash) & mask_;; pos = (pos + hash_group::width) & mask_) {
+        if (auto m = hash_group(ctrl_ + pos).match_empty()) {
+            return (pos + simd::lowest_bit(m)) & mask_;
+        }
+    }
+}
+
+//按哈希值探测，比较桶中的下标而不是键。
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+typename hash_table<V, K, KoV, H, E, A>::size_type hash_table<V, K, KoV, H, E, A>::M_bucket_of(size_type index) const {
+    auto hash = M_hash_at(index);
+    auto h2 = M_h2(hash);
+    for (auto pos = M_h1(hash) & mask_;; pos = (pos + hash_group::width) & mask_) {
+        for (auto m = hash_group(ctrl_ + pos).match(h2); m; m &= m - 1) {
+            auto b = (pos + simd::lowest_bit(m)) & mask_;
+            if (M_slots()[b].index == index) {
+                return b;
+            }
+        }
+    }
+}
+
+//按桶中保存的哈希值重新放置各桶，不访问元素，也不调用哈希函数。
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+void hash_table<V, K, KoV, H, E, A>::M_rehash(size_type buckets) {
+    auto words = M_storage_for(buckets);
+    bucket_storage storage(words, buckets_.M_get_allocator());
+    storage.M_impl.M_finish = storage.M_impl.M_end_of_storage;
+    auto ctrl = reinterpret_cast<uint8_t *>(storage.M_impl.M_start + buckets);
+    std::memset(ctrl, hash_group::empty, buckets + hash_group::width - 1);
+    auto old_ctrl = ctrl_;
+    auto old_buckets = bucket_count();
+    buckets_.M_impl.M_swap_data(storage.M_impl);
+    ctrl_ = ctrl;
+    mask_ = buckets - 1;
+    growth_limit_ = M_limit_for(buckets);
+    for (size_type b = 0; b < old_buckets; ++b) {
+        if (old_ctrl[b] != hash_group::empty) {
+            auto &old = storage.M_impl.M_start[b];
+            auto nb = M_find_empty(static_cast<size_type>(old.hash) << 7);
+            M_slots()[nb] = old;
+            M_set_ctrl(nb, old_ctrl[b]);
+        }
+    }
+}
+
+//后面的桶 j 中的元素从起始桶 home 探测到 j ，若空桶 hole 位于 [home, j) 之间，把它前移到 hole 仍可被找到。
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+void hash_table<V, K, KoV, H, E, A>::M_erase_bucket(size_type hole) {
+    auto slots = M_slots();
+    for (auto j = (hole + 1) & mask_; ctrl_[j] != hash_group::empty; j = (j + 1) & mask_) {
+        auto home = slots[j].hash & mask_;
+        if (((j - hole) & mask_) <= ((j - home) & mask_)) {
+            slots[hole] = slots[j];
+            M_set_ctrl(hole, ctrl_[j]);
+            hole = j;
+        }
+    }
+    M_set_ctrl(hole, hash_group::empty);
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+void hash_table<V, K, KoV, H, E, A>::M_erase_index(size_type index) noexcept {
+    auto last = size() - 1;
+    M_erase_bucket(M_bucket_of(index));
+    if (index != last) {
+        M_slots()[M_bucket_of(last)].index = static_cast<uint32_t>(index);
+        auto alloc = get_allocator();
+        auto p = values_.data();
+        value_alloc_traits::destroy(alloc, p + index);
+        value_alloc_traits::construct(alloc, p + index, std::move(p[last]));
+    }
+    values_.pop_back();
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+bool operator==(const hash_table<V, K, KoV, H, E, A> &lhs, const hash_table<V, K, KoV, H, E, A> &rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (const auto &value : lhs) {
+        auto it = rhs.find(KoV()(value));
+        if (it == rhs.end() || !(*it == value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename V, typename K, typename KoV, typename H, typename E, typename A>
+bool operator!=(const hash_table<V, K, KoV, H, E, A> &lhs, const hash_table<V, K, KoV, H, E, A> &rhs) {
+    return !(lhs == rhs);
+}
+} // namespace mystl
@@ -0,0 +1,279 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "my_list.hpp"
+
+namespace mystl {
+///intrusive_list 的结点特性：结点是嵌在 T 中的挂钩，取元素时由挂钩地址减去它在 T 中的偏移。
+template <typename T, list_hook T::*Hook>
+struct intrusive_node_traits {
+    using node = list_hook;
+
+    ///挂钩在 T 中的字节偏移。成员指针不能用于 offsetof ；Itanium C++ ABI（GCC 、Clang）把数据成员指针表示为成员相对对象起点的偏移，
+    ///直接复制出成员指针的对象表示即可，不需要任何 T 对象。 Hook 是模板实参，编译器会把结果折叠成常量。
+    static std::ptrdiff_t hook_offset() noexcept {
+        static_assert(sizeof(list_hook T::*) == sizeof(std::ptrdiff_t), "data member pointers must be represented as byte offsets");
+        auto member = Hook;
+        std::ptrdiff_t offset;
+        std::memcpy(&offset, &member, sizeof(offset));
+        return offset;
+    }
+
+    static T &value(node *p) noexcept { return *reinterpret_cast<T *>(reinterpret_cast<char *>(p) - hook_offset()); }
+    static node *to_node(const T &value) noexcept { return const_cast<node *>(&(value.*Hook)); }
+};
+
+///侵入式双向链表。不拥有元素，也不申请内存：元素通过嵌入其中的 list_hook 成员 Hook 链接，同一个对象可以用不同的挂钩同时挂在多个链表上。
+///迭代器与 list 共用 list_iterator ， splice 、 merge 、 sort 与 list 共用同一组结点链算法，只改动链接，不复制元素。
+///元素可以经 Hook 的 unlink() 直接从链表中摘下，链表因此不记录元素个数， size() 需要遍历。
+///元素的生存期由调用者管理：链表析构或 clear() 时只把元素的挂钩置为未链入；元素先于链表析构时挂钩自动摘链。
+template <typename T, list_hook T::*Hook>
+class intrusive_list {
+    using traits = intrusive_node_traits<T, Hook>;
+    using node = list_hook;
+
+public:
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using value_type = T;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using iterator = list_iterator<T, T &, T *, traits>;
+    using const_iterator = list_iterator<T, const T &, const T *, traits>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    //构造函数
+    intrusive_list() noexcept : M_dummy(&M_dummy, &M_dummy) {}
+    intrusive_list(const intrusive_list &) = delete;
+    intrusive_list(intrusive_list &&other) noexcept : intrusive_list() { M_take(other); } //接管 other 的全部元素。
+    ~intrusive_list() { clear(); }
+
+    intrusive_list &operator=(const intrusive_list &) = delete;
+    intrusive_list &operator=(intrusive_list &&other) noexcept; //先清空，再接管 other 的全部元素。
+
+    //元素访问
+    reference front() noexcept { return *begin(); }
+    const_reference front() const noexcept { return *begin(); }
+    reference back() noexcept { return *--end(); }
+    const_reference back() const noexcept { return *--end(); }
+
+    //迭代器
+    iterator begin() noexcept { return iterator(M_dummy.next); }
+    const_iterator begin() const noexcept { return const_iterator(M_dummy.next); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(&M_dummy); }
+    const_iterator end() const noexcept { return const_iterator(const_cast<node *>(&M_dummy)); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    static iterator iterator_to(T &value) noexcept { return iterator(traits::to_node(value)); }                   //返回指向已链入的 value 的迭代器。
+    static const_iterator iterator_to(const T &value) noexcept { return const_iterator(traits::to_node(value)); } //返回指向已链入的 value 的迭代器。
+
+    //容量
+    bool empty() const noexcept { return M_dummy.next == &M_dummy; }
+    size_type size() const noexcept { return static_cast<size_type>(std::distance(begin(), end())); } //遍历计数， O(n) 。
+
+    //修改器
+    void clear() noexcept; //摘下全部元素并把它们的挂钩置为未链入。元素本身不受影响。
+    iterator insert(const_iterator pos, T &value) noexcept; //把 value 链入 pos 之前。 value 不得已链入其他链表。
+    template <typename InputIt>
+    void insert(const_iterator pos, InputIt first, InputIt last) noexcept; //把 [first, last) 所指的对象依次链入 pos 之前。
+
+    iterator erase(const_iterator pos) noexcept;                        //摘下位于 pos 的元素，返回其后的位置。
+    iterator erase(const_iterator first, const_iterator last) noexcept; //摘下范围 [first, last) 中的元素。
+
+    void push_back(T &value) noexcept { insert(cend(), value); }
+    void push_front(T &value) noexcept { insert(cbegin(), value); }
+    void pop_back() noexcept { erase(--cend()); }
+    void pop_front() noexcept { erase(cbegin()); }
+
+    void swap(intrusive_list &other) noexcept; //交换内容，元素与迭代器保持合法。
+
+    //操作
+    void merge(intrusive_list &other);               //归并二个已排序链表为一个。
+    template <typename Compare>                      //
+    void merge(intrusive_list &other, Compare comp); //归并二个已排序链表为一个。
+
+    void splice(const_iterator pos, intrusive_list &other);                                           //从 other 转移所有元素到 pos 之前。
+    void splice(const_iterator pos, intrusive_list &other, const_iterator it);                        //从 other 转移 it 所指向的元素到 pos 之前。
+    void splice(const_iterator pos, intrusive_list &other, const_iterator first, const_iterator last); //从 other 转移范围 [first, last) 中的元素到 pos 之前。
+
+    void remove(const T &value);       //摘下所有等于 value 的元素。
+    template <typename UnaryPredicate> //
+    void remove_if(UnaryPredicate p);  //摘下所有谓词 p 对它返回 true 的元素。
+
+    void reverse() noexcept; //逆转元素顺序。
+
+    void sort();               //以升序排序元素。保持相等元素的顺序。
+    template <typename Compare> //
+    void sort(Compare comp);   //以升序排序元素。保持相等元素的顺序。只改变挂钩的链接。
+
+private:
+    node M_dummy; //空白结点，嵌在链表对象中，移动与交换时需要修正首尾结点对它的引用。
+
+    ///接管 other 的结点链，调用者保证 *this 为空。
+    void M_take(intrusive_list &other) noexcept;
+};
+
+template <typename T, list_hook T::*Hook>
+intrusive_list<T, Hook> &intrusive_list<T, Hook>::operator=(intrusive_list &&other) noexcept {
+    if (this != &other) {
+        clear();
+        M_take(other);
+    }
+    return *this;
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::M_take(intrusive_list &other) noexcept {
+    if (other.empty()) {
+        return;
+    }
+    list_transfer(&M_dummy, other.M_dummy.next, &other.M_dummy);
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::clear() noexcept {
+    auto current = M_dummy.next;
+    while (current != &M_dummy) {
+        auto next = current->next;
+        current->next = current->prev = nullptr;
+        current = next;
+    }
+    M_dummy.next = M_dummy.prev = &M_dummy;
+}
+
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::insert(const_iterator pos, T &value) noexcept {
+    auto p = traits::to_node(value);
+    auto next = pos.current_node;
+    p->next = next;
+    p->prev = next->prev;
+    next->prev->next = p;
+    next->prev = p;
+    return iterator(p);
+}
+
+template <typename T, list_hook T::*Hook>
+template <typename InputIt>
+void intrusive_list<T, Hook>::insert(const_iterator pos, InputIt first, InputIt last) noexcept {
+    for (; first != last; ++first) {
+        insert(pos, *first);
+    }
+}
+
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::erase(const_iterator pos) noexcept {
+    auto next = pos.current_node->next;
+    pos.current_node->unlink();
+    return iterator(next);
+}
+
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::erase(const_iterator first, const_iterator last) noexcept {
+    while (first != last) {
+        first = erase(first);
+    }
+    return iterator(last.current_node);
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::swap(intrusive_list &other) noexcept {
+    if (this == &other) {
+        return;
+    }
+    intrusive_list tmp(std::move(other));
+    other.M_take(*this);
+    M_take(tmp);
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::merge(intrusive_list &other) {
+    merge(other, std::less<T>());
+}
+
+template <typename T, list_hook T::*Hook>
+template <typename Compare>
+void intrusive_list<T, Hook>::merge(intrusive_list &other, Compare comp) {
+    if (this != &other) {
+        list_merge_nodes<traits>(&M_dummy, &other.M_dummy, comp);
+    }
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::splice(const_iterator pos, intrusive_list &other) {
+    if (this != &other) {
+        list_transfer(pos.current_node, other.M_dummy.next, &other.M_dummy);
+    }
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::splice(const_iterator pos, intrusive_list &, const_iterator it) {
+    if (pos != it) {
+        list_transfer(pos.current_node, it.current_node, it.current_node->next);
+    }
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::splice(const_iterator pos, intrusive_list &, const_iterator first, const_iterator last) {
+    list_transfer(pos.current_node, first.current_node, last.current_node);
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::remove(const T &value) {
+    remove_if([&value](const T &x) { return x == value; });
+}
+
+//先取得后继再判断，当前元素被摘下不影响继续遍历。
+template <typename T, list_hook T::*Hook>
+template <typename UnaryPredicate>
+void intrusive_list<T, Hook>::remove_if(UnaryPredicate p) {
+    auto current = M_dummy.next;
+    while (current != &M_dummy) {
+        auto next = current->next;
+        if (p(traits::value(current))) {
+            current->unlink();
+        }
+        current = next;
+    }
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::reverse() noexcept {
+    auto current = &M_dummy;
+    do {
+        std::swap(current->next, current->prev);
+        current = current->prev;
+    } while (current != &M_dummy);
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::sort() {
+    sort(std::less<T>());
+}
+
+template <typename T, list_hook T::*Hook>
+template <typename Compare>
+void intrusive_list<T, Hook>::sort(Compare comp) {
+    if (M_dummy.next == M_dummy.prev) {
+        return;
+    }
+    list_sort_nodes<traits>(&M_dummy, comp);
+}
+
+template <typename T, list_hook T::*Hook>
+void swap(intrusive_list<T, Hook> &lhs, intrusive_list<T, Hook> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+} // namespace mystl
@@ -1,65 +1,113 @@
 #pragma once
+#include <algorithm>
+#include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "my_memory.hpp"
+#include "my_memory_resource.hpp"
+#include "my_vector.hpp"
 
 namespace mystl {
 template <typename InIter>
 using RequireInputIter = typename std::enable_if<std::is_convertible<typename std::iterator_traits<InIter>::iterator_category, std::input_iterator_tag>::value>::type;
 
-template <typename T, typename Ref, typename Ptr>
+template <typename T>
+struct list_node_traits;
+
+template <typename T, typename Ref, typename Ptr, typename NodeTraits = list_node_traits<T>>
 class list_iterator;
 
-template <typename T>
+template <typename T, typename Alloc = allocator<T>>
 class list;
 
 template <typename T>
 class list_node;
 
-template <typename T>
-bool operator==(const list<T> &lhs, const list<T> &rhs);
+class list_hook;
 
-template <typename T>
-bool operator!=(const list<T> &lhs, const list<T> &rhs);
+template <typename T, list_hook T::*Hook>
+class intrusive_list;
 
-template <typename T>
-bool operator<(const list<T> &lhs, const list<T> &rhs);
+template <typename T, typename Alloc>
+bool operator==(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs);
 
-template <typename T>
-bool operator<=(const list<T> &lhs, const list<T> &rhs);
+template <typename T, typename Alloc>
+bool operator!=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs);
 
-template <typename T>
-bool operator>(const list<T> &lhs, const list<T> &rhs);
+template <typename T, typename Alloc>
+bool operator<(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs);
 
-template <typename T>
-bool operator>=(const list<T> &lhs, const list<T> &rhs);
+template <typename T, typename Alloc>
+bool operator<=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs);
 
-template <typename T>
-void swap(list<T> &lhs, list<T> &rhs);
+template <typename T, typename Alloc>
+bool operator>(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs);
+
+template <typename T, typename Alloc>
+bool operator>=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs);
+
+template <typename T, typename Alloc>
+void swap(list<T, Alloc> &lhs, list<T, Alloc> &rhs);
 
+///链表结点。data 放在匿名联合中，由容器通过分配器单独构造与析构；空白结点不构造 data ，因此 T 无需可默认构造。
 template <typename T>
 class list_node final {
 public:
-    T data;
     list_node *next = nullptr;
     list_node *prev = nullptr;
+    union {
+        T data;
+    };
 
-    list_node() = default;
-    explicit list_node(const T &_data) : data(_data) {}
-    explicit list_node(T &&_data) noexcept : data(std::move_if_noexcept(_data)) {}
-    list_node(const list_node &other) : data(other.data), next(other.next), prev(other.prev) {}
-    list_node(list_node &&other) noexcept : data(std::move_if_noexcept(other.data)), next(other.next), prev(other.prev) {}
-    list_node(list_node *_next, list_node *_prev) : next(_next), prev(_prev) {}
-    list_node(const T &_data, list_node *_next, list_node *_prev) : data(_data), next(_next), prev(_prev) {}
-    list_node(T &&_data, list_node *_next, list_node *_prev) noexcept : data(std::move_if_noexcept(_data)), next(_next), prev(_prev) {}
+    list_node() noexcept {}
+    list_node(list_node *_next, list_node *_prev) noexcept : next(_next), prev(_prev) {}
+    ~list_node() {}
 };
 
-template <typename T, typename Ref, typename Ptr>
+///list 的结点特性：结点类型与从结点取出元素的方式。迭代器与结点链算法只通过它访问元素。
+template <typename T>
+struct list_node_traits {
+    using node = list_node<T>;
+    static T &value(node *p) noexcept { return p->data; }
+};
+
+///侵入式链表的挂钩，嵌入在元素对象中。 next/prev 的布局与 list_node 相同，未链入时两者都为空。
+///复制对象不复制链接；对象析构时自动从所在的链表中摘下。
+class list_hook {
+public:
+    list_hook *next = nullptr;
+    list_hook *prev = nullptr;
+
+    list_hook() noexcept = default;
+    list_hook(list_hook *_next, list_hook *_prev) noexcept : next(_next), prev(_prev) {}
+    list_hook(const list_hook &) noexcept {}
+    list_hook &operator=(const list_hook &) noexcept { return *this; }
+    ~list_hook() { unlink(); }
+
+    bool is_linked() const noexcept { return next != nullptr; } //是否已链入某个链表。
+
+    ///从所在的链表中摘下，未链入时什么也不做。 O(1) ，不需要知道所在的链表。
+    void unlink() noexcept {
+        if (next) {
+            next->prev = prev;
+            prev->next = next;
+            next = prev = nullptr;
+        }
+    }
+};
+
+//链表迭代器。只保存一个节点指针，不含虚函数，可平凡复制。结点类型与取值方式由 NodeTraits 给出， list 与 intrusive_list 共用。
+template <typename T, typename Ref, typename Ptr, typename NodeTraits>
 class list_iterator {
 public:
-    using self = list_iterator<T, Ref, Ptr>;
-    using iterator = list_iterator<T, T &, T *>;
-    using const_iterator = list_iterator<T, const T &, const T *>;
+    using self = list_iterator<T, Ref, Ptr, NodeTraits>;
+    using iterator = list_iterator<T, T &, T *, NodeTraits>;
+    using const_iterator = list_iterator<T, const T &, const T *, NodeTraits>;
     using value_type = T;
     using pointer = Ptr;
     using reference = Ref;
@@ -67,107 +115,386 @@ public:
     using const_reference = const T &;
     using difference_type = std::ptrdiff_t;
     using iterator_category = std::bidirectional_iterator_tag;
-    using node = list_node<value_type>;
+    using node = typename NodeTraits::node;
 
-    friend class list<T>;
-    friend class list_iterator<T, T &, T *>;
-    friend class list_iterator<T, const T &, const T *>;
+    template <typename, typename>
+    friend class list;
+    template <typename U, list_hook U::*>
+    friend class intrusive_list;
+    template <typename, typename, typename, typename>
+    friend class list_iterator;
 
 protected:
     node *current_node = nullptr;
 
 public:
-    list_iterator() {}
-    explicit list_iterator(node *_current_node) : current_node(_current_node) {}
-    list_iterator(const iterator &other) : current_node(other.current_node) {}
-    list_iterator(const const_iterator &other) : current_node(other.current_node) {}
-    list_iterator(iterator &&other) noexcept : current_node(std::move(other.current_node)) {}
-    list_iterator(const_iterator &&other) noexcept;
-
-    virtual ~list_iterator() = default;
-
-    bool operator==(const iterator &other) const { return this->current_node == other.current_node; }
-    bool operator==(const_iterator &other) const { return this->current_node == other.current_node; }
-    bool operator==(iterator &&other) const { return this->current_node == other.current_node; }
-    bool operator==(const_iterator &&other) const { return this->current_node == other.current_node; }
-    template <class iter>
-    bool operator!=(iter &&other) const {
-        return !operator==(std::forward<iter>(other));
-    }
-    list_iterator &operator=(const iterator &other);
-    list_iterator &operator=(iterator &&other) noexcept;
-    list_iterator &operator=(const const_iterator &other);
-    list_iterator &operator=(const_iterator &&other) noexcept;
+    list_iterator() = default;
+    explicit list_iterator(node *_current_node) noexcept : current_node(_current_node) {}
+    ///iterator 可隐式转换为 const_iterator 。模板构造函数不是复制构造函数，不影响可平凡复制。
+    template <typename Iter, typename = typename std::enable_if<std::is_same<Iter, iterator>::value && !std::is_same<Iter, self>::value>::type>
+    list_iterator(const Iter &other) noexcept : current_node(other.current_node) {}
 
-    reference operator*() { return current_node->data; }
-    pointer operator->() { return &(current_node->data); }
-    const_reference operator*() const { return current_node->data; }
-    const_pointer operator->() const { return &(current_node->data); }
+    friend bool operator==(const self &lhs, const self &rhs) noexcept { return lhs.current_node == rhs.current_node; }
+    friend bool operator!=(const self &lhs, const self &rhs) noexcept { return lhs.current_node != rhs.current_node; }
 
-    self &operator++() {
+    reference operator*() const noexcept { return NodeTraits::value(current_node); }
+    pointer operator->() const noexcept { return std::addressof(NodeTraits::value(current_node)); }
+
+    self &operator++() noexcept {
         this->current_node = this->current_node->next;
         return *this;
     }
 
-    self operator++(int) {
+    self operator++(int) noexcept {
         auto temp = *this;
         current_node = current_node->next;
         return temp;
     }
 
-    self &operator--() {
+    self &operator--() noexcept {
         this->current_node = this->current_node->prev;
         return *this;
     }
 
-    self operator--(int) {
+    self operator--(int) noexcept {
         auto temp = *this;
         this->current_node = this->current_node->prev;
         return temp;
     }
 };
 
-template <typename T, typename Ref, typename Ptr>
-list_iterator<T, Ref, Ptr> &list_iterator<T, Ref, Ptr>::operator=(const iterator &other) {
-    if (current_node == other.current_node) {
-        return *this;
+//以下结点链算法只依赖结点的 next/prev ，比较时经 NodeTraits::value 取出元素，由 list 与 intrusive_list 共用。
+
+///把有序结点链 src 归并进 dest ，相等时 dest 中的结点在前。结点链以 nullptr 结尾，首结点的 prev 指向尾结点。
+///comp 抛出异常时，dest 保存两条链的全部结点，但不再有序，prev 也不再可靠。
+template <typename NodeTraits, typename Compare>
+void list_merge_chains(typename NodeTraits::node *&dest, typename NodeTraits::node *src, Compare &comp) {
+    using node = typename NodeTraits::node;
+    auto a = dest;
+    auto b = src;
+    auto a_last = a->prev;
+    auto b_last = b->prev;
+    node head; //挂钩析构时会自动摘链，离开前把 head.next 清空。
+    auto tail = &head;
+    try {
+        while (a && b) {
+            node *next;
+            if (comp(NodeTraits::value(b), NodeTraits::value(a))) {
+                next = b;
+                b = b->next;
+            } else {
+                next = a;
+                a = a->next;
+            }
+            tail->next = next;
+            next->prev = tail;
+            tail = next;
+        }
+    } catch (...) {
+        if (a) {
+            tail->next = a;
+            a_last->next = b;
+        } else {
+            tail->next = b;
+        }
+        dest = head.next;
+        head.next = nullptr;
+        throw;
     }
-    current_node = other.current_node;
-    return *this;
+    auto rest = a ? a : b;
+    tail->next = rest;
+    rest->prev = tail;
+    dest = head.next;
+    dest->prev = a ? a_last : b_last;
+    head.next = nullptr;
+}
+
+///把结点链挂回空白结点 dummy 之后。
+template <typename Node>
+void list_attach_chain(Node *dummy, Node *first) noexcept {
+    auto last = first->prev;
+    dummy->next = first;
+    first->prev = dummy;
+    last->next = dummy;
+    dummy->prev = last;
+}
+
+///把 [first, last) 中的结点摘下并链入 pos 之前。三者可以属于不同的链表。
+template <typename Node>
+void list_transfer(Node *pos, Node *first, Node *last) noexcept {
+    if (first == last) {
+        return;
+    }
+    auto before = first->prev;
+    auto tail = last->prev;
+    before->next = last;
+    last->prev = before;
+    tail->next = pos;
+    first->prev = pos->prev;
+    pos->prev->next = first;
+    pos->prev = tail;
+}
+
+//自底向上的归并排序。bins[i] 为空或保存一条长度为 2^i 的有序链，每取下一个结点就像二进制加一那样向上归并进位，
+//最后从低到高归并所有 bins 。不需要递归，也不需要额外的内存。
+//归并时顺带维护 prev ，链首的 prev 记录链尾，排好后只需改动首尾四个指针，不必再遍历一遍结点。
+//comp 抛出异常时把散落在各处的结点重新串回链表，元素的顺序不确定，但不会丢失。调用者保证链表至少有两个结点。
+template <typename NodeTraits, typename Compare>
+void list_sort_nodes(typename NodeTraits::node *dummy, Compare &comp) {
+    using node = typename NodeTraits::node;
+    constexpr size_t bin_count = 64;
+    node *bins[bin_count] = {nullptr};
+    size_t used = 0;
+    dummy->prev->next = nullptr;
+    auto current = dummy->next;
+    node *carry = nullptr;
+    try {
+        while (current) {
+            carry = current;
+            current = current->next;
+            carry->next = nullptr;
+            carry->prev = carry;
+            size_t i = 0;
+            for (; i < used && bins[i]; ++i) {
+                auto src = carry;
+                carry = nullptr;
+                list_merge_chains<NodeTraits>(bins[i], src, comp);
+                carry = bins[i];
+                bins[i] = nullptr;
+            }
+            bins[i] = carry;
+            carry = nullptr;
+            if (i == used) {
+                ++used;
+            }
+        }
+        for (size_t i = 1; i < used; ++i) {
+            if (bins[i - 1]) {
+                auto src = bins[i - 1];
+                bins[i - 1] = nullptr;
+                if (bins[i]) {
+                    list_merge_chains<NodeTraits>(bins[i], src, comp);
+                } else {
+                    bins[i] = src;
+                }
+            }
+        }
+    } catch (...) {
+        auto prev = dummy;
+        auto append = [&prev](node *first) {
+            for (; first; first = first->next) {
+                prev->next = first;
+                first->prev = prev;
+                prev = first;
+            }
+        };
+        append(carry);
+        for (size_t i = 0; i < used; ++i) {
+            append(bins[i]);
+        }
+        append(current);
+        prev->next = dummy;
+        dummy->prev = prev;
+        throw;
+    }
+    list_attach_chain(dummy, bins[used - 1]);
+}
+
+///把以 other 为空白结点的有序链表归并进以 dummy 为空白结点的有序链表，相等时 dummy 一侧的结点在前。
+///只改动结点链接。 comp 抛出异常时已转移的结点留在 dummy 一侧，两边仍各自是合法的链表。
+template <typename NodeTraits, typename Compare>
+void list_merge_nodes(typename NodeTraits::node *dummy, typename NodeTraits::node *other, Compare &comp) {
+    auto first1 = dummy->next;
+    auto first2 = other->next;
+    while (first1 != dummy && first2 != other) {
+        if (comp(NodeTraits::value(first2), NodeTraits::value(first1))) {
+            auto next = first2->next;
+            list_transfer(first1, first2, next);
+            first2 = next;
+        } else {
+            first1 = first1->next;
+        }
+    }
+    list_transfer(dummy, first2, other);
 }
 
-template <typename T, typename Ref, typename Ptr>
-list_iterator<T, Ref, Ptr> &list_iterator<T, Ref, Ptr>::operator=(iterator &&other) noexcept {
-    if (current_node == other.current_node) {
-        return *this;
+template <typename T, typename Alloc>
+class list_base {
+public:
+    using node = list_node<T>;
+    using size_type = size_t;
+    using T_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    using T_alloc_traits = std::allocator_traits<T_alloc_type>;
+    using node_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<node>;
+    using node_alloc_traits = std::allocator_traits<node_alloc_type>;
+
+    static_assert(std::is_same<typename node_alloc_traits::pointer, node *>::value, "list requires an allocator whose pointer type is a raw pointer");
+
+    ///内嵌类，保存空白结点与元素数量。继承结点分配器以便空分配器不占用空间。
+    class list_impl : public node_alloc_type {
+    public:
+        node *dummy_node = nullptr; //空白结点
+        size_type list_size = 0;    //链表元素数量
+
+        list_impl() noexcept(std::is_nothrow_default_constructible<node_alloc_type>::value) : node_alloc_type() {}
+        explicit list_impl(const node_alloc_type &alloc) noexcept : node_alloc_type(alloc) {}
+
+        void M_swap_data(list_impl &other) noexcept {
+            std::swap(dummy_node, other.dummy_node);
+            std::swap(list_size, other.list_size);
+        }
+    };
+
+    list_impl M_impl;
+
+    node_alloc_type &M_get_node_allocator() noexcept { return M_impl; }
+    const node_alloc_type &M_get_node_allocator() const noexcept { return M_impl; }
+
+    list_base() : M_impl() { M_impl.dummy_node = M_create_dummy(M_impl); }
+    explicit list_base(const node_alloc_type &alloc) : M_impl(alloc) { M_impl.dummy_node = M_create_dummy(M_impl); }
+    ~list_base() {
+        M_clear();
+        M_put_node(M_impl.dummy_node);
     }
-    current_node = std::move(other.current_node);
-    return *this;
-}
 
-template <typename T, typename Ref, typename Ptr>
-list_iterator<T, Ref, Ptr> &list_iterator<T, Ref, Ptr>::operator=(const const_iterator &other) {
-    if (current_node == other.current_node) {
-        return *this;
+    ///以 alloc 申请一个首尾相接的空白结点。
+    static node *M_create_dummy(node_alloc_type &alloc) {
+        auto p = node_alloc_traits::allocate(alloc, 1);
+        return ::new (static_cast<void *>(p)) node(p, p);
     }
-    current_node = other.current_node;
-    return *this;
-}
 
-template <typename T, typename Ref, typename Ptr>
-list_iterator<T, Ref, Ptr> &list_iterator<T, Ref, Ptr>::operator=(const_iterator &&other) noexcept {
-    if (current_node == other.current_node) {
-        return *this;
+    node *M_get_node() { return node_alloc_traits::allocate(M_impl, 1); }
+    void M_put_node(node *p) noexcept { node_alloc_traits::deallocate(M_impl, p, 1); }
+
+    ///申请结点并通过分配器构造元素，结点的指针域为空。构造抛出异常时归还结点。
+    template <typename... Args>
+    node *M_create_node(Args &&...args) {
+        auto p = ::new (static_cast<void *>(M_get_node())) node();
+        try {
+            T_alloc_type alloc(M_impl);
+            T_alloc_traits::construct(alloc, std::addressof(p->data), std::forward<Args>(args)...);
+        } catch (...) {
+            M_put_node(p);
+            throw;
+        }
+        return p;
     }
-    current_node = std::move(other.current_node);
-    return *this;
-}
 
-template <typename T, typename Ref, typename Ptr>
-list_iterator<T, Ref, Ptr>::list_iterator(list_iterator::const_iterator &&other) noexcept : current_node(std::move(other.current_node)) {}
+    ///申请至多 n 个结点，分配器支持成段申请时取一段相邻的结点，否则取一个。 count 返回实际个数。
+    node *M_get_run(size_type n, size_type &count) { return M_get_run(n, count, allocator_has_runs<node_alloc_type>()); }
+    node *M_get_run(size_type n, size_type &count, std::true_type) { return M_impl.allocate_run(n, count); }
+    node *M_get_run(size_type, size_type &count, std::false_type) {
+        count = 1;
+        return M_get_node();
+    }
+
+    ///一次建好 count 个结点组成的链，每个元素由 construct(alloc, p) 在 p 处构造。结点按分配器给出的相邻段依次取用，
+    ///新建的链在内存中基本顺序排列。返回首结点， last 返回尾结点，链内的 next/prev 已连好，首结点的 prev 与尾结点的 next 未定。
+    ///任何一步抛出异常时，已构造的元素全部析构，结点全部归还。
+    template <typename Construct>
+    node *M_create_chain(size_type count, Construct construct, node *&last) {
+        T_alloc_type alloc(M_impl);
+        node *first = nullptr;
+        last = nullptr;
+        size_type built = 0;
+        try {
+            while (built < count) {
+                size_type got;
+                auto run = M_get_run(count - built, got);
+                size_type i = 0;
+                try {
+                    for (; i < got; ++i) {
+                        auto p = ::new (static_cast<void *>(run + i)) node();
+                        construct(alloc, std::addressof(p->data));
+                        if (last) {
+                            last->next = p;
+                            p->prev = last;
+                        } else {
+                            first = p;
+                        }
+                        last = p;
+                        ++built;
+                    }
+                } catch (...) {
+                    for (; i < got; ++i) {
+                        M_put_node(run + i);
+                    }
+                    throw;
+                }
+            }
+        } catch (...) {
+            for (auto current = first; built--;) {
+                auto next = current->next;
+                M_destroy_node(current);
+                current = next;
+            }
+            throw;
+        }
+        return first;
+    }
+
+    ///析构元素并归还结点。
+    void M_destroy_node(node *p) noexcept {
+        T_alloc_type alloc(M_impl);
+        T_alloc_traits::destroy(alloc, std::addressof(p->data));
+        p->~node();
+        M_put_node(p);
+    }
+
+    ///销毁全部元素，空白结点保留。
+    void M_clear() noexcept {
+        M_clear(allocator_has_runs<node_alloc_type>());
+        auto dummy = M_impl.dummy_node;
+        dummy->next = dummy;
+        dummy->prev = dummy;
+        M_impl.list_size = 0;
+    }
+    void M_clear(std::false_type) noexcept {
+        auto dummy = M_impl.dummy_node;
+        auto current = dummy->next;
+        while (current != dummy) {
+            auto next = current->next;
+            M_destroy_node(current);
+            current = next;
+        }
+    }
+    ///遍历时把内存中首尾相接的结点合成一段，整段归还。成批建好的链在被打乱之前正好是几段相邻的结点，
+    ///下次成批建链时能原样取回，不必在逐个归还的空闲结点间追链。
+    void M_clear(std::true_type) noexcept {
+        T_alloc_type alloc(M_impl);
+        auto dummy = M_impl.dummy_node;
+        auto current = dummy->next;
+        node *run = nullptr;
+        size_type run_length = 0;
+        while (current != dummy) {
+            auto next = current->next;
+            T_alloc_traits::destroy(alloc, std::addressof(current->data));
+            current->~node();
+            if (run && current == run + run_length) {
+                ++run_length;
+            } else {
+                if (run) {
+                    M_impl.deallocate_run(run, run_length);
+                }
+                run = current;
+                run_length = 1;
+            }
+            current = next;
+        }
+        if (run) {
+            M_impl.deallocate_run(run, run_length);
+        }
+    }
+};
+
+template <typename T, typename Alloc>
+class list final : list_base<T, Alloc> {
+    using Base = list_base<T, Alloc>;
+    using typename Base::node_alloc_type;
+    using typename Base::node_alloc_traits;
+    using typename Base::T_alloc_type;
+    using typename Base::T_alloc_traits;
 
-template <typename T>
-class list final {
 public:
     using size_type = size_t;
     using value_type = T;
@@ -178,29 +505,49 @@ public:
     using const_iterator = list_iterator<T, const T &, const T *>;
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using allocator_type = Alloc;
 
 private:
-    node *dummy_node;        //空白结点
-    size_type list_size = 0; //链表元素数量
+    using Base::M_impl;
+    using Base::M_get_node_allocator;
 
     iterator insert(const_iterator pos, node &other);
-    template <typename Compare>
-    const_iterator merge_self(const_iterator first, const_iterator mid, const_iterator last, Compare comp);
+
+    ///把 M_create_chain 建好的链整体链入 pos 之前，返回指向首元素的迭代器。
+    iterator M_link_chain(const_iterator pos, node *first, node *last, size_type count) noexcept;
+    ///在 pos 前插入从 first 开始的 count 个元素的副本，结点一次建好后整体链入。
+    template <typename ForwardIt>
+    iterator M_insert_n(const_iterator pos, ForwardIt first, size_type count);
+    ///输入迭代器只能走一遍，事先无法得知个数，逐个插入。
+    template <typename InputIt>
+    iterator M_insert_range(const_iterator pos, InputIt first, InputIt last, std::input_iterator_tag);
+    template <typename ForwardIt>
+    iterator M_insert_range(const_iterator pos, ForwardIt first, ForwardIt last, std::forward_iterator_tag);
+
+    ///移动赋值实现，分配器随之传播或两者相等时直接接管 other 的结点。
+    void M_move_assign(list &other, std::true_type) noexcept;
+    ///移动赋值实现，分配器不传播时，仅在两者相等时接管结点，否则逐元素移动。
+    void M_move_assign(list &other, std::false_type);
 
 public:
     //构造函数
-    list();                                         // 默认构造函数。构造拥有默认构造的分配器的空容器
-    list(size_type count, const value_type &value); // 构造拥有 count 个有值 value 的元素的容器
-    explicit list(size_type count);                 // 构造拥有个 count 默认插入的 T 实例的容器。不进行复制
-    list(const list &other);                        // 复制构造函数。构造拥有 other 内容的容器
-    list(list &&other) noexcept;                    // 移动构造函数。用移动语义构造拥有 other 内容的容器
-    list(std::initializer_list<T> init);            // 构造拥有 initializer_list init 内容的容器
-    ~list();                                        // 销毁 list 。调用元素的析构函数，然后解分配所用的存储。注意，若元素是指针，则不销毁所指向的对象
+    list() : Base() {}                                                       // 默认构造函数。构造拥有默认构造的分配器的空容器
+    explicit list(const Alloc &alloc) : Base(node_alloc_type(alloc)) {}      // 构造拥有给定分配器 alloc 的空容器
+    list(size_type count, const value_type &value, const Alloc &alloc = Alloc()); // 构造拥有 count 个有值 value 的元素的容器
+    explicit list(size_type count, const Alloc &alloc = Alloc());           // 构造拥有个 count 默认插入的 T 实例的容器。不进行复制
+    list(const list &other);                                                 // 复制构造函数。构造拥有 other 内容的容器。分配器由 select_on_container_copy_construction 获得
+    list(const list &other, const Alloc &alloc);                             // 构造拥有 other 内容的容器，使用 alloc 作为分配器
+    list(list &&other) noexcept;                                             // 移动构造函数。用移动语义构造拥有 other 内容的容器
+    list(list &&other, const Alloc &alloc);                                  // 分配器扩展的移动构造函数。alloc 与 other 的分配器不相等时逐元素移动
+    list(std::initializer_list<T> init, const Alloc &alloc = Alloc());      // 构造拥有 initializer_list init 内容的容器
+    ~list() = default; // 销毁 list 。调用元素的析构函数，然后解分配所用的存储。注意，若元素是指针，则不销毁所指向的对象
 
     list &operator=(const list &other); // 复制赋值运算符。以 other 的副本替换内容。
-    list &operator=(list &&other) noexcept; // 移动赋值运算符。用移动语义以 other 的内容替换内容（即从 other 移动 other 中的数据到此容器中）。之后 other 在合法但未指定的状态。
+    list &operator=(list &&other) noexcept(node_alloc_traits::propagate_on_container_move_assignment::value || node_alloc_traits::is_always_equal::value); // 移动赋值运算符。用移动语义以 other 的内容替换内容（即从 other 移动 other 中的数据到此容器中）。之后 other 在合法但未指定的状态。分配器不随之转移且不相等时逐个创建结点，可能抛出异常。
     list &operator=(std::initializer_list<T> ilist); // 以 initializer_list ilist 所标识者替换内容。
 
+    allocator_type get_allocator() const noexcept { return allocator_type(M_get_node_allocator()); } // 返回与容器关联的分配器。
+
     void assign(size_type count, const T &value); // 以 count 份 value 的副本替换内容。
     template <typename InputIt>
     void assign(InputIt first, InputIt last);    // 以范围 [first, last) 中元素的副本替换内容。若任一参数是指向 *this 中的迭代器则行为未定义。
@@ -228,7 +575,7 @@ public:
 
     //容量
     bool empty() const noexcept;                           //检查容器是否无元素，即是否 begin() == end() 。
-    size_type size() const noexcept { return list_size; }; //返回容器中的元素数，即 std::distance(begin(), end())。
+    size_type size() const noexcept { return M_impl.list_size; } //返回容器中的元素数，即 std::distance(begin(), end())。
     size_type max_size() const noexcept;                   //返回根据系统或库实现限制的容器可保有的元素最大数量，即对于最大容器的 std::distance(begin(), end()) 。
 
     //修改器
@@ -295,295 +642,309 @@ public:
     template <typename BinaryPredicate> //
     void unique(BinaryPredicate p);     //从容器移除所有相继的重复元素。只留下相等元素组中的第一个元素。
 
-    //时间太赶了所以只写了冒泡
-    void sort();                                           //以升序排序元素。保持相等元素的顺序。
-    template <typename Compare>                            //
-    void sort(Compare comp);                               //以升序排序元素。保持相等元素的顺序。
-    template <typename Compare>                            //
-    node *sort(node *first, size_type size, Compare comp); //以升序排序元素。保持相等元素的顺序。
+    void sort();             //以升序排序元素。保持相等元素的顺序。
+    template <typename Compare>
+    void sort(Compare comp); //以升序排序元素。保持相等元素的顺序。只改变结点的链接，不复制或移动元素。
+
+    void sort_indexed();             //同 sort() ，但先把结点指针收集到连续的数组中排序再重新链接。适合结点分散在内存各处的大链表。
+    template <typename Compare>
+    void sort_indexed(Compare comp); //同 sort(comp) ，但先把结点指针收集到连续的数组中排序再重新链接。适合结点分散在内存各处的大链表。
 };
 
-template <typename T>
-list<T>::list() {
-    dummy_node = new list_node<value_type>;
-    dummy_node->next = dummy_node;
-    dummy_node->prev = dummy_node;
-    list_size = 0;
+template <typename T, typename Alloc>
+list<T, Alloc>::list(size_type count, const Alloc &alloc) : Base(node_alloc_type(alloc)) {
+    if (count) {
+        node *last;
+        auto first = this->M_create_chain(count, [](T_alloc_type &a, T *p) { T_alloc_traits::construct(a, p); }, last);
+        M_link_chain(cend(), first, last, count);
+    }
 }
 
-template <typename T>
-list<T>::list(list::size_type count) {
-    list_size = count;
-    dummy_node = new list_node<value_type>;
-    auto temp_pointer = dummy_node;
-    while (count--) {
-        temp_pointer->next = new list_node<value_type>(nullptr, temp_pointer);
-        temp_pointer = temp_pointer->next;
-    }
-    temp_pointer->next = dummy_node;
-    dummy_node->prev = temp_pointer;
+template <typename T, typename Alloc>
+list<T, Alloc>::list(size_type count, const value_type &value, const Alloc &alloc) : Base(node_alloc_type(alloc)) {
+    insert(cend(), count, value);
 }
 
-template <typename T>
-list<T>::list(size_type count, const value_type &value) {
-    list_size = count;
-    dummy_node = new list_node<value_type>;
-    auto temp_pointer = dummy_node;
-    while (count--) {
-        temp_pointer->next = new list_node<value_type>(value, nullptr, temp_pointer);
-        temp_pointer = temp_pointer->next;
-    }
-    temp_pointer->next = dummy_node;
-    dummy_node->prev = temp_pointer;
+template <typename T, typename Alloc>
+list<T, Alloc>::list(const list &other) : Base(node_alloc_traits::select_on_container_copy_construction(other.M_get_node_allocator())) {
+    M_insert_n(cend(), other.cbegin(), other.size());
 }
 
-template <typename T>
-list<T>::list(const list &other) {
-    list_size = other.list_size;
-    auto iter = other.cbegin();
-    dummy_node = new list_node<value_type>;
-    node *temp_pointer = dummy_node;
-    while (iter != other.cend()) {
-        temp_pointer->next = new list_node<value_type>(*iter, nullptr, temp_pointer);
-        temp_pointer = temp_pointer->next;
-        ++iter;
-    }
-    temp_pointer->next = dummy_node;
-    dummy_node->prev = temp_pointer;
+template <typename T, typename Alloc>
+list<T, Alloc>::list(const list &other, const Alloc &alloc) : Base(node_alloc_type(alloc)) {
+    M_insert_n(cend(), other.cbegin(), other.size());
 }
 
-template <typename T>
-list<T>::list(list &&other) noexcept {
-    this->dummy_node = other.dummy_node;
-    other.dummy_node = new list_node<value_type>;
-    other.dummy_node->next = other.dummy_node;
-    other.dummy_node->prev = other.dummy_node;
-    list_size = other.list_size;
-    other.list_size = 0;
+//other 换上一个新的空白结点，原有结点全部归当前容器所有。
+template <typename T, typename Alloc>
+list<T, Alloc>::list(list &&other) noexcept : Base(other.M_get_node_allocator()) {
+    M_impl.M_swap_data(other.M_impl);
 }
 
-template <typename T>
-list<T>::list(std::initializer_list<T> init) {
-    dummy_node = new list_node<value_type>;
-    dummy_node->next = dummy_node;
-    dummy_node->prev = dummy_node;
-    list_size = 0;
-    auto iter = cend();
-    for (auto &i : init) {
-        insert(iter, std::move_if_noexcept(i));
+template <typename T, typename Alloc>
+list<T, Alloc>::list(list &&other, const Alloc &alloc) : Base(node_alloc_type(alloc)) {
+    if (M_get_node_allocator() == other.M_get_node_allocator()) {
+        M_impl.M_swap_data(other.M_impl);
+        return;
     }
+    for (auto &i : other) {
+        emplace_back(std::move(i));
+    }
+    other.clear();
 }
 
-template <typename T>
-void list<T>::clear() noexcept {
-    auto iter = this->begin();
-    while (iter != this->end()) {
-        auto temp = iter.current_node;
-        ++iter;
-        delete temp;
-    }
-    dummy_node->next = dummy_node;
-    dummy_node->prev = dummy_node;
-    this->list_size = 0;
+template <typename T, typename Alloc>
+list<T, Alloc>::list(std::initializer_list<T> init, const Alloc &alloc) : Base(node_alloc_type(alloc)) {
+    insert(cend(), init);
 }
 
-template <typename T>
-list<T>::~list() {
-    this->clear();
-    delete this->dummy_node;
+template <typename T, typename Alloc>
+void list<T, Alloc>::clear() noexcept {
+    this->M_clear();
 }
 
-template <typename T>
-list<T> &list<T>::operator=(const list &other) {
+template <typename T, typename Alloc>
+list<T, Alloc> &list<T, Alloc>::operator=(const list &other) {
     if (this == &other) {
         return *this;
     }
-    this->clear();
-    auto const_iter = other.cbegin();
-    node *temp_pointer = dummy_node;
-    while (const_iter != other.cend()) {
-        temp_pointer->next = new list_node<value_type>(*const_iter, nullptr, temp_pointer);
-        temp_pointer = temp_pointer->next;
-        ++const_iter;
+    if (node_alloc_traits::propagate_on_container_copy_assignment::value && M_get_node_allocator() != other.M_get_node_allocator()) {
+        //旧结点只能由旧分配器释放：先用新分配器申请空白结点，再清空并归还旧的空白结点，最后替换分配器。
+        node_alloc_type new_alloc(other.M_get_node_allocator());
+        auto new_dummy = Base::M_create_dummy(new_alloc);
+        clear();
+        this->M_put_node(M_impl.dummy_node);
+        M_impl.dummy_node = new_dummy;
     }
-    temp_pointer->next = dummy_node;
-    dummy_node->prev = temp_pointer;
-    this->list_size = other.list_size;
+    alloc_on_copy(M_get_node_allocator(), other.M_get_node_allocator(), typename node_alloc_traits::propagate_on_container_copy_assignment());
+    assign(other.cbegin(), other.cend());
     return *this;
 }
 
-template <typename T>
-list<T> &list<T>::operator=(list &&other) noexcept {
+template <typename T, typename Alloc>
+list<T, Alloc> &list<T, Alloc>::operator=(list &&other) noexcept(node_alloc_traits::propagate_on_container_move_assignment::value || node_alloc_traits::is_always_equal::value) {
     if (this == &other) {
         return *this;
     }
-    this->clear();
-    delete this->dummy_node;
-    this->dummy_node = other.dummy_node;
-    this->list_size = other.list_size;
-    other.dummy_node = new list_node<value_type>;
-    other.dummy_node->next = other.dummy_node;
-    other.dummy_node->prev = other.dummy_node;
-    other.list_size = 0;
+    M_move_assign(other, std::integral_constant<bool, node_alloc_traits::propagate_on_container_move_assignment::value || node_alloc_traits::is_always_equal::value>());
     return *this;
 }
 
-template <typename T>
-list<T> &list<T>::operator=(std::initializer_list<T> ilist) {
+//空白结点随分配器一起交换，other 拿到的空白结点仍由它自己的分配器释放。
+template <typename T, typename Alloc>
+void list<T, Alloc>::M_move_assign(list &other, std::true_type) noexcept {
+    clear();
+    M_impl.M_swap_data(other.M_impl);
+    alloc_on_swap(M_get_node_allocator(), other.M_get_node_allocator(), typename node_alloc_traits::propagate_on_container_move_assignment());
+}
+
+template <typename T, typename Alloc>
+void list<T, Alloc>::M_move_assign(list &other, std::false_type) {
+    if (M_get_node_allocator() == other.M_get_node_allocator()) {
+        M_move_assign(other, std::true_type());
+        return;
+    }
     clear();
-    auto iter = cend();
-    for (auto &i : ilist)
-        iter = insert(iter, std::move_if_noexcept(i));
+    for (auto &i : other) {
+        emplace_back(std::move(i));
+    }
+    other.clear();
+}
+
+template <typename T, typename Alloc>
+list<T, Alloc> &list<T, Alloc>::operator=(std::initializer_list<T> ilist) {
+    assign(ilist);
     return *this;
 }
 
-template <typename T>
-void list<T>::assign(size_type count, const T &value) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::assign(size_type count, const T &value) {
     this->clear();
-    list_size = count;
-    auto temp_pointer = dummy_node;
-    while (count--) {
-        temp_pointer->next = new list_node<value_type>(value, nullptr, temp_pointer);
-        temp_pointer = temp_pointer->next;
-    }
-    temp_pointer->next = dummy_node;
-    dummy_node->prev = temp_pointer;
+    insert(cend(), count, value);
 }
 
-template <typename T>
+template <typename T, typename Alloc>
 template <class InputIt>
-void list<T>::assign(InputIt first, InputIt last) {
+void list<T, Alloc>::assign(InputIt first, InputIt last) {
     this->clear();
     insert(cend(), first, last);
 }
 
-template <typename T>
-void list<T>::assign(std::initializer_list<T> ilist) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::assign(std::initializer_list<T> ilist) {
     this->clear();
     insert(cend(), ilist);
 }
 
-template <typename T>
-T &list<T>::front() {
+template <typename T, typename Alloc>
+T &list<T, Alloc>::front() {
     return *(this->begin());
 }
 
-template <typename T>
-const T &list<T>::front() const {
+template <typename T, typename Alloc>
+const T &list<T, Alloc>::front() const {
     return *(this->cbegin());
 }
 
-template <typename T>
-T &list<T>::back() {
+template <typename T, typename Alloc>
+T &list<T, Alloc>::back() {
     return *(--(this->end()));
 }
 
-template <typename T>
-const T &list<T>::back() const {
+template <typename T, typename Alloc>
+const T &list<T, Alloc>::back() const {
     return *(--(this->cend()));
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::begin() noexcept {
-    return iterator(this->dummy_node->next);
+template <typename T, typename Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::begin() noexcept {
+    return iterator(this->M_impl.dummy_node->next);
 }
 
-template <typename T>
-typename list<T>::const_iterator list<T>::begin() const noexcept {
-    return const_iterator(this->dummy_node->next);
+template <typename T, typename Alloc>
+typename list<T, Alloc>::const_iterator list<T, Alloc>::begin() const noexcept {
+    return const_iterator(this->M_impl.dummy_node->next);
 }
 
-template <typename T>
-typename list<T>::const_iterator list<T>::cbegin() const noexcept {
-    return const_iterator(this->dummy_node->next);
+template <typename T, typename Alloc>
+typename list<T, Alloc>::const_iterator list<T, Alloc>::cbegin() const noexcept {
+    return const_iterator(this->M_impl.dummy_node->next);
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::end() noexcept {
-    return iterator(this->dummy_node);
+template <typename T, typename Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::end() noexcept {
+    return iterator(this->M_impl.dummy_node);
 }
 
-template <typename T>
-typename list<T>::const_iterator list<T>::end() const noexcept {
-    return const_iterator(this->dummy_node);
+template <typename T, typename Alloc>
+typename list<T, Alloc>::const_iterator list<T, Alloc>::end() const noexcept {
+    return const_iterator(this->M_impl.dummy_node);
 }
 
-template <typename T>
-typename list<T>::const_iterator list<T>::cend() const noexcept {
-    return const_iterator(this->dummy_node);
+template <typename T, typename Alloc>
+typename list<T, Alloc>::const_iterator list<T, Alloc>::cend() const noexcept {
+    return const_iterator(this->M_impl.dummy_node);
 }
 
-template <typename T>
-typename list<T>::reverse_iterator list<T>::rbegin() noexcept {
-    return reverse_iterator(const_iterator(this->dummy_node));
+template <typename T, typename Alloc>
+typename list<T, Alloc>::reverse_iterator list<T, Alloc>::rbegin() noexcept {
+    return reverse_iterator(iterator(this->M_impl.dummy_node));
 }
 
-template <typename T>
-typename list<T>::const_reverse_iterator list<T>::rbegin() const noexcept {
-    return const_reverse_iterator(const_iterator(this->dummy_node));
+template <typename T, typename Alloc>
+typename list<T, Alloc>::const_reverse_iterator list<T, Alloc>::rbegin() const noexcept {
+    return const_reverse_iterator(const_iterator(this->M_impl.dummy_node));
 }
 
-template <typename T>
-typename list<T>::const_reverse_iterator list<T>::crbegin() const noexcept {
-    return const_reverse_iterator(const_iterator(this->dummy_node));
+template <typename T, typename Alloc>
+typename list<T, Alloc>::const_reverse_iterator list<T, Alloc>::crbegin() const noexcept {
+    return const_reverse_iterator(const_iterator(this->M_impl.dummy_node));
 }
 
-template <typename T>
-typename list<T>::reverse_iterator list<T>::rend() noexcept {
-    return reverse_iterator(iterator(this->dummy_node->next));
+template <typename T, typename Alloc>
+typename list<T, Alloc>::reverse_iterator list<T, Alloc>::rend() noexcept {
+    return reverse_iterator(iterator(this->M_impl.dummy_node->next));
 }
 
-template <typename T>
-typename list<T>::const_reverse_iterator list<T>::rend() const noexcept {
-    return const_reverse_iterator(const_iterator(this->dummy_node->next));
+template <typename T, typename Alloc>
+typename list<T, Alloc>::const_reverse_iterator list<T, Alloc>::rend() const noexcept {
+    return const_reverse_iterator(const_iterator(this->M_impl.dummy_node->next));
 }
 
-template <typename T>
-typename list<T>::const_reverse_iterator list<T>::crend() const noexcept {
-    return const_reverse_iterator(const_iterator(this->dummy_node->next));
+template <typename T, typename Alloc>
+typename list<T, Alloc>::const_reverse_iterator list<T, Alloc>::crend() const noexcept {
+    return const_reverse_iterator(const_iterator(this->M_impl.dummy_node->next));
 }
 
-template <typename T>
-bool list<T>::empty() const noexcept {
-    return !list_size;
+template <typename T, typename Alloc>
+bool list<T, Alloc>::empty() const noexcept {
+    return !M_impl.list_size;
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::insert(const_iterator pos, const T &value) {
+template <typename T, typename Alloc>
+typename list<T, Alloc>::size_type list<T, Alloc>::max_size() const noexcept {
+    return node_alloc_traits::max_size(M_get_node_allocator());
+}
+
+template <typename T, typename Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator pos, const T &value) {
     auto current = pos.current_node;
     auto prev = current->prev;
-    auto new_node = new node(value, current, prev);
+    auto new_node = this->M_create_node(value);
+    new_node->next = current;
+    new_node->prev = prev;
     prev->next = new_node;
     current->prev = new_node;
-    ++list_size;
+    ++M_impl.list_size;
     return iterator(new_node);
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::insert(const_iterator pos, T &&value) {
+template <typename T, typename Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator pos, T &&value) {
     auto current = pos.current_node;
     auto prev = current->prev;
-    auto new_node = new node(std::move_if_noexcept(value), current, prev);
+    auto new_node = this->M_create_node(std::move_if_noexcept(value));
+    new_node->next = current;
+    new_node->prev = prev;
     prev->next = new_node;
     current->prev = new_node;
-    ++list_size;
+    ++M_impl.list_size;
     return iterator(new_node);
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::insert(const_iterator pos, size_type count, const T &value) {
+template <typename T, typename Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator pos, size_type count, const T &value) {
     if (!count) {
-        return pos;
+        return iterator(pos.current_node);
     }
-    while (count--) {
-        pos = insert(pos, value);
-    }
-    return pos;
+    node *last;
+    auto first = this->M_create_chain(count, [&value](T_alloc_type &a, T *p) { T_alloc_traits::construct(a, p, value); }, last);
+    return M_link_chain(pos, first, last, count);
 }
 
-template <typename T>
+template <typename T, typename Alloc>
 template <typename InputIt, typename>
-typename list<T>::iterator list<T>::insert(const_iterator pos, InputIt first, InputIt last) {
+typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator pos, InputIt first, InputIt last) {
+    return M_insert_range(pos, first, last, typename std::iterator_traits<InputIt>::iterator_category());
+}
+
+template <typename T, typename Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::insert(list::const_iterator pos, std::initializer_list<T> ilist) {
+    return M_insert_n(pos, ilist.begin(), ilist.size());
+}
+
+template <typename T, typename Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::M_link_chain(const_iterator pos, node *first, node *last, size_type count) noexcept {
+    auto next = pos.current_node;
+    auto prev = next->prev;
+    prev->next = first;
+    first->prev = prev;
+    last->next = next;
+    next->prev = last;
+    M_impl.list_size += count;
+    return iterator(first);
+}
+
+template <typename T, typename Alloc>
+template <typename ForwardIt>
+typename list<T, Alloc>::iterator list<T, Alloc>::M_insert_n(const_iterator pos, ForwardIt first, size_type count) {
+    if (!count) {
+        return iterator(pos.current_node);
+    }
+    node *last;
+    auto chain = this->M_create_chain(
+        count,
+        [&first](T_alloc_type &a, T *p) {
+            T_alloc_traits::construct(a, p, *first);
+            ++first;
+        },
+        last);
+    return M_link_chain(pos, chain, last, count);
+}
+
+template <typename T, typename Alloc>
+template <typename InputIt>
+typename list<T, Alloc>::iterator list<T, Alloc>::M_insert_range(const_iterator pos, InputIt first, InputIt last, std::input_iterator_tag) {
     auto prev = pos.current_node->prev;
     while (first != last) {
         insert(pos, *first);
@@ -592,144 +953,145 @@ typename list<T>::iterator list<T>::insert(const_iterator pos, InputIt first, In
     return iterator(prev->next);
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::insert(list::const_iterator pos, std::initializer_list<T> ilist) {
-    auto prev = pos.current_node->prev;
-    for (auto &i : ilist) {
-        insert(pos, std::move_if_noexcept(i));
-    }
-    return iterator(prev->next);
+template <typename T, typename Alloc>
+template <typename ForwardIt>
+typename list<T, Alloc>::iterator list<T, Alloc>::M_insert_range(const_iterator pos, ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+    return M_insert_n(pos, first, static_cast<size_type>(std::distance(first, last)));
 }
 
 //在pos后插入节点other，只改变指针值。
-template <typename T>
-typename list<T>::iterator list<T>::insert(const_iterator pos, node &other) {
+template <typename T, typename Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator pos, node &other) {
     auto current = pos.current_node;
     auto next = current->next;
     current->next = &other;
     next->prev = &other;
     other.prev = current;
     other.next = next;
-    ++list_size;
+    ++M_impl.list_size;
     return iterator(&other);
 }
 
-template <typename T>
+template <typename T, typename Alloc>
 template <class... Args>
-typename list<T>::iterator list<T>::emplace(const_iterator pos, Args &&...args) {
+typename list<T, Alloc>::iterator list<T, Alloc>::emplace(const_iterator pos, Args &&...args) {
     auto current = pos.current_node;
     auto prev = current->prev;
-    auto new_node = new node(std::forward<Args>(args)...);
+    auto new_node = this->M_create_node(std::forward<Args>(args)...);
     new_node->next = current;
     new_node->prev = prev;
     prev->next = new_node;
     current->prev = new_node;
-    ++list_size;
+    ++M_impl.list_size;
     return iterator(new_node);
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::erase(const_iterator pos) {
+template <typename T, typename Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::erase(const_iterator pos) {
     auto current = pos.current_node;
     auto prev = current->prev;
     auto next = current->next;
-    if (current == dummy_node) {
-        return pos;
+    if (current == M_impl.dummy_node) {
+        return iterator(current);
     }
-    delete current;
+    this->M_destroy_node(current);
     prev->next = next;
     next->prev = prev;
-    --list_size;
+    --M_impl.list_size;
     return iterator(next);
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::erase(const_iterator first, const_iterator last) {
+template <typename T, typename Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::erase(const_iterator first, const_iterator last) {
     auto prev = first.current_node->prev;
     while (first != last) {
         auto current = first.current_node;
         ++first;
-        delete current;
-        --list_size;
+        this->M_destroy_node(current);
+        --M_impl.list_size;
     }
     prev->next = last.current_node;
     last.current_node->prev = prev;
-    return last;
+    return iterator(last.current_node);
 }
 
-template <typename T>
-void list<T>::push_back(const T &value) {
-    auto current = dummy_node;
+template <typename T, typename Alloc>
+void list<T, Alloc>::push_back(const T &value) {
+    auto current = M_impl.dummy_node;
     auto prev = current->prev;
-    auto new_node = new node(value, current, prev);
+    auto new_node = this->M_create_node(value);
+    new_node->next = current;
+    new_node->prev = prev;
     prev->next = new_node;
     current->prev = new_node;
-    ++list_size;
+    ++M_impl.list_size;
 }
 
-template <typename T>
-void list<T>::push_back(T &&value) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::push_back(T &&value) {
     emplace_back(std::move_if_noexcept(value));
 }
 
-template <typename T>
+template <typename T, typename Alloc>
 template <class... Args>
-void list<T>::emplace_back(Args &&...args) {
-    auto current = dummy_node;
+void list<T, Alloc>::emplace_back(Args &&...args) {
+    auto current = M_impl.dummy_node;
     auto prev = current->prev;
-    auto new_node = new node(std::forward<Args>(args)...);
+    auto new_node = this->M_create_node(std::forward<Args>(args)...);
     new_node->next = current;
     new_node->prev = prev;
     prev->next = new_node;
     current->prev = new_node;
-    ++list_size;
+    ++M_impl.list_size;
 }
 
-template <typename T>
-void list<T>::pop_back() {
+template <typename T, typename Alloc>
+void list<T, Alloc>::pop_back() {
     erase(--(cend()));
 }
 
-template <typename T>
-void list<T>::push_front(const T &value) {
-    auto current = dummy_node->next;
-    auto prev = dummy_node;
+template <typename T, typename Alloc>
+void list<T, Alloc>::push_front(const T &value) {
+    auto current = M_impl.dummy_node->next;
+    auto prev = M_impl.dummy_node;
     auto next = current->next;
-    auto new_node = new node(value, current, prev);
+    auto new_node = this->M_create_node(value);
+    new_node->next = current;
+    new_node->prev = prev;
     prev->next = new_node;
     current->prev = new_node;
-    ++list_size;
+    ++M_impl.list_size;
 }
 
-template <typename T>
-void list<T>::push_front(T &&value) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::push_front(T &&value) {
     emplace_front(std::move_if_noexcept(value));
 }
 
-template <typename T>
+template <typename T, typename Alloc>
 template <class... Args>
-void list<T>::emplace_front(Args &&...args) {
-    auto current = dummy_node->next;
-    auto prev = dummy_node;
-    auto new_node = new node(std::forward<Args>(args)...);
+void list<T, Alloc>::emplace_front(Args &&...args) {
+    auto current = M_impl.dummy_node->next;
+    auto prev = M_impl.dummy_node;
+    auto new_node = this->M_create_node(std::forward<Args>(args)...);
     new_node->next = current;
     new_node->prev = prev;
     prev->next = new_node;
     current->prev = new_node;
-    ++list_size;
+    ++M_impl.list_size;
 }
 
-template <typename T>
-void list<T>::pop_front() {
+template <typename T, typename Alloc>
+void list<T, Alloc>::pop_front() {
     erase(cbegin());
 }
 
-template <typename T>
-void list<T>::resize(size_type count) {
-    if (list_size == count) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::resize(size_type count) {
+    if (M_impl.list_size == count) {
         return;
     }
-    if (list_size > count) {
+    if (M_impl.list_size > count) {
         auto iter = cbegin();
         for (size_type i = 0; i < count; ++i) {
             ++iter;
@@ -737,195 +1099,132 @@ void list<T>::resize(size_type count) {
         erase(iter, cend());
         return;
     } else {
-        insert(cend(), count - list_size, T());
+        insert(cend(), count - M_impl.list_size, T());
         return;
     }
 }
 
-template <typename T>
-void list<T>::resize(size_type count, const value_type &value) {
-    if (list_size == count) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::resize(size_type count, const value_type &value) {
+    if (M_impl.list_size == count) {
         return;
     }
-    if (list_size > count) {
+    if (M_impl.list_size > count) {
         auto iter = cbegin();
-        for (int i = 0; i < count; ++i) {
+        for (size_type i = 0; i < count; ++i) {
             ++iter;
         }
         erase(iter, cend());
         return;
     } else {
-        insert(cend(), count - list_size, value);
+        insert(cend(), count - M_impl.list_size, value);
         return;
     }
 }
 
-template <typename T>
-void list<T>::swap(list &other) {
-    std::swap(this->dummy_node, other.dummy_node);
-    std::swap(this->list_size, other.list_size);
+template <typename T, typename Alloc>
+void list<T, Alloc>::swap(list &other) {
+    M_impl.M_swap_data(other.M_impl);
+    alloc_on_swap(M_get_node_allocator(), other.M_get_node_allocator(), typename node_alloc_traits::propagate_on_container_swap());
 }
 
-template <typename T>
-void list<T>::sort() {
-    sort([](const T &a, const T &b) { return a < b; });
+template <typename T, typename Alloc>
+void list<T, Alloc>::sort() {
+    sort(std::less<T>());
 }
 
-template <typename T>
+template <typename T, typename Alloc>
 template <typename Compare>
-void list<T>::sort(Compare comp) {
-    //    sort(this->dummy_node->next, this->list_size, comp);
-    auto current = begin(), last = --end();
-    while (last != current) {
-        while (current != last) {
-            auto temp = current;
-            ++temp;
-            if (comp(*temp, *current)) {
-                std::swap(*temp, *current);
-            }
-            ++current;
-        }
-        --last;
-        current = begin();
+void list<T, Alloc>::sort(Compare comp) {
+    if (M_impl.list_size < 2) {
+        return;
     }
+    list_sort_nodes<list_node_traits<T>>(M_impl.dummy_node, comp);
 }
 
-template <typename T>
-void list<T>::merge(list &other) {
-    if (this->dummy_node == other.dummy_node) {
-        return;
-    }
-    if (other.empty()) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::sort_indexed() {
+    sort_indexed(std::less<T>());
+}
+
+//比较时仍需访问结点，但排序过程中搬动的只是连续数组里的指针，最后按数组顺序一次性重新链接。
+template <typename T, typename Alloc>
+template <typename Compare>
+void list<T, Alloc>::sort_indexed(Compare comp) {
+    if (M_impl.list_size < 2) {
         return;
     }
-    auto iter_this = this->begin();
-    auto iter_other = other.begin();
-    if (!this->empty()) {
-        while (*iter_other < *iter_this) {
-            auto temp = iter_other;
-            ++iter_other;
-            insert(this->end(), *(temp.current_node));
-        }
+    vector<node *> nodes(M_impl.list_size, default_init);
+    auto out = nodes.data();
+    for (auto current = M_impl.dummy_node->next; current != M_impl.dummy_node; current = current->next) {
+        *out++ = current;
     }
-    while (iter_other != other.end()) {
-        if (iter_this != this->end()) {
-            auto next = iter_this;
-            ++next;
-            if (next != this->end()) {
-                if (!(*iter_other < *iter_this) && *iter_other < *next) {
-                    auto temp = iter_other;
-                    ++iter_other;
-                    iter_this = insert(iter_this, *(temp.current_node));
-                    continue;
-                } else {
-                    ++iter_this;
-                    continue;
-                }
-            } else {
-                auto temp = iter_other;
-                ++iter_other;
-                iter_this = insert(iter_this, *(temp.current_node));
-                continue;
-            }
-        } else {
-            auto temp = iter_other;
-            ++iter_other;
-            insert(--iter_this, *(temp.current_node));
-            iter_this = this->end();
-            continue;
-        }
+    std::stable_sort(nodes.begin(), nodes.end(), [&comp](const node *a, const node *b) { return comp(a->data, b->data); });
+    auto prev = M_impl.dummy_node;
+    for (auto n : nodes) {
+        prev->next = n;
+        n->prev = prev;
+        prev = n;
     }
-    other.dummy_node->next = other.dummy_node;
-    other.dummy_node->prev = other.dummy_node;
-    other.list_size = 0;
+    prev->next = M_impl.dummy_node;
+    M_impl.dummy_node->prev = prev;
 }
 
-template <typename T>
-void list<T>::merge(list &&other) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::merge(list &other) {
+    merge(other, std::less<T>());
+}
+
+template <typename T, typename Alloc>
+void list<T, Alloc>::merge(list &&other) {
     merge(other);
 }
 
-template <typename T>
+//comp 抛出异常时两边的结点数已无从得知，重新数一遍。
+template <typename T, typename Alloc>
 template <typename Compare>
-void list<T>::merge(list &other, Compare comp) {
-    if (this->dummy_node == other.dummy_node) {
+void list<T, Alloc>::merge(list &other, Compare comp) {
+    if (this->M_impl.dummy_node == other.M_impl.dummy_node || other.empty()) {
         return;
     }
-    if (other.empty()) {
-        return;
-    }
-    auto iter_this = this->begin();
-    auto iter_other = other.begin();
-    if (!this->empty()) {
-        while (comp(*iter_other, *iter_this)) {
-            auto temp = iter_other;
-            ++iter_other;
-            insert(this->end(), *(temp.current_node));
-        }
-    }
-    while (iter_other != other.end()) {
-        if (iter_this != this->end()) {
-            auto next = iter_this;
-            ++next;
-            if (next != this->end()) {
-                if (!comp(*iter_other, *iter_this) && comp(*iter_other, *next)) {
-                    auto temp = iter_other;
-                    ++iter_other;
-                    iter_this = insert(iter_this, *(temp.current_node));
-                    continue;
-                } else {
-                    ++iter_this;
-                    continue;
-                }
-            } else {
-                auto temp = iter_other;
-                ++iter_other;
-                iter_this = insert(iter_this, *(temp.current_node));
-                continue;
-            }
-        } else {
-            auto temp = iter_other;
-            ++iter_other;
-            insert(--iter_this, *(temp.current_node));
-            iter_this = this->end();
-            continue;
-        }
+    try {
+        list_merge_nodes<list_node_traits<T>>(M_impl.dummy_node, other.M_impl.dummy_node, comp);
+    } catch (...) {
+        M_impl.list_size = static_cast<size_type>(std::distance(begin(), end()));
+        other.M_impl.list_size = static_cast<size_type>(std::distance(other.begin(), other.end()));
+        throw;
     }
-    other.dummy_node->next = other.dummy_node;
-    other.dummy_node->prev = other.dummy_node;
-    other.list_size = 0;
+    M_impl.list_size += other.M_impl.list_size;
+    other.M_impl.list_size = 0;
 }
 
-template <typename T>
-template <typename Compare>
-typename list<T>::const_iterator list<T>::merge_self(const_iterator first, const_iterator mid, const_iterator last, Compare comp) {}
-
-template <typename T>
+template <typename T, typename Alloc>
 template <typename Compare>
-void list<T>::merge(list &&other, Compare comp) {
+void list<T, Alloc>::merge(list &&other, Compare comp) {
     merge(other, comp);
 }
-template <typename T>
-void list<T>::splice(list::const_iterator pos, list &other) {
-    auto first = other.dummy_node->next;
-    auto last = other.dummy_node->prev;
+
+template <typename T, typename Alloc>
+void list<T, Alloc>::splice(list::const_iterator pos, list &other) {
+    auto first = other.M_impl.dummy_node->next;
+    auto last = other.M_impl.dummy_node->prev;
     first->prev = pos.current_node->prev;
     pos.current_node->prev->next = first;
     last->next = pos.current_node;
     pos.current_node->prev = last;
-    other.dummy_node->prev = other.dummy_node;
-    other.dummy_node->next = other.dummy_node;
-    this->list_size += other.list_size;
-    other.list_size = 0;
+    other.M_impl.dummy_node->prev = other.M_impl.dummy_node;
+    other.M_impl.dummy_node->next = other.M_impl.dummy_node;
+    this->M_impl.list_size += other.M_impl.list_size;
+    other.M_impl.list_size = 0;
 }
 
-template <typename T>
-void list<T>::splice(list::const_iterator pos, list &&other) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::splice(list::const_iterator pos, list &&other) {
     splice(pos, other);
 }
 
-template <typename T>
-void list<T>::splice(list::const_iterator pos, list &other, list::const_iterator it) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::splice(list::const_iterator pos, list &other, list::const_iterator it) {
     --pos;
     auto prev = it, next = it;
     --prev;
@@ -933,16 +1232,16 @@ void list<T>::splice(list::const_iterator pos, list &other, list::const_iterator
     prev.current_node->next = next.current_node;
     next.current_node->prev = prev.current_node;
     insert(pos, *(it.current_node));
-    --other.list_size;
+    --other.M_impl.list_size;
 }
 
-template <typename T>
-void list<T>::splice(list::const_iterator pos, list &&other, list::const_iterator it) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::splice(list::const_iterator pos, list &&other, list::const_iterator it) {
     splice(pos, other, it);
 }
 
-template <typename T>
-void list<T>::splice(list::const_iterator pos, list &other, list::const_iterator first, list::const_iterator last) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::splice(list::const_iterator pos, list &other, list::const_iterator first, list::const_iterator last) {
     if (first == last) {
         return;
     }
@@ -956,17 +1255,17 @@ void list<T>::splice(list::const_iterator pos, list &other, list::const_iterator
     pos.current_node->prev = last.current_node;
     prev->next = next;
     next->prev = prev;
-    other.list_size -= len;
-    this->list_size += len;
+    other.M_impl.list_size -= len;
+    this->M_impl.list_size += len;
 }
 
-template <typename T>
-void list<T>::splice(list::const_iterator pos, list &&other, list::const_iterator first, list::const_iterator last) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::splice(list::const_iterator pos, list &&other, list::const_iterator first, list::const_iterator last) {
     splice(pos, other, first, last);
 }
 
-template <typename T>
-void list<T>::remove(const T &value) {
+template <typename T, typename Alloc>
+void list<T, Alloc>::remove(const T &value) {
     auto iter = cbegin();
     while (iter != cend()) {
         if (*iter == value) {
@@ -977,9 +1276,9 @@ void list<T>::remove(const T &value) {
     }
 }
 
-template <typename T>
+template <typename T, typename Alloc>
 template <typename UnaryPredicate>
-void list<T>::remove_if(UnaryPredicate p) {
+void list<T, Alloc>::remove_if(UnaryPredicate p) {
     auto iter = cbegin();
     while (iter != cend()) {
         if (p(*iter)) {
@@ -990,8 +1289,8 @@ void list<T>::remove_if(UnaryPredicate p) {
     }
 }
 
-template <typename T>
-void list<T>::reverse() noexcept {
+template <typename T, typename Alloc>
+void list<T, Alloc>::reverse() noexcept {
     auto iter = cbegin();
     while (iter != cend()) {
         auto temp = iter;
@@ -1001,8 +1300,8 @@ void list<T>::reverse() noexcept {
     std::swap(iter.current_node->next, iter.current_node->prev);
 }
 
-template <typename T>
-void list<T>::unique() {
+template <typename T, typename Alloc>
+void list<T, Alloc>::unique() {
     auto iter = cbegin();
     while (iter != cend()) {
         auto next = iter;
@@ -1019,9 +1318,9 @@ void list<T>::unique() {
     }
 }
 
-template <typename T>
+template <typename T, typename Alloc>
 template <typename BinaryPredicate>
-void list<T>::unique(BinaryPredicate p) {
+void list<T, Alloc>::unique(BinaryPredicate p) {
     auto iter = cbegin();
     while (iter != cend()) {
         auto next = iter;
@@ -1037,24 +1336,8 @@ void list<T>::unique(BinaryPredicate p) {
         }
     }
 }
-template <typename T>
-template <typename Compare>
-typename list<T>::node *list<T>::sort(node *first, size_type size, Compare comp) {
-    // order [_First, _First + _Size), return _First + _Size
-    switch (size) {
-    case 0: return first;
-    case 1: return first->next;
-    default: break;
-    }
-
-    auto Mid = sort(first, size / 2, comp);
-    const auto Last = sort(Mid, size - size / 2, comp);
-    merge_self(const_iterator(first), const_iterator(Mid), const_iterator(Last), comp);
-    return Last;
-}
-
-template <typename T>
-bool operator==(const list<T> &lhs, const list<T> &rhs) {
+template <typename T, typename Alloc>
+bool operator==(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
     if (lhs.size() != rhs.size()) {
         return false;
     }
@@ -1070,33 +1353,37 @@ bool operator==(const list<T> &lhs, const list<T> &rhs) {
     return true;
 }
 
-template <typename T>
-bool operator!=(const list<T> &lhs, const list<T> &rhs) {
+template <typename T, typename Alloc>
+bool operator!=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
     return !(lhs == rhs);
 }
 
-template <typename T>
-bool operator<(const list<T> &lhs, const list<T> &rhs) {
+template <typename T, typename Alloc>
+bool operator<(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
     return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
 }
 
-template <typename T>
-bool operator<=(const list<T> &lhs, const list<T> &rhs) {
+template <typename T, typename Alloc>
+bool operator<=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
     return !(rhs < lhs);
 }
 
-template <typename T>
-bool operator>(const list<T> &lhs, const list<T> &rhs) {
+template <typename T, typename Alloc>
+bool operator>(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
     return rhs < lhs;
 }
-template <typename T>
-bool operator>=(const list<T> &lhs, const list<T> &rhs) {
+template <typename T, typename Alloc>
+bool operator>=(const list<T, Alloc> &lhs, const list<T, Alloc> &rhs) {
     return !(lhs < rhs);
 }
 
-template <typename T>
-void swap(list<T> &lhs, list<T> &rhs) {
+template <typename T, typename Alloc>
+void swap(list<T, Alloc> &lhs, list<T, Alloc> &rhs) {
     lhs.swap(rhs);
 }
 
-} // namespace mystl
\ No newline at end of file
+namespace pmr {
+template <typename T>
+using list = mystl::list<T, polymorphic_allocator<T>>;
+} // namespace pmr
+} // namespace mystl
@@ -0,0 +1,156 @@
+#pragma once
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "my_btree.hpp"
+#include "my_memory_resource.hpp"
+#include "my_utility.hpp"
+
+namespace mystl {
+///基于 B 树的有序映射。插入与删除使所有迭代器失效，见 btree 。
+template <typename Key, typename T, typename Compare = std::less<Key>, typename Alloc = allocator<std::pair<const Key, T>>>
+class map : public btree<std::pair<const Key, T>, Key, select_first, Compare, Alloc, false> {
+    using base = btree<std::pair<const Key, T>, Key, select_first, Compare, Alloc, false>;
+
+public:
+    using mapped_type = T;
+    using typename base::const_iterator;
+    using typename base::iterator;
+    using typename base::key_type;
+    using typename base::size_type;
+    using typename base::value_type;
+
+    ///按键比较两个元素。
+    class value_compare {
+        friend class map;
+
+    protected:
+        Compare comp;
+        explicit value_compare(const Compare &c) : comp(c) {}
+
+    public:
+        bool operator()(const value_type &lhs, const value_type &rhs) const { return comp(lhs.first, rhs.first); }
+    };
+
+    using base::base;
+    using base::operator=;
+    map() = default;
+
+    //元素访问
+    T &at(const key_type &key);             //返回键为 key 的元素的值，不存在时抛出 std::out_of_range 。
+    const T &at(const key_type &key) const; //返回键为 key 的元素的值，不存在时抛出 std::out_of_range 。
+    T &operator[](const key_type &key) { return try_emplace(key).first->second; }
+    T &operator[](key_type &&key) { return try_emplace(std::move(key)).first->second; }
+
+    //修改器
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) { //键不存在时才以 args 构造值，存在时不移动实参。
+        return this->M_emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+        return this->M_emplace_key(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                   std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    template <typename... Args>
+    iterator try_emplace(const_iterator, const key_type &key, Args &&...args) {
+        return try_emplace(key, std::forward<Args>(args)...).first;
+    }
+    template <typename... Args>
+    iterator try_emplace(const_iterator, key_type &&key, Args &&...args) {
+        return try_emplace(std::move(key), std::forward<Args>(args)...).first;
+    }
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj); //键存在时赋值，否则插入。
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(key_type &&key, M &&obj);
+
+    //观察器
+    value_compare value_comp() const { return value_compare(this->key_comp()); }
+};
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+T &map<Key, T, Compare, Alloc>::at(const key_type &key) {
+    auto it = this->find(key);
+    if (it == this->end()) {
+        throw std::out_of_range("map::at");
+    }
+    return it->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+const T &map<Key, T, Compare, Alloc>::at(const key_type &key) const {
+    auto it = this->find(key);
+    if (it == this->end()) {
+        throw std::out_of_range("map::at");
+    }
+    return it->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+template <typename M>
+std::pair<typename map<Key, T, Compare, Alloc>::iterator, bool> map<Key, T, Compare, Alloc>::insert_or_assign(const key_type &key, M &&obj) {
+    auto result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) {
+        result.first->second = std::forward<M>(obj);
+    }
+    return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+template <typename M>
+std::pair<typename map<Key, T, Compare, Alloc>::iterator, bool> map<Key, T, Compare, Alloc>::insert_or_assign(key_type &&key, M &&obj) {
+    auto result = try_emplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+        result.first->second = std::forward<M>(obj);
+    }
+    return result;
+}
+
+///基于 B 树的有序多重映射，等价的键按插入顺序排列。
+template <typename Key, typename T, typename Compare = std::less<Key>, typename Alloc = allocator<std::pair<const Key, T>>>
+class multimap : public btree<std::pair<const Key, T>, Key, select_first, Compare, Alloc, true> {
+    using base = btree<std::pair<const Key, T>, Key, select_first, Compare, Alloc, true>;
+
+public:
+    using mapped_type = T;
+    using typename base::value_type;
+
+    ///按键比较两个元素。
+    class value_compare {
+        friend class multimap;
+
+    protected:
+        Compare comp;
+        explicit value_compare(const Compare &c) : comp(c) {}
+
+    public:
+        bool operator()(const value_type &lhs, const value_type &rhs) const { return comp(lhs.first, rhs.first); }
+    };
+
+    using base::base;
+    using base::operator=;
+    multimap() = default;
+
+    value_compare value_comp() const { return value_compare(this->key_comp()); }
+};
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+void swap(map<Key, T, Compare, Alloc> &lhs, map<Key, T, Compare, Alloc> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+void swap(multimap<Key, T, Compare, Alloc> &lhs, multimap<Key, T, Compare, Alloc> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using map = mystl::map<Key, T, Compare, polymorphic_allocator<std::pair<const Key, T>>>;
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using multimap = mystl::multimap<Key, T, Compare, polymorphic_allocator<std::pair<const Key, T>>>;
+} // namespace pmr
+} // namespace mystl
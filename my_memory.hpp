@@ -0,0 +1,357 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mystl {
+///可平凡重定位类型萃取。满足此萃取的类型可以通过按字节复制到新地址来完成搬迁，且无需再对原对象调用析构函数。
+///平凡可复制类型默认满足；其余类型（例如只持有堆指针的句柄类）可以通过特化此模板显式声明。
+template <typename T>
+struct is_trivially_relocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+///两个成员都可平凡重定位的 pair 也可平凡重定位，关联容器的 pair<const Key, T> 元素因此能按字节搬迁。
+template <typename T1, typename T2>
+struct is_trivially_relocatable<std::pair<T1, T2>>
+    : std::integral_constant<bool, is_trivially_relocatable<typename std::remove_const<T1>::type>::value &&
+                                       is_trivially_relocatable<typename std::remove_const<T2>::type>::value> {};
+
+template <typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+///搬迁实现，可平凡重定位版本：一次 memmove 完成。
+template <typename T>
+T *uninitialized_relocate_impl(T *first, T *last, T *dest, std::true_type) noexcept {
+    auto count = static_cast<size_t>(last - first);
+    if (count) {
+        std::memmove(static_cast<void *>(dest), static_cast<const void *>(first), count * sizeof(T));
+    }
+    return dest + count;
+}
+
+///搬迁实现，一般版本：逐个移动构造（移动可能抛出异常时退化为复制），全部成功后再析构源对象。
+///若构造过程中抛出异常，则销毁已构造的目标对象并重新抛出，源区间保持不变。
+template <typename T>
+T *uninitialized_relocate_impl(T *first, T *last, T *dest, std::false_type) {
+    auto current = dest;
+    try {
+        for (auto iter = first; iter != last; ++iter, ++current) {
+            new (current) T(std::move_if_noexcept(*iter));
+        }
+    } catch (...) {
+        while (current != dest) {
+            (--current)->~T();
+        }
+        throw;
+    }
+    for (auto iter = first; iter != last; ++iter) {
+        iter->~T();
+    }
+    return current;
+}
+
+///将 [first, last) 中的对象搬迁到以 dest 开始的未初始化内存中，搬迁后源区间视为未初始化内存。返回目标区间的尾后指针。
+template <typename T>
+T *uninitialized_relocate(T *first, T *last, T *dest) {
+    return uninitialized_relocate_impl(first, last, dest, is_trivially_relocatable<T>());
+}
+
+///默认分配器，直接使用 std::malloc/std::free 管理内存；对齐要求超过 malloc 保证的类型改用带对齐参数的 operator new/delete 。
+///除标准分配器接口外还提供 reallocate 扩展，供容器对可平凡重定位的元素进行原地扩容。
+template <typename T>
+class allocator {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    allocator() noexcept = default;
+    template <typename U>
+    allocator(const allocator<U> &) noexcept {}
+
+    T *allocate(size_type n); //申请可容纳 n 个 T 的未初始化内存。失败时抛出 std::bad_alloc 。
+    void deallocate(T *p, size_type) noexcept;
+    T *reallocate(T *p, size_type old_n, size_type new_n); //将 p 处的内存块调整为 new_n 个 T 的大小，内容按字节保留。仅适用于可平凡重定位类型。
+
+    size_type max_size() const noexcept { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+private:
+    static constexpr bool over_aligned = alignof(T) > alignof(std::max_align_t);
+};
+
+template <typename T>
+T *allocator<T>::allocate(size_type n) {
+    if (n > max_size()) {
+        throw std::bad_alloc();
+    }
+    if (over_aligned) {
+        return static_cast<T *>(::operator new(sizeof(T) * n, std::align_val_t(alignof(T))));
+    }
+    auto p = static_cast<T *>(std::malloc(sizeof(T) * n));
+    if (!p && n) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+template <typename T>
+void allocator<T>::deallocate(T *p, size_type) noexcept {
+    if (over_aligned) {
+        ::operator delete(p, std::align_val_t(alignof(T)));
+    } else {
+        std::free(p);
+    }
+}
+
+//realloc 不保证超出 malloc 的对齐，过度对齐的类型改为申请新块、按字节复制、释放旧块。
+template <typename T>
+T *allocator<T>::reallocate(T *p, size_type old_n, size_type new_n) {
+    if (!new_n) {
+        deallocate(p, old_n);
+        return nullptr;
+    }
+    if (new_n > max_size()) {
+        throw std::bad_alloc();
+    }
+    if (over_aligned) {
+        auto new_p = allocate(new_n);
+        if (p) {
+            std::memcpy(static_cast<void *>(new_p), static_cast<const void *>(p), sizeof(T) * (old_n < new_n ? old_n : new_n));
+        }
+        deallocate(p, old_n);
+        return new_p;
+    }
+    auto new_p = static_cast<T *>(std::realloc(static_cast<void *>(p), sizeof(T) * new_n)); //只对可平凡重定位的 T 调用
+    if (!new_p) {
+        throw std::bad_alloc();
+    }
+    return new_p;
+}
+
+template <typename T, typename U>
+bool operator==(const allocator<T> &, const allocator<U> &) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const allocator<T> &, const allocator<U> &) noexcept {
+    return false;
+}
+
+///按照 propagate_on_container_copy_assignment 复制分配器。
+template <typename Alloc>
+void alloc_on_copy(Alloc &dest, const Alloc &src, std::true_type) {
+    dest = src;
+}
+
+template <typename Alloc>
+void alloc_on_copy(Alloc &, const Alloc &, std::false_type) {}
+
+///按照 propagate_on_container_move_assignment 移动分配器。
+template <typename Alloc>
+void alloc_on_move(Alloc &dest, Alloc &src, std::true_type) {
+    dest = std::move(src);
+}
+
+template <typename Alloc>
+void alloc_on_move(Alloc &, Alloc &, std::false_type) {}
+
+///按照 propagate_on_container_swap 交换分配器。
+template <typename Alloc>
+void alloc_on_swap(Alloc &lhs, Alloc &rhs, std::true_type) {
+    using std::swap;
+    swap(lhs, rhs);
+}
+
+template <typename Alloc>
+void alloc_on_swap(Alloc &, Alloc &, std::false_type) {}
+
+///分配器的 construct/destroy 是否与 placement new/直接析构等价。满足时容器可以绕过分配器，对平凡类型使用 memset/memcpy 等批量内核。
+template <typename Alloc>
+struct is_default_construct_allocator : std::false_type {};
+
+template <typename T>
+struct is_default_construct_allocator<std::allocator<T>> : std::true_type {};
+
+template <typename T>
+struct is_default_construct_allocator<allocator<T>> : std::true_type {};
+
+///分配器不干预构造且 T 满足 Trait 时为 true_type 。
+template <typename Alloc, typename T, template <typename> class Trait>
+using use_bulk_kernel = std::integral_constant<bool, is_default_construct_allocator<Alloc>::value && Trait<T>::value>;
+
+///默认初始化标签。以它构造或 resize 容器时，新元素只做默认初始化，平凡类型的元素保持未初始化状态。
+struct default_init_t {
+    explicit default_init_t() = default;
+};
+constexpr default_init_t default_init{};
+
+///通过分配器析构 [first, last) 中的元素，平凡析构类型不做任何事。
+template <typename T, typename Alloc>
+void destroy_a_impl(T *, T *, Alloc &, std::true_type) noexcept {}
+
+template <typename T, typename Alloc>
+void destroy_a_impl(T *first, T *last, Alloc &alloc, std::false_type) noexcept {
+    for (; first != last; ++first) {
+        std::allocator_traits<Alloc>::destroy(alloc, first);
+    }
+}
+
+template <typename T, typename Alloc>
+void destroy_a(T *first, T *last, Alloc &alloc) noexcept {
+    destroy_a_impl(first, last, alloc, use_bulk_kernel<Alloc, T, std::is_trivially_destructible>());
+}
+
+///通过分配器逐个构造 [dest, dest + n) 中的元素，每个元素由 construct(p) 构造。构造抛出异常时析构已构造的元素并重新抛出。
+template <typename T, typename Alloc, typename Construct>
+T *uninitialized_construct_n_a(T *dest, size_t n, Alloc &alloc, Construct construct) {
+    auto current = dest;
+    try {
+        for (; n > 0; --n, ++current) {
+            construct(current);
+        }
+    } catch (...) {
+        destroy_a(dest, current, alloc);
+        throw;
+    }
+    return current;
+}
+
+///以 value 的副本填充 [dest, dest + n) ，平凡可复制类型交给 std::fill_n ，可被编译器向量化或化为 memset 。
+template <typename T, typename Alloc>
+T *uninitialized_fill_n_a_impl(T *dest, size_t n, const T &value, Alloc &, std::true_type) {
+    return std::fill_n(dest, n, value);
+}
+
+template <typename T, typename Alloc>
+T *uninitialized_fill_n_a_impl(T *dest, size_t n, const T &value, Alloc &alloc, std::false_type) {
+    return uninitialized_construct_n_a(dest, n, alloc, [&](T *p) { std::allocator_traits<Alloc>::construct(alloc, p, value); });
+}
+
+template <typename T, typename Alloc>
+T *uninitialized_fill_n_a(T *dest, size_t n, const T &value, Alloc &alloc) {
+    return uninitialized_fill_n_a_impl(dest, n, value, alloc, use_bulk_kernel<Alloc, T, std::is_trivially_copyable>());
+}
+
+///值初始化 [dest, dest + n) ，平凡类型整体清零。
+template <typename T, typename Alloc>
+T *uninitialized_value_construct_n_a_impl(T *dest, size_t n, Alloc &, std::true_type) {
+    if (n) {
+        std::memset(static_cast<void *>(dest), 0, n * sizeof(T));
+    }
+    return dest + n;
+}
+
+template <typename T, typename Alloc>
+T *uninitialized_value_construct_n_a_impl(T *dest, size_t n, Alloc &alloc, std::false_type) {
+    return uninitialized_construct_n_a(dest, n, alloc, [&](T *p) { std::allocator_traits<Alloc>::construct(alloc, p); });
+}
+
+template <typename T, typename Alloc>
+T *uninitialized_value_construct_n_a(T *dest, size_t n, Alloc &alloc) {
+    return uninitialized_value_construct_n_a_impl(dest, n, alloc, use_bulk_kernel<Alloc, T, std::is_trivial>());
+}
+
+///默认初始化 [dest, dest + n) ，平凡默认构造类型不写入任何内存。
+template <typename T, typename Alloc>
+T *uninitialized_default_construct_n_a_impl(T *dest, size_t n, Alloc &, std::true_type) noexcept {
+    return dest + n;
+}
+
+template <typename T, typename Alloc>
+T *uninitialized_default_construct_n_a_impl(T *dest, size_t n, Alloc &alloc, std::false_type) {
+    return uninitialized_construct_n_a(dest, n, alloc, [](T *p) { ::new (static_cast<void *>(p)) T; });
+}
+
+template <typename T, typename Alloc>
+T *uninitialized_default_construct_n_a(T *dest, size_t n, Alloc &alloc) {
+    return uninitialized_default_construct_n_a_impl(dest, n, alloc, use_bulk_kernel<Alloc, T, std::is_trivially_default_constructible>());
+}
+
+///以 [first, last) 中元素的副本逐个构造以 dest 开始的元素。构造抛出异常时析构已构造的元素并重新抛出。
+template <typename InputIt, typename T, typename Alloc>
+T *uninitialized_copy_a_loop(InputIt first, InputIt last, T *dest, Alloc &alloc) {
+    auto current = dest;
+    try {
+        for (; first != last; ++first, ++current) {
+            std::allocator_traits<Alloc>::construct(alloc, current, *first);
+        }
+    } catch (...) {
+        destroy_a(dest, current, alloc);
+        throw;
+    }
+    return current;
+}
+
+///以 [first, last) 中元素的副本构造以 dest 开始的元素，一般版本。
+template <typename InputIt, typename T, typename Alloc>
+T *uninitialized_copy_a(InputIt first, InputIt last, T *dest, Alloc &alloc) {
+    return uninitialized_copy_a_loop(first, last, dest, alloc);
+}
+
+///源区间为连续内存且元素平凡可复制时一次 memcpy 。
+template <typename T, typename Alloc>
+T *uninitialized_copy_a_impl(const T *first, const T *last, T *dest, Alloc &, std::true_type) noexcept {
+    auto count = static_cast<size_t>(last - first);
+    if (count) {
+        std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), count * sizeof(T));
+    }
+    return dest + count;
+}
+
+template <typename T, typename Alloc>
+T *uninitialized_copy_a_impl(const T *first, const T *last, T *dest, Alloc &alloc, std::false_type) {
+    return uninitialized_copy_a_loop(first, last, dest, alloc);
+}
+
+template <typename T, typename Alloc>
+T *uninitialized_copy_a(const T *first, const T *last, T *dest, Alloc &alloc) {
+    return uninitialized_copy_a_impl(first, last, dest, alloc, use_bulk_kernel<Alloc, T, std::is_trivially_copyable>());
+}
+
+template <typename T, typename Alloc>
+T *uninitialized_copy_a(T *first, T *last, T *dest, Alloc &alloc) {
+    return uninitialized_copy_a(static_cast<const T *>(first), static_cast<const T *>(last), dest, alloc);
+}
+
+///以 [first, last) 中元素移动构造以 dest 开始的元素，平凡可复制类型一次 memcpy 。
+template <typename T, typename Alloc>
+T *uninitialized_move_a_impl(T *first, T *last, T *dest, Alloc &alloc, std::true_type) noexcept {
+    return uninitialized_copy_a_impl(static_cast<const T *>(first), static_cast<const T *>(last), dest, alloc, std::true_type());
+}
+
+template <typename T, typename Alloc>
+T *uninitialized_move_a_impl(T *first, T *last, T *dest, Alloc &alloc, std::false_type) {
+    return uninitialized_copy_a_loop(std::make_move_iterator(first), std::make_move_iterator(last), dest, alloc);
+}
+
+template <typename T, typename Alloc>
+T *uninitialized_move_a(T *first, T *last, T *dest, Alloc &alloc) {
+    return uninitialized_move_a_impl(first, last, dest, alloc, use_bulk_kernel<Alloc, T, std::is_trivially_copyable>());
+}
+
+///检测分配器是否提供 reallocate(p, old_n, new_n) 扩展。
+template <typename Alloc, typename = void>
+struct allocator_has_reallocate : std::false_type {};
+
+template <typename Alloc>
+struct allocator_has_reallocate<Alloc, std::void_t<decltype(std::declval<Alloc &>().reallocate(
+                                           std::declval<typename std::allocator_traits<Alloc>::pointer>(), size_t(), size_t()))>> : std::true_type {};
+
+///检测分配器是否提供成段申请单个对象的扩展： allocate_run(n, count) 一次取出至多 n 个相邻的单个对象， count 返回实际个数；
+///deallocate_run(p, count) 一次归还 count 个相邻的单个对象。两种方式取得的对象都可以单独以 deallocate(p, 1) 归还。
+template <typename Alloc, typename = void>
+struct allocator_has_runs : std::false_type {};
+
+template <typename Alloc>
+struct allocator_has_runs<Alloc, std::void_t<decltype(std::declval<Alloc &>().allocate_run(size_t(), std::declval<size_t &>())),
+                                             decltype(std::declval<Alloc &>().deallocate_run(std::declval<typename std::allocator_traits<Alloc>::pointer>(), size_t()))>>
+    : std::true_type {};
+} // namespace mystl
@@ -0,0 +1,316 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "my_memory.hpp"
+
+namespace mystl { namespace pmr {
+///内存资源抽象基类。容器通过 polymorphic_allocator 持有指向它的指针，从而在运行期切换内存来源。
+class memory_resource {
+public:
+    static constexpr size_t max_align = alignof(std::max_align_t);
+
+    memory_resource() = default;
+    memory_resource(const memory_resource &) = default;
+    virtual ~memory_resource() = default;
+
+    memory_resource &operator=(const memory_resource &) = default;
+
+    void *allocate(size_t bytes, size_t alignment = max_align) { return do_allocate(bytes, alignment); }                 //申请至少 bytes 字节、按 alignment 对齐的内存。
+    void deallocate(void *p, size_t bytes, size_t alignment = max_align) { return do_deallocate(p, bytes, alignment); } //归还由 allocate 申请的内存。
+    bool is_equal(const memory_resource &other) const noexcept { return do_is_equal(other); } //由一方申请的内存能否由另一方释放。
+
+protected:
+    virtual void *do_allocate(size_t bytes, size_t alignment) = 0;
+    virtual void do_deallocate(void *p, size_t bytes, size_t alignment) = 0;
+    virtual bool do_is_equal(const memory_resource &other) const noexcept = 0;
+};
+
+inline bool operator==(const memory_resource &lhs, const memory_resource &rhs) noexcept {
+    return &lhs == &rhs || lhs.is_equal(rhs);
+}
+
+inline bool operator!=(const memory_resource &lhs, const memory_resource &rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+///直接使用 std::malloc/std::free 的内存资源，超出 max_align 的对齐要求交给带对齐参数的 operator new 。
+class malloc_memory_resource final : public memory_resource {
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        if (alignment > max_align) {
+            return ::operator new(bytes, std::align_val_t(alignment));
+        }
+        auto p = std::malloc(bytes ? bytes : 1);
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+    void do_deallocate(void *p, size_t, size_t alignment) override {
+        if (alignment > max_align) {
+            ::operator delete(p, std::align_val_t(alignment));
+        } else {
+            std::free(p);
+        }
+    }
+    bool do_is_equal(const memory_resource &other) const noexcept override { return this == &other; }
+};
+
+///不提供任何内存的资源，任何申请都抛出 std::bad_alloc ，用于确认某段代码不会越过预先给定的缓冲区。
+class null_memory_resource_type final : public memory_resource {
+protected:
+    void *do_allocate(size_t, size_t) override { throw std::bad_alloc(); }
+    void do_deallocate(void *, size_t, size_t) override {}
+    bool do_is_equal(const memory_resource &other) const noexcept override { return this == &other; }
+};
+
+inline memory_resource *malloc_resource() noexcept {
+    static malloc_memory_resource resource;
+    return &resource;
+}
+
+inline memory_resource *null_memory_resource() noexcept {
+    static null_memory_resource_type resource;
+    return &resource;
+}
+
+inline std::atomic<memory_resource *> &default_resource_holder() noexcept {
+    static std::atomic<memory_resource *> holder{malloc_resource()};
+    return holder;
+}
+
+///返回默认内存资源。未设置时为 malloc_resource() 。
+inline memory_resource *get_default_resource() noexcept {
+    return default_resource_holder().load(std::memory_order_acquire);
+}
+
+///设置默认内存资源并返回旧值。传入 nullptr 时恢复为 malloc_resource() 。
+inline memory_resource *set_default_resource(memory_resource *r) noexcept {
+    return default_resource_holder().exchange(r ? r : malloc_resource(), std::memory_order_acq_rel);
+}
+
+///将 n 向上取整到 alignment 的倍数，alignment 须为 2 的幂。
+inline size_t align_up(size_t n, size_t alignment) noexcept {
+    return (n + alignment - 1) & ~(alignment - 1);
+}
+
+///单调缓冲资源。从当前块中顺序切分内存，deallocate 不做任何事，所有内存在 release() 或析构时一次性归还上游。
+///适合生命周期与一次请求绑定的临时容器。
+class monotonic_buffer_resource : public memory_resource {
+public:
+    explicit monotonic_buffer_resource(memory_resource *upstream = get_default_resource()) noexcept : upstream_(upstream) {}
+    monotonic_buffer_resource(size_t initial_size, memory_resource *upstream = get_default_resource()) noexcept
+        : upstream_(upstream), next_size_(initial_size ? initial_size : 1) {}
+    monotonic_buffer_resource(void *buffer, size_t buffer_size, memory_resource *upstream = get_default_resource()) noexcept
+        : upstream_(upstream), initial_buffer_(buffer), initial_size_(buffer_size), current_(static_cast<char *>(buffer)), space_(buffer_size),
+          next_size_(buffer_size ? buffer_size * 2 : default_chunk_size) {}
+    monotonic_buffer_resource(const monotonic_buffer_resource &) = delete;
+    ~monotonic_buffer_resource() override { release(); }
+
+    monotonic_buffer_resource &operator=(const monotonic_buffer_resource &) = delete;
+
+    void release() noexcept; //将所有从上游申请的块归还，并回到构造时的初始缓冲区。
+    memory_resource *upstream_resource() const noexcept { return upstream_; }
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *, size_t, size_t) override {}
+    bool do_is_equal(const memory_resource &other) const noexcept override { return this == &other; }
+
+private:
+    static constexpr size_t default_chunk_size = 1024;
+
+    ///从上游申请的块的头部，串成单链表以便 release 时归还。
+    struct chunk_header {
+        chunk_header *next;
+        size_t size;
+        size_t alignment;
+    };
+
+    memory_resource *upstream_;
+    void *initial_buffer_ = nullptr;
+    size_t initial_size_ = 0;
+    char *current_ = nullptr;
+    size_t space_ = 0;
+    size_t next_size_ = default_chunk_size;
+    chunk_header *chunks_ = nullptr;
+};
+
+inline void *monotonic_buffer_resource::do_allocate(size_t bytes, size_t alignment) {
+    void *p = current_;
+    if (!current_ || !std::align(alignment, bytes, p, space_)) {
+        auto need = bytes + alignment + sizeof(chunk_header);
+        while (next_size_ < need) {
+            next_size_ *= 2;
+        }
+        auto chunk_alignment = alignment > alignof(chunk_header) ? alignment : alignof(chunk_header);
+        auto chunk = static_cast<chunk_header *>(upstream_->allocate(next_size_, chunk_alignment));
+        chunk->next = chunks_;
+        chunk->size = next_size_;
+        chunk->alignment = chunk_alignment;
+        chunks_ = chunk;
+        current_ = reinterpret_cast<char *>(chunk + 1);
+        space_ = next_size_ - sizeof(chunk_header);
+        next_size_ *= 2;
+        p = current_;
+        std::align(alignment, bytes, p, space_);
+    }
+    current_ = static_cast<char *>(p) + bytes;
+    space_ -= bytes;
+    return p;
+}
+
+inline void monotonic_buffer_resource::release() noexcept {
+    while (chunks_) {
+        auto next = chunks_->next;
+        upstream_->deallocate(chunks_, chunks_->size, chunks_->alignment);
+        chunks_ = next;
+    }
+    current_ = static_cast<char *>(initial_buffer_);
+    space_ = initial_size_;
+}
+
+///非同步池资源。将小块请求按 2 的幂分级，每级维护一个空闲链表，归还的块直接进入链表供下次复用。
+///超过 largest_pool_block 的请求直接转发给上游。非线程安全，每个线程或每个请求应持有自己的实例。
+class unsynchronized_pool_resource : public memory_resource {
+public:
+    static constexpr size_t smallest_pool_block = 8;
+    static constexpr size_t largest_pool_block = 4096;
+
+    explicit unsynchronized_pool_resource(memory_resource *upstream = get_default_resource()) noexcept : upstream_(upstream) {}
+    unsynchronized_pool_resource(const unsynchronized_pool_resource &) = delete;
+    ~unsynchronized_pool_resource() override { release(); }
+
+    unsynchronized_pool_resource &operator=(const unsynchronized_pool_resource &) = delete;
+
+    void release() noexcept; //将池中所有块归还上游。之前分配出的小块全部失效。
+    memory_resource *upstream_resource() const noexcept { return upstream_; }
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const memory_resource &other) const noexcept override { return this == &other; }
+
+private:
+    static constexpr size_t pool_count = 10; // 8, 16, ..., 4096
+    static constexpr size_t chunk_bytes = 64 * 1024;
+
+    struct free_block {
+        free_block *next;
+    };
+    struct chunk_header {
+        chunk_header *next;
+        size_t size;
+    };
+
+    ///计算请求所属的分级，超出最大分级时返回 pool_count 。
+    static size_t pool_index(size_t bytes, size_t alignment) noexcept {
+        auto size = bytes > alignment ? bytes : alignment;
+        size_t index = 0, block = smallest_pool_block;
+        while (block < size && index < pool_count) {
+            block <<= 1;
+            ++index;
+        }
+        return index;
+    }
+
+    memory_resource *upstream_;
+    free_block *free_lists_[pool_count] = {nullptr};
+    chunk_header *chunks_ = nullptr;
+};
+
+inline void *unsynchronized_pool_resource::do_allocate(size_t bytes, size_t alignment) {
+    auto index = pool_index(bytes, alignment);
+    if (index >= pool_count) {
+        return upstream_->allocate(bytes, alignment);
+    }
+    if (!free_lists_[index]) {
+        auto block_size = smallest_pool_block << index;
+        auto size = chunk_bytes > block_size * 8 ? chunk_bytes : block_size * 8;
+        auto chunk = static_cast<chunk_header *>(upstream_->allocate(size, largest_pool_block));
+        chunk->next = chunks_;
+        chunk->size = size;
+        chunks_ = chunk;
+        //块从 block_size 对齐的位置开始切分，保证同级块的对齐不低于块大小。
+        auto first = reinterpret_cast<char *>(chunk) + align_up(sizeof(chunk_header), block_size);
+        auto last = reinterpret_cast<char *>(chunk) + size;
+        for (auto p = first; p + block_size <= last; p += block_size) {
+            auto block = reinterpret_cast<free_block *>(p);
+            block->next = free_lists_[index];
+            free_lists_[index] = block;
+        }
+    }
+    auto block = free_lists_[index];
+    free_lists_[index] = block->next;
+    return block;
+}
+
+inline void unsynchronized_pool_resource::do_deallocate(void *p, size_t bytes, size_t alignment) {
+    auto index = pool_index(bytes, alignment);
+    if (index >= pool_count) {
+        upstream_->deallocate(p, bytes, alignment);
+        return;
+    }
+    auto block = static_cast<free_block *>(p);
+    block->next = free_lists_[index];
+    free_lists_[index] = block;
+}
+
+inline void unsynchronized_pool_resource::release() noexcept {
+    while (chunks_) {
+        auto next = chunks_->next;
+        upstream_->deallocate(chunks_, chunks_->size, largest_pool_block);
+        chunks_ = next;
+    }
+    for (auto &list : free_lists_) {
+        list = nullptr;
+    }
+}
+
+///多态分配器。类型相同的容器可以在运行期绑定到不同的 memory_resource 上。
+///与标准库一致，复制构造容器时不传播资源（改用默认资源），移动与交换也不传播。
+template <typename T>
+class polymorphic_allocator {
+public:
+    using value_type = T;
+
+    polymorphic_allocator() noexcept : resource_(get_default_resource()) {}
+    polymorphic_allocator(memory_resource *r) noexcept : resource_(r ? r : get_default_resource()) {}
+    polymorphic_allocator(const polymorphic_allocator &other) = default;
+    template <typename U>
+    polymorphic_allocator(const polymorphic_allocator<U> &other) noexcept : resource_(other.resource()) {}
+
+    polymorphic_allocator &operator=(const polymorphic_allocator &) = delete;
+
+    T *allocate(size_t n) { return static_cast<T *>(resource_->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T *p, size_t n) noexcept { resource_->deallocate(p, n * sizeof(T), alignof(T)); }
+
+    polymorphic_allocator select_on_container_copy_construction() const noexcept { return polymorphic_allocator(); }
+
+    memory_resource *resource() const noexcept { return resource_; }
+
+private:
+    memory_resource *resource_;
+};
+
+template <typename T, typename U>
+bool operator==(const polymorphic_allocator<T> &lhs, const polymorphic_allocator<U> &rhs) noexcept {
+    return *lhs.resource() == *rhs.resource();
+}
+
+template <typename T, typename U>
+bool operator!=(const polymorphic_allocator<T> &lhs, const polymorphic_allocator<U> &rhs) noexcept {
+    return !(lhs == rhs);
+}
+} // namespace pmr
+
+///polymorphic_allocator 不重载 construct ，元素构造与 placement new 等价。
+template <typename T>
+struct is_default_construct_allocator<pmr::polymorphic_allocator<T>> : std::true_type {};
+} // namespace mystl
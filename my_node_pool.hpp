@@ -0,0 +1,397 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+#include "my_memory.hpp"
+
+namespace mystl {
+///缓存行大小。结点池向系统申请的内存块按它对齐。
+constexpr size_t cache_line_size = 64;
+
+///定长结点池。按块向系统申请缓存行对齐的内存并切分成等长的结点，释放的结点挂入空闲链表，
+///再次申请时直接复用，不经过 malloc 。内存块只在 release() 或析构时归还。非线程安全。
+///除单个结点外还可以成段申请、成段归还相邻的结点：成段归还的结点作为一整段保存，下次成段申请时原样取出，不必逐个追链。
+class node_pool {
+public:
+    node_pool(size_t node_size, size_t node_align) noexcept;
+    node_pool(const node_pool &) = delete;
+    ~node_pool() { release(); }
+
+    node_pool &operator=(const node_pool &) = delete;
+
+    void *allocate();                                       //取出一个结点。
+    void *allocate_run(size_t n, size_t &count);            //取出至多 n 个相邻的结点， count 返回实际个数。
+    void deallocate(void *p) noexcept;                      //归还一个结点。
+    void deallocate_run(void *p, size_t count) noexcept;    //归还从 p 开始的 count 个相邻结点。
+    void release() noexcept;                                //归还全部内存块。之前分配出的结点全部失效。
+
+    bool has_free() const noexcept { return free_ != nullptr; } //空闲链表中是否有单个结点。
+    bool has_run() const noexcept { return runs_ != nullptr; }  //是否有成段归还的结点。
+    size_t node_size() const noexcept { return stride_; }        //每个结点实际占用的字节数。
+    size_t chunk_count() const noexcept { return chunk_count_; } //已申请的内存块数。
+
+private:
+    static constexpr size_t first_chunk_nodes = 32;
+    static constexpr size_t max_chunk_bytes = 256 * 1024;
+
+    struct free_node {
+        free_node *next;
+    };
+    ///成段归还的结点，段头写在首结点中。
+    struct free_run {
+        free_run *next;
+        size_t count;
+    };
+    struct chunk_header {
+        chunk_header *next;
+        size_t bytes;
+    };
+
+    void new_chunk(size_t min_nodes = 0);
+    ///从第一段中取出至多 n 个结点。
+    void *take_run(size_t n, size_t &count) noexcept;
+
+    size_t stride_;
+    size_t chunk_align_;
+    size_t next_chunk_bytes_;
+    free_node *free_ = nullptr;
+    free_run *runs_ = nullptr;
+    char *fresh_ = nullptr; //当前块中尚未切分的部分，结点按需切出，新块不必整块写一遍空闲链表
+    char *fresh_end_ = nullptr;
+    chunk_header *chunks_ = nullptr;
+    size_t chunk_count_ = 0;
+};
+
+inline node_pool::node_pool(size_t node_size, size_t node_align) noexcept {
+    auto align = node_align > alignof(free_node) ? node_align : alignof(free_node);
+    auto size = node_size > sizeof(free_node) ? node_size : sizeof(free_node);
+    stride_ = (size + align - 1) / align * align;
+    chunk_align_ = align > cache_line_size ? align : cache_line_size;
+    next_chunk_bytes_ = chunk_align_ + stride_ * first_chunk_nodes;
+}
+
+inline void *node_pool::allocate() {
+    if (free_) {
+        auto p = free_;
+        free_ = p->next;
+        return p;
+    }
+    if (runs_) {
+        size_t count;
+        return take_run(1, count);
+    }
+    if (fresh_ == fresh_end_) {
+        new_chunk();
+    }
+    auto p = fresh_;
+    fresh_ += stride_;
+    return p;
+}
+
+//依次尝试：成段归还的结点；空闲链表中的单个结点（彼此不相邻，只取一个，以免成段申请绕开空闲链表、让内存只增不减）；
+//当前块尚未切分的部分，它已用尽时另开一块，块至少容纳 n 个结点。
+inline void *node_pool::allocate_run(size_t n, size_t &count) {
+    if (runs_) {
+        return take_run(n, count);
+    }
+    if (free_ || n <= 1) {
+        count = 1;
+        return allocate();
+    }
+    if (fresh_ == fresh_end_) {
+        new_chunk(n);
+    }
+    auto avail = static_cast<size_t>(fresh_end_ - fresh_) / stride_;
+    count = n < avail ? n : avail;
+    auto p = fresh_;
+    fresh_ += count * stride_;
+    return p;
+}
+
+inline void *node_pool::take_run(size_t n, size_t &count) noexcept {
+    auto run = runs_;
+    auto p = reinterpret_cast<char *>(run);
+    if (run->count <= n) {
+        count = run->count;
+        runs_ = run->next;
+        return p;
+    }
+    //段头移到剩余部分的首结点。
+    count = n;
+    auto rest = reinterpret_cast<free_run *>(p + n * stride_);
+    rest->next = run->next;
+    rest->count = run->count - n;
+    runs_ = rest;
+    return p;
+}
+
+inline void node_pool::deallocate(void *p) noexcept {
+    auto n = static_cast<free_node *>(p);
+    n->next = free_;
+    free_ = n;
+}
+
+//结点放不下段头时逐个归还。
+inline void node_pool::deallocate_run(void *p, size_t count) noexcept {
+    if (count == 1 || stride_ < sizeof(free_run)) {
+        for (auto c = static_cast<char *>(p); count--; c += stride_) {
+            deallocate(c);
+        }
+        return;
+    }
+    auto run = static_cast<free_run *>(p);
+    run->next = runs_;
+    run->count = count;
+    runs_ = run;
+}
+
+//块头独占第一个缓存行，结点从下一个缓存行开始切分。块大小逐次翻倍，直到 max_chunk_bytes ；批量申请需要更大的块时按需加大这一块。
+inline void node_pool::new_chunk(size_t min_nodes) {
+    auto wanted = chunk_align_ + stride_ * min_nodes;
+    auto bytes = wanted > next_chunk_bytes_ ? wanted : next_chunk_bytes_;
+    bytes = (bytes + chunk_align_ - 1) / chunk_align_ * chunk_align_;
+    auto chunk = static_cast<chunk_header *>(::operator new(bytes, std::align_val_t(chunk_align_)));
+    chunk->next = chunks_;
+    chunk->bytes = bytes;
+    chunks_ = chunk;
+    ++chunk_count_;
+    fresh_ = reinterpret_cast<char *>(chunk) + chunk_align_;
+    fresh_end_ = fresh_ + (bytes - chunk_align_) / stride_ * stride_;
+    if (next_chunk_bytes_ * 2 <= max_chunk_bytes) {
+        next_chunk_bytes_ *= 2;
+    }
+}
+
+inline void node_pool::release() noexcept {
+    while (chunks_) {
+        auto next = chunks_->next;
+        ::operator delete(chunks_, std::align_val_t(chunk_align_));
+        chunks_ = next;
+    }
+    free_ = nullptr;
+    runs_ = nullptr;
+    fresh_ = fresh_end_ = nullptr;
+    chunk_count_ = 0;
+}
+
+///进程内共享的定长结点池，每种 (NodeSize, NodeAlign) 一个。
+///每个线程另有本地缓存：分配与释放先在本地完成，缓存空了从共享池成批取出 batch 个结点，
+///缓存超过 2 * batch 个时成批还回，加锁次数约为分配次数的 1 / batch 。线程退出时本地缓存全部还回共享池。
+template <size_t NodeSize, size_t NodeAlign>
+class shared_node_pool {
+public:
+    static void *allocate();
+    static void *allocate_run(size_t n, size_t &count);
+    static void deallocate(void *p) noexcept;
+    static void deallocate_run(void *p, size_t count) noexcept;
+
+private:
+    static constexpr size_t batch = 64;
+
+    struct free_node {
+        free_node *next;
+    };
+
+    struct global_pool {
+        std::mutex mutex;
+        node_pool pool{NodeSize, NodeAlign};
+    };
+
+    struct thread_cache {
+        free_node *head = nullptr;
+        size_t count = 0;
+
+        ~thread_cache();
+    };
+
+    //共享池有意不析构：静态存储期的容器可能在它之后才归还结点，内存在进程退出时统一回收。
+    static global_pool &global() {
+        static auto pool = new global_pool;
+        return *pool;
+    }
+
+    //本地缓存析构后仍可能有结点归还（例如静态存储期的容器），此时直接还给共享池。
+    static thread_local bool cache_destroyed;
+    static thread_local thread_cache cache;
+
+    static void refill(thread_cache &c);
+    static void refill_locked(thread_cache &c, global_pool &g);
+    static void drain(thread_cache &c, size_t keep) noexcept;
+};
+
+template <size_t NodeSize, size_t NodeAlign>
+thread_local bool shared_node_pool<NodeSize, NodeAlign>::cache_destroyed = false;
+
+template <size_t NodeSize, size_t NodeAlign>
+thread_local typename shared_node_pool<NodeSize, NodeAlign>::thread_cache shared_node_pool<NodeSize, NodeAlign>::cache;
+
+template <size_t NodeSize, size_t NodeAlign>
+shared_node_pool<NodeSize, NodeAlign>::thread_cache::~thread_cache() {
+    drain(*this, 0);
+    cache_destroyed = true;
+}
+
+template <size_t NodeSize, size_t NodeAlign>
+void *shared_node_pool<NodeSize, NodeAlign>::allocate() {
+    if (cache_destroyed) {
+        auto &g = global();
+        std::lock_guard<std::mutex> lock(g.mutex);
+        return g.pool.allocate();
+    }
+    auto &c = cache;
+    if (!c.head) {
+        refill(c);
+    }
+    auto p = c.head;
+    c.head = p->next;
+    --c.count;
+    return p;
+}
+
+//成段申请与归还都直接在共享池上加锁进行，一段只加一次锁。共享池中没有成段的结点时，先用完本地缓存与空闲链表中的单个结点，
+//与 allocate 一样一批只加一次锁，最后才切出新的一段。
+template <size_t NodeSize, size_t NodeAlign>
+void *shared_node_pool<NodeSize, NodeAlign>::allocate_run(size_t n, size_t &count) {
+    auto &g = global();
+    {
+        std::lock_guard<std::mutex> lock(g.mutex);
+        if (cache_destroyed || g.pool.has_run() || (!cache.head && !g.pool.has_free())) {
+            return g.pool.allocate_run(n, count);
+        }
+        if (!cache.head) {
+            refill_locked(cache, g);
+        }
+    }
+    auto &c = cache;
+    auto p = c.head;
+    c.head = p->next;
+    --c.count;
+    count = 1;
+    return p;
+}
+
+template <size_t NodeSize, size_t NodeAlign>
+void shared_node_pool<NodeSize, NodeAlign>::deallocate_run(void *p, size_t count) noexcept {
+    auto &g = global();
+    std::lock_guard<std::mutex> lock(g.mutex);
+    g.pool.deallocate_run(p, count);
+}
+
+template <size_t NodeSize, size_t NodeAlign>
+void shared_node_pool<NodeSize, NodeAlign>::deallocate(void *p) noexcept {
+    if (cache_destroyed) {
+        auto &g = global();
+        std::lock_guard<std::mutex> lock(g.mutex);
+        g.pool.deallocate(p);
+        return;
+    }
+    auto &c = cache;
+    auto n = static_cast<free_node *>(p);
+    n->next = c.head;
+    c.head = n;
+    if (++c.count > 2 * batch) {
+        drain(c, batch);
+    }
+}
+
+template <size_t NodeSize, size_t NodeAlign>
+void shared_node_pool<NodeSize, NodeAlign>::refill(thread_cache &c) {
+    auto &g = global();
+    std::lock_guard<std::mutex> lock(g.mutex);
+    refill_locked(c, g);
+}
+
+//只在本地缓存为空时调用。结点按取出的顺序接在链尾，新切出的结点依地址递增交给调用者，逐个插入的链表遍历时也是顺序访存。
+template <size_t NodeSize, size_t NodeAlign>
+void shared_node_pool<NodeSize, NodeAlign>::refill_locked(thread_cache &c, global_pool &g) {
+    auto tail = &c.head;
+    for (size_t i = 0; i < batch; ++i) {
+        auto n = static_cast<free_node *>(g.pool.allocate());
+        *tail = n;
+        tail = &n->next;
+    }
+    *tail = nullptr;
+    c.count = batch;
+}
+
+template <size_t NodeSize, size_t NodeAlign>
+void shared_node_pool<NodeSize, NodeAlign>::drain(thread_cache &c, size_t keep) noexcept {
+    auto &g = global();
+    std::lock_guard<std::mutex> lock(g.mutex);
+    while (c.count > keep) {
+        auto n = c.head;
+        c.head = n->next;
+        --c.count;
+        g.pool.deallocate(n);
+    }
+}
+
+///结点池分配器。单个对象的申请由 shared_node_pool 提供，同一尺寸的所有容器共用一个池；成组的申请交给 mystl::allocator 。
+///无状态，任意两个实例都相等，容器之间可以直接交换、拼接结点。适合频繁增删结点的链表。
+template <typename T>
+class pool_allocator {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    pool_allocator() noexcept = default;
+    template <typename U>
+    pool_allocator(const pool_allocator<U> &) noexcept {}
+
+    T *allocate(size_type n);
+    T *allocate_run(size_type n, size_type &count);       //取出至多 n 个相邻的单个对象，每个都可以单独归还。链表批量建结点时使用。
+    void deallocate(T *p, size_type n) noexcept;
+    void deallocate_run(T *p, size_type count) noexcept; //归还 count 个相邻的单个对象，它们不必来自同一次申请。链表整体销毁时使用。
+
+private:
+    using pool = shared_node_pool<sizeof(T), alignof(T)>;
+};
+
+template <typename T>
+T *pool_allocator<T>::allocate(size_type n) {
+    if (n == 1) {
+        return static_cast<T *>(pool::allocate());
+    }
+    return allocator<T>().allocate(n);
+}
+
+template <typename T>
+T *pool_allocator<T>::allocate_run(size_type n, size_type &count) {
+    //池中结点的步长需与 sizeof(T) 一致，段内的对象才能按 T* 逐个寻址。
+    static_assert(sizeof(T) >= sizeof(void *) && sizeof(T) % alignof(void *) == 0, "allocate_run requires objects that fill whole pool nodes");
+    return static_cast<T *>(pool::allocate_run(n, count));
+}
+
+template <typename T>
+void pool_allocator<T>::deallocate_run(T *p, size_type count) noexcept {
+    static_assert(sizeof(T) >= sizeof(void *) && sizeof(T) % alignof(void *) == 0, "deallocate_run requires objects that fill whole pool nodes");
+    pool::deallocate_run(p, count);
+}
+
+template <typename T>
+void pool_allocator<T>::deallocate(T *p, size_type n) noexcept {
+    if (n == 1) {
+        pool::deallocate(p);
+    } else {
+        allocator<T>().deallocate(p, n);
+    }
+}
+
+template <typename T, typename U>
+bool operator==(const pool_allocator<T> &, const pool_allocator<U> &) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const pool_allocator<T> &, const pool_allocator<U> &) noexcept {
+    return false;
+}
+
+template <typename T>
+struct is_default_construct_allocator<pool_allocator<T>> : std::true_type {};
+} // namespace mystl
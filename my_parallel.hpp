@@ -0,0 +1,337 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "my_memory.hpp"
+#include "my_thread_pool.hpp"
+
+namespace mystl {
+///并行算法。作用于随机访问迭代器区间（如 vector 的迭代器），范围较小或线程池只有一个线程时退化为对应的串行算法。
+///每个算法都有以线程池为第一个参数的重载，不带线程池的版本使用 thread_pool::instance() 。
+///区间被切成若干段交给线程池，段数取线程数的 oversubscription 倍，由工作窃取平衡各段耗时的差异，每段不少于 min_grain 个元素。
+///函数对象会被多个线程同时调用，须可重入；抛出的第一个异常在所有段结束后重新抛出。
+namespace par {
+constexpr size_t serial_cutoff = 1 << 15;  //元素数低于此值时串行执行，调度开销（数微秒）抵不过收益。
+constexpr size_t min_grain = 1 << 13;      //每段至少处理的元素数。
+constexpr size_t oversubscription = 4;     //每个线程平均分到的段数。
+
+template <typename It>
+using RequireRandomAccess =
+    typename std::enable_if<std::is_convertible<typename std::iterator_traits<It>::iterator_category, std::random_access_iterator_tag>::value>::type;
+
+namespace detail {
+///n 个元素切成的段数，返回 1 时应串行执行。
+inline size_t chunk_count(const thread_pool &pool, size_t n) noexcept {
+    if (n < serial_cutoff || pool.concurrency() == 1) {
+        return 1;
+    }
+    auto by_grain = n / min_grain;
+    auto by_threads = pool.concurrency() * oversubscription;
+    return by_grain < by_threads ? by_grain : by_threads;
+}
+
+///第 i 段的起点。各段长度相差至多一。
+inline size_t chunk_begin(size_t n, size_t chunks, size_t i) noexcept { return n / chunks * i + (i < n % chunks ? i : n % chunks); }
+
+///把 [0, n) 切成 chunks 段，并行调用 f(begin, end) 。
+template <typename F>
+void for_chunks(thread_pool &pool, size_t n, size_t chunks, F &&f) {
+    pool.run(chunks, [&](size_t i) { f(chunk_begin(n, chunks, i), chunk_begin(n, chunks, i + 1)); });
+}
+
+///稳定归并中输出的前 d 个元素里来自 a 的个数：相等时 a 中的元素在前。
+template <typename It, typename Compare>
+size_t merge_split(It a, size_t na, It b, size_t nb, size_t d, Compare &comp) {
+    size_t lo = d > nb ? d - nb : 0;
+    size_t hi = d < na ? d : na;
+    while (lo < hi) {
+        auto i = lo + (hi - lo) / 2;
+        auto j = d - i;
+        if (comp(b[j - 1], a[i])) {
+            hi = i;
+        } else {
+            lo = i + 1;
+        }
+    }
+    return lo;
+}
+
+///并行排序使用的临时缓冲区，析构时销毁其中的元素并归还内存。
+template <typename T>
+class sort_buffer {
+public:
+    explicit sort_buffer(size_t n) : data_(alloc_.allocate(n)), size_(n) {}
+    sort_buffer(const sort_buffer &) = delete;
+    ~sort_buffer() {
+        if (constructed_) {
+            std::destroy(data_, data_ + size_);
+        }
+        alloc_.deallocate(data_, size_);
+    }
+
+    sort_buffer &operator=(const sort_buffer &) = delete;
+
+    T *data() const noexcept { return data_; }
+    void set_constructed() noexcept { constructed_ = true; }
+
+private:
+    allocator<T> alloc_;
+    T *data_;
+    size_t size_;
+    bool constructed_ = false;
+};
+
+///先把各段分别排序，再逐轮两两归并。段数取 2 的奇数次幂，归并轮数为奇数：各段搬进缓冲区后排序，
+///第一轮从缓冲区归并回原区间，最后一轮恰好落在原区间，不需要再搬一次。每轮的每对子序列再按输出位置切成若干片并行归并。
+template <typename RandomIt, typename Compare, typename SortChunk>
+void merge_sort(thread_pool &pool, RandomIt first, RandomIt last, Compare comp, SortChunk sort_chunk) {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+    auto n = static_cast<size_t>(last - first);
+    auto limit = chunk_count(pool, n);
+    if (limit < 2 || !std::is_nothrow_move_constructible<value_type>::value) {
+        sort_chunk(first, last, comp);
+        return;
+    }
+    size_t chunks = 2;
+    while (chunks * 4 <= limit) {
+        chunks *= 4;
+    }
+    sort_buffer<value_type> buffer(n);
+    auto buf = buffer.data();
+    for_chunks(pool, n, chunks, [&](size_t b, size_t e) { std::uninitialized_move(first + b, first + e, buf + b); });
+    buffer.set_constructed();
+    for_chunks(pool, n, chunks, [&](size_t b, size_t e) { sort_chunk(buf + b, buf + e, comp); });
+
+    auto target = pool.concurrency() * oversubscription;
+    bool to_range = true; //本轮的输出是否为原区间
+    for (size_t runs = chunks; runs > 1; runs /= 2, to_range = !to_range) {
+        auto pairs = runs / 2;
+        auto pieces = target > pairs ? target / pairs : 1;
+        auto width = chunks / runs; //每个子序列由几个初始段组成，边界须与初始段的边界一致
+        auto for_pieces = [&](auto f) {
+            pool.run(pairs * pieces, [&](size_t t) {
+                auto pair = t / pieces;
+                f(t, t % pieces, chunk_begin(n, chunks, 2 * pair * width), chunk_begin(n, chunks, (2 * pair + 1) * width),
+                  chunk_begin(n, chunks, (2 * pair + 2) * width));
+            });
+        };
+        //归并会移走源序列中的元素，各片的切分点须在任何一片开始归并之前全部求出。
+        std::unique_ptr<size_t[]> split(new size_t[pairs * pieces]);
+        auto merge_round = [&](auto src, auto dst) {
+            for_pieces([&](size_t t, size_t piece, size_t lo, size_t mid, size_t hi) {
+                split[t] = merge_split(src + lo, mid - lo, src + mid, hi - mid, (hi - lo) * piece / pieces, comp);
+            });
+            for_pieces([&](size_t t, size_t piece, size_t lo, size_t mid, size_t hi) {
+                auto d0 = (hi - lo) * piece / pieces;
+                auto d1 = (hi - lo) * (piece + 1) / pieces;
+                auto i0 = split[t];
+                auto i1 = piece + 1 < pieces ? split[t + 1] : mid - lo;
+                auto a = src + lo;
+                auto b = src + mid;
+                std::merge(std::make_move_iterator(a + i0), std::make_move_iterator(a + i1), std::make_move_iterator(b + (d0 - i0)),
+                           std::make_move_iterator(b + (d1 - i1)), dst + lo + d0, comp);
+            });
+        };
+        if (to_range) {
+            merge_round(buf, first);
+        } else {
+            merge_round(first, buf);
+        }
+    }
+}
+} // namespace detail
+
+template <typename RandomIt, typename UnaryFunction, typename = RequireRandomAccess<RandomIt>>
+void for_each(thread_pool &pool, RandomIt first, RandomIt last, UnaryFunction f) {
+    auto n = static_cast<size_t>(last - first);
+    detail::for_chunks(pool, n, detail::chunk_count(pool, n), [&](size_t b, size_t e) { std::for_each(first + b, first + e, f); });
+}
+
+template <typename RandomIt1, typename RandomIt2, typename UnaryOperation, typename = RequireRandomAccess<RandomIt1>, typename = RequireRandomAccess<RandomIt2>>
+RandomIt2 transform(thread_pool &pool, RandomIt1 first, RandomIt1 last, RandomIt2 d_first, UnaryOperation op) {
+    auto n = static_cast<size_t>(last - first);
+    detail::for_chunks(pool, n, detail::chunk_count(pool, n), [&](size_t b, size_t e) { std::transform(first + b, first + e, d_first + b, op); });
+    return d_first + n;
+}
+
+template <typename RandomIt1, typename RandomIt2, typename RandomIt3, typename BinaryOperation, typename = RequireRandomAccess<RandomIt1>,
+          typename = RequireRandomAccess<RandomIt2>, typename = RequireRandomAccess<RandomIt3>>
+RandomIt3 transform(thread_pool &pool, RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt3 d_first, BinaryOperation op) {
+    auto n = static_cast<size_t>(last1 - first1);
+    detail::for_chunks(pool, n, detail::chunk_count(pool, n),
+                       [&](size_t b, size_t e) { std::transform(first1 + b, first1 + e, first2 + b, d_first + b, op); });
+    return d_first + n;
+}
+
+//各段的部分和按段的顺序与 init 合并，因此 op 只需满足结合律，不要求交换律。
+template <typename RandomIt, typename T, typename BinaryOperation, typename = RequireRandomAccess<RandomIt>>
+T reduce(thread_pool &pool, RandomIt first, RandomIt last, T init, BinaryOperation op) {
+    auto n = static_cast<size_t>(last - first);
+    auto chunks = detail::chunk_count(pool, n);
+    if (chunks == 1) {
+        for (; first != last; ++first) {
+            init = op(std::move(init), *first);
+        }
+        return init;
+    }
+    std::unique_ptr<std::optional<T>[]> partial(new std::optional<T>[chunks]);
+    pool.run(chunks, [&](size_t i) {
+        auto b = first + detail::chunk_begin(n, chunks, i);
+        auto e = first + detail::chunk_begin(n, chunks, i + 1);
+        T sum = *b;
+        while (++b != e) {
+            sum = op(std::move(sum), *b);
+        }
+        partial[i].emplace(std::move(sum));
+    });
+    for (size_t i = 0; i < chunks; ++i) {
+        init = op(std::move(init), std::move(*partial[i]));
+    }
+    return init;
+}
+
+template <typename RandomIt, typename T, typename = RequireRandomAccess<RandomIt>>
+T reduce(thread_pool &pool, RandomIt first, RandomIt last, T init) {
+    return par::reduce(pool, first, last, std::move(init), std::plus<>());
+}
+
+template <typename RandomIt, typename = RequireRandomAccess<RandomIt>>
+typename std::iterator_traits<RandomIt>::value_type reduce(thread_pool &pool, RandomIt first, RandomIt last) {
+    return par::reduce(pool, first, last, typename std::iterator_traits<RandomIt>::value_type());
+}
+
+//先并行求各段之和，串行求出每段之前的累计值，再并行地带着累计值扫描各段。每段只读写自己的元素，允许 d_first == first 。
+template <typename RandomIt1, typename RandomIt2, typename BinaryOperation, typename = RequireRandomAccess<RandomIt1>, typename = RequireRandomAccess<RandomIt2>>
+RandomIt2 inclusive_scan(thread_pool &pool, RandomIt1 first, RandomIt1 last, RandomIt2 d_first, BinaryOperation op) {
+    using value_type = typename std::iterator_traits<RandomIt1>::value_type;
+    auto n = static_cast<size_t>(last - first);
+    auto chunks = detail::chunk_count(pool, n);
+    if (chunks == 1) {
+        return std::partial_sum(first, last, d_first, op);
+    }
+    std::unique_ptr<std::optional<value_type>[]> carry(new std::optional<value_type>[chunks]);
+    pool.run(chunks - 1, [&](size_t i) {
+        auto b = first + detail::chunk_begin(n, chunks, i);
+        auto e = first + detail::chunk_begin(n, chunks, i + 1);
+        value_type sum = *b;
+        while (++b != e) {
+            sum = op(std::move(sum), *b);
+        }
+        carry[i + 1].emplace(std::move(sum));
+    });
+    for (size_t i = 2; i < chunks; ++i) {
+        *carry[i] = op(*carry[i - 1], std::move(*carry[i]));
+    }
+    pool.run(chunks, [&](size_t i) {
+        auto b = detail::chunk_begin(n, chunks, i);
+        auto e = detail::chunk_begin(n, chunks, i + 1);
+        if (!carry[i]) {
+            std::partial_sum(first + b, first + e, d_first + b, op);
+            return;
+        }
+        value_type sum = std::move(*carry[i]);
+        for (; b != e; ++b) {
+            sum = op(std::move(sum), first[b]);
+            d_first[b] = sum;
+        }
+    });
+    return d_first + n;
+}
+
+template <typename RandomIt1, typename RandomIt2, typename = RequireRandomAccess<RandomIt1>, typename = RequireRandomAccess<RandomIt2>>
+RandomIt2 inclusive_scan(thread_pool &pool, RandomIt1 first, RandomIt1 last, RandomIt2 d_first) {
+    return par::inclusive_scan(pool, first, last, d_first, std::plus<>());
+}
+
+//元素的移动构造可能抛出异常时串行排序。比较抛出异常时区间中的元素有效，但顺序未定。
+template <typename RandomIt, typename Compare, typename = RequireRandomAccess<RandomIt>>
+void sort(thread_pool &pool, RandomIt first, RandomIt last, Compare comp) {
+    detail::merge_sort(pool, first, last, comp, [](auto b, auto e, Compare &c) { std::sort(b, e, c); });
+}
+
+template <typename RandomIt, typename = RequireRandomAccess<RandomIt>>
+void sort(thread_pool &pool, RandomIt first, RandomIt last) {
+    par::sort(pool, first, last, std::less<>());
+}
+
+//各段内稳定排序，归并时相等元素取前一段的在先，整体保持稳定。
+template <typename RandomIt, typename Compare, typename = RequireRandomAccess<RandomIt>>
+void stable_sort(thread_pool &pool, RandomIt first, RandomIt last, Compare comp) {
+    detail::merge_sort(pool, first, last, comp, [](auto b, auto e, Compare &c) { std::stable_sort(b, e, c); });
+}
+
+template <typename RandomIt, typename = RequireRandomAccess<RandomIt>>
+void stable_sort(thread_pool &pool, RandomIt first, RandomIt last) {
+    par::stable_sort(pool, first, last, std::less<>());
+}
+
+//使用共享线程池的版本
+template <typename RandomIt, typename UnaryFunction, typename = RequireRandomAccess<RandomIt>>
+void for_each(RandomIt first, RandomIt last, UnaryFunction f) {
+    par::for_each(thread_pool::instance(), first, last, std::move(f));
+}
+
+template <typename RandomIt1, typename RandomIt2, typename UnaryOperation, typename = RequireRandomAccess<RandomIt1>, typename = RequireRandomAccess<RandomIt2>>
+RandomIt2 transform(RandomIt1 first, RandomIt1 last, RandomIt2 d_first, UnaryOperation op) {
+    return par::transform(thread_pool::instance(), first, last, d_first, std::move(op));
+}
+
+template <typename RandomIt1, typename RandomIt2, typename RandomIt3, typename BinaryOperation, typename = RequireRandomAccess<RandomIt1>,
+          typename = RequireRandomAccess<RandomIt2>, typename = RequireRandomAccess<RandomIt3>>
+RandomIt3 transform(RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt3 d_first, BinaryOperation op) {
+    return par::transform(thread_pool::instance(), first1, last1, first2, d_first, std::move(op));
+}
+
+template <typename RandomIt, typename T, typename BinaryOperation, typename = RequireRandomAccess<RandomIt>>
+T reduce(RandomIt first, RandomIt last, T init, BinaryOperation op) {
+    return par::reduce(thread_pool::instance(), first, last, std::move(init), std::move(op));
+}
+
+template <typename RandomIt, typename T, typename = RequireRandomAccess<RandomIt>>
+T reduce(RandomIt first, RandomIt last, T init) {
+    return par::reduce(thread_pool::instance(), first, last, std::move(init));
+}
+
+template <typename RandomIt, typename = RequireRandomAccess<RandomIt>>
+typename std::iterator_traits<RandomIt>::value_type reduce(RandomIt first, RandomIt last) {
+    return par::reduce(thread_pool::instance(), first, last);
+}
+
+template <typename RandomIt1, typename RandomIt2, typename BinaryOperation, typename = RequireRandomAccess<RandomIt1>, typename = RequireRandomAccess<RandomIt2>>
+RandomIt2 inclusive_scan(RandomIt1 first, RandomIt1 last, RandomIt2 d_first, BinaryOperation op) {
+    return par::inclusive_scan(thread_pool::instance(), first, last, d_first, std::move(op));
+}
+
+template <typename RandomIt1, typename RandomIt2, typename = RequireRandomAccess<RandomIt1>, typename = RequireRandomAccess<RandomIt2>>
+RandomIt2 inclusive_scan(RandomIt1 first, RandomIt1 last, RandomIt2 d_first) {
+    return par::inclusive_scan(thread_pool::instance(), first, last, d_first);
+}
+
+template <typename RandomIt, typename Compare, typename = RequireRandomAccess<RandomIt>>
+void sort(RandomIt first, RandomIt last, Compare comp) {
+    par::sort(thread_pool::instance(), first, last, std::move(comp));
+}
+
+template <typename RandomIt, typename = RequireRandomAccess<RandomIt>>
+void sort(RandomIt first, RandomIt last) {
+    par::sort(thread_pool::instance(), first, last);
+}
+
+template <typename RandomIt, typename Compare, typename = RequireRandomAccess<RandomIt>>
+void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+    par::stable_sort(thread_pool::instance(), first, last, std::move(comp));
+}
+
+template <typename RandomIt, typename = RequireRandomAccess<RandomIt>>
+void stable_sort(RandomIt first, RandomIt last) {
+    par::stable_sort(thread_pool::instance(), first, last);
+}
+} // namespace par
+} // namespace mystl
@@ -0,0 +1,509 @@
+#pragma once
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_memory.hpp"
+#include "my_memory_resource.hpp"
+#include "my_vector.hpp"
+
+namespace mystl {
+//满载策略：缓冲区已满时再写入，由 overwrite 决定覆盖最旧的元素还是拒绝新元素。
+
+///满时覆盖最旧的元素。适合只关心最近若干个采样的场合。
+struct overwrite_oldest {
+    static constexpr bool overwrite = true;
+};
+
+///满时拒绝新元素，已有元素保持不变。适合不允许丢数据、由调用者决定如何处理背压的场合。
+struct reject_on_full {
+    static constexpr bool overwrite = false;
+};
+
+template <typename T, typename Ref, typename Ptr>
+class ring_buffer_iterator;
+
+template <typename T, typename Alloc = allocator<T>, typename FullPolicy = overwrite_oldest>
+class ring_buffer;
+
+//迭代器保存存储起点、下标掩码与逻辑位置。逻辑位置是不取模的计数，只在解引用时与掩码相与，
+//因此首尾迭代器在存储中回绕后仍可直接相减与比较。
+template <typename T, typename Ref, typename Ptr>
+class ring_buffer_iterator {
+public:
+    using self = ring_buffer_iterator<T, Ref, Ptr>;
+    using iterator = ring_buffer_iterator<T, T &, T *>;
+    using const_iterator = ring_buffer_iterator<T, const T &, const T *>;
+    using value_type = T;
+    using pointer = Ptr;
+    using reference = Ref;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::random_access_iterator_tag;
+
+    template <typename, typename, typename>
+    friend class ring_buffer;
+    template <typename, typename, typename>
+    friend class ring_buffer_iterator;
+
+protected:
+    T *base = nullptr; //存储起点
+    size_t mask = 0;   //容量减一
+    size_t index = 0;  //逻辑位置
+
+public:
+    ring_buffer_iterator() = default;
+    ring_buffer_iterator(T *_base, size_t _mask, size_t _index) noexcept : base(_base), mask(_mask), index(_index) {}
+    ///iterator 可隐式转换为 const_iterator 。
+    template <typename Iter, typename = typename std::enable_if<std::is_same<Iter, iterator>::value && !std::is_same<Iter, self>::value>::type>
+    ring_buffer_iterator(const Iter &other) noexcept : base(other.base), mask(other.mask), index(other.index) {}
+
+    friend bool operator==(const self &lhs, const self &rhs) noexcept { return lhs.index == rhs.index; }
+    friend bool operator!=(const self &lhs, const self &rhs) noexcept { return lhs.index != rhs.index; }
+    friend bool operator<(const self &lhs, const self &rhs) noexcept { return lhs - rhs < 0; }
+    friend bool operator>(const self &lhs, const self &rhs) noexcept { return rhs < lhs; }
+    friend bool operator<=(const self &lhs, const self &rhs) noexcept { return !(rhs < lhs); }
+    friend bool operator>=(const self &lhs, const self &rhs) noexcept { return !(lhs < rhs); }
+
+    ///两迭代器之间的距离。逻辑位置是无符号计数，差值按补码解释，计数本身回绕时仍然正确。
+    friend difference_type operator-(const self &lhs, const self &rhs) noexcept { return static_cast<difference_type>(lhs.index - rhs.index); }
+
+    reference operator*() const noexcept { return base[index & mask]; }
+    pointer operator->() const noexcept { return base + (index & mask); }
+
+    self &operator++() noexcept {
+        ++index;
+        return *this;
+    }
+
+    self operator++(int) noexcept {
+        auto temp = *this;
+        ++index;
+        return temp;
+    }
+
+    self &operator--() noexcept {
+        --index;
+        return *this;
+    }
+
+    self operator--(int) noexcept {
+        auto temp = *this;
+        --index;
+        return temp;
+    }
+
+    self &operator+=(difference_type n) noexcept {
+        index += static_cast<size_t>(n);
+        return *this;
+    }
+
+    self &operator-=(difference_type n) noexcept {
+        index -= static_cast<size_t>(n);
+        return *this;
+    }
+
+    self operator+(difference_type n) const noexcept {
+        auto temp = *this;
+        return temp += n;
+    }
+    friend self operator+(difference_type n, const self &it) noexcept { return it + n; }
+
+    self operator-(difference_type n) const noexcept {
+        auto temp = *this;
+        return temp -= n;
+    }
+
+    reference operator[](difference_type n) const noexcept { return base[(index + static_cast<size_t>(n)) & mask]; }
+};
+
+///定长环形缓冲区：存储由 vector_base 在构造时一次申请，容量向上取整为 2 的幂，之后的读写不再申请内存。
+///首尾位置是只增不减的计数，元素 i 位于存储的 (首位置 + i) & (容量 - 1) 处，两端的插入与弹出都是 O(1) 。
+///已满时再写入按 FullPolicy 处理：overwrite_oldest 先丢弃最旧的元素， reject_on_full 不写入并返回 false 。
+///元素在存储中至多分成两段连续区间， array_one 与 array_two 给出这两段，write 与 read 逐段成块复制，可平凡复制的元素直接 memcpy 。
+template <typename T, typename Alloc, typename FullPolicy>
+class ring_buffer : vector_base<T, Alloc> {
+    using Base = vector_base<T, Alloc>;
+    using typename Base::T_alloc_type;
+    using typename Base::alloc_traits;
+    using full_tag = std::integral_constant<bool, FullPolicy::overwrite>;
+
+public:
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = ring_buffer_iterator<T, T &, T *>;
+    using const_iterator = ring_buffer_iterator<T, const T &, const T *>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using allocator_type = Alloc;
+    using full_policy = FullPolicy;
+    using array_range = std::pair<pointer, size_type>;             //一段连续元素：起始地址与元素个数。
+    using const_array_range = std::pair<const_pointer, size_type>; //一段连续元素：起始地址与元素个数。
+
+protected:
+    using Base::M_impl;
+    using Base::M_get_allocator;
+    using Base::M_deallocate;
+
+public:
+    //构造函数
+    ring_buffer() : Base() {} //构造容量为 0 的容器。不申请任何内存。
+    explicit ring_buffer(size_type capacity, const Alloc &alloc = Alloc())
+        : Base(M_check_capacity(capacity, T_alloc_type(alloc)), T_alloc_type(alloc)) {} //构造能容纳至少 capacity 个元素的空容器，容量向上取整为 2 的幂。
+    ring_buffer(const ring_buffer &other);                                               //复制构造函数。容量与 other 相同，元素从存储开头依次存放。
+    ring_buffer(ring_buffer &&other) noexcept;                                           //移动构造函数。接管 other 的存储。
+    ~ring_buffer() { clear(); }
+
+    ring_buffer &operator=(const ring_buffer &other); //复制赋值运算符。容量变为与 other 相同。
+    ring_buffer &operator=(ring_buffer &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value); //移动赋值运算符。分配器不随之转移且不相等时重新申请存储并逐个移动元素，可能抛出异常。
+
+    allocator_type get_allocator() const noexcept { return allocator_type(M_get_allocator()); } //返回与容器关联的分配器。
+
+    //元素访问
+    reference at(size_type pos);             //有边界检查。 pos 不在容器范围内时抛出 std::out_of_range 。
+    const_reference at(size_type pos) const; //有边界检查。 pos 不在容器范围内时抛出 std::out_of_range 。
+    reference operator[](size_type pos) noexcept { return *M_slot(M_head + pos); }
+    const_reference operator[](size_type pos) const noexcept { return *M_slot(M_head + pos); }
+    reference front() noexcept { return *M_slot(M_head); }
+    const_reference front() const noexcept { return *M_slot(M_head); }
+    reference back() noexcept { return *M_slot(M_tail - 1); }
+    const_reference back() const noexcept { return *M_slot(M_tail - 1); }
+
+    array_range array_one() noexcept { return M_array_one(); }                   //从首元素开始、到存储末尾或尾元素为止的一段。
+    const_array_range array_one() const noexcept { return M_array_one(); }       //从首元素开始、到存储末尾或尾元素为止的一段。
+    array_range array_two() noexcept { return M_array_two(); }                   //回绕到存储开头的一段，元素没有回绕时长度为 0 。
+    const_array_range array_two() const noexcept { return M_array_two(); }       //回绕到存储开头的一段，元素没有回绕时长度为 0 。
+
+    //迭代器
+    iterator begin() noexcept { return iterator(M_impl.M_start, M_mask(), M_head); }
+    const_iterator begin() const noexcept { return const_iterator(M_impl.M_start, M_mask(), M_head); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(M_impl.M_start, M_mask(), M_tail); }
+    const_iterator end() const noexcept { return const_iterator(M_impl.M_start, M_mask(), M_tail); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    //容量
+    bool empty() const noexcept { return M_head == M_tail; }
+    bool full() const noexcept { return size() == capacity(); }
+    size_type size() const noexcept { return M_tail - M_head; }
+    size_type capacity() const noexcept { return static_cast<size_type>(M_impl.M_end_of_storage - M_impl.M_start); }
+    size_type max_size() const noexcept { return M_max_capacity(M_get_allocator()); } //不超过分配器上限的最大的 2 的幂。
+
+    //修改器
+    void clear() noexcept { //移除全部元素，容量不变。
+        pop_front(size());
+        M_head = M_tail = 0;
+    }
+
+    //插入与弹出定义在类内，未满时只有一次比较与一次构造；已满时才进入 M_emplace_back_full 。
+    bool push_back(const T &value) { return emplace_back(value); }
+    bool push_back(T &&value) { return emplace_back(std::move(value)); }
+    template <typename... Args>
+    bool emplace_back(Args &&...args) { //添加新元素到末尾。已满时按 FullPolicy 处理，返回新元素是否存入。
+        if (size() != capacity()) {
+            M_construct(M_slot(M_tail), std::forward<Args>(args)...);
+            ++M_tail;
+            return true;
+        }
+        return M_emplace_back_full(full_tag(), std::forward<Args>(args)...);
+    }
+    void pop_front() noexcept { //移除首元素。
+        M_destroy(M_slot(M_head));
+        ++M_head;
+    }
+    void pop_front(size_type count) noexcept; //移除最旧的 count 个元素，逐段析构。调用者保证 count 不超过 size() 。
+    void pop_back() noexcept {                //移除末元素。
+        --M_tail;
+        M_destroy(M_slot(M_tail));
+    }
+
+    size_type write(const T *src, size_type count); //把 [src, src + count) 复制到末尾，至多两段。已满时按 FullPolicy：覆盖时丢弃最旧的元素并保留最后 capacity() 个，拒绝时只写入放得下的部分。返回写入的元素数。
+    size_type read(T *dest, size_type count);        //把最旧的至多 count 个元素移动到 dest 并从容器中移除，至多两段。返回读出的元素数。
+
+    void swap(ring_buffer &other) noexcept; //交换内容，不搬动任何元素。
+
+private:
+    size_t M_head = 0; //首元素的逻辑位置
+    size_t M_tail = 0; //尾后位置的逻辑位置
+
+    size_t M_mask() const noexcept { return capacity() - 1; }
+    T *M_slot(size_t index) const noexcept { return M_impl.M_start + (index & M_mask()); }
+
+    template <typename... Args>
+    void M_construct(T *p, Args &&...args) {
+        alloc_traits::construct(M_get_allocator(), p, std::forward<Args>(args)...);
+    }
+    void M_destroy(T *p) noexcept { alloc_traits::destroy(M_get_allocator(), p); }
+
+    array_range M_array_one() const noexcept {
+        auto pos = M_head & M_mask();
+        return {M_impl.M_start + pos, std::min(size(), capacity() - pos)};
+    }
+    array_range M_array_two() const noexcept { return {M_impl.M_start, size() - M_array_one().second}; }
+
+    ///不超过分配器上限的最大的 2 的幂。
+    static size_type M_max_capacity(const T_alloc_type &alloc) noexcept {
+        auto limit = alloc_traits::max_size(alloc);
+        size_type capacity = 1;
+        while (capacity <= limit / 2) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+    ///把请求的容量向上取整为 2 的幂，超过 max_size() 时抛出 std::length_error 。
+    static size_type M_check_capacity(size_type capacity, const T_alloc_type &alloc) {
+        if (capacity > M_max_capacity(alloc)) {
+            throw std::length_error("ring_buffer capacity exceeds max_size()");
+        }
+        size_type rounded = capacity ? 1 : 0;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    ///已满时插入：覆盖策略先构造新值，再析构最旧的元素并把新值移入腾出的位置，容量为 0 时什么也不做；拒绝策略直接返回 false 。
+    template <typename... Args>
+    bool M_emplace_back_full(std::true_type, Args &&...args);
+    template <typename... Args>
+    bool M_emplace_back_full(std::false_type, Args &&...) noexcept {
+        return false;
+    }
+
+    ///把 [first, last) 复制到末尾。调用者保证空位足够。
+    void M_append(const T *first, const T *last);
+    ///把 other 的元素依次复制到空容器中，中途抛出异常时析构已复制的元素。
+    void M_copy_elements(const ring_buffer &other);
+
+    ///释放全部元素与存储，容量变为 0 。
+    void M_release_storage() noexcept {
+        clear();
+        M_deallocate(M_impl.M_start, capacity());
+        M_impl.M_start = M_impl.M_finish = M_impl.M_end_of_storage = nullptr;
+    }
+    ///释放现有存储并申请 capacity 个元素的新存储。
+    void M_recreate_storage(size_type capacity) {
+        M_release_storage();
+        this->M_create_storage(capacity);
+    }
+
+    ///分配器可以随之转移时，直接接管 other 的存储。
+    void M_move_assign(ring_buffer &other, std::true_type) noexcept;
+    ///分配器可能不相等时，分配器相等则接管存储，否则逐个移动元素。
+    void M_move_assign(ring_buffer &other, std::false_type);
+};
+
+template <typename T, typename Alloc, typename FullPolicy>
+ring_buffer<T, Alloc, FullPolicy>::ring_buffer(const ring_buffer &other)
+    : Base(other.capacity(), alloc_traits::select_on_container_copy_construction(other.M_get_allocator())) {
+    M_copy_elements(other);
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+ring_buffer<T, Alloc, FullPolicy>::ring_buffer(ring_buffer &&other) noexcept : Base(std::move(other)), M_head(other.M_head), M_tail(other.M_tail) {
+    other.M_head = other.M_tail = 0;
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+ring_buffer<T, Alloc, FullPolicy> &ring_buffer<T, Alloc, FullPolicy>::operator=(const ring_buffer &other) {
+    if (this == &other) {
+        return *this;
+    }
+    clear();
+    if (alloc_traits::propagate_on_container_copy_assignment::value && M_get_allocator() != other.M_get_allocator()) {
+        //旧存储只能由旧分配器释放，必须在替换分配器之前归还。
+        M_release_storage();
+    }
+    alloc_on_copy(M_get_allocator(), other.M_get_allocator(), typename alloc_traits::propagate_on_container_copy_assignment());
+    if (capacity() != other.capacity()) {
+        M_recreate_storage(other.capacity());
+    }
+    M_copy_elements(other);
+    return *this;
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+ring_buffer<T, Alloc, FullPolicy> &ring_buffer<T, Alloc, FullPolicy>::operator=(ring_buffer &&other)
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+    if (this == &other) {
+        return *this;
+    }
+    M_move_assign(other, std::integral_constant<bool, alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value>());
+    return *this;
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+void ring_buffer<T, Alloc, FullPolicy>::M_move_assign(ring_buffer &other, std::true_type) noexcept {
+    M_release_storage();
+    M_impl.M_swap_data(other.M_impl);
+    M_head = other.M_head;
+    M_tail = other.M_tail;
+    other.M_head = other.M_tail = 0;
+    alloc_on_move(M_get_allocator(), other.M_get_allocator(), typename alloc_traits::propagate_on_container_move_assignment());
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+void ring_buffer<T, Alloc, FullPolicy>::M_move_assign(ring_buffer &other, std::false_type) {
+    if (M_get_allocator() == other.M_get_allocator()) {
+        M_move_assign(other, std::true_type());
+        return;
+    }
+    clear();
+    if (capacity() != other.capacity()) {
+        M_recreate_storage(other.capacity());
+    }
+    auto one = other.array_one();
+    auto two = other.array_two();
+    uninitialized_move_a(one.first, one.first + one.second, M_impl.M_start, M_get_allocator());
+    M_tail = one.second;
+    try {
+        uninitialized_move_a(two.first, two.first + two.second, M_impl.M_start + one.second, M_get_allocator());
+    } catch (...) {
+        clear();
+        throw;
+    }
+    M_tail += two.second;
+    other.clear();
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+typename ring_buffer<T, Alloc, FullPolicy>::reference ring_buffer<T, Alloc, FullPolicy>::at(size_type pos) {
+    if (pos >= size()) {
+        throw std::out_of_range("ring_buffer::at");
+    }
+    return (*this)[pos];
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+typename ring_buffer<T, Alloc, FullPolicy>::const_reference ring_buffer<T, Alloc, FullPolicy>::at(size_type pos) const {
+    if (pos >= size()) {
+        throw std::out_of_range("ring_buffer::at");
+    }
+    return (*this)[pos];
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+template <typename... Args>
+bool ring_buffer<T, Alloc, FullPolicy>::M_emplace_back_full(std::true_type, Args &&...args) {
+    if (capacity() == 0) {
+        return false;
+    }
+    //最旧的元素与新元素占同一个位置。参数可能引用容器内的元素（如 push_back(front())），先在局部构造新值再析构最旧的元素；
+    //构造新值时抛出异常则容器不变，之后的移动构造抛出异常时最旧的元素已经移除。
+    T value(std::forward<Args>(args)...);
+    pop_front();
+    M_construct(M_slot(M_tail), std::move(value));
+    ++M_tail;
+    return true;
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+void ring_buffer<T, Alloc, FullPolicy>::pop_front(size_type count) noexcept {
+    auto pos = M_head & M_mask();
+    auto first = std::min(count, capacity() - pos);
+    destroy_a(M_impl.M_start + pos, M_impl.M_start + pos + first, M_get_allocator());
+    destroy_a(M_impl.M_start, M_impl.M_start + (count - first), M_get_allocator());
+    M_head += count;
+}
+
+//第一段从尾后位置写到存储末尾，第二段从存储开头写起。每段写完立即推进尾位置，第二段抛出异常时第一段保留在容器中。
+template <typename T, typename Alloc, typename FullPolicy>
+void ring_buffer<T, Alloc, FullPolicy>::M_append(const T *first, const T *last) {
+    auto count = static_cast<size_type>(last - first);
+    if (count == 0) {
+        return;
+    }
+    auto pos = M_tail & M_mask();
+    auto head = std::min(count, capacity() - pos);
+    uninitialized_copy_a(first, first + head, M_impl.M_start + pos, M_get_allocator());
+    M_tail += head;
+    uninitialized_copy_a(first + head, last, M_impl.M_start, M_get_allocator());
+    M_tail += count - head;
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+void ring_buffer<T, Alloc, FullPolicy>::M_copy_elements(const ring_buffer &other) {
+    auto one = other.array_one();
+    auto two = other.array_two();
+    try {
+        M_append(one.first, one.first + one.second);
+        M_append(two.first, two.first + two.second);
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+typename ring_buffer<T, Alloc, FullPolicy>::size_type ring_buffer<T, Alloc, FullPolicy>::write(const T *src, size_type count) {
+    auto room = capacity() - size();
+    if (count > room) {
+        if (FullPolicy::overwrite) {
+            if (count > capacity()) {
+                src += count - capacity();
+                count = capacity();
+            }
+            pop_front(count - room);
+        } else {
+            count = room;
+        }
+    }
+    M_append(src, src + count);
+    return count;
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+typename ring_buffer<T, Alloc, FullPolicy>::size_type ring_buffer<T, Alloc, FullPolicy>::read(T *dest, size_type count) {
+    count = std::min(count, size());
+    if (count == 0) {
+        return 0;
+    }
+    auto one = array_one();
+    auto first = std::min(count, one.second);
+    dest = std::move(one.first, one.first + first, dest);
+    std::move(M_impl.M_start, M_impl.M_start + (count - first), dest);
+    pop_front(count);
+    return count;
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+void ring_buffer<T, Alloc, FullPolicy>::swap(ring_buffer &other) noexcept {
+    M_impl.M_swap_data(other.M_impl);
+    std::swap(M_head, other.M_head);
+    std::swap(M_tail, other.M_tail);
+    alloc_on_swap(M_get_allocator(), other.M_get_allocator(), typename alloc_traits::propagate_on_container_swap());
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+bool operator==(const ring_buffer<T, Alloc, FullPolicy> &lhs, const ring_buffer<T, Alloc, FullPolicy> &rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+bool operator!=(const ring_buffer<T, Alloc, FullPolicy> &lhs, const ring_buffer<T, Alloc, FullPolicy> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Alloc, typename FullPolicy>
+void swap(ring_buffer<T, Alloc, FullPolicy> &lhs, ring_buffer<T, Alloc, FullPolicy> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+template <typename T, typename FullPolicy = overwrite_oldest>
+using ring_buffer = mystl::ring_buffer<T, polymorphic_allocator<T>, FullPolicy>;
+} // namespace pmr
+} // namespace mystl
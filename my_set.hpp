@@ -0,0 +1,55 @@
+#pragma once
+#include <functional>
+
+#include "my_btree.hpp"
+#include "my_memory_resource.hpp"
+#include "my_utility.hpp"
+
+namespace mystl {
+///基于 B 树的有序集合。插入与删除使所有迭代器失效，见 btree 。
+template <typename Key, typename Compare = std::less<Key>, typename Alloc = allocator<Key>>
+class set : public btree<Key, Key, identity, Compare, Alloc, false> {
+    using base = btree<Key, Key, identity, Compare, Alloc, false>;
+
+public:
+    using value_compare = Compare;
+
+    using base::base;
+    using base::operator=;
+    set() = default;
+
+    value_compare value_comp() const { return this->key_comp(); }
+};
+
+///基于 B 树的有序多重集合，等价的元素按插入顺序排列。
+template <typename Key, typename Compare = std::less<Key>, typename Alloc = allocator<Key>>
+class multiset : public btree<Key, Key, identity, Compare, Alloc, true> {
+    using base = btree<Key, Key, identity, Compare, Alloc, true>;
+
+public:
+    using value_compare = Compare;
+
+    using base::base;
+    using base::operator=;
+    multiset() = default;
+
+    value_compare value_comp() const { return this->key_comp(); }
+};
+
+template <typename Key, typename Compare, typename Alloc>
+void swap(set<Key, Compare, Alloc> &lhs, set<Key, Compare, Alloc> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void swap(multiset<Key, Compare, Alloc> &lhs, multiset<Key, Compare, Alloc> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+template <typename Key, typename Compare = std::less<Key>>
+using set = mystl::set<Key, Compare, polymorphic_allocator<Key>>;
+template <typename Key, typename Compare = std::less<Key>>
+using multiset = mystl::multiset<Key, Compare, polymorphic_allocator<Key>>;
+} // namespace pmr
+} // namespace mystl
@@ -0,0 +1,562 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MYTINYSTL_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define MYTINYSTL_SIMD_X86 0
+#endif
+
+namespace mystl {
+///int32_t 、 uint8_t 、 float 、 double 连续序列上的 SIMD 核函数：查找、计数、按大小计数、比较相等、字典序比较、最小值、最大值与求和。
+///每个核函数有标量、 SSE2 、 AVX2 与 AVX-512 四个版本，首次调用时按 CPUID 选出本机支持的最高指令集，也可以用 set_isa 指定。
+///比较的语义与对应的标准算法一致：浮点以 == 与 < 比较， NaN 与任何值都不相等， -0.0 等于 +0.0 。
+///浮点的 sum 、 min 、 max 按规范顺序计算，任何指令集的结果逐位一致：
+///把序列按 64 字节分块，块内第 k 个元素累加到第 k 个累加器；全部整块处理完后，累加器按 k 与 k + w 两两合并， w 从块长的一半逐次减半；
+///最后把不足一块的尾部依次合并进结果。 min(acc, x) 取 x < acc ? x : acc ， max(acc, x) 取 acc < x ? x : acc 。
+namespace simd {
+enum class isa { scalar, sse2, avx2, avx512 };
+
+constexpr size_t block_bytes = 64; //核函数一次处理的字节数
+
+///有 SIMD 核函数的元素类型。
+template <typename T>
+struct has_kernel
+    : std::integral_constant<bool, std::is_same<T, int32_t>::value || std::is_same<T, uint8_t>::value || std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+///sum 的结果类型：整数加宽到 64 位，不会溢出；浮点不变。
+template <typename T>
+struct simd_sum {
+    using type = T;
+};
+template <>
+struct simd_sum<int32_t> {
+    using type = int64_t;
+};
+template <>
+struct simd_sum<uint8_t> {
+    using type = uint64_t;
+};
+
+template <typename T>
+inline T scalar_min(T acc, T x) noexcept {
+    return x < acc ? x : acc;
+}
+
+template <typename T>
+inline T scalar_max(T acc, T x) noexcept {
+    return acc < x ? x : acc;
+}
+
+///最低位的 1 的位置， m 不为零。
+inline size_t lowest_bit(uint64_t m) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(m));
+#else
+    size_t i = 0;
+    for (; !(m & 1); m >>= 1) {
+        ++i;
+    }
+    return i;
+#endif
+}
+
+inline size_t popcount(uint64_t m) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(m));
+#else
+    size_t c = 0;
+    for (; m; m &= m - 1) {
+        ++c;
+    }
+    return c;
+#endif
+}
+
+///标量版本：每个“寄存器”只有一个元素，块内的累加器与 SIMD 版本一一对应。也是非 x86 平台上唯一的版本。
+namespace scalar {
+template <typename T>
+struct ops {
+    using reg = T;
+    using sum_reg = typename simd_sum<T>::type;
+    static constexpr size_t lanes = 1;
+    static constexpr size_t sum_lanes = 1;
+
+    static reg load(const T *p) noexcept { return *p; }
+    static void store(T *p, reg a) noexcept { *p = a; }
+    static reg set1(T v) noexcept { return v; }
+    static uint64_t eq(reg a, reg b) noexcept { return a == b; }
+    static uint64_t ne(reg a, reg b) noexcept { return a < b || b < a; }
+    static uint64_t lt(reg a, reg b) noexcept { return a < b; }
+    static reg min(reg acc, reg x) noexcept { return scalar_min(acc, x); }
+    static reg max(reg acc, reg x) noexcept { return scalar_max(acc, x); }
+    static sum_reg sum_zero() noexcept { return 0; }
+    static sum_reg sum_add(sum_reg acc, reg x) noexcept { return acc + x; }
+    static void sum_store(sum_reg *p, sum_reg acc) noexcept { *p = acc; }
+};
+
+#include "my_simd_kernels.hpp"
+} // namespace scalar
+
+#if MYTINYSTL_SIMD_X86
+//以下各指令集的函数只在 CPUID 确认支持后才会被调用。 ops 的成员按各自的语义实现：
+//eq/ne/lt 返回各通道的位掩码， ne 为“有序且不等”， lt 为 a < b ； min(acc, x) 与 max(acc, x) 与 scalar_min/scalar_max 逐通道一致；
+//sum_reg 是求和的累加器，整数在其中加宽到 64 位， sum_store 写出 sum_lanes 个部分和。
+#pragma GCC push_options
+#pragma GCC target("sse2")
+namespace sse2 {
+template <typename T>
+struct ops;
+
+template <>
+struct ops<float> {
+    using reg = __m128;
+    using sum_reg = __m128;
+    static constexpr size_t lanes = 4;
+    static constexpr size_t sum_lanes = 4;
+
+    static reg load(const float *p) noexcept { return _mm_loadu_ps(p); }
+    static void store(float *p, reg a) noexcept { _mm_storeu_ps(p, a); }
+    static reg set1(float v) noexcept { return _mm_set1_ps(v); }
+    static uint64_t eq(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+    static uint64_t ne(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(a, b), _mm_cmplt_ps(b, a)))); }
+    static uint64_t lt(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm_movemask_ps(_mm_cmplt_ps(a, b))); }
+    static reg min(reg acc, reg x) noexcept { return _mm_min_ps(x, acc); }
+    static reg max(reg acc, reg x) noexcept { return _mm_max_ps(x, acc); }
+    static sum_reg sum_zero() noexcept { return _mm_setzero_ps(); }
+    static sum_reg sum_add(sum_reg acc, reg x) noexcept { return _mm_add_ps(acc, x); }
+    static void sum_store(float *p, sum_reg acc) noexcept { _mm_storeu_ps(p, acc); }
+};
+
+template <>
+struct ops<double> {
+    using reg = __m128d;
+    using sum_reg = __m128d;
+    static constexpr size_t lanes = 2;
+    static constexpr size_t sum_lanes = 2;
+
+    static reg load(const double *p) noexcept { return _mm_loadu_pd(p); }
+    static void store(double *p, reg a) noexcept { _mm_storeu_pd(p, a); }
+    static reg set1(double v) noexcept { return _mm_set1_pd(v); }
+    static uint64_t eq(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+    static uint64_t ne(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm_movemask_pd(_mm_or_pd(_mm_cmplt_pd(a, b), _mm_cmplt_pd(b, a)))); }
+    static uint64_t lt(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm_movemask_pd(_mm_cmplt_pd(a, b))); }
+    static reg min(reg acc, reg x) noexcept { return _mm_min_pd(x, acc); }
+    static reg max(reg acc, reg x) noexcept { return _mm_max_pd(x, acc); }
+    static sum_reg sum_zero() noexcept { return _mm_setzero_pd(); }
+    static sum_reg sum_add(sum_reg acc, reg x) noexcept { return _mm_add_pd(acc, x); }
+    static void sum_store(double *p, sum_reg acc) noexcept { _mm_storeu_pd(p, acc); }
+};
+
+template <>
+struct ops<int32_t> {
+    using reg = __m128i;
+    struct sum_reg {
+        __m128i lo, hi;
+    };
+    static constexpr size_t lanes = 4;
+    static constexpr size_t sum_lanes = 4;
+
+    static reg load(const int32_t *p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    static void store(int32_t *p, reg a) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), a); }
+    static reg set1(int32_t v) noexcept { return _mm_set1_epi32(v); }
+    static uint64_t eq(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))); }
+    static uint64_t ne(reg a, reg b) noexcept { return eq(a, b) ^ 0xF; }
+    static uint64_t lt(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(a, b)))); }
+    //SSE2 没有 32 位整数的 min/max ，以比较结果做选择。
+    static reg min(reg acc, reg x) noexcept {
+        auto lt = _mm_cmplt_epi32(x, acc);
+        return _mm_or_si128(_mm_and_si128(lt, x), _mm_andnot_si128(lt, acc));
+    }
+    static reg max(reg acc, reg x) noexcept {
+        auto gt = _mm_cmpgt_epi32(x, acc);
+        return _mm_or_si128(_mm_and_si128(gt, x), _mm_andnot_si128(gt, acc));
+    }
+    static sum_reg sum_zero() noexcept { return {_mm_setzero_si128(), _mm_setzero_si128()}; }
+    static sum_reg sum_add(sum_reg acc, reg x) noexcept {
+        auto sign = _mm_srai_epi32(x, 31);
+        return {_mm_add_epi64(acc.lo, _mm_unpacklo_epi32(x, sign)), _mm_add_epi64(acc.hi, _mm_unpackhi_epi32(x, sign))};
+    }
+    static void sum_store(int64_t *p, sum_reg acc) noexcept {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(p), acc.lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(p + 2), acc.hi);
+    }
+};
+
+template <>
+struct ops<uint8_t> {
+    using reg = __m128i;
+    using sum_reg = __m128i;
+    static constexpr size_t lanes = 16;
+    static constexpr size_t sum_lanes = 2;
+
+    static reg load(const uint8_t *p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    static void store(uint8_t *p, reg a) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), a); }
+    static reg set1(uint8_t v) noexcept { return _mm_set1_epi8(static_cast<char>(v)); }
+    static uint64_t eq(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))); }
+    static uint64_t ne(reg a, reg b) noexcept { return eq(a, b) ^ 0xFFFF; }
+    //SSE2 只有有符号字节比较，翻转最高位后无符号的大小关系与有符号一致。
+    static uint64_t lt(reg a, reg b) noexcept {
+        auto flip = _mm_set1_epi8(static_cast<char>(0x80));
+        return static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmplt_epi8(_mm_xor_si128(a, flip), _mm_xor_si128(b, flip))));
+    }
+    static reg min(reg acc, reg x) noexcept { return _mm_min_epu8(acc, x); }
+    static reg max(reg acc, reg x) noexcept { return _mm_max_epu8(acc, x); }
+    static sum_reg sum_zero() noexcept { return _mm_setzero_si128(); }
+    //psadbw 把每 8 个字节之和放进一个 64 位通道。
+    static sum_reg sum_add(sum_reg acc, reg x) noexcept { return _mm_add_epi64(acc, _mm_sad_epu8(x, _mm_setzero_si128())); }
+    static void sum_store(uint64_t *p, sum_reg acc) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), acc); }
+};
+
+#include "my_simd_kernels.hpp"
+} // namespace sse2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt,bmi")
+namespace avx2 {
+template <typename T>
+struct ops;
+
+template <>
+struct ops<float> {
+    using reg = __m256;
+    using sum_reg = __m256;
+    static constexpr size_t lanes = 8;
+    static constexpr size_t sum_lanes = 8;
+
+    static reg load(const float *p) noexcept { return _mm256_loadu_ps(p); }
+    static void store(float *p, reg a) noexcept { _mm256_storeu_ps(p, a); }
+    static reg set1(float v) noexcept { return _mm256_set1_ps(v); }
+    static uint64_t eq(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))); }
+    static uint64_t ne(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_NEQ_OQ))); }
+    static uint64_t lt(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ))); }
+    static reg min(reg acc, reg x) noexcept { return _mm256_min_ps(x, acc); }
+    static reg max(reg acc, reg x) noexcept { return _mm256_max_ps(x, acc); }
+    static sum_reg sum_zero() noexcept { return _mm256_setzero_ps(); }
+    static sum_reg sum_add(sum_reg acc, reg x) noexcept { return _mm256_add_ps(acc, x); }
+    static void sum_store(float *p, sum_reg acc) noexcept { _mm256_storeu_ps(p, acc); }
+};
+
+template <>
+struct ops<double> {
+    using reg = __m256d;
+    using sum_reg = __m256d;
+    static constexpr size_t lanes = 4;
+    static constexpr size_t sum_lanes = 4;
+
+    static reg load(const double *p) noexcept { return _mm256_loadu_pd(p); }
+    static void store(double *p, reg a) noexcept { _mm256_storeu_pd(p, a); }
+    static reg set1(double v) noexcept { return _mm256_set1_pd(v); }
+    static uint64_t eq(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))); }
+    static uint64_t ne(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_NEQ_OQ))); }
+    static uint64_t lt(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ))); }
+    static reg min(reg acc, reg x) noexcept { return _mm256_min_pd(x, acc); }
+    static reg max(reg acc, reg x) noexcept { return _mm256_max_pd(x, acc); }
+    static sum_reg sum_zero() noexcept { return _mm256_setzero_pd(); }
+    static sum_reg sum_add(sum_reg acc, reg x) noexcept { return _mm256_add_pd(acc, x); }
+    static void sum_store(double *p, sum_reg acc) noexcept { _mm256_storeu_pd(p, acc); }
+};
+
+template <>
+struct ops<int32_t> {
+    using reg = __m256i;
+    struct sum_reg {
+        __m256i lo, hi;
+    };
+    static constexpr size_t lanes = 8;
+    static constexpr size_t sum_lanes = 8;
+
+    static reg load(const int32_t *p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    static void store(int32_t *p, reg a) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), a); }
+    static reg set1(int32_t v) noexcept { return _mm256_set1_epi32(v); }
+    static uint64_t eq(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))); }
+    static uint64_t ne(reg a, reg b) noexcept { return eq(a, b) ^ 0xFF; }
+    static uint64_t lt(reg a, reg b) noexcept { return static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(b, a)))); }
+    static reg min(reg acc, reg x) noexcept { return _mm256_min_epi32(acc, x); }
+    static reg max(reg acc, reg x) noexcept { return _mm256_max_epi32(acc, x); }
+    static sum_reg sum_zero() noexcept { return {_mm256_setzero_si256(), _mm256_setzero_si256()}; }
+    static sum_reg sum_add(sum_reg acc, reg x) noexcept {
+        return {_mm256_add_epi64(acc.lo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x))),
+                _mm256_add_epi64(acc.hi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)))};
+    }
+    static void sum_store(int64_t *p, sum_reg acc) noexcept {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), acc.lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p + 4), acc.hi);
+    }
+};
+
+template <>
+struct ops<uint8_t> {
+    using reg = __m256i;
+    using sum_reg = __m256i;
+    static constexpr size_t lanes = 32;
+    static constexpr size_t sum_lanes = 4;
+
+    static reg load(const uint8_t *p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    static void store(uint8_t *p, reg a) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), a); }
+    static reg set1(uint8_t v) noexcept { return _mm256_set1_epi8(static_cast<char>(v)); }
+    static uint64_t eq(reg a, reg b) noexcept { return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))); }
+    static uint64_t ne(reg a, reg b) noexcept { return eq(a, b) ^ 0xFFFFFFFFu; }
+    static uint64_t lt(reg a, reg b) noexcept {
+        auto flip = _mm256_set1_epi8(static_cast<char>(0x80));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_xor_si256(b, flip), _mm256_xor_si256(a, flip))));
+    }
+    static reg min(reg acc, reg x) noexcept { return _mm256_min_epu8(acc, x); }
+    static reg max(reg acc, reg x) noexcept { return _mm256_max_epu8(acc, x); }
+    static sum_reg sum_zero() noexcept { return _mm256_setzero_si256(); }
+    static sum_reg sum_add(sum_reg acc, reg x) noexcept { return _mm256_add_epi64(acc, _mm256_sad_epu8(x, _mm256_setzero_si256())); }
+    static void sum_store(uint64_t *p, sum_reg acc) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), acc); }
+};
+
+#include "my_simd_kernels.hpp"
+} // namespace avx2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,avx2,popcnt,bmi")
+//GCC 12 的 AVX-512 头文件以自赋值构造未定义的寄存器，内联后误报 -Wmaybe-uninitialized 。
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+namespace avx512 {
+template <typename T>
+struct ops;
+
+template <>
+struct ops<float> {
+    using reg = __m512;
+    using sum_reg = __m512;
+    static constexpr size_t lanes = 16;
+    static constexpr size_t sum_lanes = 16;
+
+    static reg load(const float *p) noexcept { return _mm512_loadu_ps(p); }
+    static void store(float *p, reg a) noexcept { _mm512_storeu_ps(p, a); }
+    static reg set1(float v) noexcept { return _mm512_set1_ps(v); }
+    static uint64_t eq(reg a, reg b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+    static uint64_t ne(reg a, reg b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_OQ); }
+    static uint64_t lt(reg a, reg b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static reg min(reg acc, reg x) noexcept { return _mm512_min_ps(x, acc); }
+    static reg max(reg acc, reg x) noexcept { return _mm512_max_ps(x, acc); }
+    static sum_reg sum_zero() noexcept { return _mm512_setzero_ps(); }
+    static sum_reg sum_add(sum_reg acc, reg x) noexcept { return _mm512_add_ps(acc, x); }
+    static void sum_store(float *p, sum_reg acc) noexcept { _mm512_storeu_ps(p, acc); }
+};
+
+template <>
+struct ops<double> {
+    using reg = __m512d;
+    using sum_reg = __m512d;
+    static constexpr size_t lanes = 8;
+    static constexpr size_t sum_lanes = 8;
+
+    static reg load(const double *p) noexcept { return _mm512_loadu_pd(p); }
+    static void store(double *p, reg a) noexcept { _mm512_storeu_pd(p, a); }
+    static reg set1(double v) noexcept { return _mm512_set1_pd(v); }
+    static uint64_t eq(reg a, reg b) noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static uint64_t ne(reg a, reg b) noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_OQ); }
+    static uint64_t lt(reg a, reg b) noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static reg min(reg acc, reg x) noexcept { return _mm512_min_pd(x, acc); }
+    static reg max(reg acc, reg x) noexcept { return _mm512_max_pd(x, acc); }
+    static sum_reg sum_zero() noexcept { return _mm512_setzero_pd(); }
+    static sum_reg sum_add(sum_reg acc, reg x) noexcept { return _mm512_add_pd(acc, x); }
+    static void sum_store(double *p, sum_reg acc) noexcept { _mm512_storeu_pd(p, acc); }
+};
+
+template <>
+struct ops<int32_t> {
+    using reg = __m512i;
+    struct sum_reg {
+        __m512i lo, hi;
+    };
+    static constexpr size_t lanes = 16;
+    static constexpr size_t sum_lanes = 16;
+
+    static reg load(const int32_t *p) noexcept { return _mm512_loadu_si512(p); }
+    static void store(int32_t *p, reg a) noexcept { _mm512_storeu_si512(p, a); }
+    static reg set1(int32_t v) noexcept { return _mm512_set1_epi32(v); }
+    static uint64_t eq(reg a, reg b) noexcept { return _mm512_cmpeq_epi32_mask(a, b); }
+    static uint64_t ne(reg a, reg b) noexcept { return _mm512_cmpneq_epi32_mask(a, b); }
+    static uint64_t lt(reg a, reg b) noexcept { return _mm512_cmplt_epi32_mask(a, b); }
+    static reg min(reg acc, reg x) noexcept { return _mm512_min_epi32(acc, x); }
+    static reg max(reg acc, reg x) noexcept { return _mm512_max_epi32(acc, x); }
+    static sum_reg sum_zero() noexcept { return {_mm512_setzero_si512(), _mm512_setzero_si512()}; }
+    static sum_reg sum_add(sum_reg acc, reg x) noexcept {
+        auto sign = _mm512_srai_epi32(x, 31);
+        return {_mm512_add_epi64(acc.lo, _mm512_unpacklo_epi32(x, sign)), _mm512_add_epi64(acc.hi, _mm512_unpackhi_epi32(x, sign))};
+    }
+    static void sum_store(int64_t *p, sum_reg acc) noexcept {
+        _mm512_storeu_si512(p, acc.lo);
+        _mm512_storeu_si512(p + 8, acc.hi);
+    }
+};
+
+template <>
+struct ops<uint8_t> {
+    using reg = __m512i;
+    using sum_reg = __m512i;
+    static constexpr size_t lanes = 64;
+    static constexpr size_t sum_lanes = 8;
+
+    static reg load(const uint8_t *p) noexcept { return _mm512_loadu_si512(p); }
+    static void store(uint8_t *p, reg a) noexcept { _mm512_storeu_si512(p, a); }
+    static reg set1(uint8_t v) noexcept { return _mm512_set1_epi8(static_cast<char>(v)); }
+    static uint64_t eq(reg a, reg b) noexcept { return _mm512_cmpeq_epi8_mask(a, b); }
+    static uint64_t ne(reg a, reg b) noexcept { return _mm512_cmpneq_epi8_mask(a, b); }
+    static uint64_t lt(reg a, reg b) noexcept { return _mm512_cmplt_epu8_mask(a, b); }
+    static reg min(reg acc, reg x) noexcept { return _mm512_min_epu8(acc, x); }
+    static reg max(reg acc, reg x) noexcept { return _mm512_max_epu8(acc, x); }
+    static sum_reg sum_zero() noexcept { return _mm512_setzero_si512(); }
+    static sum_reg sum_add(sum_reg acc, reg x) noexcept { return _mm512_add_epi64(acc, _mm512_sad_epu8(x, _mm512_setzero_si512())); }
+    static void sum_store(uint64_t *p, sum_reg acc) noexcept { _mm512_storeu_si512(p, acc); }
+};
+
+#include "my_simd_kernels.hpp"
+} // namespace avx512
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+#endif
+
+///本机支持的最高指令集。 AVX-512 需要 F 与 BW 两个子集。
+inline isa detect_isa() noexcept {
+#if MYTINYSTL_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return isa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt") && __builtin_cpu_supports("bmi")) {
+        return isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return isa::sse2;
+    }
+#endif
+    return isa::scalar;
+}
+
+inline std::atomic<isa> &M_active_isa() noexcept {
+    static std::atomic<isa> active{detect_isa()};
+    return active;
+}
+
+inline isa active_isa() noexcept { return M_active_isa().load(std::memory_order_relaxed); } //当前使用的指令集。
+
+///指定之后使用的指令集，超出本机支持的范围时取本机支持的最高指令集，返回实际生效的指令集。用于测试与性能对比。
+inline isa set_isa(isa level) noexcept {
+    auto best = detect_isa();
+    if (static_cast<int>(level) > static_cast<int>(best)) {
+        level = best;
+    }
+    M_active_isa().store(level, std::memory_order_relaxed);
+    return level;
+}
+
+inline const char *isa_name(isa level) noexcept {
+    switch (level) {
+    case isa::sse2:
+        return "sse2";
+    case isa::avx2:
+        return "avx2";
+    case isa::avx512:
+        return "avx512";
+    default:
+        return "scalar";
+    }
+}
+
+///一种元素类型在一个指令集下的全部核函数。
+template <typename T>
+struct kernel_table {
+    size_t (*find)(const T *, size_t, T);
+    size_t (*count)(const T *, size_t, T);
+    size_t (*count_less)(const T *, size_t, T);
+    size_t (*count_greater)(const T *, size_t, T);
+    size_t (*mismatch)(const T *, const T *, size_t);
+    bool (*lexicographical_less)(const T *, size_t, const T *, size_t);
+    T (*min)(const T *, size_t);
+    T (*max)(const T *, size_t);
+    typename simd_sum<T>::type (*sum)(const T *, size_t);
+};
+
+///当前指令集下的核函数。
+template <typename T>
+const kernel_table<T> &kernels() noexcept {
+    static_assert(has_kernel<T>::value, "no SIMD kernels for this element type");
+#define MYTINYSTL_SIMD_TABLE(ns)                                                                                                     \
+    { &ns::find<T>, &ns::count<T>, &ns::count_less<T>, &ns::count_greater<T>, &ns::mismatch<T>, &ns::lexicographical_less<T>, &ns::min<T>, &ns::max<T>, &ns::sum<T> }
+#if MYTINYSTL_SIMD_X86
+    static const kernel_table<T> tables[] = {MYTINYSTL_SIMD_TABLE(scalar), MYTINYSTL_SIMD_TABLE(sse2), MYTINYSTL_SIMD_TABLE(avx2),
+                                             MYTINYSTL_SIMD_TABLE(avx512)};
+    return tables[static_cast<int>(active_isa())];
+#else
+    static const kernel_table<T> table = MYTINYSTL_SIMD_TABLE(scalar);
+    return table;
+#endif
+#undef MYTINYSTL_SIMD_TABLE
+}
+
+//以下为对外接口，按当前指令集分派。
+
+///第一个等于 value 的元素的下标，没有时返回 n 。
+template <typename T>
+size_t find(const T *p, size_t n, T value) {
+    return kernels<T>().find(p, n, value);
+}
+
+///等于 value 的元素个数。
+template <typename T>
+size_t count(const T *p, size_t n, T value) {
+    return kernels<T>().count(p, n, value);
+}
+
+///小于 value 的元素个数。序列升序时即 std::lower_bound 的下标。
+template <typename T>
+size_t count_less(const T *p, size_t n, T value) {
+    return kernels<T>().count_less(p, n, value);
+}
+
+///大于 value 的元素个数。序列升序时 n 减去它即 std::upper_bound 的下标。
+template <typename T>
+size_t count_greater(const T *p, size_t n, T value) {
+    return kernels<T>().count_greater(p, n, value);
+}
+
+///第一个 !(a[i] == b[i]) 的下标，没有时返回 n 。
+template <typename T>
+size_t mismatch(const T *a, const T *b, size_t n) {
+    return kernels<T>().mismatch(a, b, n);
+}
+
+template <typename T>
+bool equal(const T *a, const T *b, size_t n) {
+    return kernels<T>().mismatch(a, b, n) == n;
+}
+
+///[a, a + na) 按字典序是否小于 [b, b + nb) ，与 std::lexicographical_compare 相同。
+template <typename T>
+bool lexicographical_less(const T *a, size_t na, const T *b, size_t nb) {
+    return kernels<T>().lexicographical_less(a, na, b, nb);
+}
+
+///最小值。 n 须大于零。
+template <typename T>
+T min(const T *p, size_t n) {
+    return kernels<T>().min(p, n);
+}
+
+///最大值。 n 须大于零。
+template <typename T>
+T max(const T *p, size_t n) {
+    return kernels<T>().max(p, n);
+}
+
+///元素之和，整数加宽到 64 位。
+template <typename T>
+typename simd_sum<T>::type sum(const T *p, size_t n) {
+    return kernels<T>().sum(p, n);
+}
+} // namespace simd
+} // namespace mystl
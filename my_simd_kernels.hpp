@@ -0,0 +1,216 @@
+// 本文件没有 include guard ，只由 my_simd.hpp 包含：每个指令集的命名空间中各包含一次，配合 #pragma GCC target 生成该指令集的版本。
+// 核函数只通过所在命名空间中的 ops<T> 访问寄存器，按 64 字节的块处理，块内寄存器数 regs = 64 / (ops<T>::lanes * sizeof(T)) ，
+// 不足一块的尾部逐个处理。浮点的 sum / min / max 按规范顺序合并（见 my_simd.hpp ），任何指令集的结果都逐位一致。
+
+///一个 64 字节块的参数。
+template <typename T>
+struct block {
+    static constexpr size_t size = block_bytes / sizeof(T); //块内元素数
+    static constexpr size_t regs = size / ops<T>::lanes;    //块内寄存器数
+    static constexpr uint64_t full = size == 64 ? ~uint64_t(0) : (uint64_t(1) << size) - 1;
+};
+
+///块内 a[i] == b[i] 的元素的位掩码。
+template <typename T>
+inline uint64_t eq_mask(const T *a, const T *b) {
+    uint64_t m = 0;
+    for (size_t r = 0; r < block<T>::regs; ++r) {
+        m |= ops<T>::eq(ops<T>::load(a + r * ops<T>::lanes), ops<T>::load(b + r * ops<T>::lanes)) << (r * ops<T>::lanes);
+    }
+    return m;
+}
+
+///块内等于 value 的元素的位掩码。
+template <typename T>
+inline uint64_t eq_mask(const T *a, typename ops<T>::reg value) {
+    uint64_t m = 0;
+    for (size_t r = 0; r < block<T>::regs; ++r) {
+        m |= ops<T>::eq(ops<T>::load(a + r * ops<T>::lanes), value) << (r * ops<T>::lanes);
+    }
+    return m;
+}
+
+///块内 a[i] < b[i] 或 b[i] < a[i] 的元素的位掩码。
+template <typename T>
+inline uint64_t ordered_ne_mask(const T *a, const T *b) {
+    uint64_t m = 0;
+    for (size_t r = 0; r < block<T>::regs; ++r) {
+        m |= ops<T>::ne(ops<T>::load(a + r * ops<T>::lanes), ops<T>::load(b + r * ops<T>::lanes)) << (r * ops<T>::lanes);
+    }
+    return m;
+}
+
+///块内 a[i] < value （Less 为 true）或 value < a[i] （Less 为 false）的元素的位掩码。
+template <bool Less, typename T>
+inline uint64_t lt_mask(const T *a, typename ops<T>::reg value) {
+    uint64_t m = 0;
+    for (size_t r = 0; r < block<T>::regs; ++r) {
+        auto x = ops<T>::load(a + r * ops<T>::lanes);
+        m |= (Less ? ops<T>::lt(x, value) : ops<T>::lt(value, x)) << (r * ops<T>::lanes);
+    }
+    return m;
+}
+
+///count_less 与 count_greater 的公共部分。不提前退出，升序序列上也整段计数，没有难以预测的分支。
+template <bool Less, typename T>
+size_t count_order(const T *p, size_t n, T value) {
+    auto v = ops<T>::set1(value);
+    size_t c = 0;
+    size_t i = 0;
+    for (; i + block<T>::size <= n; i += block<T>::size) {
+        c += popcount(lt_mask<Less>(p + i, v));
+    }
+    for (; i < n; ++i) {
+        c += Less ? p[i] < value : value < p[i];
+    }
+    return c;
+}
+
+template <typename T>
+size_t count_less(const T *p, size_t n, T value) {
+    return count_order<true>(p, n, value);
+}
+
+template <typename T>
+size_t count_greater(const T *p, size_t n, T value) {
+    return count_order<false>(p, n, value);
+}
+
+template <typename T>
+size_t find(const T *p, size_t n, T value) {
+    auto v = ops<T>::set1(value);
+    size_t i = 0;
+    for (; i + block<T>::size <= n; i += block<T>::size) {
+        if (auto m = eq_mask(p + i, v)) {
+            return i + lowest_bit(m);
+        }
+    }
+    for (; i < n && !(p[i] == value); ++i) {
+    }
+    return i;
+}
+
+template <typename T>
+size_t count(const T *p, size_t n, T value) {
+    auto v = ops<T>::set1(value);
+    size_t c = 0;
+    size_t i = 0;
+    for (; i + block<T>::size <= n; i += block<T>::size) {
+        c += popcount(eq_mask(p + i, v));
+    }
+    for (; i < n; ++i) {
+        c += p[i] == value;
+    }
+    return c;
+}
+
+template <typename T>
+size_t mismatch(const T *a, const T *b, size_t n) {
+    size_t i = 0;
+    for (; i + block<T>::size <= n; i += block<T>::size) {
+        if (auto m = eq_mask(a + i, b + i) ^ block<T>::full) {
+            return i + lowest_bit(m);
+        }
+    }
+    for (; i < n && a[i] == b[i]; ++i) {
+    }
+    return i;
+}
+
+template <typename T>
+bool lexicographical_less(const T *a, size_t na, const T *b, size_t nb) {
+    auto n = na < nb ? na : nb;
+    size_t i = 0;
+    for (; i + block<T>::size <= n; i += block<T>::size) {
+        if (auto m = ordered_ne_mask(a + i, b + i)) {
+            i += lowest_bit(m);
+            return a[i] < b[i];
+        }
+    }
+    for (; i < n; ++i) {
+        if (a[i] < b[i]) {
+            return true;
+        }
+        if (b[i] < a[i]) {
+            return false;
+        }
+    }
+    return na < nb;
+}
+
+template <typename T>
+typename simd_sum<T>::type sum(const T *p, size_t n) {
+    using sum_type = typename simd_sum<T>::type;
+    constexpr size_t regs = block<T>::regs;
+    constexpr size_t lanes = regs * ops<T>::sum_lanes;
+    typename ops<T>::sum_reg acc[regs];
+    for (size_t r = 0; r < regs; ++r) {
+        acc[r] = ops<T>::sum_zero();
+    }
+    size_t i = 0;
+    for (; i + block<T>::size <= n; i += block<T>::size) {
+        for (size_t r = 0; r < regs; ++r) {
+            acc[r] = ops<T>::sum_add(acc[r], ops<T>::load(p + i + r * ops<T>::lanes));
+        }
+    }
+    sum_type partial[lanes];
+    for (size_t r = 0; r < regs; ++r) {
+        ops<T>::sum_store(partial + r * ops<T>::sum_lanes, acc[r]);
+    }
+    for (size_t w = lanes / 2; w; w /= 2) {
+        for (size_t k = 0; k < w; ++k) {
+            partial[k] = partial[k] + partial[k + w];
+        }
+    }
+    auto result = partial[0];
+    for (; i < n; ++i) {
+        result = result + p[i];
+    }
+    return result;
+}
+
+///min 与 max 的公共部分。 n 须大于零。 Min 为 true 时求最小值。
+template <bool Min, typename T>
+T extremum(const T *p, size_t n) {
+    constexpr size_t regs = block<T>::regs;
+    size_t i = 0;
+    T result;
+    if (n >= block<T>::size) {
+        typename ops<T>::reg acc[regs];
+        for (size_t r = 0; r < regs; ++r) {
+            acc[r] = ops<T>::load(p + r * ops<T>::lanes);
+        }
+        for (i = block<T>::size; i + block<T>::size <= n; i += block<T>::size) {
+            for (size_t r = 0; r < regs; ++r) {
+                auto x = ops<T>::load(p + i + r * ops<T>::lanes);
+                acc[r] = Min ? ops<T>::min(acc[r], x) : ops<T>::max(acc[r], x);
+            }
+        }
+        T partial[block<T>::size];
+        for (size_t r = 0; r < regs; ++r) {
+            ops<T>::store(partial + r * ops<T>::lanes, acc[r]);
+        }
+        for (size_t w = block<T>::size / 2; w; w /= 2) {
+            for (size_t k = 0; k < w; ++k) {
+                partial[k] = Min ? scalar_min(partial[k], partial[k + w]) : scalar_max(partial[k], partial[k + w]);
+            }
+        }
+        result = partial[0];
+    } else {
+        result = p[i++];
+    }
+    for (; i < n; ++i) {
+        result = Min ? scalar_min(result, p[i]) : scalar_max(result, p[i]);
+    }
+    return result;
+}
+
+template <typename T>
+T min(const T *p, size_t n) {
+    return extremum<true>(p, n);
+}
+
+template <typename T>
+T max(const T *p, size_t n) {
+    return extremum<false>(p, n);
+}
@@ -0,0 +1,391 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "my_memory.hpp"
+#include "my_vector.hpp"
+
+namespace mystl {
+template <typename T, size_t N, typename Alloc>
+class small_buffer_allocator;
+
+template <typename T, size_t N, typename Alloc = allocator<T>, typename Growth = double_growth>
+class small_vector;
+
+///small_vector 的分配器：自身带有可容纳 N 个 T 的内联缓冲区，其余申请交给 Alloc 。
+///它作为 vector_base::vector_impl 的基类存放在容器对象内部，缓冲区与容器同生命周期；释放内联缓冲区是空操作。
+///复制得到的分配器各有一块未使用的缓冲区，两个实例只在是同一对象时相等，因此它从不在容器之间传播，
+///内联元素的搬迁由 small_vector 自己完成。
+template <typename T, size_t N, typename Alloc>
+class small_buffer_allocator : private std::allocator_traits<Alloc>::template rebind_alloc<T> {
+    static_assert(N > 0, "small_buffer_allocator needs at least one inline element");
+
+    using inner_type = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    using inner_traits = std::allocator_traits<inner_type>;
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    template <typename U>
+    struct rebind {
+        using other = small_buffer_allocator<U, N, typename std::allocator_traits<Alloc>::template rebind_alloc<U>>;
+    };
+
+    small_buffer_allocator() noexcept(std::is_nothrow_default_constructible<inner_type>::value) : inner_type() {}
+    explicit small_buffer_allocator(const inner_type &inner) noexcept : inner_type(inner) {}
+    small_buffer_allocator(const small_buffer_allocator &other) noexcept : inner_type(other.inner()) {} //只复制内层分配器，不复制缓冲区。
+    template <typename U, size_t M, typename A>
+    small_buffer_allocator(const small_buffer_allocator<U, M, A> &other) noexcept : inner_type(other.inner()) {}
+
+    small_buffer_allocator &operator=(const small_buffer_allocator &) = delete;
+
+    T *allocate(size_type n) { return inner_traits::allocate(inner(), n); }
+    void deallocate(T *p, size_type n) noexcept;
+    T *reallocate(T *p, size_type old_n, size_type new_n); //内容按字节保留，仅适用于可平凡重定位类型。p 为内联缓冲区时申请新内存后复制。
+
+    template <typename U, typename... Args>
+    void construct(U *p, Args &&...args) {
+        inner_traits::construct(inner(), p, std::forward<Args>(args)...);
+    }
+    template <typename U>
+    void destroy(U *p) noexcept {
+        inner_traits::destroy(inner(), p);
+    }
+
+    size_type max_size() const noexcept { return inner_traits::max_size(inner()); }
+
+    small_buffer_allocator select_on_container_copy_construction() const {
+        return small_buffer_allocator(inner_traits::select_on_container_copy_construction(inner()));
+    }
+
+    T *buffer() noexcept { return reinterpret_cast<T *>(storage_); }
+    const T *buffer() const noexcept { return reinterpret_cast<const T *>(storage_); }
+
+    inner_type &inner() noexcept { return *this; }
+    const inner_type &inner() const noexcept { return *this; }
+
+private:
+    T *M_reallocate(T *p, size_type old_n, size_type new_n, std::true_type);
+    T *M_reallocate(T *p, size_type old_n, size_type new_n, std::false_type);
+
+    alignas(T) unsigned char storage_[N * sizeof(T)];
+};
+
+template <typename T, size_t N, typename Alloc>
+void small_buffer_allocator<T, N, Alloc>::deallocate(T *p, size_type n) noexcept {
+    if (p != buffer()) {
+        inner_traits::deallocate(inner(), p, n);
+    }
+}
+
+template <typename T, size_t N, typename Alloc>
+T *small_buffer_allocator<T, N, Alloc>::reallocate(T *p, size_type old_n, size_type new_n) {
+    if (p != buffer()) {
+        return M_reallocate(p, old_n, new_n, allocator_has_reallocate<inner_type>());
+    }
+    auto new_p = allocate(new_n);
+    std::memcpy(static_cast<void *>(new_p), static_cast<const void *>(p), (old_n < new_n ? old_n : new_n) * sizeof(T));
+    return new_p;
+}
+
+//堆上的内存块交给内层分配器原地调整。
+template <typename T, size_t N, typename Alloc>
+T *small_buffer_allocator<T, N, Alloc>::M_reallocate(T *p, size_type old_n, size_type new_n, std::true_type) {
+    return inner().reallocate(p, old_n, new_n);
+}
+
+template <typename T, size_t N, typename Alloc>
+T *small_buffer_allocator<T, N, Alloc>::M_reallocate(T *p, size_type old_n, size_type new_n, std::false_type) {
+    auto new_p = allocate(new_n);
+    std::memcpy(static_cast<void *>(new_p), static_cast<const void *>(p), (old_n < new_n ? old_n : new_n) * sizeof(T));
+    deallocate(p, old_n);
+    return new_p;
+}
+
+template <typename T, size_t N, typename Alloc>
+bool operator==(const small_buffer_allocator<T, N, Alloc> &lhs, const small_buffer_allocator<T, N, Alloc> &rhs) noexcept {
+    return &lhs == &rhs;
+}
+
+template <typename T, size_t N, typename Alloc>
+bool operator!=(const small_buffer_allocator<T, N, Alloc> &lhs, const small_buffer_allocator<T, N, Alloc> &rhs) noexcept {
+    return &lhs != &rhs;
+}
+
+template <typename T, size_t N, typename Alloc>
+struct is_default_construct_allocator<small_buffer_allocator<T, N, Alloc>> : is_default_construct_allocator<Alloc> {};
+
+///带内联存储的 vector 。不超过 N 个元素时存放在对象内部的缓冲区中，不申请堆内存；超出时按 Growth 转移到堆上。
+///接口与迭代器类型同 vector 。移动时若元素在堆上则直接接管内存；若在缓冲区中则逐个搬迁，可平凡重定位的元素只做一次 memcpy ，
+///两种情况都不申请内存。与 vector 不同，移动与交换之后指向内联元素的迭代器失效。
+template <typename T, size_t N, typename Alloc, typename Growth>
+class small_vector : vector<T, small_buffer_allocator<T, N, Alloc>, Growth> {
+    using Base = vector<T, small_buffer_allocator<T, N, Alloc>, Growth>;
+    using buffer_allocator = small_buffer_allocator<T, N, Alloc>;
+
+public:
+    using self = small_vector;
+    using typename Base::value_type;
+    using typename Base::pointer;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::size_type;
+    using typename Base::difference_type;
+    using allocator_type = Alloc;
+    using growth_policy = Growth;
+
+    static constexpr size_type inline_capacity = N; //内联缓冲区可容纳的元素数。
+
+protected:
+    using Base::M_impl;
+    using Base::M_deallocate;
+    using Base::M_get_allocator;
+
+public:
+    //构造函数
+    small_vector() : small_vector(Alloc()) {}                                                    //构造空容器，元素存放在内联缓冲区中。
+    explicit small_vector(const Alloc &alloc) : Base(buffer_allocator(alloc)) { M_reset_inline(); } //构造使用 alloc 的空容器。
+    small_vector(size_type count, const T &value, const Alloc &alloc = Alloc());                 //构造拥有 count 个有值 value 的元素的容器。
+    explicit small_vector(size_type count, const Alloc &alloc = Alloc());                        //构造拥有 count 个默认插入的 T 实例的容器。
+    small_vector(size_type count, default_init_t, const Alloc &alloc = Alloc());                 //构造拥有 count 个默认初始化元素的容器。
+    template <typename InputIt, typename = RequireInputIter<InputIt>>                            //
+    small_vector(InputIt first, InputIt last, const Alloc &alloc = Alloc());                     //构造拥有范围 [first, last) 内容的容器。
+    small_vector(const small_vector &other);                                                     //复制构造函数。不超过 N 个元素时副本同样存放在内联缓冲区中。
+    small_vector(small_vector &&other) noexcept(nothrow_relocatable);                            //移动构造函数。不申请内存，移动后 other 为空。
+    small_vector(std::initializer_list<T> init, const Alloc &alloc = Alloc());                   //构造拥有 initializer_list init 内容的容器。
+
+    //赋值运算符重载
+    small_vector &operator=(const small_vector &other);                        //复制赋值运算符。
+    small_vector &operator=(small_vector &&other) noexcept(nothrow_move_assignable); //移动赋值运算符。赋值后 other 为空。分配器不相等且 other 在堆上时需要扩容，可能抛出异常。
+    small_vector &operator=(std::initializer_list<T> ilist);                   //以 initializer_list ilist 所标识者替换内容。
+
+    allocator_type get_allocator() const noexcept { return allocator_type(M_get_allocator().inner()); } //返回内层分配器的副本。
+
+    using Base::assign;
+
+    //元素访问
+    using Base::at;
+    using Base::operator[];
+    using Base::front;
+    using Base::back;
+    using Base::data;
+
+    //迭代器
+    using Base::begin;
+    using Base::cbegin;
+    using Base::end;
+    using Base::cend;
+    using Base::rbegin;
+    using Base::crbegin;
+    using Base::rend;
+    using Base::crend;
+
+    //容量
+    using Base::empty;
+    using Base::size;
+    using Base::max_size;
+    using Base::reserve;
+    using Base::capacity;
+    void shrink_to_fit();                            //请求移除未使用的容量。元素不超过 N 个时搬回内联缓冲区。
+    bool is_inline() const noexcept;                 //元素是否存放在内联缓冲区中。
+
+    //修改器
+    using Base::clear;
+    using Base::insert;
+    using Base::emplace;
+    using Base::erase;
+    using Base::push_back;
+    using Base::emplace_back;
+    using Base::pop_back;
+    using Base::resize;
+    using Base::resize_uninitialized;
+
+    void swap(small_vector &other) noexcept(nothrow_relocatable); //交换内容。两边都在堆上时只交换指针，否则逐个搬迁内联元素，不申请内存。
+
+private:
+    static constexpr bool nothrow_relocatable = is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value;
+    ///移动赋值不保留对方的分配器，分配器可能不相等时要在本容器的分配器上扩容。
+    static constexpr bool nothrow_move_assignable = nothrow_relocatable && std::allocator_traits<Alloc>::is_always_equal::value;
+
+    ///令容器指向空的内联缓冲区，不析构元素也不释放内存。
+    void M_reset_inline() noexcept;
+    ///释放堆内存并回到内联缓冲区。调用者保证容器为空。
+    void M_release_heap() noexcept;
+    ///以 other 的元素替换内容，other 变为空：other 在堆上时接管其内存，否则把元素搬迁到 *this 的存储中。
+    void M_take(small_vector &other);
+};
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+small_vector<T, N, Alloc, Growth>::small_vector(size_type count, const T &value, const Alloc &alloc) : small_vector(alloc) {
+    this->assign(count, value);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+small_vector<T, N, Alloc, Growth>::small_vector(size_type count, const Alloc &alloc) : small_vector(alloc) {
+    this->resize(count);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+small_vector<T, N, Alloc, Growth>::small_vector(size_type count, default_init_t, const Alloc &alloc) : small_vector(alloc) {
+    this->resize(count, default_init);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+template <typename InputIt, typename>
+small_vector<T, N, Alloc, Growth>::small_vector(InputIt first, InputIt last, const Alloc &alloc) : small_vector(alloc) {
+    this->assign(first, last);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+small_vector<T, N, Alloc, Growth>::small_vector(const small_vector &other)
+    : small_vector(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.get_allocator())) {
+    this->assign(other.begin(), other.end());
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+small_vector<T, N, Alloc, Growth>::small_vector(small_vector &&other) noexcept(nothrow_relocatable) : small_vector(other.get_allocator()) {
+    M_take(other);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+small_vector<T, N, Alloc, Growth>::small_vector(std::initializer_list<T> init, const Alloc &alloc) : small_vector(alloc) {
+    this->assign(init);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+small_vector<T, N, Alloc, Growth> &small_vector<T, N, Alloc, Growth>::operator=(const small_vector &other) {
+    Base::operator=(other);
+    return *this;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+small_vector<T, N, Alloc, Growth> &small_vector<T, N, Alloc, Growth>::operator=(small_vector &&other) noexcept(nothrow_move_assignable) {
+    if (this != &other) {
+        M_take(other);
+    }
+    return *this;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+small_vector<T, N, Alloc, Growth> &small_vector<T, N, Alloc, Growth>::operator=(std::initializer_list<T> ilist) {
+    Base::operator=(ilist);
+    return *this;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+bool small_vector<T, N, Alloc, Growth>::is_inline() const noexcept {
+    return M_impl.M_start == M_get_allocator().buffer();
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void small_vector<T, N, Alloc, Growth>::M_reset_inline() noexcept {
+    auto buffer = M_get_allocator().buffer();
+    M_impl.M_start = M_impl.M_finish = buffer;
+    M_impl.M_end_of_storage = buffer + N;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void small_vector<T, N, Alloc, Growth>::M_release_heap() noexcept {
+    if (!is_inline()) {
+        M_deallocate(M_impl.M_start, capacity());
+        M_reset_inline();
+    }
+}
+
+//内层分配器不相等时 other 的堆内存不能由 *this 释放，此时同样逐个搬迁，必要时先扩容。
+template <typename T, size_t N, typename Alloc, typename Growth>
+void small_vector<T, N, Alloc, Growth>::M_take(small_vector &other) {
+    this->clear();
+    if (!other.is_inline() && get_allocator() == other.get_allocator()) {
+        M_release_heap();
+        M_impl.M_swap_data(other.M_impl);
+        other.M_reset_inline();
+        return;
+    }
+    this->reserve(other.size());
+    M_impl.M_finish = uninitialized_relocate(other.M_impl.M_start, other.M_impl.M_finish, M_impl.M_start);
+    other.M_impl.M_finish = other.M_impl.M_start;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void small_vector<T, N, Alloc, Growth>::shrink_to_fit() {
+    if (is_inline()) {
+        return;
+    }
+    auto size = this->size();
+    if (size > N) {
+        Base::shrink_to_fit();
+        return;
+    }
+    auto old_start = M_impl.M_start, old_finish = M_impl.M_finish;
+    auto old_capacity = capacity();
+    auto buffer = M_get_allocator().buffer();
+    uninitialized_relocate(old_start, old_finish, buffer);
+    M_deallocate(old_start, old_capacity);
+    M_reset_inline();
+    M_impl.M_finish = buffer + size;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void small_vector<T, N, Alloc, Growth>::swap(small_vector &other) noexcept(nothrow_relocatable) {
+    if (this == &other) {
+        return;
+    }
+    if (!is_inline() && !other.is_inline() && get_allocator() == other.get_allocator()) {
+        M_impl.M_swap_data(other.M_impl);
+        return;
+    }
+    small_vector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+bool operator==(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs) {
+    return (lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+bool operator!=(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+bool operator<(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+bool operator<=(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+bool operator>(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+bool operator>=(const small_vector<T, N, Alloc, Growth> &lhs, const small_vector<T, N, Alloc, Growth> &rhs) {
+    return !(lhs < rhs);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+void swap(small_vector<T, N, Alloc, Growth> &lhs, small_vector<T, N, Alloc, Growth> &rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+} // namespace mystl
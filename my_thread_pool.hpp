@@ -0,0 +1,247 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "my_node_pool.hpp"
+
+namespace mystl {
+///工作窃取线程池。每个工作线程有自己的任务队列：自己从队尾取任务（后进先出，刚拆出的任务数据还在缓存中），
+///自己的队列空了就从其他队列的队首窃取（先进先出，偷到的是最早拆出的任务）。
+///任务是 (函数, 上下文, 下标) 三元组，不做类型擦除，不为每个任务单独申请内存；任务队列是 std::deque ，只在按块增长时申请。提交任务的线程在等待期间也执行任务，任务内部再次提交不会死锁。
+class thread_pool {
+public:
+    explicit thread_pool(size_t workers = default_workers());
+    thread_pool(const thread_pool &) = delete;
+    ~thread_pool();
+
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    ///对 [0, count) 中的每个 i 并行调用 fn(context, i) ，全部完成后返回。
+    ///某个任务抛出异常时其余任务照常执行，全部结束后重新抛出第一个异常。
+    void run(size_t count, void (*fn)(void *, size_t), void *context);
+    template <typename F>
+    void run(size_t count, F &&f); //对 [0, count) 中的每个 i 并行调用 f(i) 。
+
+    size_t concurrency() const noexcept { return worker_count_ + 1; } //参与执行任务的线程数，含提交任务的线程。
+
+    static thread_pool &instance();           //进程内共享的线程池。
+    static size_t default_workers() noexcept; //硬件线程数减一，提交任务的线程补上最后一个。
+
+private:
+    ///一次 run 提交的一批任务，放在提交线程的栈上，全部任务结束前 run 不返回。
+    struct batch {
+        void (*fn)(void *, size_t);
+        void *context;
+        std::atomic<size_t> remaining;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+    struct task {
+        batch *owner;
+        size_t index;
+    };
+    ///每个队列独占缓存行，相邻线程的加锁不互相干扰。
+    struct alignas(cache_line_size) task_queue {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    static constexpr size_t no_queue = static_cast<size_t>(-1);
+
+    size_t worker_count_;
+    std::unique_ptr<task_queue[]> queues_; //工作线程 i 的队列是 queues_[i] ，外部线程提交的任务轮流放入各队列。
+    std::unique_ptr<std::thread[]> workers_;
+    std::atomic<std::ptrdiff_t> queued_{0}; //所有队列中的任务数，入队前先加，空闲线程据此决定是否睡眠。
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    bool stop_ = false;
+
+    //当前线程所属的线程池与它的队列下标，外部线程为 nullptr 与 no_queue 。
+    static inline thread_local thread_pool *current_pool_ = nullptr;
+    static inline thread_local size_t current_queue_ = no_queue;
+
+    void M_worker_loop(size_t self);
+    ///先取自己队列的队尾，再从其他队列的队首窃取。
+    bool M_pop(size_t self, task &t);
+    static void M_execute(const task &t) noexcept;
+    ///逐个执行时的异常处理与并行时一致。
+    static void M_run_serial(size_t count, void (*fn)(void *, size_t), void *context);
+};
+
+inline thread_pool::thread_pool(size_t workers) : worker_count_(workers) {
+    if (!worker_count_) {
+        return;
+    }
+    queues_.reset(new task_queue[worker_count_]);
+    workers_.reset(new std::thread[worker_count_]);
+    for (size_t i = 0; i < worker_count_; ++i) {
+        try {
+            workers_[i] = std::thread(&thread_pool::M_worker_loop, this, i);
+        } catch (...) {
+            //析构函数不会执行，在此停掉已启动的线程。
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                stop_ = true;
+            }
+            sleep_cv_.notify_all();
+            for (size_t j = 0; j < i; ++j) {
+                workers_[j].join();
+            }
+            throw;
+        }
+    }
+}
+
+inline thread_pool::~thread_pool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (size_t i = 0; i < worker_count_; ++i) {
+        workers_[i].join();
+    }
+}
+
+inline thread_pool &thread_pool::instance() {
+    static thread_pool pool;
+    return pool;
+}
+
+inline size_t thread_pool::default_workers() noexcept {
+    auto n = std::thread::hardware_concurrency();
+    return n > 1 ? n - 1 : 0;
+}
+
+template <typename F>
+void thread_pool::run(size_t count, F &&f) {
+    using fn_type = typename std::remove_reference<F>::type;
+    run(
+        count, [](void *context, size_t i) { (*static_cast<fn_type *>(context))(i); }, const_cast<void *>(static_cast<const void *>(std::addressof(f))));
+}
+
+//提交线程是本池的工作线程时任务全部放入它自己的队列，由空闲线程窃取；外部线程没有队列，任务轮流放入各队列。
+inline void thread_pool::run(size_t count, void (*fn)(void *, size_t), void *context) {
+    if (count <= 1 || !worker_count_) {
+        M_run_serial(count, fn, context);
+        return;
+    }
+    batch b;
+    b.fn = fn;
+    b.context = context;
+    b.remaining.store(count, std::memory_order_relaxed);
+    auto self = current_pool_ == this ? current_queue_ : no_queue;
+    queued_.fetch_add(static_cast<std::ptrdiff_t>(count), std::memory_order_release);
+    if (self != no_queue) {
+        std::lock_guard<std::mutex> lock(queues_[self].mutex);
+        for (size_t i = 0; i < count; ++i) {
+            queues_[self].tasks.push_back(task{&b, i});
+        }
+    } else {
+        for (size_t q = 0; q < worker_count_ && q < count; ++q) {
+            std::lock_guard<std::mutex> lock(queues_[q].mutex);
+            for (size_t i = q; i < count; i += worker_count_) {
+                queues_[q].tasks.push_back(task{&b, i});
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    sleep_cv_.notify_all();
+    //等待期间执行任意任务，可能是别的批次的，这样嵌套提交时不会有线程干等。
+    while (b.remaining.load(std::memory_order_acquire)) {
+        task t;
+        if (M_pop(self, t)) {
+            M_execute(t);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    if (b.error) {
+        std::rethrow_exception(b.error);
+    }
+}
+
+inline void thread_pool::M_run_serial(size_t count, void (*fn)(void *, size_t), void *context) {
+    std::exception_ptr error;
+    for (size_t i = 0; i < count; ++i) {
+        try {
+            fn(context, i);
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+inline void thread_pool::M_worker_loop(size_t self) {
+    current_pool_ = this;
+    current_queue_ = self;
+    for (;;) {
+        task t;
+        if (M_pop(self, t)) {
+            M_execute(t);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cv_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_acquire) > 0; });
+        if (stop_ && queued_.load(std::memory_order_acquire) <= 0) {
+            return;
+        }
+    }
+}
+
+inline bool thread_pool::M_pop(size_t self, task &t) {
+    if (queued_.load(std::memory_order_acquire) <= 0) {
+        return false;
+    }
+    if (self != no_queue) {
+        auto &q = queues_[self];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty()) {
+            t = q.tasks.back();
+            q.tasks.pop_back();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    auto start = self == no_queue ? 0 : self + 1;
+    for (size_t k = 0; k < worker_count_; ++k) {
+        auto &q = queues_[(start + k) % worker_count_];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty()) {
+            t = q.tasks.front();
+            q.tasks.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void thread_pool::M_execute(const task &t) noexcept {
+    auto b = t.owner;
+    try {
+        b->fn(b->context, t.index);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(b->error_mutex);
+        if (!b->error) {
+            b->error = std::current_exception();
+        }
+    }
+    b->remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+} // namespace mystl
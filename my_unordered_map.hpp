@@ -0,0 +1,109 @@
+#pragma once
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "my_hash_table.hpp"
+#include "my_memory_resource.hpp"
+#include "my_utility.hpp"
+
+namespace mystl {
+///开放寻址哈希映射。元素连续存放，按插入顺序遍历；迭代器失效规则与 std::unordered_map 不同，见 hash_table 。
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+          typename Alloc = allocator<std::pair<const Key, T>>>
+class unordered_map : public hash_table<std::pair<const Key, T>, Key, select_first, Hash, KeyEqual, Alloc> {
+    using base = hash_table<std::pair<const Key, T>, Key, select_first, Hash, KeyEqual, Alloc>;
+
+public:
+    using mapped_type = T;
+    using typename base::const_iterator;
+    using typename base::iterator;
+    using typename base::key_type;
+    using typename base::size_type;
+    using typename base::value_type;
+
+    using base::base;
+    using base::operator=;
+    unordered_map() = default;
+
+    //元素访问
+    T &at(const key_type &key);             //返回键为 key 的元素的值，不存在时抛出 std::out_of_range 。
+    const T &at(const key_type &key) const; //返回键为 key 的元素的值，不存在时抛出 std::out_of_range 。
+    T &operator[](const key_type &key) { return try_emplace(key).first->second; }
+    T &operator[](key_type &&key) { return try_emplace(std::move(key)).first->second; }
+
+    //修改器
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) { //键不存在时才以 args 构造值，存在时不移动实参。
+        return this->M_emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+        return this->M_emplace_key(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                   std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    template <typename... Args>
+    iterator try_emplace(const_iterator, const key_type &key, Args &&...args) {
+        return try_emplace(key, std::forward<Args>(args)...).first;
+    }
+    template <typename... Args>
+    iterator try_emplace(const_iterator, key_type &&key, Args &&...args) {
+        return try_emplace(std::move(key), std::forward<Args>(args)...).first;
+    }
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj); //键存在时赋值，否则插入。
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(key_type &&key, M &&obj);
+};
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+T &unordered_map<Key, T, Hash, KeyEqual, Alloc>::at(const key_type &key) {
+    auto it = this->find(key);
+    if (it == this->end()) {
+        throw std::out_of_range("unordered_map::at");
+    }
+    return it->second;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+const T &unordered_map<Key, T, Hash, KeyEqual, Alloc>::at(const key_type &key) const {
+    auto it = this->find(key);
+    if (it == this->end()) {
+        throw std::out_of_range("unordered_map::at");
+    }
+    return it->second;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+template <typename M>
+std::pair<typename unordered_map<Key, T, Hash, KeyEqual, Alloc>::iterator, bool>
+unordered_map<Key, T, Hash, KeyEqual, Alloc>::insert_or_assign(const key_type &key, M &&obj) {
+    auto result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) {
+        result.first->second = std::forward<M>(obj);
+    }
+    return result;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+template <typename M>
+std::pair<typename unordered_map<Key, T, Hash, KeyEqual, Alloc>::iterator, bool>
+unordered_map<Key, T, Hash, KeyEqual, Alloc>::insert_or_assign(key_type &&key, M &&obj) {
+    auto result = try_emplace(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+        result.first->second = std::forward<M>(obj);
+    }
+    return result;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+void swap(unordered_map<Key, T, Hash, KeyEqual, Alloc> &lhs, unordered_map<Key, T, Hash, KeyEqual, Alloc> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using unordered_map = mystl::unordered_map<Key, T, Hash, KeyEqual, polymorphic_allocator<std::pair<const Key, T>>>;
+} // namespace pmr
+} // namespace mystl
@@ -0,0 +1,29 @@
+#pragma once
+#include <functional>
+
+#include "my_hash_table.hpp"
+#include "my_memory_resource.hpp"
+#include "my_utility.hpp"
+
+namespace mystl {
+///开放寻址哈希集合。元素连续存放，按插入顺序遍历；迭代器失效规则与 std::unordered_set 不同，见 hash_table 。
+template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>, typename Alloc = allocator<Key>>
+class unordered_set : public hash_table<Key, Key, identity, Hash, KeyEqual, Alloc> {
+    using base = hash_table<Key, Key, identity, Hash, KeyEqual, Alloc>;
+
+public:
+    using base::base;
+    using base::operator=;
+    unordered_set() = default;
+};
+
+template <typename Key, typename Hash, typename KeyEqual, typename Alloc>
+void swap(unordered_set<Key, Hash, KeyEqual, Alloc> &lhs, unordered_set<Key, Hash, KeyEqual, Alloc> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using unordered_set = mystl::unordered_set<Key, Hash, KeyEqual, polymorphic_allocator<Key>>;
+} // namespace pmr
+} // namespace mystl
@@ -0,0 +1,853 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "my_memory.hpp"
+#include "my_node_pool.hpp"
+#include "my_vector.hpp"
+
+namespace mystl {
+template <typename T, size_t BlockBytes, typename Ref, typename Ptr>
+class unrolled_list_iterator;
+
+template <typename T, size_t BlockBytes = cache_line_size, typename Alloc = allocator<T>>
+class unrolled_list;
+
+///块头。空白块只有块头，没有元素区。
+struct unrolled_block_base {
+    unrolled_block_base *next = nullptr;
+    unrolled_block_base *prev = nullptr;
+    uint32_t count = 0; //块中的元素数
+};
+
+///每块可容纳的元素数：块头与元素区合计不超过 BlockBytes ，至少为 1 。
+template <typename T, size_t BlockBytes>
+struct unrolled_block_capacity {
+    static constexpr size_t header = (sizeof(unrolled_block_base) + alignof(T) - 1) / alignof(T) * alignof(T);
+    static constexpr size_t value = BlockBytes >= header + sizeof(T) ? (BlockBytes - header) / sizeof(T) : 1;
+};
+
+///块的对齐：BlockBytes 是缓存行大小的整数倍时按缓存行对齐，每块恰好占满整数个缓存行；否则取块头与元素的自然对齐。
+template <typename T, size_t BlockBytes>
+struct unrolled_block_align {
+    static constexpr size_t natural = alignof(T) > alignof(unrolled_block_base) ? alignof(T) : alignof(unrolled_block_base);
+    static constexpr size_t value = BlockBytes % cache_line_size == 0 && natural < cache_line_size ? cache_line_size : natural;
+};
+
+///元素块。元素放在匿名联合中，由容器逐个构造与析构，只有 [0, count) 中的元素是存活的。
+template <typename T, size_t BlockBytes>
+struct alignas(unrolled_block_align<T, BlockBytes>::value) unrolled_block final : unrolled_block_base {
+    static constexpr size_t capacity = unrolled_block_capacity<T, BlockBytes>::value;
+
+    union {
+        T elements[capacity];
+    };
+
+    unrolled_block() noexcept {}
+    ~unrolled_block() {}
+};
+
+//迭代器保存块指针与块内下标。指向某块末尾之后的位置总是规范化为下一块的 0 号位置， end() 为 (空白块, 0) 。
+template <typename T, size_t BlockBytes, typename Ref, typename Ptr>
+class unrolled_list_iterator {
+public:
+    using self = unrolled_list_iterator<T, BlockBytes, Ref, Ptr>;
+    using iterator = unrolled_list_iterator<T, BlockBytes, T &, T *>;
+    using const_iterator = unrolled_list_iterator<T, BlockBytes, const T &, const T *>;
+    using value_type = T;
+    using pointer = Ptr;
+    using reference = Ref;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using block = unrolled_block<T, BlockBytes>;
+
+    template <typename, size_t, typename>
+    friend class unrolled_list;
+    template <typename, size_t, typename, typename>
+    friend class unrolled_list_iterator;
+
+protected:
+    unrolled_block_base *current_block = nullptr;
+    size_t index = 0;
+
+public:
+    unrolled_list_iterator() = default;
+    unrolled_list_iterator(unrolled_block_base *_block, size_t _index) noexcept : current_block(_block), index(_index) {}
+    ///iterator 可隐式转换为 const_iterator 。
+    template <typename Iter, typename = typename std::enable_if<std::is_same<Iter, iterator>::value && !std::is_same<Iter, self>::value>::type>
+    unrolled_list_iterator(const Iter &other) noexcept : current_block(other.current_block), index(other.index) {}
+
+    friend bool operator==(const self &lhs, const self &rhs) noexcept { return lhs.current_block == rhs.current_block && lhs.index == rhs.index; }
+    friend bool operator!=(const self &lhs, const self &rhs) noexcept { return !(lhs == rhs); }
+
+    reference operator*() const noexcept { return static_cast<block *>(current_block)->elements[index]; }
+    pointer operator->() const noexcept { return &static_cast<block *>(current_block)->elements[index]; }
+
+    self &operator++() noexcept {
+        if (++index == current_block->count) {
+            current_block = current_block->next;
+            index = 0;
+        }
+        return *this;
+    }
+
+    self operator++(int) noexcept {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    self &operator--() noexcept {
+        if (index == 0) {
+            current_block = current_block->prev;
+            index = current_block->count;
+        }
+        --index;
+        return *this;
+    }
+
+    self operator--(int) noexcept {
+        auto temp = *this;
+        --*this;
+        return temp;
+    }
+};
+
+///展开链表：每个结点是一块约 BlockBytes 字节的连续内存，存放多个元素，块之间双向链接。
+///相比 list 每个元素少两个指针，遍历时一次缓存行读入多个元素，适合扫描远多于拼接的场景。
+///插入时块满则一分为二，删除后相邻两块合计不超过一块容量时合并，每块至少约半满。
+///迭代器失效规则弱于 list ：插入与删除会使同一块中位于其后的迭代器失效，分裂或合并时涉及的两块中的迭代器全部失效；
+///push_back 不使任何迭代器失效。整表 splice 只改动块指针，other 的迭代器继续有效并改为指向本容器；
+///但 pos 不在块首时要先在 pos 处把块一分为二，该块中 pos 及其后的迭代器失效。元素需要能够无异常地搬迁。
+template <typename T, size_t BlockBytes, typename Alloc>
+class unrolled_list {
+    using block_base = unrolled_block_base;
+    using block = unrolled_block<T, BlockBytes>;
+    using block_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<block>;
+    using block_alloc_traits = std::allocator_traits<block_alloc_type>;
+    using T_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    using T_alloc_traits = std::allocator_traits<T_alloc_type>;
+
+    static_assert(is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value,
+                  "unrolled_list requires elements that can be relocated without throwing");
+
+public:
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using value_type = T;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using iterator = unrolled_list_iterator<T, BlockBytes, T &, T *>;
+    using const_iterator = unrolled_list_iterator<T, BlockBytes, const T &, const T *>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using allocator_type = Alloc;
+
+    static constexpr size_type block_capacity = block::capacity; //每块可容纳的元素数。
+
+    //构造函数
+    unrolled_list() : unrolled_list(Alloc()) {}                                            //构造空容器。
+    explicit unrolled_list(const Alloc &alloc) : M_impl(block_alloc_type(alloc)) { M_reset(); } //构造拥有给定分配器 alloc 的空容器。
+    unrolled_list(size_type count, const T &value, const Alloc &alloc = Alloc());        //构造拥有 count 个有值 value 的元素的容器。
+    explicit unrolled_list(size_type count, const Alloc &alloc = Alloc());               //构造拥有 count 个默认插入的 T 实例的容器。
+    template <typename InputIt, typename = RequireInputIter<InputIt>>                    //
+    unrolled_list(InputIt first, InputIt last, const Alloc &alloc = Alloc());            //构造拥有范围 [first, last) 内容的容器。
+    unrolled_list(const unrolled_list &other);                                           //复制构造函数。元素按块填满，不留空位。
+    unrolled_list(unrolled_list &&other) noexcept;                                       //移动构造函数。接管 other 的全部块。
+    unrolled_list(std::initializer_list<T> init, const Alloc &alloc = Alloc());          //构造拥有 initializer_list init 内容的容器。
+    ~unrolled_list() { clear(); }
+
+    unrolled_list &operator=(const unrolled_list &other); //复制赋值运算符。
+    unrolled_list &operator=(unrolled_list &&other) noexcept(block_alloc_traits::propagate_on_container_move_assignment::value || block_alloc_traits::is_always_equal::value); //移动赋值运算符。分配器随之转移或相等时接管 other 的全部块，否则逐个移动元素，可能抛出异常。
+    unrolled_list &operator=(std::initializer_list<T> ilist); //以 initializer_list ilist 所标识者替换内容。
+
+    allocator_type get_allocator() const noexcept { return allocator_type(M_impl); } //返回与容器关联的分配器。
+
+    void assign(size_type count, const T &value);                     //以 count 份 value 的副本替换内容。
+    template <typename InputIt, typename = RequireInputIter<InputIt>> //
+    void assign(InputIt first, InputIt last);                         //以范围 [first, last) 中元素的副本替换内容。
+    void assign(std::initializer_list<T> ilist);                      //以来自 initializer_list ilist 的元素替换内容。
+
+    //元素访问
+    reference front() { return *begin(); }
+    const_reference front() const { return *begin(); }
+    reference back() { return *--end(); }
+    const_reference back() const { return *--end(); }
+
+    //迭代器
+    iterator begin() noexcept { return iterator(M_impl.sentinel.next, 0); }
+    const_iterator begin() const noexcept { return const_iterator(const_cast<block_base *>(M_impl.sentinel.next), 0); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(&M_impl.sentinel, 0); }
+    const_iterator end() const noexcept { return const_iterator(const_cast<block_base *>(&M_impl.sentinel), 0); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    //容量
+    bool empty() const noexcept { return M_impl.size == 0; }
+    size_type size() const noexcept { return M_impl.size; }
+    size_type max_size() const noexcept { return block_alloc_traits::max_size(M_impl) * block_capacity; }
+    size_type block_count() const noexcept { return M_impl.blocks; } //当前占用的块数。
+
+    //修改器
+    void clear() noexcept; //移除全部元素并归还全部块。
+    iterator insert(const_iterator pos, const T &value);                  //在 pos 前插入 value 。
+    iterator insert(const_iterator pos, T &&value);                       //在 pos 前插入 value 。
+    iterator insert(const_iterator pos, size_type count, const T &value); //在 pos 前插入 count 个 value 的副本。
+    template <typename InputIt, typename = RequireInputIter<InputIt>>     //
+    iterator insert(const_iterator pos, InputIt first, InputIt last);     //在 pos 前插入来自范围 [first, last) 的元素。
+    iterator insert(const_iterator pos, std::initializer_list<T> ilist);  //在 pos 前插入来自 ilist 的元素。
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args); //直接于 pos 前构造元素。
+
+    iterator erase(const_iterator pos);                        //移除位于 pos 的元素。
+    iterator erase(const_iterator first, const_iterator last); //移除范围 [first, last) 中的元素。
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+    template <typename... Args>
+    reference emplace_back(Args &&...args); //添加新元素到容器尾。末块已满时另开新块，不搬动已有元素。
+    void pop_back() { erase(--cend()); }
+
+    void push_front(const T &value) { emplace_front(value); }
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+    template <typename... Args>
+    reference emplace_front(Args &&...args); //插入新元素到容器起始。
+    void pop_front() { erase(cbegin()); }
+
+    void resize(size_type count);                          //重设容器大小以容纳 count 个元素。
+    void resize(size_type count, const value_type &value); //重设容器大小以容纳 count 个元素。
+
+    void swap(unrolled_list &other) noexcept; //交换内容，不搬动任何元素。
+
+    //操作
+    void splice(const_iterator pos, unrolled_list &other);  //从 other 转移所有元素到 pos 前。 pos 不在块首时先在 pos 处把块一分为二，该块中 pos 及其后的迭代器失效，其余只改动块指针。
+    void splice(const_iterator pos, unrolled_list &&other); //同上。
+
+    void remove(const T &value);       //移除所有等于 value 的元素。
+    template <typename UnaryPredicate> //
+    void remove_if(UnaryPredicate p);  //移除所有谓词 p 对它返回 true 的元素。保留下来的元素在块内前移并逐块压紧，整体只扫描一遍。
+
+private:
+    ///内嵌类，保存空白块与计数。继承块分配器以便空分配器不占用空间。空白块嵌在容器中，移动与交换时需要修正首尾块对它的引用。
+    class impl : public block_alloc_type {
+    public:
+        block_base sentinel;
+        size_type size = 0;
+        size_type blocks = 0;
+
+        explicit impl(const block_alloc_type &alloc) noexcept : block_alloc_type(alloc) {}
+    };
+
+    impl M_impl;
+
+    static block *M_cast(block_base *b) noexcept { return static_cast<block *>(b); }
+    static T *M_at(block_base *b, size_t i) noexcept { return M_cast(b)->elements + i; }
+
+    ///令空白块首尾相接，容器为空。
+    void M_reset() noexcept;
+    ///接管 other 的块链，调用者保证 *this 为空。
+    void M_take(unrolled_list &other) noexcept;
+    ///分配器可以随之转移时，直接接管 other 的块链。
+    void M_move_assign(unrolled_list &other, std::true_type) noexcept;
+    ///分配器可能不相等时，分配器相等则接管块链，否则逐个移动元素。
+    void M_move_assign(unrolled_list &other, std::false_type);
+
+    ///申请一个空块并链接在 pos 之前。
+    block_base *M_new_block_before(block_base *pos);
+    ///从链中摘下空块并归还。
+    void M_free_block(block_base *b) noexcept;
+
+    template <typename... Args>
+    void M_construct(T *p, Args &&...args) {
+        T_alloc_type alloc(M_impl);
+        T_alloc_traits::construct(alloc, p, std::forward<Args>(args)...);
+    }
+    void M_destroy(T *p) noexcept {
+        T_alloc_type alloc(M_impl);
+        T_alloc_traits::destroy(alloc, p);
+    }
+    void M_destroy(T *first, T *last) noexcept {
+        T_alloc_type alloc(M_impl);
+        destroy_a(first, last, alloc);
+    }
+
+    ///把 [first, last) 搬迁到 dest ，两者可以重叠。
+    static void M_relocate(T *first, T *last, T *dest) noexcept;
+    static void M_relocate(T *first, T *last, T *dest, std::true_type) noexcept;
+    static void M_relocate(T *first, T *last, T *dest, std::false_type) noexcept;
+
+    ///把 b 中 [at, count) 的元素搬到紧随其后的新块中。
+    void M_split(block_base *b, size_t at);
+    ///把 (b, i) 规范化为迭代器：i 到达块尾时指向下一块首元素。
+    static iterator M_normalize(block_base *b, size_t i) noexcept { return i < b->count ? iterator(b, i) : iterator(b->next, 0); }
+    ///为在 pos 前插入一个元素腾出未初始化的空位，返回空位的位置。不构造元素。
+    iterator M_make_room(const_iterator pos);
+    ///M_make_room 的逆操作，空位中的元素构造失败时用于复原。
+    void M_close_room(iterator hole) noexcept;
+    ///从 pos 开始移除 count 个元素，返回被移除元素之后的位置。
+    iterator M_erase_n(const_iterator pos, size_type count) noexcept;
+    ///b 不足半满时与后继块合并。
+    void M_try_merge(block_base *b) noexcept;
+};
+
+template <typename T, size_t BlockBytes, typename Alloc>
+unrolled_list<T, BlockBytes, Alloc>::unrolled_list(size_type count, const T &value, const Alloc &alloc) : unrolled_list(alloc) {
+    insert(cend(), count, value);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+unrolled_list<T, BlockBytes, Alloc>::unrolled_list(size_type count, const Alloc &alloc) : unrolled_list(alloc) {
+    resize(count);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+template <typename InputIt, typename>
+unrolled_list<T, BlockBytes, Alloc>::unrolled_list(InputIt first, InputIt last, const Alloc &alloc) : unrolled_list(alloc) {
+    insert(cend(), first, last);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+unrolled_list<T, BlockBytes, Alloc>::unrolled_list(const unrolled_list &other)
+    : M_impl(block_alloc_traits::select_on_container_copy_construction(other.M_impl)) {
+    M_reset();
+    insert(cend(), other.cbegin(), other.cend());
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+unrolled_list<T, BlockBytes, Alloc>::unrolled_list(unrolled_list &&other) noexcept : M_impl(other.M_impl) {
+    M_reset();
+    M_take(other);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+unrolled_list<T, BlockBytes, Alloc>::unrolled_list(std::initializer_list<T> init, const Alloc &alloc) : unrolled_list(alloc) {
+    insert(cend(), init);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+unrolled_list<T, BlockBytes, Alloc> &unrolled_list<T, BlockBytes, Alloc>::operator=(const unrolled_list &other) {
+    if (this == &other) {
+        return *this;
+    }
+    auto &alloc = static_cast<block_alloc_type &>(M_impl);
+    const auto &other_alloc = static_cast<const block_alloc_type &>(other.M_impl);
+    if (block_alloc_traits::propagate_on_container_copy_assignment::value && alloc != other_alloc) {
+        //旧块只能由旧分配器释放，必须在替换分配器之前归还。
+        clear();
+    }
+    alloc_on_copy(alloc, other_alloc, typename block_alloc_traits::propagate_on_container_copy_assignment());
+    assign(other.cbegin(), other.cend());
+    return *this;
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+unrolled_list<T, BlockBytes, Alloc> &unrolled_list<T, BlockBytes, Alloc>::operator=(unrolled_list &&other) noexcept(block_alloc_traits::propagate_on_container_move_assignment::value || block_alloc_traits::is_always_equal::value) {
+    if (this == &other) {
+        return *this;
+    }
+    M_move_assign(other, std::integral_constant<bool, block_alloc_traits::propagate_on_container_move_assignment::value ||
+                                                          block_alloc_traits::is_always_equal::value>());
+    return *this;
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::M_move_assign(unrolled_list &other, std::true_type) noexcept {
+    clear();
+    M_take(other);
+    alloc_on_move(static_cast<block_alloc_type &>(M_impl), static_cast<block_alloc_type &>(other.M_impl),
+                  typename block_alloc_traits::propagate_on_container_move_assignment());
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::M_move_assign(unrolled_list &other, std::false_type) {
+    if (static_cast<block_alloc_type &>(M_impl) == static_cast<block_alloc_type &>(other.M_impl)) {
+        M_move_assign(other, std::true_type());
+        return;
+    }
+    clear();
+    for (auto &i : other) {
+        emplace_back(std::move(i));
+    }
+    other.clear();
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+unrolled_list<T, BlockBytes, Alloc> &unrolled_list<T, BlockBytes, Alloc>::operator=(std::initializer_list<T> ilist) {
+    assign(ilist);
+    return *this;
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::assign(size_type count, const T &value) {
+    clear();
+    insert(cend(), count, value);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+template <typename InputIt, typename>
+void unrolled_list<T, BlockBytes, Alloc>::assign(InputIt first, InputIt last) {
+    clear();
+    insert(cend(), first, last);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::assign(std::initializer_list<T> ilist) {
+    clear();
+    insert(cend(), ilist);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::M_reset() noexcept {
+    M_impl.sentinel.next = M_impl.sentinel.prev = &M_impl.sentinel;
+    M_impl.size = 0;
+    M_impl.blocks = 0;
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::M_take(unrolled_list &other) noexcept {
+    if (other.empty()) {
+        return;
+    }
+    auto &s = M_impl.sentinel;
+    s.next = other.M_impl.sentinel.next;
+    s.prev = other.M_impl.sentinel.prev;
+    s.next->prev = &s;
+    s.prev->next = &s;
+    M_impl.size = other.M_impl.size;
+    M_impl.blocks = other.M_impl.blocks;
+    other.M_reset();
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+typename unrolled_list<T, BlockBytes, Alloc>::block_base *unrolled_list<T, BlockBytes, Alloc>::M_new_block_before(block_base *pos) {
+    auto b = ::new (static_cast<void *>(block_alloc_traits::allocate(M_impl, 1))) block();
+    b->next = pos;
+    b->prev = pos->prev;
+    pos->prev->next = b;
+    pos->prev = b;
+    ++M_impl.blocks;
+    return b;
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::M_free_block(block_base *b) noexcept {
+    b->prev->next = b->next;
+    b->next->prev = b->prev;
+    auto p = M_cast(b);
+    p->~block();
+    block_alloc_traits::deallocate(M_impl, p, 1);
+    --M_impl.blocks;
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::clear() noexcept {
+    auto &s = M_impl.sentinel;
+    for (auto b = s.next; b != &s;) {
+        auto next = b->next;
+        M_destroy(M_at(b, 0), M_at(b, b->count));
+        b->count = 0;
+        M_free_block(b);
+        b = next;
+    }
+    M_impl.size = 0;
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::M_relocate(T *first, T *last, T *dest) noexcept {
+    M_relocate(first, last, dest, is_trivially_relocatable<T>());
+}
+
+//可平凡重定位类型整段 memmove 。
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::M_relocate(T *first, T *last, T *dest, std::true_type) noexcept {
+    if (first != last) {
+        std::memmove(static_cast<void *>(dest), static_cast<const void *>(first), (last - first) * sizeof(T));
+    }
+}
+
+//其他类型逐个移动构造并析构原对象。后移时从后往前，前移时从前往后。
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::M_relocate(T *first, T *last, T *dest, std::false_type) noexcept {
+    if (dest > first) {
+        auto dest_last = dest + (last - first);
+        while (last != first) {
+            ::new (static_cast<void *>(--dest_last)) T(std::move(*--last));
+            last->~T();
+        }
+    } else {
+        for (; first != last; ++first, ++dest) {
+            ::new (static_cast<void *>(dest)) T(std::move(*first));
+            first->~T();
+        }
+    }
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::M_split(block_base *b, size_t at) {
+    auto nb = M_new_block_before(b->next);
+    M_relocate(M_at(b, at), M_at(b, b->count), M_at(nb, 0));
+    nb->count = static_cast<uint32_t>(b->count - at);
+    b->count = static_cast<uint32_t>(at);
+}
+
+//pos 在块首且前一块有空位时直接放到前一块末尾；在表尾时末块有空位则追加，否则另开新块；
+//其余情况目标块满则从中间拆开，再在目标块内把 pos 之后的元素后移一位。
+template <typename T, size_t BlockBytes, typename Alloc>
+typename unrolled_list<T, BlockBytes, Alloc>::iterator unrolled_list<T, BlockBytes, Alloc>::M_make_room(const_iterator pos) {
+    auto b = pos.current_block;
+    size_t i = pos.index;
+    if (i == 0 && b->prev != &M_impl.sentinel && b->prev->count < block_capacity) {
+        b = b->prev;
+        i = b->count;
+    } else if (b == &M_impl.sentinel) {
+        b = M_new_block_before(b);
+    } else if (b->count == block_capacity) {
+        auto half = block_capacity / 2;
+        M_split(b, half);
+        if (i > half) {
+            b = b->next;
+            i -= half;
+        }
+    }
+    M_relocate(M_at(b, i), M_at(b, b->count), M_at(b, i + 1));
+    ++b->count;
+    return iterator(b, i);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::M_close_room(iterator hole) noexcept {
+    auto b = hole.current_block;
+    M_relocate(M_at(b, hole.index + 1), M_at(b, b->count), M_at(b, hole.index));
+    if (--b->count == 0) {
+        M_free_block(b);
+    }
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+typename unrolled_list<T, BlockBytes, Alloc>::iterator unrolled_list<T, BlockBytes, Alloc>::insert(const_iterator pos, const T &value) {
+    return emplace(pos, value);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+typename unrolled_list<T, BlockBytes, Alloc>::iterator unrolled_list<T, BlockBytes, Alloc>::insert(const_iterator pos, T &&value) {
+    return emplace(pos, std::move(value));
+}
+
+//逐个插入，每次都在上一个新元素之后；连续插入时新元素依次填满当前块，块满后才拆分。
+template <typename T, size_t BlockBytes, typename Alloc>
+typename unrolled_list<T, BlockBytes, Alloc>::iterator unrolled_list<T, BlockBytes, Alloc>::insert(const_iterator pos, size_type count, const T &value) {
+    if (count == 0) {
+        return iterator(pos.current_block, pos.index);
+    }
+    value_type copy(value);
+    auto next = emplace(pos, copy);
+    for (size_type i = 1; i < count; ++i) {
+        next = emplace(++next, copy);
+    }
+    //拆分可能搬走先插入的元素，从最后一个新元素倒数回去。
+    return std::prev(next, static_cast<difference_type>(count - 1));
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+template <typename InputIt, typename>
+typename unrolled_list<T, BlockBytes, Alloc>::iterator unrolled_list<T, BlockBytes, Alloc>::insert(const_iterator pos, InputIt first, InputIt last) {
+    if (first == last) {
+        return iterator(pos.current_block, pos.index);
+    }
+    auto next = emplace(pos, *first);
+    difference_type count = 0;
+    while (++first != last) {
+        next = emplace(++next, *first);
+        ++count;
+    }
+    return std::prev(next, count);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+typename unrolled_list<T, BlockBytes, Alloc>::iterator unrolled_list<T, BlockBytes, Alloc>::insert(const_iterator pos, std::initializer_list<T> ilist) {
+    return insert(pos, ilist.begin(), ilist.end());
+}
+
+//参数可能引用容器中的元素，腾出空位会搬动它们，因此先构造出新元素再移入空位。
+template <typename T, size_t BlockBytes, typename Alloc>
+template <typename... Args>
+typename unrolled_list<T, BlockBytes, Alloc>::iterator unrolled_list<T, BlockBytes, Alloc>::emplace(const_iterator pos, Args &&...args) {
+    value_type tmp(std::forward<Args>(args)...);
+    auto hole = M_make_room(pos);
+    try {
+        M_construct(&*hole, std::move(tmp));
+    } catch (...) {
+        M_close_room(hole);
+        throw;
+    }
+    ++M_impl.size;
+    return hole;
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+template <typename... Args>
+typename unrolled_list<T, BlockBytes, Alloc>::reference unrolled_list<T, BlockBytes, Alloc>::emplace_back(Args &&...args) {
+    auto b = M_impl.sentinel.prev;
+    auto fresh = b == &M_impl.sentinel || b->count == block_capacity;
+    if (fresh) {
+        b = M_new_block_before(&M_impl.sentinel);
+    }
+    try {
+        M_construct(M_at(b, b->count), std::forward<Args>(args)...);
+    } catch (...) {
+        if (fresh) {
+            M_free_block(b);
+        }
+        throw;
+    }
+    ++M_impl.size;
+    return *M_at(b, b->count++);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+template <typename... Args>
+typename unrolled_list<T, BlockBytes, Alloc>::reference unrolled_list<T, BlockBytes, Alloc>::emplace_front(Args &&...args) {
+    return *emplace(cbegin(), std::forward<Args>(args)...);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+typename unrolled_list<T, BlockBytes, Alloc>::iterator unrolled_list<T, BlockBytes, Alloc>::erase(const_iterator pos) {
+    return M_erase_n(pos, 1);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+typename unrolled_list<T, BlockBytes, Alloc>::iterator unrolled_list<T, BlockBytes, Alloc>::erase(const_iterator first, const_iterator last) {
+    return M_erase_n(first, static_cast<size_type>(std::distance(first, last)));
+}
+
+//按块处理：每块内一次析构、一次前移，块空了就归还。最后一块不足半满时尝试与后继块合并。
+template <typename T, size_t BlockBytes, typename Alloc>
+typename unrolled_list<T, BlockBytes, Alloc>::iterator unrolled_list<T, BlockBytes, Alloc>::M_erase_n(const_iterator pos, size_type count) noexcept {
+    auto b = pos.current_block;
+    size_t i = pos.index;
+    M_impl.size -= count;
+    while (count) {
+        auto n = std::min<size_type>(count, b->count - i);
+        M_destroy(M_at(b, i), M_at(b, i + n));
+        M_relocate(M_at(b, i + n), M_at(b, b->count), M_at(b, i));
+        b->count = static_cast<uint32_t>(b->count - n);
+        count -= n;
+        if (b->count == 0) {
+            auto next = b->next;
+            M_free_block(b);
+            b = next;
+            i = 0;
+        } else if (i == b->count) {
+            b = b->next;
+            i = 0;
+        }
+    }
+    if (b == &M_impl.sentinel) {
+        auto last = b->prev;
+        if (last != b && last->prev != b) {
+            M_try_merge(last->prev);
+        }
+        return end();
+    }
+    if (i == 0 && b->prev != &M_impl.sentinel) {
+        //被删区间止于块首，合并前一块时 b 的元素接在它后面。
+        auto prev = b->prev;
+        auto offset = prev->count;
+        M_try_merge(prev);
+        if (prev->next != b) {
+            return iterator(prev, offset);
+        }
+    } else {
+        M_try_merge(b);
+    }
+    return M_normalize(b, i);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::M_try_merge(block_base *b) noexcept {
+    auto next = b->next;
+    if (next == &M_impl.sentinel || b->count >= block_capacity / 2 || b->count + next->count > block_capacity) {
+        return;
+    }
+    M_relocate(M_at(next, 0), M_at(next, next->count), M_at(b, b->count));
+    b->count += next->count;
+    next->count = 0;
+    M_free_block(next);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::resize(size_type count) {
+    if (count < size()) {
+        auto iter = cbegin();
+        std::advance(iter, count);
+        erase(iter, cend());
+        return;
+    }
+    while (size() < count) {
+        emplace_back();
+    }
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::resize(size_type count, const value_type &value) {
+    if (count < size()) {
+        auto iter = cbegin();
+        std::advance(iter, count);
+        erase(iter, cend());
+        return;
+    }
+    while (size() < count) {
+        emplace_back(value);
+    }
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::swap(unrolled_list &other) noexcept {
+    if (this == &other) {
+        return;
+    }
+    unrolled_list tmp(std::move(other));
+    other.M_take(*this);
+    M_take(tmp);
+    alloc_on_swap(static_cast<block_alloc_type &>(M_impl), static_cast<block_alloc_type &>(other.M_impl),
+                  typename block_alloc_traits::propagate_on_container_swap());
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::splice(const_iterator pos, unrolled_list &other) {
+    if (other.empty() || this == &other) {
+        return;
+    }
+    auto b = pos.current_block;
+    if (pos.index != 0) {
+        M_split(b, pos.index);
+        b = b->next;
+    }
+    auto first = other.M_impl.sentinel.next;
+    auto last = other.M_impl.sentinel.prev;
+    first->prev = b->prev;
+    b->prev->next = first;
+    last->next = b;
+    b->prev = last;
+    M_impl.size += other.M_impl.size;
+    M_impl.blocks += other.M_impl.blocks;
+    other.M_reset();
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::splice(const_iterator pos, unrolled_list &&other) {
+    splice(pos, other);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void unrolled_list<T, BlockBytes, Alloc>::remove(const T &value) {
+    remove_if([&value](const T &x) { return x == value; });
+}
+
+//读写两个游标在块链上同步前进：保留的元素搬到写游标处，写满一块换下一块，扫描结束后归还写游标之后的块。
+//谓词抛出异常时，把当前块中未扫描的元素也搬到写游标处，之后的块原样保留。
+template <typename T, size_t BlockBytes, typename Alloc>
+template <typename UnaryPredicate>
+void unrolled_list<T, BlockBytes, Alloc>::remove_if(UnaryPredicate p) {
+    auto &s = M_impl.sentinel;
+    auto wb = s.next;
+    size_t wi = 0;
+    //写游标不会越过读游标，目标位置总是空的或就是 src 本身。
+    auto keep = [&](T *src) noexcept {
+        if (wi == block_capacity) {
+            wb->count = static_cast<uint32_t>(wi);
+            wb = wb->next;
+            wi = 0;
+        }
+        auto dst = M_at(wb, wi++);
+        if (dst != src) {
+            M_relocate(src, src + 1, dst);
+        }
+    };
+    auto rb = s.next;
+    size_t ri = 0;
+    try {
+        for (; rb != &s; rb = rb->next) {
+            for (ri = 0; ri < rb->count; ++ri) {
+                auto src = M_at(rb, ri);
+                if (p(*src)) {
+                    M_destroy(src);
+                    --M_impl.size;
+                } else {
+                    keep(src);
+                }
+            }
+        }
+    } catch (...) {
+        for (; ri < rb->count; ++ri) {
+            keep(M_at(rb, ri));
+        }
+        auto rest = rb->next;
+        wb->count = static_cast<uint32_t>(wi);
+        for (auto b = wb->next; b != rest;) {
+            auto next = b->next;
+            M_free_block(b);
+            b = next;
+        }
+        throw;
+    }
+    if (wi != 0) {
+        wb->count = static_cast<uint32_t>(wi);
+        wb = wb->next;
+    }
+    while (wb != &s) {
+        auto next = wb->next;
+        M_free_block(wb);
+        wb = next;
+    }
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+bool operator==(const unrolled_list<T, BlockBytes, Alloc> &lhs, const unrolled_list<T, BlockBytes, Alloc> &rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+bool operator!=(const unrolled_list<T, BlockBytes, Alloc> &lhs, const unrolled_list<T, BlockBytes, Alloc> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+bool operator<(const unrolled_list<T, BlockBytes, Alloc> &lhs, const unrolled_list<T, BlockBytes, Alloc> &rhs) {
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+bool operator<=(const unrolled_list<T, BlockBytes, Alloc> &lhs, const unrolled_list<T, BlockBytes, Alloc> &rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+bool operator>(const unrolled_list<T, BlockBytes, Alloc> &lhs, const unrolled_list<T, BlockBytes, Alloc> &rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+bool operator>=(const unrolled_list<T, BlockBytes, Alloc> &lhs, const unrolled_list<T, BlockBytes, Alloc> &rhs) {
+    return !(lhs < rhs);
+}
+
+template <typename T, size_t BlockBytes, typename Alloc>
+void swap(unrolled_list<T, BlockBytes, Alloc> &lhs, unrolled_list<T, BlockBytes, Alloc> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+} // namespace mystl
@@ -0,0 +1,46 @@
+#pragma once
+#include <type_traits>
+#include <utility>
+
+namespace mystl {
+///以实参的退化类型构造 std::pair ，与 std::make_pair 相同。关联容器以 std::pair 为元素类型，测试宏通过 mystl::make_pair 构造插入的元素。
+template <typename T1, typename T2>
+constexpr auto make_pair(T1 &&first, T2 &&second) -> decltype(std::make_pair(std::forward<T1>(first), std::forward<T2>(second))) {
+    return std::make_pair(std::forward<T1>(first), std::forward<T2>(second));
+}
+
+///从 pair 元素中取出键，用于 map 类容器。
+struct select_first {
+    template <typename Pair>
+    const typename Pair::first_type &operator()(const Pair &p) const noexcept {
+        return p.first;
+    }
+};
+
+///元素本身就是键，用于 set 类容器。
+struct identity {
+    template <typename T>
+    const T &operator()(const T &x) const noexcept {
+        return x;
+    }
+};
+
+///比较器声明了 is_transparent 时，有序容器的查找接受任何可与键比较的类型，不必先构造键。
+template <typename Compare, typename = void>
+struct is_transparent_compare : std::false_type {};
+
+template <typename Compare>
+struct is_transparent_compare<Compare, std::void_t<typename Compare::is_transparent>> : std::true_type {};
+
+///标记输入区间已按键升序排列且没有等价的键。有序容器据此逐个追加到末尾，不做查找。
+struct sorted_unique_t {
+    explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
+///标记输入区间已按键升序排列，可以有等价的键。
+struct sorted_equivalent_t {
+    explicit sorted_equivalent_t() = default;
+};
+inline constexpr sorted_equivalent_t sorted_equivalent{};
+} // namespace mystl
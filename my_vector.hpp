@@ -5,6 +5,11 @@
 #include <type_traits>
 #include <algorithm>
 
+#include "my_growth_policy.hpp"
+#include "my_memory.hpp"
+#include "my_memory_resource.hpp"
+#include "my_simd.hpp"
+
 namespace mystl {
 template <typename InIter>
 using RequireInputIter = typename std::enable_if<std::is_convertible<typename std::iterator_traits<InIter>::iterator_category, std::input_iterator_tag>::value>::type;
@@ -18,29 +23,29 @@ class vector_iterator;
 template <typename T>
 class vector_const_iterator;
 
-template <typename T>
+template <typename T, typename Alloc>
 class vector_base;
 
-template <typename T>
+template <typename T, typename Alloc = allocator<T>, typename Growth = double_growth>
 class vector;
 
-template <typename T>
-inline bool operator==(const vector<T> &lhs, const vector<T> &rhs);
-template <typename T>
-inline bool operator!=(const vector<T> &lhs, const vector<T> &rhs);
-template <typename T>
-inline bool operator<(const vector<T> &lhs, const vector<T> &rhs);
-template <typename T>
-inline bool operator<=(const vector<T> &lhs, const vector<T> &rhs);
-template <typename T>
-inline bool operator>(const vector<T> &lhs, const vector<T> &rhs);
-template <typename T>
-inline bool operator>=(const vector<T> &lhs, const vector<T> &rhs);
+template <typename T, typename Alloc, typename Growth>
+inline bool operator==(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs);
+template <typename T, typename Alloc, typename Growth>
+inline bool operator!=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs);
+template <typename T, typename Alloc, typename Growth>
+inline bool operator<(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs);
+template <typename T, typename Alloc, typename Growth>
+inline bool operator<=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs);
+template <typename T, typename Alloc, typename Growth>
+inline bool operator>(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs);
+template <typename T, typename Alloc, typename Growth>
+inline bool operator>=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs);
 
-template <typename T>
-void swap(vector<T> &lhs, vector<T> &rhs);
+template <typename T, typename Alloc, typename Growth>
+void swap(vector<T, Alloc, Growth> &lhs, vector<T, Alloc, Growth> &rhs);
 
-//迭代器基类
+//迭代器基类。只保存一个裸指针，不含虚函数，可平凡复制，大小与 T * 相同。
 template <typename T>
 class vector_iterator_base {
 public:
@@ -50,50 +55,33 @@ public:
     using const_reference = const T &;
     using difference_type = std::ptrdiff_t;
     using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus > 201703L
+    using iterator_concept = std::contiguous_iterator_tag;
+#endif
 
-    friend class vector<T>;
+    template <typename, typename, typename>
+    friend class vector;
 
 protected:
     T *current = nullptr;
 
 public:
     vector_iterator_base() = default;
-    vector_iterator_base(const self &other) : current(other.current) {}
-    vector_iterator_base(self &&other) noexcept : current(std::move(other.current)) {}
-    explicit vector_iterator_base(T *&ptr) : current(ptr) {}
-    explicit vector_iterator_base(T *&&ptr) : current(std::move(ptr)) {}
-
-    virtual ~vector_iterator_base() = default;
-
-    bool operator==(const self &other) const { return this->current == other.current; }
-    bool operator==(const self &&other) const { return this->current == other.current; }
-    template <typename iter>
-    bool operator!=(iter &&other) const {
-        return !operator==(std::forward<iter>(other));
-    }
+    explicit vector_iterator_base(T *ptr) noexcept : current(ptr) {}
+
+    friend bool operator==(const self &lhs, const self &rhs) noexcept { return lhs.current == rhs.current; }
+    friend bool operator!=(const self &lhs, const self &rhs) noexcept { return lhs.current != rhs.current; }
+    friend bool operator<(const self &lhs, const self &rhs) noexcept { return lhs.current < rhs.current; }
+    friend bool operator>(const self &lhs, const self &rhs) noexcept { return lhs.current > rhs.current; }
+    friend bool operator<=(const self &lhs, const self &rhs) noexcept { return lhs.current <= rhs.current; }
+    friend bool operator>=(const self &lhs, const self &rhs) noexcept { return lhs.current >= rhs.current; }
 
-    vector_iterator_base &operator=(const self &other);
-    vector_iterator_base &operator=(const self &&other) noexcept;
+    ///两迭代器之间的距离。
+    friend difference_type operator-(const self &lhs, const self &rhs) noexcept { return lhs.current - rhs.current; }
 
-    const_reference operator*() const { return *current; }
-    const_pointer operator->() const { return current; }
+    const_reference operator*() const noexcept { return *current; }
+    const_pointer operator->() const noexcept { return current; }
 };
-template <typename T>
-vector_iterator_base<T> &vector_iterator_base<T>::operator=(const vector_iterator_base::self &other) {
-    if (this == other) {
-        return *this;
-    }
-    this->current = other.current;
-    return *this;
-}
-template <typename T>
-vector_iterator_base<T> &vector_iterator_base<T>::operator=(const vector_iterator_base::self &&other) noexcept {
-    if (this == other) {
-        return *this;
-    }
-    this->current = std::move(other.current);
-    return *this;
-}
 
 //非常量迭代器类
 template <typename T>
@@ -112,82 +100,46 @@ public:
     using vector_iterator_base<T>::current;
 
     //派生类构造函数
-    vector_iterator() : base() {}
-    explicit vector_iterator(pointer &ptr) : base(ptr) {}
-    explicit vector_iterator(pointer &&ptr) : base(std::move(ptr)) {}
-    vector_iterator(const self &other) : base(other) {}
-    vector_iterator(self &&other) noexcept : base(std::move(other)) {}
-    vector_iterator(const vector_const_iterator<T> &other) : base(other) {}
-    vector_iterator(vector_const_iterator<T> &&other) : base(std::move(other)) {}
-
-    vector_iterator &operator=(const self &other) {
-        base::operator=(other);
-        return *this;
-    }
-    vector_iterator &operator=(const self &&other) noexcept {
-        base::operator=(std::move(other));
-        return *this;
-    }
-    vector_iterator &operator=(const vector_const_iterator<T> &other) {
-        base::operator=(other);
-        return *this;
-    }
-    vector_iterator &operator=(vector_const_iterator<T> &&other) {
-        base::operator=(std::move(other));
-        return *this;
-    }
+    vector_iterator() = default;
+    explicit vector_iterator(pointer ptr) noexcept : base(ptr) {}
+    vector_iterator(const vector_const_iterator<T> &other) noexcept : base(other) {}
 
-    reference operator*() { return *current; }
-    pointer operator->() { return current; }
+    reference operator*() const noexcept { return *current; }
+    pointer operator->() const noexcept { return current; }
 
-    self &operator++() {
+    self &operator++() noexcept {
         ++current;
         return *this;
     }
 
-    self operator++(int) {
+    self operator++(int) noexcept {
         auto temp = *this;
         ++current;
         return temp;
     }
 
-    self &operator--() {
+    self &operator--() noexcept {
         --current;
         return *this;
     }
 
-    self operator--(int) {
+    self operator--(int) noexcept {
         auto temp = *this;
         --current;
         return temp;
     }
 
-    reference &operator[](difference_type n) const noexcept { return current[n]; }
+    reference operator[](difference_type n) const noexcept { return current[n]; }
 
     self operator+(difference_type n) const noexcept { return self(current + n); }
+    friend self operator+(difference_type n, const self &it) noexcept { return self(it.current + n); }
 
     self &operator+=(difference_type n) noexcept {
         current += n;
         return *this;
     }
 
-    //减号运算符重载实现，整数版本。
-    template <typename tp>
-    self sub_impl(tp n, std::true_type) const noexcept {
-        return self(current - n);
-    }
-
-    //减号运算符重载实现，迭代器版本。
-    template <typename Iter>
-    difference_type sub_impl(Iter &&other, std::false_type) const noexcept {
-        return this->current - other.current;
-    }
-
-    //减号运算符重载分发。
-    template <typename tp>
-    decltype(auto) operator-(tp &&n) const noexcept {
-        return sub_impl(std::forward<tp>(n), std::is_integral<std::remove_reference_t<tp>>());
-    }
+    self operator-(difference_type n) const noexcept { return self(current - n); }
 
     self &operator-=(difference_type n) noexcept {
         current -= n;
@@ -209,85 +161,51 @@ public:
     using difference_type = std::ptrdiff_t;
     using iterator_category = std::random_access_iterator_tag;
 
-    friend vector<T>;
+    template <typename, typename, typename>
+    friend class vector;
 
     //派生类构造函数
-    vector_const_iterator() : base() {}
-    explicit vector_const_iterator(T *ptr) : base(ptr) {}
-    vector_const_iterator(const self &other) : base(other) {}
-    vector_const_iterator(self &&other) noexcept : base(std::move(other)) {}
-    vector_const_iterator(const vector_iterator<T> &other) : base(other) {}
-    vector_const_iterator(vector_iterator<T> &&other) noexcept : base(std::move(other)) {}
+    vector_const_iterator() = default;
+    explicit vector_const_iterator(T *ptr) noexcept : base(ptr) {}
+    vector_const_iterator(const vector_iterator<T> &other) noexcept : base(other) {}
 
 protected:
     using vector_iterator_base<T>::current;
 
 public:
-    vector_const_iterator &operator=(const self &other) {
-        base::operator=(other);
-        return *this;
-    }
-    vector_const_iterator &operator=(const self &&other) noexcept {
-        base::operator=(std::move(other));
-        return *this;
-    }
-    vector_const_iterator &operator=(const vector_iterator<T> &other) {
-        base::operator=(other);
-        return *this;
-    }
-    vector_const_iterator &operator=(vector_iterator<T> &&other) {
-        base::operator=(std::move(other));
-        return *this;
-    }
-
-    self &operator++() {
+    self &operator++() noexcept {
         ++current;
         return *this;
     }
 
-    self operator++(int) {
+    self operator++(int) noexcept {
         auto temp = *this;
         ++current;
         return temp;
     }
 
-    self &operator--() {
+    self &operator--() noexcept {
         --current;
         return *this;
     }
 
-    self operator--(int) {
+    self operator--(int) noexcept {
         auto temp = *this;
         --current;
         return temp;
     }
 
-    reference &operator[](difference_type n) const noexcept { return current[n]; }
+    reference operator[](difference_type n) const noexcept { return current[n]; }
 
     self operator+(difference_type n) const noexcept { return self(current + n); }
+    friend self operator+(difference_type n, const self &it) noexcept { return self(it.current + n); }
 
     self &operator+=(difference_type n) noexcept {
         current += n;
         return *this;
     }
 
-    ///减号运算符重载实现，整数版本。
-    template <typename tp>
-    self sub_impl(tp n, std::true_type) const noexcept {
-        return self(current - n);
-    }
-
-    ///减号运算符重载实现，迭代器版本。
-    template <typename Iter>
-    difference_type sub_impl(Iter &&other, std::false_type) const noexcept {
-        return this->current - other.current;
-    }
-
-    ///减号运算符重载分发。
-    template <typename tp>
-    decltype(auto) operator-(tp &&n) const noexcept {
-        return sub_impl(std::forward<tp>(n), std::is_integral<std::remove_reference_t<tp>>());
-    }
+    self operator-(difference_type n) const noexcept { return self(current - n); }
 
     self &operator-=(difference_type n) noexcept {
         current -= n;
@@ -295,18 +213,37 @@ public:
     }
 };
 
-template <typename T>
+///源区间为 vector 迭代器时还原为裸指针，交给按指针处理的批量内核。
+template <typename T, typename Alloc>
+T *uninitialized_copy_a(vector_iterator<T> first, vector_iterator<T> last, T *dest, Alloc &alloc) {
+    return uninitialized_copy_a(first.operator->(), last.operator->(), dest, alloc);
+}
+
+template <typename T, typename Alloc>
+T *uninitialized_copy_a(vector_const_iterator<T> first, vector_const_iterator<T> last, T *dest, Alloc &alloc) {
+    return uninitialized_copy_a(first.operator->(), last.operator->(), dest, alloc);
+}
+
+template <typename T, typename Alloc>
 class vector_base {
 public:
+    using T_alloc_type = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    using alloc_traits = std::allocator_traits<T_alloc_type>;
     using pointer = T *;
 
-    ///内嵌类，保存容器申请到的动态内存的开始位置，结束位置及尾元素后指针。
-    class vector_impl {
+    static_assert(std::is_same<typename alloc_traits::pointer, pointer>::value, "vector requires an allocator whose pointer type is T *");
+
+    ///内嵌类，保存容器申请到的动态内存的开始位置，结束位置及尾元素后指针。继承分配器以便空分配器不占用空间。
+    class vector_impl : public T_alloc_type {
     public:
         pointer M_start = nullptr;
         pointer M_finish = nullptr;
         pointer M_end_of_storage = nullptr;
 
+        vector_impl() noexcept(std::is_nothrow_default_constructible<T_alloc_type>::value) : T_alloc_type() {}
+        explicit vector_impl(const T_alloc_type &alloc) noexcept : T_alloc_type(alloc) {}
+        explicit vector_impl(T_alloc_type &&alloc) noexcept : T_alloc_type(std::move(alloc)) {}
+
         void M_swap_data(vector_impl &other) {
             std::swap(M_start, other.M_start);
             std::swap(M_finish, other.M_finish);
@@ -318,25 +255,41 @@ public:
     ///维护动态内存的内嵌类成员
     vector_impl M_impl;
 
+    T_alloc_type &M_get_allocator() noexcept { return M_impl; }
+    const T_alloc_type &M_get_allocator() const noexcept { return M_impl; }
+
     ///申请动态内存
-    pointer M_allocate(size_t _n);
+    pointer M_allocate(size_t _n) { return _n ? alloc_traits::allocate(M_impl, _n) : nullptr; }
 
-    ///重新分配内存并释放原有内存
+    ///重新分配内存并释放原有内存。元素通过搬迁转移到新内存，原有元素在搬迁后不再存在。
     void M_reallocate(size_t new_size);
 
     ///释放内存
-    void M_deallocate(pointer _p);
+    void M_deallocate(pointer _p, size_t _n) {
+        if (_p) {
+            alloc_traits::deallocate(M_impl, _p, _n);
+        }
+    }
 
     ///基类构造函数
     vector_base() : M_impl() {}
 
+    explicit vector_base(const T_alloc_type &alloc) : M_impl(alloc) {}
+
+    vector_base(size_t _n, const T_alloc_type &alloc) : M_impl(alloc) { M_create_storage(_n); }
+
     explicit vector_base(size_t _n) : M_impl() { M_create_storage(_n); }
 
-    vector_base(vector_base &&_x) noexcept { this->M_impl.M_swap_data(_x.M_impl); }
+    vector_base(vector_base &&_x) noexcept : M_impl(std::move(_x.M_get_allocator())) { this->M_impl.M_swap_data(_x.M_impl); }
 
-    virtual ~vector_base() noexcept { M_deallocate(M_impl.M_start); }
+    virtual ~vector_base() noexcept { M_deallocate(M_impl.M_start, M_impl.M_end_of_storage - M_impl.M_start); }
 
 protected:
+    void M_reallocate_impl(size_t new_size, std::true_type);
+    void M_reallocate_impl(size_t new_size, std::false_type);
+    pointer M_reallocate_block(size_t new_size, std::true_type);
+    pointer M_reallocate_block(size_t new_size, std::false_type);
+
     ///申请动态内存并初始化内嵌类成员
     void M_create_storage(size_t _n) {
         this->M_impl.M_start = this->M_allocate(_n);
@@ -345,32 +298,59 @@ protected:
     }
 };
 
-template <typename T>
-typename vector_base<T>::pointer vector_base<T>::M_allocate(size_t _n) {
-    return static_cast<pointer>(std::malloc(sizeof(T) * _n));
+template <typename T, typename Alloc>
+void vector_base<T, Alloc>::M_reallocate(size_t new_size) {
+    M_reallocate_impl(new_size, is_trivially_relocatable<T>());
 }
 
-template <typename T>
-void vector_base<T>::M_deallocate(vector_base::pointer _p) {
-    std::free(_p);
+//可平凡重定位类型按字节整体搬迁。
+template <typename T, typename Alloc>
+void vector_base<T, Alloc>::M_reallocate_impl(size_t new_size, std::true_type) {
+    auto size = static_cast<size_t>(M_impl.M_finish - M_impl.M_start);
+    auto new_start = M_reallocate_block(new_size, allocator_has_reallocate<T_alloc_type>());
+    M_impl.M_start = new_start;
+    M_impl.M_finish = new_start + size;
+    M_impl.M_end_of_storage = new_start + new_size;
 }
 
-template <typename T>
-void vector_base<T>::M_reallocate(size_t new_size) {
-    auto temp_start = M_impl.M_start, temp_finish = M_impl.M_finish;
-    auto mark_start = M_impl.M_start;
-    this->M_create_storage(new_size);
-    while (temp_start != temp_finish) {
-        new (M_impl.M_finish) T(std::move(*temp_start));
-        ++M_impl.M_finish;
-        ++temp_start;
+//分配器支持 reallocate 时直接交给它，内存可原地扩展时无需任何复制。
+template <typename T, typename Alloc>
+typename vector_base<T, Alloc>::pointer vector_base<T, Alloc>::M_reallocate_block(size_t new_size, std::true_type) {
+    return M_impl.reallocate(M_impl.M_start, M_impl.M_end_of_storage - M_impl.M_start, new_size);
+}
+
+//否则申请新内存后一次 memcpy 。
+template <typename T, typename Alloc>
+typename vector_base<T, Alloc>::pointer vector_base<T, Alloc>::M_reallocate_block(size_t new_size, std::false_type) {
+    auto new_start = this->M_allocate(new_size);
+    uninitialized_relocate(M_impl.M_start, M_impl.M_finish, new_start);
+    M_deallocate(M_impl.M_start, M_impl.M_end_of_storage - M_impl.M_start);
+    return new_start;
+}
+
+//其他类型先在新内存中逐个搬迁，成功后再释放旧内存。
+template <typename T, typename Alloc>
+void vector_base<T, Alloc>::M_reallocate_impl(size_t new_size, std::false_type) {
+    auto old_start = M_impl.M_start, old_finish = M_impl.M_finish;
+    auto new_start = this->M_allocate(new_size);
+    pointer new_finish;
+    try {
+        new_finish = uninitialized_relocate(old_start, old_finish, new_start);
+    } catch (...) {
+        M_deallocate(new_start, new_size);
+        throw;
     }
-    std::free(mark_start);
+    M_deallocate(old_start, M_impl.M_end_of_storage - old_start);
+    M_impl.M_start = new_start;
+    M_impl.M_finish = new_finish;
+    M_impl.M_end_of_storage = new_start + new_size;
 }
 
-template <typename T>
-class vector : vector_base<T> {
-    using Base = vector_base<T>;
+template <typename T, typename Alloc, typename Growth>
+class vector : vector_base<T, Alloc> {
+    using Base = vector_base<T, Alloc>;
+    using typename Base::T_alloc_type;
+    using typename Base::alloc_traits;
 
 public:
     using self = vector;
@@ -385,31 +365,40 @@ public:
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
     using size_type = size_t;
     using difference_type = ptrdiff_t;
+    using allocator_type = Alloc;
+    using growth_policy = Growth;
 
 protected:
     using Base::M_impl;
     using Base::M_reallocate;
     using Base::M_deallocate;
+    using Base::M_get_allocator;
 
 public:
     //构造函数
-    vector() : Base() {}                     //默认构造函数。构造拥有默认构造的分配器的空容器。
-    vector(size_type count, const T &value); //构造拥有 count 个有值 value 的元素的容器。
-    explicit vector(size_type count);        //构造拥有个 count 默认插入的 T 实例的容器。不进行复制。
-    template <typename InputIt, typename = RequireInputIter<InputIt>>
-    vector(InputIt first, InputIt last);                        //构造拥有范围 [first, last) 内容的容器。
-    vector(const vector &other);                                //复制构造函数。构造拥有other内容的容器。
-    vector(vector &&other) noexcept : Base(std::move(other)) {} //移动构造函数。用移动语义构造拥有other内容的容器。移动后，保证other为empty() 。
-    vector(std::initializer_list<T> init);                      //构造拥有 initializer_list init 内容的容器。
+    vector() : Base() {}                                                          //默认构造函数。构造拥有默认构造的分配器的空容器。
+    explicit vector(const Alloc &alloc) noexcept : Base(alloc) {}                 //构造拥有给定分配器 alloc 的空容器。
+    vector(size_type count, const T &value, const Alloc &alloc = Alloc());        //构造拥有 count 个有值 value 的元素的容器。
+    explicit vector(size_type count, const Alloc &alloc = Alloc());               //构造拥有个 count 默认插入的 T 实例的容器。不进行复制。
+    vector(size_type count, default_init_t, const Alloc &alloc = Alloc());        //构造拥有 count 个默认初始化元素的容器。平凡类型的元素不被写入，适合随后整体覆盖的缓冲区。
+    template <typename InputIt, typename = RequireInputIter<InputIt>>             //
+    vector(InputIt first, InputIt last, const Alloc &alloc = Alloc());            //构造拥有范围 [first, last) 内容的容器。
+    vector(const vector &other);                                                  //复制构造函数。构造拥有other内容的容器。分配器由 select_on_container_copy_construction 获得。
+    vector(const vector &other, const Alloc &alloc);                              //构造拥有other内容的容器，使用 alloc 作为分配器。
+    vector(vector &&other) noexcept : Base(std::move(other)) {}                   //移动构造函数。用移动语义构造拥有other内容的容器。移动后，保证other为empty() 。
+    vector(vector &&other, const Alloc &alloc);                                   //分配器扩展的移动构造函数。alloc 与 other 的分配器不相等时逐元素移动。
+    vector(std::initializer_list<T> init, const Alloc &alloc = Alloc());          //构造拥有 initializer_list init 内容的容器。
 
     //析构函数
     ~vector(); //销毁vector。调用元素的析构函数，然后解分配所用的存储。注意，若元素是指针，则不销毁所指向的对象。
 
     //赋值运算符重载
     vector &operator=(const vector &other); //复制赋值运算符。以 other 的副本替换内容。
-    vector &operator=(vector &&other) noexcept; //移动赋值运算符。用移动语义以 other 的内容替换内容（即从 other 移动 other 中的数据到此容器中）。之后 other 在合法但未指定的状态。
+    vector &operator=(vector &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value); //移动赋值运算符。用移动语义以 other 的内容替换内容（即从 other 移动 other 中的数据到此容器中）。之后 other 在合法但未指定的状态。分配器不随之转移且不相等时逐个移动元素，可能抛出异常。
     vector &operator=(std::initializer_list<T> ilist); //以 initializer_list ilist 所标识者替换内容。
 
+    allocator_type get_allocator() const noexcept { return allocator_type(M_get_allocator()); } //返回与容器关联的分配器。
+
     //赋值函数
     void assign(size_type count, const T &value);                     //以 count 份 value 的副本替换内容。
     template <typename InputIt, typename = RequireInputIter<InputIt>> //
@@ -483,9 +472,79 @@ public:
 
     void resize(size_type count);                          //重设容器大小以容纳count个元素。若当前大小小于count，则后附额外的默认插入的元素。
     void resize(size_type count, const value_type &value); //重设容器大小以容纳count个元素。若当前大小小于count，则后附额外的value的副本。
+    void resize(size_type count, default_init_t);          //重设容器大小以容纳count个元素。若当前大小小于count，则后附额外的默认初始化的元素。
+    void resize_uninitialized(size_type count);            //同 resize(count, default_init) 。平凡类型的新元素保持未初始化，调用者需在读取前写入。
 
     void swap(vector &other); //将内容与 other 的交换。不在单独的元素上调用任何移动、复制或交换操作。所有迭代器和引用保持合法。尾后迭代器被非法化。
 protected:
+    ///按增长策略计算容纳 required 个元素所需的新容量。
+    size_type M_grow_capacity(size_type required) const {
+        if (required > max_size()) {
+            throw std::length_error("vector is too long.");
+        }
+        auto new_cap = Growth::next_capacity(capacity(), required, sizeof(T));
+        if (new_cap < required || new_cap > max_size()) {
+            new_cap = required;
+        }
+        return new_cap;
+    }
+
+    ///通过分配器在 p 处构造元素
+    template <typename... Args>
+    void M_construct(pointer p, Args &&...args) {
+        alloc_traits::construct(M_get_allocator(), p, std::forward<Args>(args)...);
+    }
+
+    ///通过分配器析构 p 处的元素
+    void M_destroy(pointer p) noexcept { alloc_traits::destroy(M_get_allocator(), p); }
+
+    ///释放全部元素与内存
+    void M_release_storage() noexcept {
+        clear();
+        M_deallocate(M_impl.M_start, capacity());
+        M_impl.M_start = M_impl.M_finish = M_impl.M_end_of_storage = nullptr;
+    }
+
+    ///以 [first, last) 中 count 个元素的副本替换内容。
+    template <typename ForwardIt>
+    void M_assign_copy(ForwardIt first, ForwardIt last, size_type count);
+
+    ///resize 的公共部分。
+    bool M_resize_prepare(size_type count);
+
+    ///元素能否无异常地搬迁。满足时插入可以在原内存中腾出空位，否则在新内存中重建，以保证强异常安全。
+    static constexpr bool nothrow_relocatable = is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value;
+
+    ///能否在原内存中插入 count 个元素。
+    bool M_can_insert_in_place(size_type count) const noexcept { return nothrow_relocatable && size_type(M_impl.M_end_of_storage - M_impl.M_finish) >= count; }
+
+    ///在 pos 前插入 count 个元素，新元素由 construct(dest) 在 [dest, dest + count) 中构造，构造失败时须自行析构已构造的部分。
+    template <typename Construct>
+    iterator M_insert_n(pointer pos, size_type count, Construct construct);
+    ///申请新内存，按 前缀 + 新元素 + 后缀 的顺序一次建成，再释放旧内存。
+    template <typename Construct>
+    iterator M_realloc_insert(pointer pos, size_type count, Construct construct);
+    ///把 [start, pos) 搬到 new_start ，[pos, finish) 搬到 new_suffix 。
+    void M_relocate_around(pointer pos, pointer new_start, pointer new_suffix, std::true_type) noexcept;
+    void M_relocate_around(pointer pos, pointer new_start, pointer new_suffix, std::false_type);
+
+    ///把 [pos, finish) 整体后移 count 个位置，在 pos 处留出 count 个未初始化的空位。调用者保证容量足够。
+    void M_open_gap(pointer pos, size_type count) noexcept;
+    ///M_open_gap 的逆操作，空位中的元素构造失败时用于复原。
+    void M_close_gap(pointer pos, size_type count) noexcept;
+    ///把 [first, last) 搬迁到 dest ，两者可以重叠。
+    void M_shift_tail(pointer first, pointer last, pointer dest, std::true_type) noexcept;
+    void M_shift_tail(pointer first, pointer last, pointer dest, std::false_type) noexcept;
+
+    ///移除 [first, last) 中的元素，后缀前移补齐。
+    void M_erase_impl(pointer first, pointer last, std::true_type) noexcept;
+    void M_erase_impl(pointer first, pointer last, std::false_type);
+
+    ///移动赋值实现，分配器随之传播或必然相等时直接接管 other 的内存。
+    void M_move_assign(vector &other, std::true_type) noexcept;
+    ///移动赋值实现，分配器不传播时，仅在两者相等时接管内存，否则逐元素移动。
+    void M_move_assign(vector &other, std::false_type);
+
     /// Safety check used only from at().
     void M_range_check(size_type _n) const {
         if (_n >= this->size())
@@ -493,273 +552,273 @@ protected:
     }
 };
 
-template <typename T>
-vector<T>::vector(size_type count, const T &value) : Base(count * 2) {
-    while (count--) {
-        new (M_impl.M_finish) T(value);
-        ++M_impl.M_finish;
-    }
+template <typename T, typename Alloc, typename Growth>
+vector<T, Alloc, Growth>::vector(size_type count, const T &value, const Alloc &alloc) : Base(count, alloc) {
+    M_impl.M_finish = uninitialized_fill_n_a(M_impl.M_start, count, value, M_get_allocator());
 }
-template <typename T>
-vector<T>::vector(vector::size_type count) : Base(count * 2) {
-    while (count--) {
-        new (M_impl.M_finish) T;
-        ++M_impl.M_finish;
-    }
+
+template <typename T, typename Alloc, typename Growth>
+vector<T, Alloc, Growth>::vector(vector::size_type count, const Alloc &alloc) : Base(count, alloc) {
+    M_impl.M_finish = uninitialized_value_construct_n_a(M_impl.M_start, count, M_get_allocator());
 }
 
-template <typename T>
+template <typename T, typename Alloc, typename Growth>
+vector<T, Alloc, Growth>::vector(size_type count, default_init_t, const Alloc &alloc) : Base(count, alloc) {
+    M_impl.M_finish = uninitialized_default_construct_n_a(M_impl.M_start, count, M_get_allocator());
+}
+
+template <typename T, typename Alloc, typename Growth>
 template <typename InputIt, typename>
-vector<T>::vector(InputIt first, InputIt last) : Base((last - first) * 2) {
-    while (first != last) {
-        new (M_impl.M_finish) T(*first);
-        ++M_impl.M_finish;
-        ++first;
-    }
+vector<T, Alloc, Growth>::vector(InputIt first, InputIt last, const Alloc &alloc) : Base(std::distance(first, last), alloc) {
+    M_impl.M_finish = uninitialized_copy_a(first, last, M_impl.M_start, M_get_allocator());
 }
 
-template <typename T>
-vector<T>::vector(const vector &other) : Base(other.size() * 2) {
-    auto iter = other.cbegin();
-    while (iter != other.cend()) {
-        new (M_impl.M_finish) T(*iter);
-        ++M_impl.M_finish;
-        ++iter;
-    }
+template <typename T, typename Alloc, typename Growth>
+vector<T, Alloc, Growth>::vector(const vector &other) : vector(other, alloc_traits::select_on_container_copy_construction(other.M_get_allocator())) {}
+
+template <typename T, typename Alloc, typename Growth>
+vector<T, Alloc, Growth>::vector(const vector &other, const Alloc &alloc) : Base(other.size(), alloc) {
+    M_impl.M_finish = uninitialized_copy_a(other.M_impl.M_start, other.M_impl.M_finish, M_impl.M_start, M_get_allocator());
 }
 
-template <typename T>
-vector<T>::vector(std::initializer_list<T> init) : Base(init.size() * 2) {
-    for (auto &i : init) {
-        new (M_impl.M_finish) T(std::move(i));
-        ++M_impl.M_finish;
+template <typename T, typename Alloc, typename Growth>
+vector<T, Alloc, Growth>::vector(vector &&other, const Alloc &alloc) : Base(alloc) {
+    if (M_get_allocator() == other.M_get_allocator()) {
+        M_impl.M_swap_data(other.M_impl);
+        return;
     }
+    this->M_create_storage(other.size());
+    M_impl.M_finish = uninitialized_move_a(other.M_impl.M_start, other.M_impl.M_finish, M_impl.M_start, M_get_allocator());
+    other.clear();
 }
-template <typename T>
-vector<T>::~vector() {
+
+template <typename T, typename Alloc, typename Growth>
+vector<T, Alloc, Growth>::vector(std::initializer_list<T> init, const Alloc &alloc) : Base(init.size(), alloc) {
+    M_impl.M_finish = uninitialized_copy_a(init.begin(), init.end(), M_impl.M_start, M_get_allocator());
+}
+
+template <typename T, typename Alloc, typename Growth>
+vector<T, Alloc, Growth>::~vector() {
     this->clear();
 }
 
-template <typename T>
-vector<T> &vector<T>::operator=(const vector &other) {
-    if (this->M_impl.M_finish == other.M_impl.M_finish) {
+template <typename T, typename Alloc, typename Growth>
+vector<T, Alloc, Growth> &vector<T, Alloc, Growth>::operator=(const vector &other) {
+    if (this == &other) {
         return *this;
     }
-    this->clear();
-    if (this->capacity() < other.capacity()) {
-        this->reserve(other.capacity() * 2);
-    }
-    auto iter = other.cbegin();
-    while (iter != other.cend()) {
-        new (M_impl.M_finish) T(*iter);
-        ++M_impl.M_finish;
-        ++iter;
+    if (alloc_traits::propagate_on_container_copy_assignment::value && M_get_allocator() != other.M_get_allocator()) {
+        //旧内存只能由旧分配器释放，必须在替换分配器之前归还。
+        M_release_storage();
     }
+    alloc_on_copy(M_get_allocator(), other.M_get_allocator(), typename alloc_traits::propagate_on_container_copy_assignment());
+    M_assign_copy(other.M_impl.M_start, other.M_impl.M_finish, other.size());
     return *this;
 }
 
-template <typename T>
-vector<T> &vector<T>::operator=(vector &&other) noexcept {
-    if (this->M_impl.M_finish == other.M_impl.M_finish) {
+template <typename T, typename Alloc, typename Growth>
+vector<T, Alloc, Growth> &vector<T, Alloc, Growth>::operator=(vector &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+    if (this == &other) {
         return *this;
     }
-    vector temp;
-    this->M_impl.M_swap_data(temp.M_impl);
-    this->M_impl.M_swap_data(other.M_impl);
+    M_move_assign(other, std::integral_constant<bool, alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value>());
     return *this;
 }
-template <typename T>
-vector<T> &vector<T>::operator=(std::initializer_list<T> ilist) {
-    this->clear();
-    if (this->capacity() < ilist.size()) {
-        this->reserve(ilist.size() * 2);
-    }
-    for (auto &i : ilist) {
-        new (M_impl.M_finish) T(std::move(i));
-        ++M_impl.M_finish;
+
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::M_move_assign(vector &other, std::true_type) noexcept {
+    M_release_storage();
+    this->M_impl.M_swap_data(other.M_impl);
+    alloc_on_move(M_get_allocator(), other.M_get_allocator(), typename alloc_traits::propagate_on_container_move_assignment());
+}
+
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::M_move_assign(vector &other, std::false_type) {
+    if (M_get_allocator() == other.M_get_allocator()) {
+        M_move_assign(other, std::true_type());
+        return;
     }
+    this->clear();
+    this->reserve(other.size());
+    M_impl.M_finish = uninitialized_move_a(other.M_impl.M_start, other.M_impl.M_finish, M_impl.M_start, M_get_allocator());
+    other.clear();
+}
+
+template <typename T, typename Alloc, typename Growth>
+vector<T, Alloc, Growth> &vector<T, Alloc, Growth>::operator=(std::initializer_list<T> ilist) {
+    M_assign_copy(ilist.begin(), ilist.end(), ilist.size());
     return *this;
 }
 
-template <typename T>
-void vector<T>::assign(size_type count, const T &value) {
+//清空容器并以 [first, last) 的副本重新填充，容量不足时按精确大小重新分配。
+template <typename T, typename Alloc, typename Growth>
+template <typename ForwardIt>
+void vector<T, Alloc, Growth>::M_assign_copy(ForwardIt first, ForwardIt last, size_type count) {
     this->clear();
     if (this->capacity() < count) {
-        auto new_size = count * 2;
-        M_reallocate(new_size);
-    }
-    while (count--) {
-        new (M_impl.M_finish) T(value);
-        ++M_impl.M_finish;
+        M_reallocate(count);
     }
+    M_impl.M_finish = uninitialized_copy_a(first, last, M_impl.M_start, M_get_allocator());
 }
 
-template <typename T>
-template <typename InputIt, typename>
-void vector<T>::assign(InputIt first, InputIt last) {
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::assign(size_type count, const T &value) {
     this->clear();
-    auto count = last - first;
     if (this->capacity() < count) {
-        auto new_size = count * 2;
-        M_reallocate(new_size);
-    }
-    while (first != last) {
-        new (M_impl.M_finish) T(*first);
-        ++M_impl.M_finish;
-        ++first;
+        M_reallocate(count);
     }
+    M_impl.M_finish = uninitialized_fill_n_a(M_impl.M_start, count, value, M_get_allocator());
 }
-template <typename T>
-void vector<T>::assign(std::initializer_list<T> ilist) {
-    this->clear();
-    if (ilist.empty()) {
-        return;
-    }
-    if (ilist.size() > this->capacity()) {
-        auto new_size = ilist.size() * 2;
-        M_reallocate(new_size);
-    }
-    for (auto &i : ilist) {
-        new (M_impl.M_finish) T(std::move(i));
-        ++M_impl.M_finish;
-    }
+
+template <typename T, typename Alloc, typename Growth>
+template <typename InputIt, typename>
+void vector<T, Alloc, Growth>::assign(InputIt first, InputIt last) {
+    M_assign_copy(first, last, std::distance(first, last));
 }
 
-template <typename T>
-typename vector<T>::reference vector<T>::at(vector::size_type pos) {
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::assign(std::initializer_list<T> ilist) {
+    M_assign_copy(ilist.begin(), ilist.end(), ilist.size());
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::reference vector<T, Alloc, Growth>::at(vector::size_type pos) {
     this->M_range_check(pos);
     return (*this)[pos];
 }
 
-template <typename T>
-typename vector<T>::const_reference vector<T>::at(vector::size_type pos) const {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::const_reference vector<T, Alloc, Growth>::at(vector::size_type pos) const {
     this->M_range_check(pos);
     return (*this)[pos];
 }
 
-template <typename T>
-typename vector<T>::reference vector<T>::operator[](vector::size_type pos) {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::reference vector<T, Alloc, Growth>::operator[](vector::size_type pos) {
     return *(this->M_impl.M_start + pos);
 }
 
-template <typename T>
-typename vector<T>::const_reference vector<T>::operator[](vector::size_type pos) const {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::const_reference vector<T, Alloc, Growth>::operator[](vector::size_type pos) const {
     return *(this->M_impl.M_start + pos);
 }
 
-template <typename T>
-typename vector<T>::reference vector<T>::front() {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::reference vector<T, Alloc, Growth>::front() {
     return *begin();
 }
 
-template <typename T>
-typename vector<T>::const_reference vector<T>::front() const {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::const_reference vector<T, Alloc, Growth>::front() const {
     return *begin();
 }
 
-template <typename T>
-typename vector<T>::reference vector<T>::back() {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::reference vector<T, Alloc, Growth>::back() {
     return *(end() - 1);
 }
 
-template <typename T>
-typename vector<T>::const_reference vector<T>::back() const {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::const_reference vector<T, Alloc, Growth>::back() const {
     return *(end() - 1);
 }
 
-template <typename T>
-T *vector<T>::data() noexcept {
+template <typename T, typename Alloc, typename Growth>
+T *vector<T, Alloc, Growth>::data() noexcept {
     return this->M_impl.M_start;
 }
 
-template <typename T>
-const T *vector<T>::data() const noexcept {
+template <typename T, typename Alloc, typename Growth>
+const T *vector<T, Alloc, Growth>::data() const noexcept {
     return this->M_impl.M_start;
 }
 
-template <typename T>
-void vector<T>::clear() noexcept {
-    while (M_impl.M_finish != M_impl.M_start) {
-        --M_impl.M_finish;
-        M_impl.M_finish->~T();
-    }
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::clear() noexcept {
+    destroy_a(M_impl.M_start, M_impl.M_finish, M_get_allocator());
+    M_impl.M_finish = M_impl.M_start;
 }
 
-template <typename T>
-typename vector<T>::iterator vector<T>::begin() noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::begin() noexcept {
     return iterator(const_cast<T *>(M_impl.M_start));
 }
 
-template <typename T>
-typename vector<T>::const_iterator vector<T>::begin() const noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::const_iterator vector<T, Alloc, Growth>::begin() const noexcept {
     return const_iterator(const_cast<T *>(M_impl.M_start));
 }
 
-template <typename T>
-typename vector<T>::const_iterator vector<T>::cbegin() const noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::const_iterator vector<T, Alloc, Growth>::cbegin() const noexcept {
     return const_iterator(const_cast<T *>(M_impl.M_start));
 }
 
-template <typename T>
-typename vector<T>::iterator vector<T>::end() noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::end() noexcept {
     return iterator(const_cast<T *>(M_impl.M_finish));
 }
 
-template <typename T>
-typename vector<T>::const_iterator vector<T>::end() const noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::const_iterator vector<T, Alloc, Growth>::end() const noexcept {
     return const_iterator(const_cast<T *>(M_impl.M_finish));
 }
-template <typename T>
-typename vector<T>::const_iterator vector<T>::cend() const noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::const_iterator vector<T, Alloc, Growth>::cend() const noexcept {
     return const_iterator(const_cast<T *>(M_impl.M_finish));
 }
-template <typename T>
-typename vector<T>::reverse_iterator vector<T>::rbegin() noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::reverse_iterator vector<T, Alloc, Growth>::rbegin() noexcept {
     return std::reverse_iterator<iterator>(end());
 }
 
-template <typename T>
-typename vector<T>::const_reverse_iterator vector<T>::rbegin() const noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::const_reverse_iterator vector<T, Alloc, Growth>::rbegin() const noexcept {
     return std::reverse_iterator<const_iterator>(cend());
 }
 
-template <typename T>
-typename vector<T>::const_reverse_iterator vector<T>::crbegin() const noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::const_reverse_iterator vector<T, Alloc, Growth>::crbegin() const noexcept {
     return std::reverse_iterator<const_iterator>(cend());
 }
 
-template <typename T>
-typename vector<T>::reverse_iterator vector<T>::rend() noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::reverse_iterator vector<T, Alloc, Growth>::rend() noexcept {
     return std::reverse_iterator<iterator>(begin());
 }
 
-template <typename T>
-typename vector<T>::const_reverse_iterator vector<T>::rend() const noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::const_reverse_iterator vector<T, Alloc, Growth>::rend() const noexcept {
     return std::reverse_iterator<const_iterator>(cbegin());
 }
 
-template <typename T>
-typename vector<T>::const_reverse_iterator vector<T>::crend() const noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::const_reverse_iterator vector<T, Alloc, Growth>::crend() const noexcept {
     return std::reverse_iterator<const_iterator>(cbegin());
 }
 
-template <typename T>
-bool vector<T>::empty() const noexcept {
+template <typename T, typename Alloc, typename Growth>
+bool vector<T, Alloc, Growth>::empty() const noexcept {
     return M_impl.M_finish == M_impl.M_start;
 }
 
-template <typename T>
-typename vector<T>::size_type vector<T>::size() const noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::size_type vector<T, Alloc, Growth>::size() const noexcept {
     return M_impl.M_finish - M_impl.M_start;
 }
 
-template <typename T>
-typename vector<T>::size_type vector<T>::capacity() const noexcept {
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::size_type vector<T, Alloc, Growth>::max_size() const noexcept {
+    return alloc_traits::max_size(M_get_allocator());
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::size_type vector<T, Alloc, Growth>::capacity() const noexcept {
     return M_impl.M_end_of_storage - M_impl.M_start;
 }
 
-template <typename T>
-void vector<T>::shrink_to_fit() {
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::shrink_to_fit() {
     auto size = this->size();
     if (size == capacity()) {
         return;
@@ -767,429 +826,387 @@ void vector<T>::shrink_to_fit() {
     M_reallocate(size);
 }
 
-template <typename T>
-void vector<T>::resize(vector::size_type count) {
-    auto size = this->size();
-    if (count == size) {
-        return;
-    } else if (count > size) {
-        if (count > this->capacity()) {
-            if (!this->capacity()) {
-                this->M_create_storage(count);
-            } else {
-                M_reallocate(count);
-            }
-        }
-        while (M_impl.M_finish != M_impl.M_end_of_storage) {
-            new (M_impl.M_finish) T;
-            ++M_impl.M_finish;
-        }
-    } else {
-        size -= count;
-        while (size--) {
-            --M_impl.M_finish;
-            M_impl.M_finish->~T();
-        }
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::resize(vector::size_type count) {
+    if (M_resize_prepare(count)) {
+        M_impl.M_finish = uninitialized_value_construct_n_a(M_impl.M_finish, count - this->size(), M_get_allocator());
     }
 }
 
-template <typename T>
-void vector<T>::resize(vector::size_type count, const value_type &value) {
-    auto size = this->size();
-    if (count == size) {
-        return;
-    } else if (count > size) {
-        if (count > this->capacity()) {
-            if (!this->capacity()) {
-                this->M_create_storage(count);
-            } else {
-                M_reallocate(count);
-            }
-        }
-        while (M_impl.M_finish != M_impl.M_end_of_storage) {
-            new (M_impl.M_finish) T(value);
-            ++M_impl.M_finish;
-        }
-    } else {
-        size -= count;
-        while (size--) {
-            --M_impl.M_finish;
-            M_impl.M_finish->~T();
-        }
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::resize(vector::size_type count, const value_type &value) {
+    if (M_resize_prepare(count)) {
+        M_impl.M_finish = uninitialized_fill_n_a(M_impl.M_finish, count - this->size(), value, M_get_allocator());
     }
 }
 
-template <typename T>
-typename vector<T>::iterator vector<T>::insert(const_iterator pos, const T &value) {
-    if (M_impl.M_finish != M_impl.M_end_of_storage) {
-        auto pos_ptr = pos.current - 1;
-        auto now_ptr = M_impl.M_finish;
-        ++M_impl.M_finish;
-        new (now_ptr) T;
-        while (now_ptr != pos_ptr) {
-            *now_ptr = std::move(*(now_ptr - 1));
-            --now_ptr;
-        }
-        new (pos_ptr) T(value);
-        return iterator(pos_ptr);
-    } else {
-        auto pos_dif = pos.current - M_impl.M_start;
-        auto new_size = 2 * this->size();
-        if (!new_size)
-            new_size = 2;
-        M_reallocate(new_size);
-        auto now_ptr = M_impl.M_finish;
-        ++M_impl.M_finish;
-        auto pos_ptr = M_impl.M_start + pos_dif;
-        new (now_ptr) T;
-        while (now_ptr != pos_ptr) {
-            *now_ptr = std::move(*(now_ptr - 1));
-            --now_ptr;
-        }
-        new (pos_ptr) T(value);
-        return iterator(pos_ptr);
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::resize(vector::size_type count, default_init_t) {
+    if (M_resize_prepare(count)) {
+        M_impl.M_finish = uninitialized_default_construct_n_a(M_impl.M_finish, count - this->size(), M_get_allocator());
     }
 }
 
-template <typename T>
-typename vector<T>::iterator vector<T>::insert(const_iterator pos, T &&value) {
-    if (M_impl.M_finish != M_impl.M_end_of_storage) {
-        auto pos_ptr = pos.current - 1;
-        auto now_ptr = M_impl.M_finish;
-        ++M_impl.M_finish;
-        while (now_ptr != pos_ptr) {
-            new (now_ptr) T(std::move(*(now_ptr - 1)));
-            --now_ptr;
-        }
-        ++pos_ptr;
-        new (pos_ptr) T(std::move(value));
-        return iterator(pos_ptr);
-    } else {
-        auto pos_dif = pos.current - M_impl.M_start;
-        auto new_size = 2 * this->size();
-        if (!new_size)
-            new_size = 2;
-        M_reallocate(new_size);
-        auto now_ptr = M_impl.M_finish;
-        ++M_impl.M_finish;
-        auto pos_ptr = M_impl.M_start + pos_dif - 1;
-        while (now_ptr != pos_ptr) {
-            new (now_ptr) T(std::move(*(now_ptr - 1)));
-            --now_ptr;
-        }
-        ++pos_ptr;
-        new (pos_ptr) T(std::move(value));
-        return iterator(pos_ptr);
-    }
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::resize_uninitialized(vector::size_type count) {
+    resize(count, default_init);
 }
 
-template <typename T>
-typename vector<T>::iterator vector<T>::insert(const_iterator pos, size_type count, const T &value) {
-    if (count <= 0) {
-        return pos;
+//缩小时直接析构多余元素并返回 false ；扩大时确保容量足够并返回 true ，由调用者构造新元素。
+template <typename T, typename Alloc, typename Growth>
+bool vector<T, Alloc, Growth>::M_resize_prepare(size_type count) {
+    auto size = this->size();
+    if (count <= size) {
+        destroy_a(M_impl.M_start + count, M_impl.M_finish, M_get_allocator());
+        M_impl.M_finish = M_impl.M_start + count;
+        return false;
     }
-    if (M_impl.M_end_of_storage - M_impl.M_finish >= count) {
-        auto pos_ptr = pos.current - 1;
-        M_impl.M_finish += count;
-        auto now_ptr = M_impl.M_finish - 1;
-        new (now_ptr) T;
-        while (now_ptr - count != pos_ptr) {
-            *now_ptr = std::move(*(now_ptr - count));
-            --now_ptr;
-        }
-        ++pos_ptr;
-        auto temp = pos_ptr;
-        while (count--) {
-            new (pos_ptr) T(value);
-            ++pos_ptr;
-        }
-        return iterator(temp);
-    } else {
-        auto pos_dif = pos.current - M_impl.M_start;
-        auto new_size = (this->size() + count) * 2;
-        M_reallocate(new_size);
-        M_impl.M_finish += count;
-        auto now_ptr = M_impl.M_finish - 1;
-        auto pos_ptr = M_impl.M_start + pos_dif - 1;
-        new (now_ptr) T;
-        while (now_ptr - count != pos_ptr) {
-            *now_ptr = std::move(*(now_ptr - count));
-            --now_ptr;
-        }
-        ++pos_ptr;
-        auto temp = pos_ptr;
-        while (count--) {
-            new (pos_ptr) T(value);
-            ++pos_ptr;
-        }
-        return iterator(temp);
+    if (count > this->capacity()) {
+        M_reallocate(M_grow_capacity(count));
     }
+    return true;
 }
 
-template <typename T>
-template <typename InputIt, typename>
-typename vector<T>::iterator vector<T>::insert(const_iterator pos, InputIt first, InputIt last) {
-    auto count = std::distance(first, last);
-    if (count <= 0) {
-        return pos;
-    }
-    if (M_impl.M_end_of_storage - M_impl.M_finish >= count) {
-        auto pos_ptr = pos.current - 1;
-        M_impl.M_finish += count;
-        auto now_ptr = M_impl.M_finish - 1;
-        new (now_ptr) T;
-        while (now_ptr - count != pos_ptr) {
-            *now_ptr = std::move(*(now_ptr - count));
-            --now_ptr;
-        }
-        ++pos_ptr;
-        auto temp = pos_ptr;
-        while (first != last) {
-            new (pos_ptr) T(*first);
-            ++pos_ptr;
-            ++first;
-        }
-        return iterator(temp);
-    } else {
-        auto pos_dif = pos.current - M_impl.M_start;
-        auto new_size = 2 * this->size();
-        if (!new_size)
-            new_size = 2;
-        M_reallocate(new_size);
-        M_impl.M_finish += count;
-        auto now_ptr = M_impl.M_finish - 1;
-        auto pos_ptr = M_impl.M_start + pos_dif - 1;
-        new (now_ptr) T;
-        while (now_ptr - count != pos_ptr) {
-            *now_ptr = std::move(*(now_ptr - count));
-            --now_ptr;
-        }
-        ++pos_ptr;
-        auto temp = pos_ptr;
-        while (first != last) {
-            new (pos_ptr) T(*first);
-            ++pos_ptr;
-            ++first;
-        }
-        return iterator(temp);
-    }
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::insert(const_iterator pos, const T &value) {
+    return emplace(pos, value);
 }
 
-template <typename T>
-typename vector<T>::iterator vector<T>::insert(vector::const_iterator pos, std::initializer_list<T> ilist) {
-    auto count = ilist.size();
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::insert(const_iterator pos, T &&value) {
+    return M_insert_n(pos.current, 1, [&](pointer dest) { this->M_construct(dest, std::move(value)); });
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::insert(const_iterator pos, size_type count, const T &value) {
     if (count == 0) {
-        return pos;
+        return iterator(pos.current);
     }
-    if (M_impl.M_end_of_storage - M_impl.M_finish >= count) {
-        auto pos_ptr = pos.current - 1;
-        M_impl.M_finish += count;
-        auto now_ptr = M_impl.M_finish - 1;
-        new (now_ptr) T;
-        while (now_ptr - count != pos_ptr) {
-            *now_ptr = std::move(*(now_ptr - count));
-            --now_ptr;
-        }
-        ++pos_ptr;
-        auto temp = pos_ptr;
-        for (auto &i : ilist) {
-            new (pos_ptr) T(std::move(i));
-            ++pos_ptr;
-        }
-        return iterator(temp);
-    } else {
-        auto pos_dif = pos.current - M_impl.M_start;
-        auto new_size = 2 * this->size();
-        if (!new_size)
-            new_size = 2;
-        M_reallocate(new_size);
-        M_impl.M_finish += count;
-        auto now_ptr = M_impl.M_finish - 1;
-        auto pos_ptr = M_impl.M_start + pos_dif - 1;
-        new (now_ptr) T;
-        while (now_ptr - count != pos_ptr) {
-            *now_ptr = std::move(*(now_ptr - count));
-            --now_ptr;
-        }
-        ++pos_ptr;
-        auto temp = pos_ptr;
-        for (auto &i : ilist) {
-            new (pos_ptr) T(std::move(i));
-            ++pos_ptr;
-        }
-        return iterator(temp);
+    if (!M_can_insert_in_place(count)) {
+        return M_realloc_insert(pos.current, count, [&](pointer dest) { uninitialized_fill_n_a(dest, count, value, M_get_allocator()); });
     }
+    //value 可能就是容器中位于 pos 之后的元素，腾出空位后它会被移走，先复制一份。
+    value_type copy(value);
+    return M_insert_n(pos.current, count, [&](pointer dest) { uninitialized_fill_n_a(dest, count, copy, M_get_allocator()); });
 }
 
-template <typename T>
+template <typename T, typename Alloc, typename Growth>
+template <typename InputIt, typename>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::insert(const_iterator pos, InputIt first, InputIt last) {
+    auto count = static_cast<size_type>(std::distance(first, last));
+    return M_insert_n(pos.current, count, [&](pointer dest) { uninitialized_copy_a(first, last, dest, M_get_allocator()); });
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::insert(vector::const_iterator pos, std::initializer_list<T> ilist) {
+    return M_insert_n(pos.current, ilist.size(), [&](pointer dest) { uninitialized_copy_a(ilist.begin(), ilist.end(), dest, M_get_allocator()); });
+}
+
+template <typename T, typename Alloc, typename Growth>
 template <typename... Args>
-typename vector<T>::iterator vector<T>::emplace(vector::const_iterator pos, Args &&...args) {
-    if (M_impl.M_finish != M_impl.M_end_of_storage) {
-        auto pos_ptr = pos.current - 1;
-        auto now_ptr = M_impl.M_finish;
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::emplace(vector::const_iterator pos, Args &&...args) {
+    auto pos_ptr = pos.current;
+    if (pos_ptr == M_impl.M_finish && M_impl.M_finish != M_impl.M_end_of_storage) {
+        this->M_construct(pos_ptr, std::forward<Args>(args)...);
         ++M_impl.M_finish;
-        new (now_ptr) T;
-        while (now_ptr != pos_ptr) {
-            *now_ptr = std::move(*(now_ptr - 1));
-            --now_ptr;
-        }
-        ++pos_ptr;
-        new (pos_ptr) T(std::forward<Args>(args)...);
         return iterator(pos_ptr);
+    }
+    if (!M_can_insert_in_place(1)) {
+        return M_realloc_insert(pos_ptr, 1, [&](pointer dest) { this->M_construct(dest, std::forward<Args>(args)...); });
+    }
+    //参数可能引用容器中位于 pos 之后的元素，先构造出新元素再腾出空位。
+    value_type tmp(std::forward<Args>(args)...);
+    return M_insert_n(pos_ptr, 1, [&](pointer dest) { this->M_construct(dest, std::move(tmp)); });
+}
+
+//容量足够且元素可无异常搬迁时，在原内存中腾出空位后直接构造新元素；构造失败则把后缀搬回原处，容器保持不变。
+//否则在新内存中一次建成，同样只在全部成功后才替换旧内存。
+template <typename T, typename Alloc, typename Growth>
+template <typename Construct>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::M_insert_n(pointer pos, size_type count, Construct construct) {
+    if (count == 0) {
+        return iterator(pos);
+    }
+    if (!M_can_insert_in_place(count)) {
+        return M_realloc_insert(pos, count, construct);
+    }
+    M_open_gap(pos, count);
+    try {
+        construct(pos);
+    } catch (...) {
+        M_close_gap(pos, count);
+        throw;
+    }
+    M_impl.M_finish += count;
+    return iterator(pos);
+}
+
+//新元素先在新内存中构造，此时旧内存原封未动，参数引用容器内元素也是安全的；随后前缀与后缀各搬迁一次。
+template <typename T, typename Alloc, typename Growth>
+template <typename Construct>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::M_realloc_insert(pointer pos, size_type count, Construct construct) {
+    auto required = this->size() + count;
+    auto new_cap = required <= capacity() ? capacity() : M_grow_capacity(required);
+    auto new_start = this->M_allocate(new_cap);
+    auto new_pos = new_start + (pos - M_impl.M_start);
+    try {
+        construct(new_pos);
+    } catch (...) {
+        M_deallocate(new_start, new_cap);
+        throw;
+    }
+    try {
+        M_relocate_around(pos, new_start, new_pos + count, std::integral_constant<bool, nothrow_relocatable>());
+    } catch (...) {
+        destroy_a(new_pos, new_pos + count, M_get_allocator());
+        M_deallocate(new_start, new_cap);
+        throw;
+    }
+    M_deallocate(M_impl.M_start, capacity());
+    M_impl.M_start = new_start;
+    M_impl.M_finish = new_start + required;
+    M_impl.M_end_of_storage = new_start + new_cap;
+    return iterator(new_pos);
+}
+
+//元素可无异常搬迁时，前缀与后缀直接搬迁到新内存。
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::M_relocate_around(pointer pos, pointer new_start, pointer new_suffix, std::true_type) noexcept {
+    uninitialized_relocate(M_impl.M_start, pos, new_start);
+    uninitialized_relocate(pos, M_impl.M_finish, new_suffix);
+}
+
+//否则先复制前缀与后缀，全部成功后再析构旧元素；复制抛出异常时旧内存中的元素不受影响。
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::M_relocate_around(pointer pos, pointer new_start, pointer new_suffix, std::false_type) {
+    auto prefix_end = uninitialized_copy_a(M_impl.M_start, pos, new_start, M_get_allocator());
+    try {
+        uninitialized_copy_a(pos, M_impl.M_finish, new_suffix, M_get_allocator());
+    } catch (...) {
+        destroy_a(new_start, prefix_end, M_get_allocator());
+        throw;
+    }
+    destroy_a(M_impl.M_start, M_impl.M_finish, M_get_allocator());
+}
+
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::M_open_gap(pointer pos, size_type count) noexcept {
+    M_shift_tail(pos, M_impl.M_finish, pos + count, is_trivially_relocatable<T>());
+}
+
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::M_close_gap(pointer pos, size_type count) noexcept {
+    M_shift_tail(pos + count, M_impl.M_finish + count, pos, is_trivially_relocatable<T>());
+}
+
+//可平凡重定位类型整段 memmove 。
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::M_shift_tail(pointer first, pointer last, pointer dest, std::true_type) noexcept {
+    if (first != last) {
+        std::memmove(static_cast<void *>(dest), static_cast<const void *>(first), (last - first) * sizeof(T));
+    }
+}
+
+//其他类型逐个移动构造到目标位置并析构原对象。区间可能重叠，后移时从后往前，前移时从前往后。
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::M_shift_tail(pointer first, pointer last, pointer dest, std::false_type) noexcept {
+    if (dest > first) {
+        auto dest_last = dest + (last - first);
+        while (last != first) {
+            --last;
+            --dest_last;
+            this->M_construct(dest_last, std::move(*last));
+            this->M_destroy(last);
+        }
     } else {
-        auto pos_dif = pos.current - M_impl.M_start;
-        auto new_size = 2 * this->size();
-        if (!new_size)
-            new_size = 2;
-        M_reallocate(new_size);
-        auto now_ptr = M_impl.M_finish;
-        ++M_impl.M_finish;
-        auto pos_ptr = M_impl.M_start + pos_dif - 1;
-        new (now_ptr) T;
-        while (now_ptr != pos_ptr) {
-            *now_ptr = std::move(*(now_ptr - 1));
-            --now_ptr;
+        for (; first != last; ++first, ++dest) {
+            this->M_construct(dest, std::move(*first));
+            this->M_destroy(first);
         }
-        ++pos_ptr;
-        new (pos_ptr) T(std::forward<Args>(args)...);
-        return iterator(pos_ptr);
     }
 }
 
-template <typename T>
-typename vector<T>::iterator vector<T>::erase(vector::const_iterator pos) {
-    auto pos_ptr = pos.current;
-    pos_ptr->~T();
-    new (pos_ptr) T;
-    auto now_ptr = pos_ptr + 1;
-    while (now_ptr != M_impl.M_finish) {
-        *(now_ptr - 1) = std::move(*now_ptr);
-        ++now_ptr;
-    }
-    --M_impl.M_finish;
-     M_impl.M_finish->~T();
-    return iterator(pos_ptr);
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::erase(vector::const_iterator pos) {
+    return erase(pos, pos + 1);
 }
 
-template <typename T>
-typename vector<T>::iterator vector<T>::erase(const_iterator first, const_iterator last) {
-    auto count = std::distance(first, last);
-    if (count == 0) {
-        return last;
-    }
+template <typename T, typename Alloc, typename Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::erase(const_iterator first, const_iterator last) {
     auto first_ptr = first.current, last_ptr = last.current;
-    auto now_ptr = first_ptr;
-    while (now_ptr != last_ptr) {
-        now_ptr->~T();
-        if (now_ptr + count < M_impl.M_finish) {
-            new (now_ptr) T;
-        }
-        ++now_ptr;
-    }
-    now_ptr = first_ptr;
-    while (now_ptr != M_impl.M_finish) {
-        if (now_ptr + count < M_impl.M_finish) {
-            *now_ptr = std::move(*(now_ptr + count));
-        } else {
-            break;
-        }
-        ++now_ptr;
+    if (first_ptr != last_ptr) {
+        M_erase_impl(first_ptr, last_ptr, is_trivially_relocatable<T>());
     }
-    M_impl.M_finish -= count;
     return iterator(first_ptr);
 }
 
-template <typename T>
-void vector<T>::push_back(const T &value) {
-    if (M_impl.M_finish != M_impl.M_end_of_storage) {
-        new (M_impl.M_finish) T(value);
-        ++M_impl.M_finish;
-    } else {
-        auto new_size = 2 * this->size();
-        if (!new_size)
-            new_size = 2;
-        M_reallocate(new_size);
-        new (M_impl.M_finish) T(value);
-        ++M_impl.M_finish;
-    }
+//可平凡重定位类型析构被删除的元素后，后缀整段 memmove 到空位上。
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::M_erase_impl(pointer first, pointer last, std::true_type) noexcept {
+    destroy_a(first, last, M_get_allocator());
+    M_shift_tail(last, M_impl.M_finish, first, std::true_type());
+    M_impl.M_finish -= last - first;
 }
 
-template <typename T>
-void vector<T>::push_back(T &&value) {
+//其他类型把后缀移动赋值到前面，再析构尾部多出的元素。
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::M_erase_impl(pointer first, pointer last, std::false_type) {
+    auto new_finish = std::move(last, M_impl.M_finish, first);
+    destroy_a(new_finish, M_impl.M_finish, M_get_allocator());
+    M_impl.M_finish = new_finish;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::push_back(const T &value) {
+    emplace_back(value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::push_back(T &&value) {
     emplace_back(std::move(value));
 }
 
-template <typename T>
+template <typename T, typename Alloc, typename Growth>
 template <typename... Args>
-void vector<T>::emplace_back(Args &&...args) {
+void vector<T, Alloc, Growth>::emplace_back(Args &&...args) {
     if (M_impl.M_finish != M_impl.M_end_of_storage) {
-        new (M_impl.M_finish) T(std::forward<Args>(args)...);
+        this->M_construct(M_impl.M_finish, std::forward<Args>(args)...);
         ++M_impl.M_finish;
     } else {
-        auto new_size = 2 * this->size();
-        if (!new_size)
-            new_size = 2;
-        M_reallocate(new_size);
-        new (M_impl.M_finish) T(std::forward<Args>(args)...);
-        ++M_impl.M_finish;
+        //先在新内存中构造新元素，参数引用容器内元素时也不会读到已搬走的对象。
+        M_realloc_insert(M_impl.M_finish, 1, [&](pointer dest) { this->M_construct(dest, std::forward<Args>(args)...); });
     }
 }
 
-template <typename T>
-void vector<T>::pop_back() {
-    M_impl.M_finish->~T();
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::pop_back() {
     --M_impl.M_finish;
+    this->M_destroy(M_impl.M_finish);
 }
 
-template <typename T>
-void vector<T>::swap(vector &other) {
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::swap(vector &other) {
     M_impl.M_swap_data(other.M_impl);
+    alloc_on_swap(M_get_allocator(), other.M_get_allocator(), typename alloc_traits::propagate_on_container_swap());
 }
 
-template <typename T>
-void vector<T>::reserve(size_type new_cap) {
+template <typename T, typename Alloc, typename Growth>
+void vector<T, Alloc, Growth>::reserve(size_type new_cap) {
     if (new_cap > this->capacity()) {
         M_reallocate(new_cap);
     }
 }
 
+//int32_t 、 uint8_t 、 float 、 double 的比较交给 SIMD 核函数，结果与逐个比较相同。
 template <typename T>
-bool operator==(const vector<T> &lhs, const vector<T> &rhs) {
-    return (lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+bool vector_equal_impl(const T *lhs, const T *rhs, size_t n, std::true_type) {
+    return simd::equal(lhs, rhs, n);
 }
 
 template <typename T>
-bool operator!=(const vector<T> &lhs, const vector<T> &rhs) {
-    return !(lhs == rhs);
+bool vector_equal_impl(const T *lhs, const T *rhs, size_t n, std::false_type) {
+    return std::equal(lhs, lhs + n, rhs);
 }
 
 template <typename T>
-bool operator<(const vector<T> &lhs, const vector<T> &rhs) {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+bool vector_less_impl(const T *lhs, size_t lhs_n, const T *rhs, size_t rhs_n, std::true_type) {
+    return simd::lexicographical_less(lhs, lhs_n, rhs, rhs_n);
 }
 
 template <typename T>
-bool operator<=(const vector<T> &lhs, const vector<T> &rhs) {
+bool vector_less_impl(const T *lhs, size_t lhs_n, const T *rhs, size_t rhs_n, std::false_type) {
+    return std::lexicographical_compare(lhs, lhs + lhs_n, rhs, rhs + rhs_n);
+}
+
+template <typename T, typename Alloc, typename Growth>
+bool operator==(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs) {
+    return lhs.size() == rhs.size() && vector_equal_impl(lhs.data(), rhs.data(), lhs.size(), simd::has_kernel<T>());
+}
+
+template <typename T, typename Alloc, typename Growth>
+bool operator!=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Alloc, typename Growth>
+bool operator<(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs) {
+    return vector_less_impl(lhs.data(), lhs.size(), rhs.data(), rhs.size(), simd::has_kernel<T>());
+}
+
+template <typename T, typename Alloc, typename Growth>
+bool operator<=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs) {
     return !(rhs < lhs);
 }
 
-template <typename T>
-bool operator>(const vector<T> &lhs, const vector<T> &rhs) {
+template <typename T, typename Alloc, typename Growth>
+bool operator>(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs) {
     return rhs < lhs;
 }
 
-template <typename T>
-bool operator>=(const vector<T> &lhs, const vector<T> &rhs) {
+template <typename T, typename Alloc, typename Growth>
+bool operator>=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs) {
     return !(lhs < rhs);
 }
 
-template <typename T>
-void swap(vector<T> &lhs, vector<T> &rhs) {
+template <typename T, typename Alloc, typename Growth>
+void swap(vector<T, Alloc, Growth> &lhs, vector<T, Alloc, Growth> &rhs) {
     lhs.swap(rhs);
 }
 
+template <typename T, typename U>
+const T *vector_find_impl(const T *first, const T *last, const U &value, std::true_type) {
+    return first + simd::find(first, static_cast<size_t>(last - first), value);
+}
+
+template <typename T, typename U>
+const T *vector_find_impl(const T *first, const T *last, const U &value, std::false_type) {
+    return std::find(first, last, value);
+}
+
+template <typename T, typename U>
+size_t vector_count_impl(const T *first, const T *last, const U &value, std::true_type) {
+    return simd::count(first, static_cast<size_t>(last - first), value);
+}
+
+template <typename T, typename U>
+size_t vector_count_impl(const T *first, const T *last, const U &value, std::false_type) {
+    return static_cast<size_t>(std::count(first, last, value));
+}
+
+///查找的值与元素同类型且有 SIMD 核函数时按块比较，否则同 std::find 。
+template <typename T, typename U>
+using vector_simd_search = std::integral_constant<bool, simd::has_kernel<T>::value && std::is_same<T, U>::value>;
+
+template <typename T, typename U>
+vector_const_iterator<T> find(vector_const_iterator<T> first, vector_const_iterator<T> last, const U &value) {
+    auto pos = vector_find_impl(first.operator->(), last.operator->(), value, vector_simd_search<T, U>());
+    return first + (pos - first.operator->());
+}
+
+template <typename T, typename U>
+vector_iterator<T> find(vector_iterator<T> first, vector_iterator<T> last, const U &value) {
+    auto pos = vector_find_impl<T>(first.operator->(), last.operator->(), value, vector_simd_search<T, U>());
+    return first + (pos - first.operator->());
+}
+
+template <typename T, typename U>
+std::ptrdiff_t count(vector_const_iterator<T> first, vector_const_iterator<T> last, const U &value) {
+    return static_cast<std::ptrdiff_t>(vector_count_impl(first.operator->(), last.operator->(), value, vector_simd_search<T, U>()));
+}
+
+template <typename T, typename U>
+std::ptrdiff_t count(vector_iterator<T> first, vector_iterator<T> last, const U &value) {
+    return static_cast<std::ptrdiff_t>(vector_count_impl<T>(first.operator->(), last.operator->(), value, vector_simd_search<T, U>()));
+}
+
 template <typename Iter, typename num_type, typename = RequireInputIter<Iter>>
 Iter operator+(num_type &n, Iter iter) {
     return Iter(iter + n);
 }
+
+namespace pmr {
+///使用多态分配器的 vector ，可在运行期选择单调缓冲、内存池或 malloc 作为内存来源。
+template <typename T, typename Growth = double_growth>
+using vector = mystl::vector<T, polymorphic_allocator<T>, Growth>;
+} // namespace pmr
 } // namespace mystl
\ No newline at end of file
@@ -0,0 +1,196 @@
+#ifndef MYTINYSTL_PAR_TEST_H_
+#define MYTINYSTL_PAR_TEST_H_
+
+// par test : 测试 mystl::par 并行算法的结果与串行算法一致，以及线程数从 1 增加到硬件线程数时的加速比
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "my_parallel.hpp"
+#include "my_vector.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace par_test {
+
+mystl::vector<int> random_vector(size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(0, 1 << 20);
+    mystl::vector<int> v(n);
+    for (auto &x : v) {
+        x = dist(gen);
+    }
+    return v;
+}
+
+// 超过串行阈值的输入上，与串行算法逐一对比结果
+bool check_large(mystl::thread_pool &pool, size_t n) {
+    auto v = random_vector(n, 7);
+    bool ok = true;
+    auto w = v;
+    mystl::par::for_each(pool, w.begin(), w.end(), [](int &x) { x = x * 3 + 1; });
+    for (size_t i = 0; i < n; ++i) {
+        ok = ok && w[i] == v[i] * 3 + 1;
+    }
+    mystl::vector<long long> t(n);
+    mystl::par::transform(pool, v.begin(), v.end(), t.begin(), [](int x) { return static_cast<long long>(x) * x; });
+    ok = ok && mystl::par::reduce(pool, t.begin(), t.end(), 0LL) == std::accumulate(t.begin(), t.end(), 0LL);
+    mystl::vector<long long> s(n), expect(n);
+    mystl::par::inclusive_scan(pool, t.begin(), t.end(), s.begin());
+    std::partial_sum(t.begin(), t.end(), expect.begin());
+    ok = ok && s == expect;
+    mystl::par::inclusive_scan(pool, t.begin(), t.end(), t.begin());
+    ok = ok && t == expect;
+    auto sorted = v;
+    std::sort(sorted.begin(), sorted.end());
+    w = v;
+    mystl::par::sort(pool, w.begin(), w.end());
+    ok = ok && w == sorted;
+    // 只按高位比较，相等元素很多，检查稳定性
+    auto high = [](int a, int b) { return (a >> 12) < (b >> 12); };
+    auto stable = v;
+    std::stable_sort(stable.begin(), stable.end(), high);
+    w = v;
+    mystl::par::stable_sort(pool, w.begin(), w.end(), high);
+    ok = ok && w == stable;
+    mystl::vector<std::string> strs(n / 8);
+    for (size_t i = 0; i < strs.size(); ++i) {
+        strs[i] = std::to_string(v[i]) + "-a string that needs its own heap block";
+    }
+    auto strs_sorted = strs;
+    std::sort(strs_sorted.begin(), strs_sorted.end());
+    mystl::par::sort(pool, strs.begin(), strs.end());
+    ok = ok && strs == strs_sorted;
+    return ok;
+}
+
+// 任务抛出的异常在全部任务结束后传回调用者
+bool check_exception(mystl::thread_pool &pool) {
+    auto v = random_vector(mystl::par::serial_cutoff * 4, 1);
+    v[v.size() / 2] = -1;
+    try {
+        mystl::par::for_each(pool, v.begin(), v.end(), [](int x) {
+            if (x < 0) {
+                throw std::runtime_error("negative");
+            }
+        });
+    } catch (const std::runtime_error &) {
+        return true;
+    }
+    return false;
+}
+
+// 以 threads 个线程（含调用线程）运行 bench_fn ，与单线程的结果 single 对比输出一行，比值为加速比
+template <class Bench>
+const bench::Result &scaling_row(const char *op, size_t n, size_t threads, const bench::Result *single, Bench bench_fn) {
+    mystl::thread_pool pool(threads - 1);
+    auto &r = bench::Run(std::string("par::") + op, std::to_string(threads) + " threads", n, [&](bench::State &state) { bench_fn(state, pool); });
+    print_bench_row(std::string(op) + " " + std::to_string(threads), single ? *single : r, r, true);
+    return r;
+}
+
+// 线程数取 1, 2, 4, ... 直到硬件线程数
+template <class Bench>
+void scaling_test(const char *op, size_t n, Bench bench_fn) {
+    size_t max_threads = std::thread::hardware_concurrency();
+    max_threads = max_threads ? max_threads : 1;
+    auto &single = scaling_row(op, n, 1, nullptr, bench_fn);
+    for (size_t t = 2; t <= max_threads; t *= 2) {
+        scaling_row(op, n, t, &single, bench_fn);
+    }
+    if ((max_threads & (max_threads - 1)) != 0) {
+        scaling_row(op, n, max_threads, &single, bench_fn);
+    }
+}
+
+void par_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[---------------- Run algorithm test : parallel ----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    mystl::vector<int> v1{5, 3, 8, 1, 9, 2, 7};
+    mystl::vector<int> v2(v1.size());
+    mystl::thread_pool pool(3);
+    std::cout << std::boolalpha;
+    FUN_VALUE(pool.concurrency());
+    FUN_AFTER(v1, mystl::par::for_each(v1.begin(), v1.end(), [](int &x) { x *= 2; }));
+    FUN_AFTER(v2, mystl::par::transform(v1.begin(), v1.end(), v2.begin(), [](int x) { return x + 1; }));
+    FUN_VALUE(mystl::par::reduce(v2.begin(), v2.end()));
+    FUN_VALUE(mystl::par::reduce(v2.begin(), v2.end(), 1, [](int a, int b) { return a * b % 1000; }));
+    FUN_AFTER(v2, mystl::par::inclusive_scan(v2.begin(), v2.end(), v2.begin()));
+    FUN_AFTER(v1, mystl::par::sort(v1.begin(), v1.end(), std::greater<int>()));
+    FUN_AFTER(v1, mystl::par::stable_sort(pool, v1.begin(), v1.end()));
+    FUN_VALUE(check_large(pool, mystl::par::serial_cutoff * 40 + 3));
+    FUN_VALUE(check_large(mystl::thread_pool::instance(), mystl::par::serial_cutoff * 40 + 3));
+    FUN_VALUE(check_exception(pool));
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|     op  threads     |  1 thread   |  n threads  |   speedup   |\n";
+    size_t n = LEN3 _M;
+    auto data = random_vector(n, 42);
+    scaling_test("for_each", n, [&](bench::State &state, mystl::thread_pool &p) {
+        auto v = data;
+        for (auto _ : state) {
+            mystl::par::for_each(p, v.begin(), v.end(), [](int &x) { x = x * 7 + 3; });
+            bench::ClobberMemory();
+        }
+    });
+    scaling_test("transform", n, [&](bench::State &state, mystl::thread_pool &p) {
+        mystl::vector<double> out(n);
+        for (auto _ : state) {
+            mystl::par::transform(p, data.begin(), data.end(), out.begin(), [](int x) { return x * 0.5 + 1.0; });
+            bench::ClobberMemory();
+        }
+    });
+    scaling_test("reduce", n, [&](bench::State &state, mystl::thread_pool &p) {
+        for (auto _ : state) {
+            bench::DoNotOptimize(mystl::par::reduce(p, data.begin(), data.end(), 0LL));
+        }
+    });
+    scaling_test("scan", n, [&](bench::State &state, mystl::thread_pool &p) {
+        mystl::vector<long long> in(data.begin(), data.end()); //前缀和超出 int 的范围
+        mystl::vector<long long> out(n);
+        for (auto _ : state) {
+            mystl::par::inclusive_scan(p, in.begin(), in.end(), out.begin());
+            bench::ClobberMemory();
+        }
+    });
+    scaling_test("sort", n, [&](bench::State &state, mystl::thread_pool &p) {
+        for (auto _ : state) {
+            {
+                state.PauseTiming();
+                auto v = data;
+                state.ResumeTiming();
+                mystl::par::sort(p, v.begin(), v.end());
+                bench::DoNotOptimize(v.data());
+                state.PauseTiming();
+            }
+            state.ResumeTiming();
+        }
+    });
+    scaling_test("stable_sort", n, [&](bench::State &state, mystl::thread_pool &p) {
+        for (auto _ : state) {
+            {
+                state.PauseTiming();
+                auto v = data;
+                state.ResumeTiming();
+                mystl::par::stable_sort(p, v.begin(), v.end());
+                bench::DoNotOptimize(v.data());
+                state.PauseTiming();
+            }
+            state.ResumeTiming();
+        }
+    });
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[---------------- End algorithm test : parallel ----------------]\n";
+}
+
+}}}    // namespace mystl::test::par_test
+#endif // !MYTINYSTL_PAR_TEST_H_
@@ -0,0 +1,288 @@
+#ifndef MYTINYSTL_RING_BUFFER_TEST_H_
+#define MYTINYSTL_RING_BUFFER_TEST_H_
+
+// ring_buffer test : 测试 ring_buffer 的接口、与 std::deque 随机对比的结果，以及定长先进先出队列的性能
+
+#include <deque>
+#include <random>
+#include <string>
+
+#include "deque_test.h"
+#include "my_deque.hpp"
+#include "my_ring_buffer.hpp"
+#include "my_vector.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace ring_buffer_test {
+
+static_assert(std::is_same<std::iterator_traits<mystl::ring_buffer<int>::iterator>::iterator_category, std::random_access_iterator_tag>::value,
+              "ring_buffer iterator must be random access");
+static_assert(std::is_trivially_copyable<mystl::ring_buffer<int>::iterator>::value, "ring_buffer iterator must be trivially copyable");
+static_assert(std::is_nothrow_move_assignable<mystl::ring_buffer<int>>::value, "move assignment with an always-equal allocator cannot throw");
+static_assert(!std::is_nothrow_move_assignable<mystl::pmr::ring_buffer<int>>::value, "move assignment between unequal pmr allocators allocates");
+
+// 插入、弹出、成块写入与读出随机交错，每步与按相同策略维护的 std::deque 对比。元素为 std::string ，检查非平凡类型的构造与析构
+template <typename Policy>
+bool check_random(unsigned seed) {
+    std::mt19937 gen(seed);
+    mystl::ring_buffer<std::string, mystl::allocator<std::string>, Policy> b(100);
+    std::deque<std::string> r;
+    std::string block[200];
+    std::string out[200];
+    bool ok = b.capacity() == 128;
+    for (int i = 0; i < 20000 && ok; ++i) {
+        auto v = std::to_string(gen());
+        switch (gen() % 6) {
+        case 0:
+        case 1: {
+            bool stored = b.push_back(v);
+            if (r.size() < b.capacity()) {
+                ok = stored;
+                r.push_back(v);
+            } else if (Policy::overwrite) {
+                ok = stored;
+                r.pop_front();
+                r.push_back(v);
+            } else {
+                ok = !stored;
+            }
+            break;
+        }
+        case 2:
+            if (!r.empty()) {
+                b.pop_front();
+                r.pop_front();
+            }
+            break;
+        case 3:
+            if (!r.empty()) {
+                b.pop_back();
+                r.pop_back();
+            }
+            break;
+        case 4: {
+            auto count = gen() % 200;
+            for (size_t j = 0; j < count; ++j) {
+                block[j] = v + std::to_string(j);
+            }
+            auto written = b.write(block, count);
+            size_t expect = Policy::overwrite ? std::min<size_t>(count, b.capacity()) : std::min<size_t>(count, b.capacity() - r.size());
+            ok = written == expect;
+            for (size_t j = Policy::overwrite ? count - written : 0; j < (Policy::overwrite ? count : written); ++j) {
+                if (r.size() == b.capacity()) {
+                    r.pop_front();
+                }
+                r.push_back(block[j]);
+            }
+            break;
+        }
+        default: {
+            auto count = gen() % 100;
+            auto got = b.read(out, count);
+            ok = got == std::min<size_t>(count, r.size());
+            for (size_t j = 0; j < got && ok; ++j) {
+                ok = out[j] == r.front();
+                r.pop_front();
+            }
+            break;
+        }
+        }
+        auto one = b.array_one();
+        auto two = b.array_two();
+        ok = ok && b.size() == r.size() && one.second + two.second == r.size() && std::equal(one.first, one.first + one.second, r.begin()) &&
+             std::equal(two.first, two.first + two.second, r.begin() + static_cast<std::ptrdiff_t>(one.second));
+    }
+    auto c(b);
+    auto m(std::move(c));
+    return ok && std::equal(b.begin(), b.end(), r.begin(), r.end()) && m == b && c.empty();
+}
+
+// 构造后只申请一次内存，覆盖写入不移动存储，元素的地址在回绕后重复使用
+bool check_fixed_storage() {
+    mystl::ring_buffer<int> b(5);
+    b.push_back(0);
+    auto slot = &b.front();
+    for (int i = 1; i < 1000; ++i) {
+        b.push_back(i);
+    }
+    return b.capacity() == 8 && b.full() && b.front() == 992 && &b[0] == slot && b.back() == 999;
+}
+
+// 已满时压入容器自身的元素：新值在最旧的元素析构之前构造，复制的是有效的字符串
+bool check_self_push() {
+    mystl::ring_buffer<std::string> b(2);
+    b.push_back(std::string(40, 'a'));
+    b.push_back(std::string(40, 'b'));
+    b.push_back(b.front());
+    b.push_back(b.back());
+    return b.size() == 2 && b.front() == std::string(40, 'a') && b.back() == std::string(40, 'a');
+}
+
+// 先进先出队列：不断在尾部加入、从头部取出，队列长度保持在 1000 左右
+template <typename T>
+void fifo_push(mystl::ring_buffer<T> &q, const T &value) {
+    q.push_back(value);
+}
+
+template <typename Queue, typename T>
+void fifo_push(Queue &q, const T &value) {
+    q.push_back(value);
+    if (q.size() > 1000) {
+        deque_test::fifo_pop(q);
+    }
+}
+
+template <typename Queue>
+Queue make_fifo() {
+    return Queue();
+}
+
+template <>
+mystl::ring_buffer<int> make_fifo<mystl::ring_buffer<int>>() {
+    return mystl::ring_buffer<int>(1024);
+}
+
+template <typename Queue>
+void fifo_queue_test(const char *variant, size_t count) {
+    auto &r = bench::Run("ring_buffer<int>::fifo", variant, count, [count](bench::State &state) {
+        for (auto _ : state) {
+            auto q = make_fifo<Queue>();
+            for (size_t i = 0; i < count; ++i) {
+                fifo_push(q, static_cast<int>(i));
+            }
+            bench::DoNotOptimize(q);
+        }
+    });
+    bench::PrintCell(r, WIDE);
+}
+
+// 成块读写：每次写入 256 个采样，再成块读出 256 个
+template <typename Queue>
+void block_io(Queue &q, const int *src, int *dest, size_t n) {
+    q.insert(q.end(), src, src + n);
+    std::copy(q.begin(), q.begin() + static_cast<std::ptrdiff_t>(n), dest);
+    q.erase(q.begin(), q.begin() + static_cast<std::ptrdiff_t>(n));
+}
+
+void block_io(mystl::ring_buffer<int> &q, const int *src, int *dest, size_t n) {
+    q.write(src, n);
+    q.read(dest, n);
+}
+
+template <typename Queue>
+void block_io_test(const char *variant, size_t count) {
+    auto &r = bench::Run("ring_buffer<int>::block_io", variant, count, [count](bench::State &state) {
+        int src[256] = {};
+        int dest[256];
+        for (auto _ : state) {
+            auto q = make_fifo<Queue>();
+            for (size_t i = 0; i < 1000; ++i) {
+                q.push_back(static_cast<int>(i));
+            }
+            for (size_t i = 0; i < count; i += 256) {
+                src[0] = static_cast<int>(i);
+                block_io(q, src, dest, 256);
+                bench::DoNotOptimize(dest);
+            }
+            bench::DoNotOptimize(q);
+        }
+    });
+    bench::PrintCell(r, WIDE);
+}
+
+void ring_buffer_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : ring_buffer ---------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    int out[10] = {};
+    mystl::ring_buffer<int> b1(8);
+    mystl::ring_buffer<int, mystl::allocator<int>, mystl::reject_on_full> b2(4);
+    mystl::ring_buffer<int> b3(b1);
+    mystl::ring_buffer<int> b4(std::move(b3));
+    mystl::ring_buffer<int> b5, b6;
+    b5 = b1;
+    b6 = std::move(b4);
+
+    FUN_AFTER(b1, b1.push_back(1));
+    FUN_AFTER(b1, b1.emplace_back(2));
+    FUN_AFTER(b1, b1.write(a, 10));
+    FUN_AFTER(b1, b1.push_back(11));
+    FUN_AFTER(b1, b1.pop_front());
+    FUN_AFTER(b1, b1.pop_back());
+    FUN_AFTER(b1, b1.read(out, 2));
+    FUN_AFTER(b1, b1.pop_front(1));
+    FUN_AFTER(b1, b1.write(a, 4));
+    FUN_AFTER(b2, b2.write(a, 3));
+    FUN_AFTER(b2, b2.write(a + 3, 3));
+    FUN_AFTER(b2, b2.push_back(100));
+    FUN_AFTER(b2, b2.pop_front());
+    FUN_VALUE(out[0]);
+    FUN_VALUE(*b1.begin());
+    FUN_VALUE(*(b1.end() - 1));
+    FUN_VALUE(*b1.rbegin());
+    FUN_VALUE(b1.front());
+    FUN_VALUE(b1.back());
+    FUN_VALUE(b1[1]);
+    FUN_VALUE(b1.at(2));
+    FUN_VALUE(b1.size());
+    FUN_VALUE(b1.capacity());
+    FUN_VALUE(b1.array_one().second);
+    FUN_VALUE(b1.array_two().second);
+    FUN_AFTER(b1, b1.swap(b5));
+    FUN_AFTER(b5, b5.clear());
+    std::cout << std::boolalpha;
+    FUN_VALUE(b5.empty());
+    FUN_VALUE(b2.full());
+    FUN_VALUE(b2.push_back(200));
+    FUN_VALUE((b1 == b6));
+    FUN_VALUE(check_random<mystl::overwrite_oldest>(1));
+    FUN_VALUE(check_random<mystl::reject_on_full>(2));
+    FUN_VALUE(check_fixed_storage());
+    FUN_VALUE(check_self_push());
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|     fifo queue      |";
+    TEST_LEN(LEN1 _L, LEN2 _L, LEN3 _L, WIDE);
+    std::cout << "|         std         |";
+    fifo_queue_test<std::deque<int>>("std", LEN1 _L);
+    fifo_queue_test<std::deque<int>>("std", LEN2 _L);
+    fifo_queue_test<std::deque<int>>("std", LEN3 _L);
+    std::cout << "\n|        mystl        |";
+    fifo_queue_test<mystl::ring_buffer<int>>("mystl", LEN1 _L);
+    fifo_queue_test<mystl::ring_buffer<int>>("mystl", LEN2 _L);
+    fifo_queue_test<mystl::ring_buffer<int>>("mystl", LEN3 _L);
+    std::cout << "\n|     mystl deque     |";
+    fifo_queue_test<mystl::deque<int>>("mystl deque", LEN1 _L);
+    fifo_queue_test<mystl::deque<int>>("mystl deque", LEN2 _L);
+    fifo_queue_test<mystl::deque<int>>("mystl deque", LEN3 _L);
+    std::cout << "\n|    mystl vector     |";
+    fifo_queue_test<mystl::vector<int>>("mystl vector", LEN1 _L);
+    fifo_queue_test<mystl::vector<int>>("mystl vector", LEN2 _L);
+    fifo_queue_test<mystl::vector<int>>("mystl vector", LEN3 _L);
+    bench::PrintComparisonRows("ring_buffer<int>::fifo", LEN1 _L, LEN2 _L, LEN3 _L, WIDE);
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|      block io       |";
+    TEST_LEN(LEN1 _L, LEN2 _L, LEN3 _L, WIDE);
+    std::cout << "|         std         |";
+    block_io_test<std::deque<int>>("std", LEN1 _L);
+    block_io_test<std::deque<int>>("std", LEN2 _L);
+    block_io_test<std::deque<int>>("std", LEN3 _L);
+    std::cout << "\n|        mystl        |";
+    block_io_test<mystl::ring_buffer<int>>("mystl", LEN1 _L);
+    block_io_test<mystl::ring_buffer<int>>("mystl", LEN2 _L);
+    block_io_test<mystl::ring_buffer<int>>("mystl", LEN3 _L);
+    bench::PrintComparisonRows("ring_buffer<int>::block_io", LEN1 _L, LEN2 _L, LEN3 _L, WIDE);
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[-------------- End container test : ring_buffer ---------------]\n";
+}
+
+}}}    // namespace mystl::test::ring_buffer_test
+#endif // !MYTINYSTL_RING_BUFFER_TEST_H_
@@ -0,0 +1,118 @@
+#ifndef MYTINYSTL_SET_TEST_H_
+#define MYTINYSTL_SET_TEST_H_
+
+// set test : 测试 set, multiset 的接口、与 std::set, std::multiset 随机对比的结果，以及 insert, find 的性能
+
+#include <random>
+#include <set>
+
+#include "my_set.hpp"
+#include "my_vector.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace set_test {
+
+static_assert(std::is_same<mystl::set<int>::iterator, mystl::set<int>::const_iterator>::value, "set elements must not be modified through iterators");
+
+// 随机插入与删除，与 std::set / std::multiset 对比；最后按区间删除一半元素
+template <class Set, class Ref>
+bool check_random(unsigned seed) {
+    std::mt19937 gen(seed);
+    Set s;
+    Ref r;
+    bool ok = true;
+    for (int i = 0; i < 50000; ++i) {
+        int k = static_cast<int>(gen() % 3000);
+        if (gen() % 3) {
+            s.insert(k);
+            r.insert(k);
+        } else {
+            ok = ok && s.erase(k) == r.erase(k);
+        }
+    }
+    for (int k = 0; k < 3000; ++k) {
+        ok = ok && s.count(k) == r.count(k);
+    }
+    ok = ok && s.size() == r.size() && std::equal(s.begin(), s.end(), r.begin(), r.end());
+    s.erase(s.lower_bound(1000), s.upper_bound(2000));
+    r.erase(r.lower_bound(1000), r.upper_bound(2000));
+    ok = ok && std::equal(s.begin(), s.end(), r.begin(), r.end());
+    s.erase(s.begin(), s.end());
+    return ok && s.empty() && s.find(1) == s.end();
+}
+
+template <class Set>
+void insert_find(const mystl::vector<int> &keys) {
+    Set s;
+    for (auto k : keys) {
+        s.insert(k);
+    }
+    size_t hits = 0;
+    for (auto k : keys) {
+        hits += s.find(k) != s.end();
+    }
+    bench::DoNotOptimize(hits);
+}
+
+void set_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------------- Run container test : set ------------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = {5, 3, 5, 1, 3, 9};
+    mystl::set<int> s1;
+    mystl::set<int> s2(a, a + 6);
+    mystl::set<int> s3{1, 2, 3};
+    mystl::set<int> s4;
+    mystl::multiset<int> s5(a, a + 6);
+    mystl::vector<int> v{1, 2, 4, 8};
+    mystl::set<int> s6(mystl::sorted_unique, v.begin(), v.end());
+    s4 = s2;
+    std::cout << std::boolalpha;
+    COUT(s2);
+    COUT(s5);
+    COUT(s6);
+    FUN_VALUE(s2.size());
+    FUN_AFTER(s1, s1.insert({4, 2, 4, 8}));
+    FUN_AFTER(s1, s1.emplace(6));
+    FUN_AFTER(s1, s1.erase(s1.begin()));
+    FUN_AFTER(s1, s1.erase(8));
+    FUN_AFTER(s1, s1.insert(a, a + 6));
+    FUN_AFTER(s1, s1.swap(s3));
+    FUN_AFTER(s5, s5.erase(5));
+    FUN_VALUE(s1.contains(2));
+    FUN_VALUE(s3.count(7));
+    FUN_VALUE(*s3.lower_bound(7));
+    FUN_VALUE((s2 == s4));
+    FUN_VALUE((s1 == s3));
+    FUN_AFTER(s1, s1.clear());
+    FUN_VALUE((check_random<mystl::set<int>, std::set<int>>(1)));
+    FUN_VALUE((check_random<mystl::multiset<int>, std::multiset<int>>(2)));
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  op  element count  |     std     |    mystl    |   speedup   |\n";
+    for (size_t n : {size_t(LEN1 _M), size_t(LEN2 _M)}) {
+        std::mt19937 gen(7);
+        mystl::vector<int> keys(n);
+        for (auto &k : keys) {
+            k = static_cast<int>(gen());
+        }
+        bench_row(
+            "set<int>::", "insert_find", n,
+            [&](bench::State &state) {
+                for (auto _ : state) insert_find<std::set<int>>(keys);
+            },
+            [&](bench::State &state) {
+                for (auto _ : state) insert_find<mystl::set<int>>(keys);
+            });
+    }
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[------------------- End container test : set ------------------]\n";
+}
+
+}}}    // namespace mystl::test::set_test
+#endif // !MYTINYSTL_SET_TEST_H_
@@ -0,0 +1,179 @@
+#ifndef MYTINYSTL_SIMD_TEST_H_
+#define MYTINYSTL_SIMD_TEST_H_
+
+// simd test : 测试各指令集的 SIMD 核函数与标量版本逐位一致、与标准算法结果相同，以及 vector<float> 上扫描的性能
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+
+#include "my_simd.hpp"
+#include "my_vector.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace simd_test {
+
+template <class T>
+bool same_bits(const T &a, const T &b) {
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+// 值域较小以便 find/count 有命中；浮点混入 NaN 与 ±0
+template <class T>
+mystl::vector<T> random_data(size_t n, std::mt19937 &gen) {
+    std::uniform_int_distribution<int> dist(0, 60);
+    mystl::vector<T> v(n);
+    for (auto &x : v) {
+        x = static_cast<T>(dist(gen));
+        if (std::is_floating_point<T>::value) {
+            x = x / static_cast<T>(7) - static_cast<T>(3);
+        }
+    }
+    if (std::is_floating_point<T>::value && n > 8) {
+        v[n / 3] = std::numeric_limits<T>::quiet_NaN();
+        v[n / 2] = static_cast<T>(-0.0);
+        v[n / 2 + 1] = static_cast<T>(0.0);
+    }
+    return v;
+}
+
+// 对每个长度，在本机支持的每个指令集下运行全部核函数，与标量版本逐位比较，标量版本再与标准算法比较
+template <class T>
+bool check_isa(unsigned seed) {
+    std::mt19937 gen(seed);
+    auto saved = mystl::simd::active_isa();
+    bool ok = true;
+    for (size_t n = 0; n < 600; n += n < 160 ? 1 : 29) {
+        auto a = random_data<T>(n, gen);
+        auto b = a;
+        if (n) {
+            b[gen() % n] = static_cast<T>(1);
+        }
+        auto value = n ? a[gen() % n] : static_cast<T>(0);
+        mystl::simd::set_isa(mystl::simd::isa::scalar);
+        auto f = mystl::simd::find(a.data(), n, value);
+        auto c = mystl::simd::count(a.data(), n, value);
+        auto cl = mystl::simd::count_less(a.data(), n, value);
+        auto cg = mystl::simd::count_greater(a.data(), n, value);
+        auto m = mystl::simd::mismatch(a.data(), b.data(), n);
+        auto l1 = mystl::simd::lexicographical_less(a.data(), n, b.data(), n);
+        auto l2 = mystl::simd::lexicographical_less(b.data(), n, a.data(), n / 2);
+        auto s = mystl::simd::sum(a.data(), n);
+        auto lo = n ? mystl::simd::min(a.data(), n) : T();
+        auto hi = n ? mystl::simd::max(a.data(), n) : T();
+        ok = ok && f == static_cast<size_t>(std::find(a.begin(), a.end(), value) - a.begin());
+        ok = ok && c == static_cast<size_t>(std::count(a.begin(), a.end(), value));
+        ok = ok && cl == static_cast<size_t>(std::count_if(a.begin(), a.end(), [&](T x) { return x < value; }));
+        ok = ok && cg == static_cast<size_t>(std::count_if(a.begin(), a.end(), [&](T x) { return value < x; }));
+        ok = ok && m == static_cast<size_t>(std::mismatch(a.begin(), a.end(), b.begin()).first - a.begin());
+        ok = ok && l1 == std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+        ok = ok && l2 == std::lexicographical_compare(b.begin(), b.end(), a.begin(), a.begin() + n / 2);
+        for (auto level : {mystl::simd::isa::sse2, mystl::simd::isa::avx2, mystl::simd::isa::avx512}) {
+            if (mystl::simd::set_isa(level) != level) {
+                break;
+            }
+            ok = ok && mystl::simd::find(a.data(), n, value) == f;
+            ok = ok && mystl::simd::count(a.data(), n, value) == c;
+            ok = ok && mystl::simd::count_less(a.data(), n, value) == cl;
+            ok = ok && mystl::simd::count_greater(a.data(), n, value) == cg;
+            ok = ok && mystl::simd::mismatch(a.data(), b.data(), n) == m;
+            ok = ok && mystl::simd::lexicographical_less(a.data(), n, b.data(), n) == l1;
+            ok = ok && mystl::simd::lexicographical_less(b.data(), n, a.data(), n / 2) == l2;
+            ok = ok && same_bits(mystl::simd::sum(a.data(), n), s);
+            ok = ok && (!n || same_bits(mystl::simd::min(a.data(), n), lo));
+            ok = ok && (!n || same_bits(mystl::simd::max(a.data(), n), hi));
+        }
+    }
+    mystl::simd::set_isa(saved);
+    return ok;
+}
+
+// vector 的比较运算与 find/count 走核函数后，结果与标准算法相同
+bool check_vector() {
+    std::mt19937 gen(3);
+    auto a = random_data<float>(1000, gen);
+    auto b = a;
+    bool ok = !(a == b) && a != b; // 含 NaN ，不等于自身
+    a[1000 / 3] = b[1000 / 3] = 1.0f;
+    ok = ok && a == b && !(a < b) && !(b < a);
+    b[900] = 100.0f;
+    ok = ok && a < b && !(b < a) && a != b;
+    auto c = a;
+    c.pop_back();
+    ok = ok && c < a && !(a < c);
+    const auto &ca = a;
+    ok = ok && mystl::find(a.begin(), a.end(), b[900]) == a.end();
+    ok = ok && mystl::find(ca.begin(), ca.end(), a[700]) == std::find(ca.begin(), ca.end(), a[700]);
+    ok = ok && mystl::count(a.begin(), a.end(), a[10]) == std::count(a.begin(), a.end(), a[10]);
+    ok = ok && mystl::count(a.begin(), a.end(), -0.0f) == std::count(a.begin(), a.end(), 0.0f);
+    mystl::vector<std::string> s{"a", "b", "c"};
+    ok = ok && mystl::find(s.begin(), s.end(), "b") == s.begin() + 1 && mystl::count(s.begin(), s.end(), std::string("c")) == 1;
+    return ok;
+}
+
+void simd_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------------ Run algorithm test : simd ------------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    mystl::vector<int> v1{5, 3, 8, 1, 9, 2, 7};
+    mystl::vector<int> v2{5, 3, 8, 1, 9, 4};
+    std::cout << std::boolalpha;
+    FUN_VALUE(mystl::simd::isa_name(mystl::simd::detect_isa()));
+    FUN_VALUE(mystl::simd::find(v1.data(), v1.size(), 9));
+    FUN_VALUE(mystl::simd::count(v1.data(), v1.size(), 4));
+    FUN_VALUE(mystl::simd::count_less(v1.data(), v1.size(), 5));
+    FUN_VALUE(mystl::simd::mismatch(v1.data(), v2.data(), v2.size()));
+    FUN_VALUE(mystl::simd::min(v1.data(), v1.size()));
+    FUN_VALUE(mystl::simd::max(v1.data(), v1.size()));
+    FUN_VALUE(mystl::simd::sum(v1.data(), v1.size()));
+    FUN_VALUE((v1 < v2));
+    FUN_VALUE((v1 == v2));
+    FUN_VALUE(*mystl::find(v1.begin(), v1.end(), 8));
+    FUN_VALUE(check_isa<int32_t>(1));
+    FUN_VALUE(check_isa<uint8_t>(2));
+    FUN_VALUE(check_isa<float>(3));
+    FUN_VALUE(check_isa<double>(4));
+    FUN_VALUE(check_vector());
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  op  element count  |     std     |    mystl    |   speedup   |\n";
+    for (size_t n : {size_t(LEN1 _M) / 10, size_t(LEN3 _M)}) {
+        std::mt19937 gen(42);
+        auto a = random_data<float>(n, gen);
+        a[n / 3] = 1.0f;
+        auto b = a;
+        auto miss = 1000.0f;
+        bench_row(
+            "simd::", "find", n, [&](bench::State &state) { for (auto _ : state) bench::DoNotOptimize(std::find(a.begin(), a.end(), miss)); },
+            [&](bench::State &state) { for (auto _ : state) bench::DoNotOptimize(mystl::find(a.begin(), a.end(), miss)); });
+        bench_row(
+            "simd::", "count", n, [&](bench::State &state) { for (auto _ : state) bench::DoNotOptimize(std::count(a.begin(), a.end(), 1.0f)); },
+            [&](bench::State &state) { for (auto _ : state) bench::DoNotOptimize(mystl::count(a.begin(), a.end(), 1.0f)); });
+        bench_row(
+            "simd::", "equal", n, [&](bench::State &state) { for (auto _ : state) bench::DoNotOptimize(std::equal(a.begin(), a.end(), b.begin(), b.end())); },
+            [&](bench::State &state) { for (auto _ : state) bench::DoNotOptimize(a == b); });
+        bench_row(
+            "simd::", "less", n,
+            [&](bench::State &state) { for (auto _ : state) bench::DoNotOptimize(std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end())); },
+            [&](bench::State &state) { for (auto _ : state) bench::DoNotOptimize(a < b); });
+        bench_row(
+            "simd::", "min", n, [&](bench::State &state) { for (auto _ : state) bench::DoNotOptimize(*std::min_element(a.begin(), a.end())); },
+            [&](bench::State &state) { for (auto _ : state) bench::DoNotOptimize(mystl::simd::min(a.data(), a.size())); });
+        bench_row(
+            "simd::", "sum", n, [&](bench::State &state) { for (auto _ : state) bench::DoNotOptimize(std::accumulate(a.begin(), a.end(), 0.0f)); },
+            [&](bench::State &state) { for (auto _ : state) bench::DoNotOptimize(mystl::simd::sum(a.data(), a.size())); });
+    }
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[------------------ End algorithm test : simd ------------------]\n";
+}
+
+}}}    // namespace mystl::test::simd_test
+#endif // !MYTINYSTL_SIMD_TEST_H_
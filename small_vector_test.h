@@ -0,0 +1,136 @@
+#ifndef MYTINYSTL_SMALL_VECTOR_TEST_H_
+#define MYTINYSTL_SMALL_VECTOR_TEST_H_
+
+// small_vector test : 测试 small_vector 的接口，以及小规模时相对 vector 的构造、复制、移动性能
+
+#include <string>
+
+#include "my_small_vector.hpp"
+#include "my_vector.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace small_vector_test {
+
+// 与 vector 共用迭代器类型
+static_assert(std::is_same<mystl::small_vector<int, 8>::iterator, mystl::vector<int>::iterator>::value, "small_vector must reuse vector's iterator");
+static_assert(std::is_same<mystl::small_vector<int, 8>::const_iterator, mystl::vector<int>::const_iterator>::value,
+              "small_vector must reuse vector's const_iterator");
+static_assert(std::is_nothrow_move_assignable<mystl::small_vector<int, 8>>::value, "move assignment with an always-equal allocator cannot throw");
+static_assert(!std::is_nothrow_move_assignable<mystl::small_vector<int, 8, mystl::pmr::polymorphic_allocator<int>>>::value,
+              "move assignment between unequal pmr allocators may grow the heap buffer");
+
+// 反复构造含 k 个元素的容器并销毁，共 n 个容器
+template <class Vec>
+void build_bench(bench::State &state, size_t n, size_t k) {
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            Vec v;
+            for (size_t j = 0; j < k; ++j) {
+                v.push_back(static_cast<int>(j));
+            }
+            bench::DoNotOptimize(v.data());
+        }
+    }
+}
+
+// 复制 n 个含 k 个元素的容器
+template <class Vec>
+void copy_bench(bench::State &state, size_t n, size_t k) {
+    Vec src;
+    for (size_t j = 0; j < k; ++j) {
+        src.push_back(static_cast<int>(j));
+    }
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            Vec v(src);
+            bench::DoNotOptimize(v.data());
+        }
+    }
+}
+
+// 在两个容器之间来回移动 n 次
+template <class Vec>
+void move_bench(bench::State &state, size_t n, size_t k) {
+    Vec a, b;
+    for (size_t j = 0; j < k; ++j) {
+        a.push_back(static_cast<int>(j));
+    }
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            b = std::move(a);
+            bench::DoNotOptimize(b);
+            a = std::move(b);
+            bench::DoNotOptimize(a);
+        }
+    }
+}
+
+// 以 k 个元素分别测试 vector 与 small_vector<int, 8> ，每行输出两者耗时与比值
+template <class Bench>
+void small_size_row(const char *op, size_t n, size_t k, Bench bench_fn) {
+    bench_row(
+        "small_vector<int,8>::", std::string(op) + "/" + std::to_string(k), n, {"vector", "small_vector", false},
+        [&](bench::State &state) { bench_fn(state, mystl::vector<int>()); }, [&](bench::State &state) { bench_fn(state, mystl::small_vector<int, 8>()); });
+}
+
+void small_vector_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : small_vector --------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = {1, 2, 3, 4, 5};
+    mystl::small_vector<int, 4> v1;
+    mystl::small_vector<int, 4> v2(10);
+    mystl::small_vector<int, 4> v3(3, 1);
+    mystl::small_vector<int, 4> v4(a, a + 5);
+    mystl::small_vector<int, 4> v5(v3);
+    mystl::small_vector<int, 4> v6(std::move(v5));
+    mystl::small_vector<int, 4> v7{1, 2, 3};
+    std::cout << std::boolalpha;
+    FUN_VALUE(v1.is_inline());
+    FUN_VALUE(v2.is_inline());
+    FUN_VALUE(v6.is_inline());
+    FUN_VALUE(v5.empty());
+    FUN_AFTER(v1, v1.assign(4, 8));
+    FUN_VALUE(v1.is_inline());
+    FUN_AFTER(v1, v1.push_back(9));
+    FUN_VALUE(v1.is_inline());
+    FUN_VALUE(v1.capacity());
+    FUN_AFTER(v1, v1.insert(v1.begin() + 1, a, a + 3));
+    FUN_AFTER(v1, v1.erase(v1.begin(), v1.begin() + 5));
+    FUN_AFTER(v1, v1.shrink_to_fit());
+    FUN_VALUE(v1.is_inline());
+    FUN_AFTER(v1, v1.swap(v4));
+    FUN_AFTER(v4, v4 = std::move(v2));
+    FUN_VALUE(v2.is_inline());
+    FUN_AFTER(v7, v7 = v3);
+    FUN_VALUE((v7 == v3));
+    mystl::small_vector<std::string, 2> s1{"short", "a string that needs its own heap block"};
+    mystl::small_vector<std::string, 2> s2(std::move(s1));
+    FUN_AFTER(s2, s2.emplace_back("spilled"));
+    FUN_VALUE(s2.is_inline());
+    FUN_AFTER(s2, s2.pop_back());
+    FUN_AFTER(s2, s2.shrink_to_fit());
+    FUN_VALUE(s2.is_inline());
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  op  element count  |    vector   | small_vector| small/vector|\n";
+    for (size_t k : {1, 4, 8, 16}) {
+        small_size_row("build", LEN1, k, [&](bench::State &state, auto vec) { build_bench<decltype(vec)>(state, LEN1, k); });
+    }
+    for (size_t k : {1, 4, 8, 16}) {
+        small_size_row("copy", LEN1, k, [&](bench::State &state, auto vec) { copy_bench<decltype(vec)>(state, LEN1, k); });
+    }
+    for (size_t k : {1, 4, 8, 16}) {
+        small_size_row("move", LEN1, k, [&](bench::State &state, auto vec) { move_bench<decltype(vec)>(state, LEN1, k); });
+    }
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[-------------- End container test : small_vector --------------]\n";
+}
+
+}}}    // namespace mystl::test::small_vector_test
+#endif // !MYTINYSTL_SMALL_VECTOR_TEST_H_
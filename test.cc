@@ -1,6 +1,20 @@
 #include "test.h"
 #include "vector_test.h"
 #include "list_test.h"
+#include "any_test.h"
+#include "small_vector_test.h"
+#include "unrolled_list_test.h"
+#include "intrusive_list_test.h"
+#include "par_test.h"
+#include "simd_test.h"
+#include "unordered_map_test.h"
+#include "unordered_set_test.h"
+#include "map_test.h"
+#include "set_test.h"
+#include "flat_map_test.h"
+#include "flat_set_test.h"
+#include "deque_test.h"
+#include "ring_buffer_test.h"
 #include "my_any.hpp"
 #include <any>
 #include <iostream>
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "Lib/redbud/io/color.h"
+#include "benchmark.h"
 
 namespace mystl
 {
@@ -578,74 +579,117 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
 #define TEST_LEN(len1, len2, len3, wide) \
   test_len(len1, len2, len3, wide)
 
+// 对比表中两列在结果记录中的实现名，以及第四列比值的方向
+struct bench_columns
+{
+  std::string base;     // 第二列，如 std
+  std::string variant;  // 第三列，如 mystl
+  bool speedup;         // true 时比值为 base / variant ，大于 1 表示 variant 更快；false 时为 variant / base ，小于 1 表示更快
+};
+
+// 输出一行对比：首列 label 、两者的中位耗时与比值；统计了硬件事件时再输出两者的计数器
+inline void print_bench_row(const std::string& label, const bench::Result& base, const bench::Result& variant, bool speedup)
+{
+  auto ratio = speedup ? base.median_ns / variant.median_ns : variant.median_ns / base.median_ns;
+  std::cout << "|" << std::setw(21) << label << "|" << std::setw(13) << bench::format_time(base.median_ns) << "|"
+            << std::setw(13) << bench::format_time(variant.median_ns) << "|" << std::setw(13) << ratio << "|\n";
+  bench::PrintPairCounters(base, variant, 21, 14);
+}
+
+// 运行 cols 的两个版本并输出一行对比，首列为操作与元素数
+// name 为结果记录中的名称前缀，如 "map<int, int>::"
+template <class BaseBench, class VariantBench>
+void bench_row(const std::string& name, const std::string& op, size_t n, const bench_columns& cols,
+               BaseBench base_fn, VariantBench variant_fn)
+{
+  auto& b = bench::Run(name + op, cols.base, n, base_fn);
+  auto& v = bench::Run(name + op, cols.variant, n, variant_fn);
+  print_bench_row(op + " " + std::to_string(n), b, v, cols.speedup);
+}
+
+// std 与 mystl 的对比，比值为 std / mystl
+template <class StdBench, class MystlBench>
+void bench_row(const std::string& name, const std::string& op, size_t n, StdBench std_fn, MystlBench mystl_fn)
+{
+  bench_row(name, op, n, bench_columns{"std", "mystl", true}, std_fn, mystl_fn);
+}
+
 // 常用测试性能的宏
+// 由 benchmark.h 计时：每格输出单次运行耗时的中位数，容器的析构不计入
 #define FUN_TEST_FORMAT1(mode, fun, arg, count) do {         \
   srand((int)time(0));                                       \
-  clock_t start, end;                                        \
-  mode c;                                                    \
-  char buf[10];                                              \
-  start = clock();                                           \
-  for (size_t i = 0; i < count; ++i)                         \
-    c.fun(arg);                                              \
-  end = clock();                                             \
-  int n = static_cast<int>(static_cast<double>(end - start)  \
-      / CLOCKS_PER_SEC * 1000);                              \
-  std::snprintf(buf, sizeof(buf), "%d", n);                  \
-  std::string t = buf;                                       \
-  t += "ms    |";                                            \
-  std::cout << std::setw(WIDE) << t;                         \
+  auto& r = mystl::test::bench::RunCell(#mode, #fun, count,  \
+      [&](mystl::test::bench::State& state) {                \
+    for (auto _ : state) {                                   \
+      {                                                      \
+        mode c;                                              \
+        for (size_t i = 0; i < count; ++i)                   \
+          c.fun(arg);                                        \
+        mystl::test::bench::DoNotOptimize(c);                \
+        state.PauseTiming();                                 \
+      }                                                      \
+      state.ResumeTiming();                                  \
+    }                                                        \
+  });                                                        \
+  mystl::test::bench::PrintCell(r, WIDE);                    \
 } while(0)
 
 #define FUN_TEST_FORMAT2(mode, fun, arg1, arg2, count) do {  \
   srand((int)time(0));                                       \
-  clock_t start, end;                                        \
-  mode c;                                                    \
-  char buf[10];                                              \
-  start = clock();                                           \
-  for (size_t i = 0; i < count; ++i)                         \
-    c.fun(c.arg1(), arg2);                                   \
-  end = clock();                                             \
-  int n = static_cast<int>(static_cast<double>(end - start)  \
-      / CLOCKS_PER_SEC * 1000);                              \
-  std::snprintf(buf, sizeof(buf), "%d", n);                  \
-  std::string t = buf;                                       \
-  t += "ms    |";                                            \
-  std::cout << std::setw(WIDE) << t;                         \
+  auto& r = mystl::test::bench::RunCell(#mode, #fun, count,  \
+      [&](mystl::test::bench::State& state) {                \
+    for (auto _ : state) {                                   \
+      {                                                      \
+        mode c;                                              \
+        for (size_t i = 0; i < count; ++i)                   \
+          c.fun(c.arg1(), arg2);                             \
+        mystl::test::bench::DoNotOptimize(c);                \
+        state.PauseTiming();                                 \
+      }                                                      \
+      state.ResumeTiming();                                  \
+    }                                                        \
+  });                                                        \
+  mystl::test::bench::PrintCell(r, WIDE);                    \
 } while(0)
 
+// 每次迭代重新填充一个乱序的链表，填充与析构不计入
 #define LIST_SORT_DO_TEST(mode, count) do {                  \
   srand((int)time(0));                                       \
-  clock_t start, end;                                        \
-  mode::list<int> l;                                         \
-  char buf[10];                                              \
-  for (size_t i = 0; i < count; ++i)                         \
-    l.insert(l.end(), rand());                               \
-  start = clock();                                           \
-  l.sort();                                                  \
-  end = clock();                                             \
-  int n = static_cast<int>(static_cast<double>(end - start)  \
-      / CLOCKS_PER_SEC * 1000);                              \
-  std::snprintf(buf, sizeof(buf), "%d", n);                  \
-  std::string t = buf;                                       \
-  t += "ms    |";                                            \
-  std::cout << std::setw(WIDE) << t;                         \
+  auto& r = mystl::test::bench::Run("list<int>::sort", #mode,\
+      count, [&](mystl::test::bench::State& state) {         \
+    for (auto _ : state) {                                   \
+      state.PauseTiming();                                   \
+      {                                                      \
+        mode::list<int> l;                                   \
+        for (size_t i = 0; i < count; ++i)                   \
+          l.insert(l.end(), rand());                         \
+        state.ResumeTiming();                                \
+        l.sort();                                            \
+        mystl::test::bench::DoNotOptimize(l);                \
+        state.PauseTiming();                                 \
+      }                                                      \
+      state.ResumeTiming();                                  \
+    }                                                        \
+  });                                                        \
+  mystl::test::bench::PrintCell(r, WIDE);                    \
 } while(0)
 
 #define MAP_EMPLACE_DO_TEST(mode, con, count) do {           \
   srand((int)time(0));                                       \
-  clock_t start, end;                                        \
-  mode::con<int, int> c;                                     \
-  char buf[10];                                              \
-  start = clock();                                           \
-  for (size_t i = 0; i < count; ++i)                         \
-    c.emplace(mode::make_pair(rand(), rand()));              \
-  end = clock();                                             \
-  int n = static_cast<int>(static_cast<double>(end - start)  \
-      / CLOCKS_PER_SEC * 1000);                              \
-  std::snprintf(buf, sizeof(buf), "%d", n);                  \
-  std::string t = buf;                                       \
-  t += "ms    |";                                            \
-  std::cout << std::setw(WIDE) << t;                         \
+  auto& r = mystl::test::bench::Run(#con "<int, int>::emplace", \
+      #mode, count, [&](mystl::test::bench::State& state) {  \
+    for (auto _ : state) {                                   \
+      {                                                      \
+        mode::con<int, int> c;                               \
+        for (size_t i = 0; i < count; ++i)                   \
+          c.emplace(mode::make_pair(rand(), rand()));        \
+        mystl::test::bench::DoNotOptimize(c);                \
+        state.PauseTiming();                                 \
+      }                                                      \
+      state.ResumeTiming();                                  \
+    }                                                        \
+  });                                                        \
+  mystl::test::bench::PrintCell(r, WIDE);                    \
 } while(0)
 
 // 重构重复代码
@@ -658,7 +702,9 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
   std::cout << "\n|        mystl        |";                  \
   FUN_TEST_FORMAT1(mystl::con, fun, arg, len1);              \
   FUN_TEST_FORMAT1(mystl::con, fun, arg, len2);              \
-  FUN_TEST_FORMAT1(mystl::con, fun, arg, len3);    
+  FUN_TEST_FORMAT1(mystl::con, fun, arg, len3);              \
+  mystl::test::bench::PrintComparisonRows(#con "::" #fun,    \
+      len1, len2, len3, WIDE);
 
 #define CON_TEST_P2(con, fun, arg1, arg2, len1, len2, len3)  \
   TEST_LEN(len1, len2, len3, WIDE);                          \
@@ -669,7 +715,9 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
   std::cout << "\n|        mystl        |";                  \
   FUN_TEST_FORMAT2(mystl::con, fun, arg1, arg2, len1);       \
   FUN_TEST_FORMAT2(mystl::con, fun, arg1, arg2, len2);       \
-  FUN_TEST_FORMAT2(mystl::con, fun, arg1, arg2, len3);    
+  FUN_TEST_FORMAT2(mystl::con, fun, arg1, arg2, len3);       \
+  mystl::test::bench::PrintComparisonRows(#con "::" #fun,    \
+      len1, len2, len3, WIDE);
 
 #define MAP_EMPLACE_TEST(con, len1, len2, len3)              \
   TEST_LEN(len1, len2, len3, WIDE);                          \
@@ -680,7 +728,9 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
   std::cout << "\n|        mystl        |";                  \
   MAP_EMPLACE_DO_TEST(mystl, con, len1);                     \
   MAP_EMPLACE_DO_TEST(mystl, con, len2);                     \
-  MAP_EMPLACE_DO_TEST(mystl, con, len3);
+  MAP_EMPLACE_DO_TEST(mystl, con, len3);                     \
+  mystl::test::bench::PrintComparisonRows(#con "<int, int>::emplace", \
+      len1, len2, len3, WIDE);
 
 #define LIST_SORT_TEST(len1, len2, len3)                     \
   TEST_LEN(len1, len2, len3, WIDE);                          \
@@ -691,7 +741,9 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide)
   std::cout << "\n|        mystl        |";                  \
   LIST_SORT_DO_TEST(mystl, len1);                            \
   LIST_SORT_DO_TEST(mystl, len2);                            \
-  LIST_SORT_DO_TEST(mystl, len3);
+  LIST_SORT_DO_TEST(mystl, len3);                            \
+  mystl::test::bench::PrintComparisonRows("list<int>::sort", \
+      len1, len2, len3, WIDE);
 
 // 简单测试的宏定义
 #define TEST(testcase_name) \
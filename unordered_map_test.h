@@ -0,0 +1,231 @@
+#ifndef MYTINYSTL_UNORDERED_MAP_TEST_H_
+#define MYTINYSTL_UNORDERED_MAP_TEST_H_
+
+// unordered_map test : 测试 unordered_map 的接口、与 std::unordered_map 随机对比的结果，以及 emplace, find, erase, 遍历的性能
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "my_unordered_map.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace unordered_map_test {
+
+static_assert(std::is_same<mystl::unordered_map<int, int>::iterator, mystl::vector_iterator<std::pair<const int, int>>>::value,
+              "unordered_map iterates its dense element array");
+static_assert(sizeof(mystl::hash_bucket) == 8, "a bucket holds a 32-bit index and 32 bits of hash");
+static_assert(std::is_nothrow_move_assignable<mystl::unordered_map<int, int>>::value, "move assignment with an always-equal allocator cannot throw");
+static_assert(!std::is_nothrow_move_assignable<mystl::pmr::unordered_map<int, int>>::value, "move assignment between unequal pmr allocators copies buckets");
+
+struct string_hash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+};
+
+struct string_equal {
+    using is_transparent = void;
+    bool operator()(std::string_view a, std::string_view b) const { return a == b; }
+};
+
+// 插入、删除、查找随机交错，每一步与 std::unordered_map 对比
+bool check_random(unsigned seed) {
+    std::mt19937 gen(seed);
+    bool ok = true;
+    for (int round = 0; round < 8; ++round) {
+        mystl::unordered_map<int, int> m;
+        std::unordered_map<int, int> r;
+        int range = 50 + round * 500;
+        for (int i = 0; i < 20000; ++i) {
+            int k = static_cast<int>(gen() % range);
+            auto op = gen() % 4;
+            if (op < 2) {
+                auto a = m.emplace(mystl::make_pair(k, i));
+                auto b = r.emplace(k, i);
+                ok = ok && a.second == b.second && a.first->second == b.first->second;
+            } else if (op == 2) {
+                ok = ok && m.erase(k) == r.erase(k);
+            } else {
+                auto it = m.find(k);
+                auto jt = r.find(k);
+                ok = ok && (it == m.end()) == (jt == r.end()) && (it == m.end() || it->second == jt->second);
+            }
+            ok = ok && m.size() == r.size();
+        }
+        for (auto &kv : r) {
+            ok = ok && m.at(kv.first) == kv.second;
+        }
+        // 边遍历边删除，每个剩余元素恰好访问一次
+        size_t visited = 0;
+        for (auto it = m.begin(); it != m.end();) {
+            ++visited;
+            it = it->first % 3 == 0 ? m.erase(it) : it + 1;
+        }
+        size_t kept = 0;
+        for (auto &kv : r) {
+            kept += kv.first % 3 != 0;
+        }
+        ok = ok && visited == r.size() && m.size() == kept;
+        auto c = m;
+        auto d = std::move(c);
+        ok = ok && c.empty() && d == m;
+        m.rehash(0);
+        m.reserve(1000);
+        ok = ok && d == m;
+    }
+    return ok;
+}
+
+// 透明的哈希与相等比较：删除后以字面量和 string_view 查找，键的哈希按 string_view 计算
+bool check_transparent() {
+    mystl::unordered_map<std::string, int, string_hash, string_equal> m;
+    for (int i = 0; i < 1000; ++i) {
+        m[std::to_string(i)] = i;
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        m.erase(std::to_string(i));
+    }
+    bool ok = m.size() == 500 && m.count("7") == 1 && !m.contains(std::string_view("8"));
+    for (int i = 0; i < 1000; ++i) {
+        ok = ok && m.count(std::to_string(i)) == static_cast<size_t>(i % 2);
+    }
+    return ok && m.find(std::string_view("999"))->second == 999;
+}
+
+// 随机键的查找（全部命中）、删除一半、遍历求和
+void lookup_rows(size_t n) {
+    std::mt19937 gen(42);
+    mystl::vector<int> keys(n);
+    for (auto &k : keys) {
+        k = static_cast<int>(gen());
+    }
+    std::unordered_map<int, int> s;
+    mystl::unordered_map<int, int> m;
+    for (auto k : keys) {
+        s.emplace(k, k);
+        m.emplace(k, k);
+    }
+    bench_row(
+        "unordered_map<int, int>::", "find", n,
+        [&](bench::State &state) {
+            for (auto _ : state)
+                for (auto k : keys) bench::DoNotOptimize(s.find(k));
+        },
+        [&](bench::State &state) {
+            for (auto _ : state)
+                for (auto k : keys) bench::DoNotOptimize(m.find(k));
+        });
+    bench_row(
+        "unordered_map<int, int>::", "erase", n,
+        [&](bench::State &state) {
+            for (auto _ : state) {
+                {
+                    state.PauseTiming();
+                    auto c = s;
+                    state.ResumeTiming();
+                    for (size_t i = 0; i < n; i += 2) c.erase(keys[i]);
+                    state.PauseTiming();
+                }
+                state.ResumeTiming();
+            }
+        },
+        [&](bench::State &state) {
+            for (auto _ : state) {
+                {
+                    state.PauseTiming();
+                    auto c = m;
+                    state.ResumeTiming();
+                    for (size_t i = 0; i < n; i += 2) c.erase(keys[i]);
+                    state.PauseTiming();
+                }
+                state.ResumeTiming();
+            }
+        });
+    bench_row(
+        "unordered_map<int, int>::", "iterate", n,
+        [&](bench::State &state) {
+            for (auto _ : state) {
+                long long sum = 0;
+                for (auto &kv : s) sum += kv.second;
+                bench::DoNotOptimize(sum);
+            }
+        },
+        [&](bench::State &state) {
+            for (auto _ : state) {
+                long long sum = 0;
+                for (auto &kv : m) sum += kv.second;
+                bench::DoNotOptimize(sum);
+            }
+        });
+}
+
+void unordered_map_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : unordered_map -------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    mystl::unordered_map<int, int> m1;
+    mystl::unordered_map<int, int> m2{{1, 1}, {2, 4}, {3, 9}, {2, 5}};
+    mystl::unordered_map<int, int> m3(m2);
+    mystl::unordered_map<int, int> m4(std::move(m3));
+    mystl::unordered_map<std::string, int> m5;
+    std::cout << std::boolalpha;
+    FUN_VALUE(m1.size());
+    FUN_VALUE(m1.bucket_count());
+    FUN_VALUE(m2.size());
+    FUN_VALUE(m2.at(2));
+    FUN_VALUE(m4.count(3));
+    FUN_VALUE(m1.emplace(1, 10).second);
+    FUN_VALUE(m1.emplace(1, 11).second);
+    FUN_VALUE(m1.insert(mystl::make_pair(2, 20)).second);
+    FUN_VALUE(m1.try_emplace(3, 30).second);
+    FUN_VALUE(m1.insert_or_assign(3, 31).second);
+    FUN_VALUE(m1[3]);
+    FUN_VALUE(m1[4]);
+    FUN_VALUE(m1.size());
+    FUN_VALUE(m1.begin()->first);
+    FUN_VALUE(m1.erase(1));
+    FUN_VALUE(m1.erase(1));
+    FUN_VALUE(m1.begin()->first);
+    FUN_VALUE(m1.contains(2));
+    FUN_VALUE((m1.find(5) == m1.end()));
+    FUN_VALUE(m1.size());
+    FUN_VALUE((m2 == m4));
+    FUN_VALUE((m1 != m2));
+    FUN_VALUE(m5.try_emplace("abc", 3).first->second);
+    FUN_VALUE(m5["abc"]);
+    m1.reserve(1000);
+    FUN_VALUE(m1.bucket_count());
+    FUN_VALUE(m1.load_factor());
+    FUN_VALUE(m1.max_load_factor());
+    m1.clear();
+    FUN_VALUE(m1.empty());
+    m1.rehash(0);
+    FUN_VALUE(m1.bucket_count());
+    FUN_VALUE(check_random(1));
+    FUN_VALUE(check_transparent());
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|       emplace       |";
+#if LARGER_TEST_DATA_ON
+    MAP_EMPLACE_TEST(unordered_map, LEN1 _L, LEN2 _L, LEN3 _L);
+#else
+    MAP_EMPLACE_TEST(unordered_map, LEN1 _M, LEN2 _M, LEN3 _M);
+#endif
+    std::cout << "\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  op  element count  |     std     |    mystl    |   speedup   |\n";
+    for (size_t n : {size_t(LEN1 _M), size_t(LEN3 _M)}) {
+        lookup_rows(n);
+    }
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[-------------- End container test : unordered_map -------------]\n";
+}
+
+}}}    // namespace mystl::test::unordered_map_test
+#endif // !MYTINYSTL_UNORDERED_MAP_TEST_H_
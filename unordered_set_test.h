@@ -0,0 +1,105 @@
+#ifndef MYTINYSTL_UNORDERED_SET_TEST_H_
+#define MYTINYSTL_UNORDERED_SET_TEST_H_
+
+// unordered_set test : 测试 unordered_set 的接口与 insert, find 的性能
+
+#include <random>
+#include <unordered_set>
+
+#include "my_unordered_set.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace unordered_set_test {
+
+static_assert(std::is_same<mystl::unordered_set<int>::iterator, mystl::unordered_set<int>::const_iterator>::value,
+              "unordered_set elements must not be modified through iterators");
+
+// 随机插入与删除，与 std::unordered_set 对比；最后按区间删除全部元素
+bool check_random(unsigned seed) {
+    std::mt19937 gen(seed);
+    mystl::unordered_set<int> s;
+    std::unordered_set<int> r;
+    bool ok = true;
+    for (int i = 0; i < 50000; ++i) {
+        int k = static_cast<int>(gen() % 3000);
+        if (gen() % 3) {
+            ok = ok && s.insert(k).second == r.insert(k).second;
+        } else {
+            ok = ok && s.erase(k) == r.erase(k);
+        }
+    }
+    for (int k = 0; k < 3000; ++k) {
+        ok = ok && s.count(k) == r.count(k);
+    }
+    ok = ok && s.size() == r.size();
+    s.erase(s.begin(), s.end());
+    return ok && s.empty() && s.find(1) == s.end();
+}
+
+template <class Set>
+void insert_find(const mystl::vector<int> &keys) {
+    Set s;
+    for (auto k : keys) {
+        s.insert(k);
+    }
+    size_t hits = 0;
+    for (auto k : keys) {
+        hits += s.find(k) != s.end();
+    }
+    bench::DoNotOptimize(hits);
+}
+
+void unordered_set_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : unordered_set -------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = {5, 3, 5, 1, 3, 9};
+    mystl::unordered_set<int> s1;
+    mystl::unordered_set<int> s2(a, a + 6);
+    mystl::unordered_set<int> s3{1, 2, 3};
+    mystl::unordered_set<int> s4;
+    s4 = s2;
+    std::cout << std::boolalpha;
+    COUT(s2);
+    FUN_VALUE(s2.size());
+    FUN_AFTER(s1, s1.insert({4, 2, 4, 8}));
+    FUN_AFTER(s1, s1.emplace(6));
+    FUN_AFTER(s1, s1.erase(s1.begin()));
+    FUN_AFTER(s1, s1.erase(8));
+    FUN_AFTER(s1, s1.insert(a, a + 6));
+    FUN_AFTER(s1, s1.swap(s3));
+    FUN_VALUE(s1.contains(2));
+    FUN_VALUE(s3.count(7));
+    FUN_VALUE((s2 == s4));
+    FUN_VALUE((s1 == s3));
+    FUN_AFTER(s1, s1.clear());
+    FUN_VALUE(check_random(1));
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  op  element count  |     std     |    mystl    |   speedup   |\n";
+    for (size_t n : {size_t(LEN1 _M), size_t(LEN2 _M)}) {
+        std::mt19937 gen(7);
+        mystl::vector<int> keys(n);
+        for (auto &k : keys) {
+            k = static_cast<int>(gen());
+        }
+        bench_row(
+            "unordered_set<int>::", "insert_find", n,
+            [&](bench::State &state) {
+                for (auto _ : state) insert_find<std::unordered_set<int>>(keys);
+            },
+            [&](bench::State &state) {
+                for (auto _ : state) insert_find<mystl::unordered_set<int>>(keys);
+            });
+    }
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[-------------- End container test : unordered_set -------------]\n";
+}
+
+}}}    // namespace mystl::test::unordered_set_test
+#endif // !MYTINYSTL_UNORDERED_SET_TEST_H_
@@ -0,0 +1,166 @@
+#ifndef MYTINYSTL_UNROLLED_LIST_TEST_H_
+#define MYTINYSTL_UNROLLED_LIST_TEST_H_
+
+// unrolled_list test : 测试 unrolled_list 的接口，以及遍历、中间插入、删除相对 list 的性能
+
+#include <string>
+
+#include "my_list.hpp"
+#include "my_unrolled_list.hpp"
+#include "test.h"
+
+namespace mystl { namespace test { namespace unrolled_list_test {
+
+static_assert(sizeof(mystl::unrolled_block<int, 64>) <= 64, "a block must fit in BlockBytes");
+static_assert(alignof(mystl::unrolled_block<int, 64>) == mystl::cache_line_size, "a block must occupy exactly one cache line");
+static_assert(mystl::unrolled_list<int>::block_capacity == 10, "a cache line holds ten ints after the block header");
+static_assert(mystl::unrolled_list<std::string, 16>::block_capacity == 1, "a block holds at least one element");
+static_assert(std::is_nothrow_move_assignable<mystl::unrolled_list<int>>::value, "move assignment with an always-equal allocator cannot throw");
+static_assert(!std::is_nothrow_move_assignable<mystl::unrolled_list<int, 64, mystl::pmr::polymorphic_allocator<int>>>::value,
+              "move assignment between unequal pmr allocators allocates blocks");
+
+template <class List>
+List make_list(size_t n) {
+    List l;
+    for (size_t i = 0; i < n; ++i) {
+        l.push_back(static_cast<int>(i));
+    }
+    return l;
+}
+
+// 尾部逐个插入 n 个元素
+template <class List>
+void push_back_bench(bench::State &state, size_t n) {
+    for (auto _ : state) {
+        List l;
+        for (size_t i = 0; i < n; ++i) {
+            l.push_back(static_cast<int>(i));
+        }
+        bench::DoNotOptimize(l.size());
+    }
+}
+
+// 顺序遍历求和
+template <class List>
+void iterate_bench(bench::State &state, size_t n) {
+    auto l = make_list<List>(n);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (auto &x : l) {
+            sum += x;
+        }
+        bench::DoNotOptimize(sum);
+    }
+}
+
+// 从头走到尾，在每个元素之前插入一个新元素，长度翻倍
+template <class List>
+void insert_bench(bench::State &state, size_t n) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto l = make_list<List>(n);
+        state.ResumeTiming();
+        for (auto it = l.begin(); it != l.end(); ++it) {
+            it = l.insert(it, -1);
+            ++it;
+        }
+        bench::DoNotOptimize(l.size());
+        state.PauseTiming();
+        l.clear();
+        state.ResumeTiming();
+    }
+}
+
+// 从头走到尾，每隔一个元素删除一个
+template <class List>
+void erase_bench(bench::State &state, size_t n) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto l = make_list<List>(n);
+        state.ResumeTiming();
+        for (auto it = l.begin(); it != l.end();) {
+            it = l.erase(it);
+            if (it != l.end()) {
+                ++it;
+            }
+        }
+        bench::DoNotOptimize(l.size());
+        state.PauseTiming();
+        l.clear();
+        state.ResumeTiming();
+    }
+}
+
+// 分别测试 list<int> 与 unrolled_list<int> ，每行输出两者耗时与比值
+template <class Bench>
+void unrolled_row(const char *op, size_t n, Bench bench_fn) {
+    bench_row(
+        "unrolled_list<int>::", op, n, {"list", "unrolled_list", false}, [&](bench::State &state) { bench_fn(state, mystl::list<int>()); },
+        [&](bench::State &state) { bench_fn(state, mystl::unrolled_list<int>()); });
+}
+
+void unrolled_list_test() {
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : unrolled_list --------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    int a[] = {1, 2, 3, 4, 5};
+    mystl::unrolled_list<int> l1;
+    mystl::unrolled_list<int> l2(25);
+    mystl::unrolled_list<int> l3(3, 1);
+    mystl::unrolled_list<int> l4(a, a + 5);
+    mystl::unrolled_list<int> l5(l4);
+    mystl::unrolled_list<int> l6(std::move(l5));
+    mystl::unrolled_list<int> l7{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::cout << std::boolalpha;
+    FUN_VALUE(l2.block_count());
+    FUN_VALUE(l5.empty());
+    FUN_AFTER(l1, l1.assign(12, 8));
+    FUN_VALUE(l1.block_count());
+    FUN_AFTER(l1, l1.insert(++l1.begin(), a, a + 5));
+    FUN_VALUE(l1.block_count());
+    FUN_AFTER(l1, l1.erase(l1.begin(), ++++++l1.begin()));
+    FUN_AFTER(l1, l1.push_front(0));
+    FUN_AFTER(l1, l1.emplace_back(10));
+    FUN_AFTER(l1, l1.pop_back());
+    FUN_AFTER(l1, l1.remove(8));
+    FUN_VALUE(l1.block_count());
+    FUN_AFTER(l1, l1.remove_if([](int x) { return x & 1; }));
+    FUN_AFTER(l7, l7.splice(++++l7.begin(), l4));
+    FUN_VALUE(l4.empty());
+    FUN_VALUE(l7.block_count());
+    FUN_AFTER(l7, l7.resize(4));
+    FUN_AFTER(l7, l7.swap(l6));
+    FUN_VALUE((l6 == l7));
+    FUN_AFTER(l3, l3 = l6);
+    FUN_VALUE((l3 == l6));
+    mystl::unrolled_list<std::string, 96> s1{"short", "a string that needs its own heap block"};
+    FUN_VALUE(s1.block_capacity);
+    FUN_VALUE(s1.front());
+    s1.insert(++s1.begin(), s1.back());
+    FUN_VALUE(*++s1.begin());
+    std::cout << std::noboolalpha;
+    PASSED;
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|  op  element count  |    list     |unrolled_list|unrolled/list|\n";
+    for (size_t n : {LEN1, LEN2}) {
+        unrolled_row("push_back", n, [&](bench::State &state, auto l) { push_back_bench<decltype(l)>(state, n); });
+    }
+    for (size_t n : {LEN1, LEN2}) {
+        unrolled_row("iterate", n, [&](bench::State &state, auto l) { iterate_bench<decltype(l)>(state, n); });
+    }
+    for (size_t n : {LEN1, LEN2}) {
+        unrolled_row("insert", n, [&](bench::State &state, auto l) { insert_bench<decltype(l)>(state, n); });
+    }
+    for (size_t n : {LEN1, LEN2}) {
+        unrolled_row("erase", n, [&](bench::State &state, auto l) { erase_bench<decltype(l)>(state, n); });
+    }
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    PASSED;
+#endif
+    std::cout << "[------------- End container test : unrolled_list --------------]\n";
+}
+
+}}}    // namespace mystl::test::unrolled_list_test
+#endif // !MYTINYSTL_UNROLLED_LIST_TEST_H_
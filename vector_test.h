@@ -1,8 +1,9 @@
 ﻿#ifndef MYTINYSTL_VECTOR_TEST_H_
 #define MYTINYSTL_VECTOR_TEST_H_
 
-// vector test : 测试 vector 的接口与 push_back 的性能
+// vector test : 测试 vector 的接口、push_back 的性能以及迭代器与裸指针遍历的性能差异
 
+#include <numeric>
 #include <vector>
 
 #include "my_vector.hpp"
@@ -10,6 +11,42 @@
 
 namespace mystl { namespace test { namespace vector_test {
 
+// 迭代器应与裸指针一样轻量
+static_assert(std::is_trivially_copyable<mystl::vector<int>::iterator>::value, "vector iterator must be trivially copyable");
+static_assert(sizeof(mystl::vector<int>::iterator) == sizeof(int *), "vector iterator must be pointer-sized");
+static_assert(std::is_nothrow_move_assignable<mystl::vector<int>>::value, "move assignment with an always-equal allocator cannot throw");
+static_assert(!std::is_nothrow_move_assignable<mystl::pmr::vector<int>>::value, "move assignment between unequal pmr allocators allocates");
+#if __cplusplus > 201703L
+static_assert(std::contiguous_iterator<mystl::vector<int>::iterator>, "vector iterator must model contiguous_iterator");
+static_assert(std::contiguous_iterator<mystl::vector<int>::const_iterator>, "vector const_iterator must model contiguous_iterator");
+#endif
+
+// 输出一种增长策略在追加 count 个元素后的最终容量、浪费的字节数与重新分配次数
+template <typename Policy>
+void growth_waste_test(const char *name, size_t count, size_t elem_size) {
+    auto report = mystl::simulate_growth<Policy>(count, elem_size);
+    std::cout << "|" << std::setw(21) << name << "|" << std::setw(13) << report.capacity << "|" << std::setw(13) << report.wasted_bytes << "|"
+              << std::setw(13) << report.reallocations << "|\n";
+}
+
+// 对 [first, last) 执行 fn ，返回单次执行耗时的中位数
+template <typename Iter, typename Fn>
+const bench::Result &loop_time(const char *name, const char *variant, Iter first, Iter last, Fn fn) {
+    return bench::Run(name, variant, static_cast<size_t>(last - first), [&](bench::State &state) {
+        for (auto _ : state) {
+            fn(first, last);
+        }
+    });
+}
+
+// 分别以 vector 迭代器与裸指针遍历同一块数据执行 fn ，两者耗时应当一致
+template <typename Fn>
+void iterator_parity_test(const char *name, mystl::vector<int> &v, Fn fn) {
+    auto &iter = loop_time(name, "iterator", v.begin(), v.end(), fn);
+    auto &ptr = loop_time(name, "pointer", v.data(), v.data() + v.size(), fn);
+    print_bench_row(name, iter, ptr, true);
+}
+
 void vector_test() {
     std::cout << "[===============================================================]\n";
     std::cout << "[----------------- Run container test : vector -----------------]\n";
@@ -86,6 +123,13 @@ void vector_test() {
     FUN_AFTER(v1, v1.shrink_to_fit());
     FUN_VALUE(v1.size());
     FUN_VALUE(v1.capacity());
+    mystl::pmr::monotonic_buffer_resource arena;
+    mystl::pmr::unsynchronized_pool_resource pool;
+    mystl::pmr::vector<int> pv1(&arena);
+    mystl::pmr::vector<int> pv2(&pool);
+    FUN_AFTER(pv1, pv1.assign(a, a + 5));
+    FUN_AFTER(pv2, pv2.assign(8, 8));
+    FUN_AFTER(pv1, pv1 = std::move(pv2));
     PASSED;
 #if PERFORMANCE_TEST_ON
     std::cout << "[--------------------- Performance Testing ---------------------]\n";
@@ -98,6 +142,29 @@ void vector_test() {
 #endif
     std::cout << "\n";
     std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|    growth policy    |   capacity  | waste bytes |   reallocs  |\n";
+    growth_waste_test<mystl::exact_growth>("exact", LEN1 + 1, sizeof(int));
+    growth_waste_test<mystl::double_growth>("double", LEN1 + 1, sizeof(int));
+    growth_waste_test<mystl::one_and_half_growth>("1.5x", LEN1 + 1, sizeof(int));
+    growth_waste_test<mystl::golden_growth>("golden", LEN1 + 1, sizeof(int));
+    growth_waste_test<mystl::page_growth<>>("page", LEN1 + 1, sizeof(int));
+    growth_waste_test<mystl::size_class_growth<>>("size class", LEN1 + 1, sizeof(int));
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
+    std::cout << "|    iterator loop    |   iterator  |     T *     |   iter/ptr  |\n";
+    {
+        mystl::vector<int> data(LEN3);
+        mystl::vector<int> out(LEN3);
+        for (auto &i : data) {
+            i = rand();
+        }
+        iterator_parity_test("accumulate", data, [](auto first, auto last) { bench::DoNotOptimize(std::accumulate(first, last, 0LL)); });
+        iterator_parity_test("find", data, [](auto first, auto last) { bench::DoNotOptimize(std::find(first, last, -1)); });
+        iterator_parity_test("copy", data, [&](auto first, auto last) {
+            std::copy(first, last, out.data());
+            bench::ClobberMemory();
+        });
+    }
+    std::cout << "|---------------------|-------------|-------------|-------------|\n";
     PASSED;
 #endif
     std::cout << "[----------------- End container test : vector -----------------]\n";